@@ -1,5 +1,7 @@
 #include "bimodal.h"
 
+#include "checkpoint.h"
+
 bool bimodal::predict_branch(champsim::address ip)
 {
   auto value = bimodal_table[hash(ip)];
@@ -10,3 +12,7 @@ void bimodal::last_branch_result(champsim::address ip, champsim::address branch_
 {
   bimodal_table[hash(ip)] += taken ? 1 : -1;
 }
+
+void bimodal::branch_predictor_save_checkpoint(std::ostream& os) const { champsim::checkpoint::write(os, bimodal_table); }
+
+void bimodal::branch_predictor_restore_checkpoint(std::istream& is) { champsim::checkpoint::read(is, bimodal_table); }
@@ -1,5 +1,7 @@
 #include "gshare.h"
 
+#include "checkpoint.h"
+
 std::size_t gshare::gs_table_hash(champsim::address ip, std::bitset<GLOBAL_HISTORY_LENGTH> bh_vector)
 {
   constexpr champsim::data::bits LOG2_HISTORY_TABLE_SIZE{champsim::lg2(GS_HISTORY_TABLE_SIZE)};
@@ -29,3 +31,17 @@ void gshare::last_branch_result(champsim::address ip, champsim::address branch_t
   branch_history_vector <<= 1;
   branch_history_vector[0] = taken;
 }
+
+void gshare::branch_predictor_save_checkpoint(std::ostream& os) const
+{
+  champsim::checkpoint::write(os, static_cast<uint64_t>(branch_history_vector.to_ullong()));
+  champsim::checkpoint::write(os, gs_history_table);
+}
+
+void gshare::branch_predictor_restore_checkpoint(std::istream& is)
+{
+  uint64_t history{};
+  champsim::checkpoint::read(is, history);
+  branch_history_vector = decltype(branch_history_vector){history};
+  champsim::checkpoint::read(is, gs_history_table);
+}
@@ -49,6 +49,8 @@ sources for you to plagiarize.
 
 #include <numeric>
 
+#include "checkpoint.h"
+
 bool hashed_perceptron::predict_branch(champsim::address pc)
 {
   auto get_index = [pc_slice = pc.slice_lower<TABLE_INDEX_BITS>().to<uint64_t>()](const auto& hist) {
@@ -100,3 +102,18 @@ void hashed_perceptron::adjust_threshold(bool correct)
     }
   }
 }
+
+// The global history is rebuilt within a few hundred branches, so only the weights and the threshold are kept
+void hashed_perceptron::branch_predictor_save_checkpoint(std::ostream& os) const
+{
+  champsim::checkpoint::write(os, tables);
+  champsim::checkpoint::write(os, theta);
+  champsim::checkpoint::write(os, tc);
+}
+
+void hashed_perceptron::branch_predictor_restore_checkpoint(std::istream& is)
+{
+  champsim::checkpoint::read(is, tables);
+  champsim::checkpoint::read(is, theta);
+  champsim::checkpoint::read(is, tc);
+}
@@ -3,12 +3,13 @@
 
 #include <array>
 #include <cstdint>
+#include <iosfwd>
 #include <tuple>
 #include <vector>
 
-#include "folded_shift_register.h"
 #include "modules.h"
 #include "msl/bits.h"
+#include "msl/folded_shift_register.h"
 #include "msl/fwcounter.h"
 
 class hashed_perceptron : champsim::modules::branch_predictor
@@ -51,6 +52,8 @@ public:
   bool predict_branch(champsim::address pc);
   void last_branch_result(champsim::address pc, champsim::address branch_target, bool taken, uint8_t branch_type);
   void adjust_threshold(bool correct);
+  void branch_predictor_save_checkpoint(std::ostream& os) const;
+  void branch_predictor_restore_checkpoint(std::istream& is);
 };
 
 #endif
@@ -40,6 +40,8 @@
 
 #include <cmath>
 
+#include "checkpoint.h"
+
 bool perceptron::predict_branch(champsim::address ip)
 {
   // hash the address to get an index into the table of perceptrons
@@ -86,3 +88,20 @@ void perceptron::last_branch_result(champsim::address ip, champsim::address bran
     perceptrons[index].update(taken, history);
   }
 }
+
+// The branches in flight are fetched again by the restored run, so the speculative history restarts from the committed history
+void perceptron::branch_predictor_save_checkpoint(std::ostream& os) const
+{
+  champsim::checkpoint::write(os, perceptrons);
+  champsim::checkpoint::write(os, static_cast<uint64_t>(global_history.to_ullong()));
+}
+
+void perceptron::branch_predictor_restore_checkpoint(std::istream& is)
+{
+  uint64_t history{};
+  champsim::checkpoint::read(is, perceptrons);
+  champsim::checkpoint::read(is, history);
+  global_history = decltype(global_history){history};
+  spec_global_history = global_history;
+  perceptron_state_buf.clear();
+}
@@ -8,6 +8,7 @@
 
 #include "basic_btb.h"
 
+#include "checkpoint.h"
 #include "instruction.h"
 
 std::pair<champsim::address, bool> basic_btb::btb_prediction(champsim::address ip)
@@ -46,3 +47,35 @@ void basic_btb::update_btb(champsim::address ip, champsim::address branch_target
 
   direct.update(ip, branch_target, branch_type);
 }
+
+void basic_btb::btb_save_checkpoint(std::ostream& os) const
+{
+  direct.BTB.save_checkpoint(os);
+
+  champsim::checkpoint::write(os, indirect.predictor);
+  champsim::checkpoint::write(os, static_cast<uint64_t>(indirect.conditional_history.to_ullong()));
+
+  champsim::checkpoint::write(os, static_cast<uint64_t>(std::size(ras.stack)));
+  for (auto return_addr : ras.stack)
+    champsim::checkpoint::write(os, return_addr);
+  champsim::checkpoint::write(os, ras.call_size_trackers);
+}
+
+void basic_btb::btb_restore_checkpoint(std::istream& is)
+{
+  direct.BTB.restore_checkpoint(is);
+
+  uint64_t history{};
+  champsim::checkpoint::read(is, indirect.predictor);
+  champsim::checkpoint::read(is, history);
+  indirect.conditional_history = decltype(indirect.conditional_history){history};
+
+  uint64_t ras_size{};
+  champsim::checkpoint::read(is, ras_size);
+  if (ras_size > return_stack::max_size)
+    throw champsim::checkpoint::format_error{"Checkpoint return stack is larger than the configured return stack"};
+  ras.stack.resize(ras_size);
+  for (auto& return_addr : ras.stack)
+    champsim::checkpoint::read(is, return_addr);
+  champsim::checkpoint::read(is, ras.call_size_trackers);
+}
@@ -21,6 +21,9 @@ struct return_stack {
    */
   std::array<typename champsim::address::difference_type, num_call_size_trackers> call_size_trackers;
 
+  // Each core has its own stack, and cores may run on separate threads, so the warning count is kept per stack
+  int num_times_returned_backwards = 0;
+
   return_stack() { std::fill(std::begin(call_size_trackers), std::end(call_size_trackers), 4); }
 
   std::pair<champsim::address, bool> prediction();
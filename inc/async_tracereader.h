@@ -0,0 +1,239 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ASYNC_TRACEREADER_H
+#define ASYNC_TRACEREADER_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "instruction.h"
+#include "util/detect.h"
+
+namespace champsim
+{
+/**
+ * A reader that decodes the instructions of another reader on a background thread.
+ *
+ * The background thread fills batches of instructions into a single-producer, single-consumer ring, which is lock-free.
+ * The reading thread only takes the instructions from the batches, and waits only if the ring is empty.
+ * The instructions are produced by the wrapped reader, which sets their branch targets, so no batch boundary separates a branch from its target.
+ */
+template <typename R>
+class async_tracereader
+{
+public:
+  constexpr static std::size_t batch_size = 1024;
+  constexpr static std::size_t ring_size = 8;
+
+private:
+  using batch_type = std::vector<ooo_model_instr>;
+
+  template <typename U>
+  using has_skip = decltype(std::declval<U>().skip(uint64_t{}));
+
+  struct shared_state {
+    R reader;
+    std::array<batch_type, ring_size> ring{};
+    std::atomic<std::size_t> head = 0; // Only written by the reading thread
+    std::atomic<std::size_t> tail = 0; // Only written by the background thread
+    std::atomic<bool> finished = false;
+    std::atomic<bool> stopped = false;
+    std::exception_ptr error{};
+
+    explicit shared_state(R&& rdr) : reader(std::move(rdr)) {}
+
+    void produce();
+  };
+
+  std::unique_ptr<shared_state> state;
+  std::thread producer{};
+  batch_type current{};
+  std::size_t offset = 0;
+  std::exception_ptr pending_error{}; // Thrown when the instructions before it have been read
+
+  void take_batch();
+  void start();
+  void stop();
+
+public:
+  explicit async_tracereader(R&& reader) : state(std::make_unique<shared_state>(std::move(reader)))
+  {
+    start();
+    take_batch();
+  }
+
+  async_tracereader(async_tracereader&&) noexcept = default;
+  async_tracereader& operator=(async_tracereader&&) = delete;
+  async_tracereader(const async_tracereader&) = delete;
+  async_tracereader& operator=(const async_tracereader&) = delete;
+
+  ~async_tracereader() { stop(); }
+
+  ooo_model_instr operator()();
+
+  /**
+   * Discard the given number of instructions. The instructions that were already decoded are dropped, and the rest are skipped by the wrapped reader.
+   */
+  void skip(uint64_t count);
+
+  [[nodiscard]] bool eof() const { return offset == std::size(current) && !pending_error; }
+};
+
+template <typename R>
+void async_tracereader<R>::shared_state::produce()
+{
+  std::size_t next_tail = tail.load(std::memory_order_relaxed);
+  bool more = true;
+  while (more) {
+    if (stopped.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    while (next_tail - head.load(std::memory_order_acquire) == ring_size) {
+      if (stopped.load(std::memory_order_relaxed)) {
+        return;
+      }
+      // The reading thread is a whole ring behind, so it will not need this thread soon
+      std::this_thread::sleep_for(std::chrono::microseconds{50});
+    }
+
+    auto& batch = ring[next_tail % ring_size];
+    batch.clear();
+    try {
+      while (std::size(batch) < batch_size && !reader.eof()) {
+        batch.push_back(reader());
+      }
+      more = !reader.eof();
+    } catch (...) {
+      // The instructions before the error are still delivered
+      error = std::current_exception();
+      more = false;
+    }
+
+    if (!std::empty(batch)) {
+      tail.store(++next_tail, std::memory_order_release);
+    }
+  }
+  finished.store(true, std::memory_order_release);
+}
+
+template <typename R>
+void async_tracereader<R>::start()
+{
+  state->stopped.store(false, std::memory_order_relaxed);
+  producer = std::thread{&shared_state::produce, state.get()};
+}
+
+template <typename R>
+void async_tracereader<R>::stop()
+{
+  if (producer.joinable()) {
+    state->stopped.store(true, std::memory_order_relaxed);
+    producer.join();
+  }
+}
+
+template <typename R>
+void async_tracereader<R>::take_batch()
+{
+  const auto next_head = state->head.load(std::memory_order_relaxed);
+  for (;;) {
+    // The ring must be checked again after the background thread finishes, since it may have filled a batch in between
+    const bool finished = state->finished.load(std::memory_order_acquire);
+    if (next_head != state->tail.load(std::memory_order_acquire)) {
+      break;
+    }
+    if (finished) {
+      pending_error = state->error;
+      current.clear();
+      offset = 0;
+      return;
+    }
+    std::this_thread::yield();
+  }
+
+  // Exchange the buffers, so that the background thread reuses the storage of the batch that was just read
+  std::swap(current, state->ring[next_head % ring_size]);
+  offset = 0;
+  state->head.store(next_head + 1, std::memory_order_release);
+}
+
+template <typename R>
+void async_tracereader<R>::skip(uint64_t count)
+{
+  stop();
+
+  // The background thread is stopped, so the decoded batches can be dropped directly
+  auto next_head = state->head.load(std::memory_order_relaxed);
+  const auto tail = state->tail.load(std::memory_order_relaxed);
+  while (count >= std::size(current) - offset && next_head != tail) {
+    count -= std::size(current) - offset;
+    std::swap(current, state->ring[next_head % ring_size]);
+    offset = 0;
+    ++next_head;
+  }
+  state->head.store(next_head, std::memory_order_relaxed);
+
+  auto in_batch = std::min<uint64_t>(count, std::size(current) - offset);
+  offset += in_batch;
+  count -= in_batch;
+
+  if constexpr (champsim::is_detected_v<has_skip, R>) {
+    state->reader.skip(count);
+  } else {
+    for (uint64_t i = 0; i < count && !state->reader.eof(); ++i) {
+      state->reader();
+    }
+  }
+
+  if (!state->finished.load(std::memory_order_relaxed)) {
+    start();
+  }
+
+  if (offset == std::size(current) && !pending_error) {
+    take_batch();
+  }
+}
+
+template <typename R>
+ooo_model_instr async_tracereader<R>::operator()()
+{
+  if (pending_error) {
+    std::rethrow_exception(pending_error);
+  }
+
+  auto retval = current.at(offset++);
+
+  // Read ahead, so that the end of the trace is known as soon as the last instruction is taken
+  if (offset == std::size(current)) {
+    take_batch();
+  }
+
+  return retval;
+}
+} // namespace champsim
+
+#endif
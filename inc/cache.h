@@ -22,16 +22,19 @@
 #undef CHAMPSIM_MODULE
 #endif
 
+#include <algorithm>
 #include <array>
 #include <cstddef> // for size_t
 #include <cstdint> // for uint64_t, uint32_t, uint8_t
-#include <deque>
 #include <iterator> // for size
 #include <limits>   // for numeric_limits
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "address.h"
@@ -42,8 +45,12 @@
 #include "champsim.h"
 #include "channel.h"
 #include "chrono.h"
+#include "compact_block_store.h"
 #include "modules.h"
 #include "operable.h"
+#include "tag_store.h"
+#include "util/bits.h"
+#include "util/packet_pool.h"
 #include "util/to_underlying.h" // for to_underlying
 #include "waitable.h"
 
@@ -77,10 +84,10 @@ class CACHE : public champsim::operable
 
     champsim::chrono::clock::time_point event_cycle = champsim::chrono::clock::time_point::max();
 
-    std::vector<uint64_t> instr_depend_on_me{};
-    std::vector<std::deque<response_type>*> to_return{};
+    champsim::channel::dependency_list_type instr_depend_on_me{};
+    champsim::channel::return_list_type to_return{};
 
-    explicit tag_lookup_type(request_type req) : tag_lookup_type(req, false, false) {}
+    explicit tag_lookup_type(const request_type& req) : tag_lookup_type(req, false, false) {}
     tag_lookup_type(const request_type& req, bool local_pref, bool skip);
   };
 
@@ -105,16 +112,18 @@ public:
 
     champsim::chrono::clock::time_point time_enqueued;
 
-    std::vector<uint64_t> instr_depend_on_me{};
-    std::vector<std::deque<response_type>*> to_return{};
+    champsim::channel::dependency_list_type instr_depend_on_me{};
+    champsim::channel::return_list_type to_return{};
 
     mshr_type(const tag_lookup_type& req, champsim::chrono::clock::time_point _time_enqueued);
-    static mshr_type merge(mshr_type predecessor, mshr_type successor);
+    void merge(const tag_lookup_type& successor, champsim::chrono::clock::time_point successor_enqueued);
   };
 
 private:
   bool try_hit(const tag_lookup_type& handle_pkt);
   bool handle_fill(const mshr_type& fill_mshr);
+  template <typename F>
+  bool do_fill(const mshr_type& fill_mshr, F&& issue_writeback);
   bool handle_miss(const tag_lookup_type& handle_pkt);
   bool handle_write(const tag_lookup_type& handle_pkt);
   void finish_packet(const response_type& packet);
@@ -126,28 +135,50 @@ public:
   using BLOCK = champsim::cache_block;
 
 private:
-  static BLOCK fill_block(mshr_type mshr, uint32_t metadata);
+  static BLOCK fill_block(const mshr_type& mshr, uint32_t metadata);
   using set_type = std::vector<BLOCK>;
 
   std::pair<set_type::iterator, set_type::iterator> get_set_span(champsim::address address);
-  [[nodiscard]] std::pair<set_type::const_iterator, set_type::const_iterator> get_set_span(champsim::address address) const;
   [[nodiscard]] long get_set_index(champsim::address address) const;
 
   template <typename T>
   bool should_activate_prefetcher(const T& pkt) const;
 
-  template <bool>
-  auto initiate_tag_check(champsim::channel* ul = nullptr);
+  using lookup_queue_type = champsim::pooled_queue<tag_lookup_type>;
+
+  auto initiate_tag_check();
+  template <typename F>
+  long initiate_tag_checks(lookup_queue_type& queue, champsim::bandwidth sz, F&& test_func);
+  template <typename F>
+  long initiate_tag_checks(channel_type* ul, channel_type::request_queue_type& queue, champsim::bandwidth sz, F&& test_func);
 
   template <typename T>
   champsim::address module_address(const T& element) const;
 
   auto matches_address(champsim::address address) const;
-  std::pair<mshr_type, request_type> mshr_and_forward_packet(const tag_lookup_type& handle_pkt);
-
-  std::deque<tag_lookup_type> internal_PQ{};
-  std::deque<tag_lookup_type> inflight_tag_check{};
-  std::deque<tag_lookup_type> translation_stash{};
+  static request_type forward_packet(const tag_lookup_type& handle_pkt);
+
+  // Like the channel queues, these hold their entries in a pool that is reused as entries come and go.
+  // The queues share the pool, so that a tag lookup moves from one to the next by handle.
+  std::shared_ptr<champsim::packet_pool<tag_lookup_type>> lookup_pool = std::make_shared<champsim::packet_pool<tag_lookup_type>>();
+  lookup_queue_type internal_PQ{lookup_pool};
+  lookup_queue_type inflight_tag_check{lookup_pool};
+  lookup_queue_type translation_stash{lookup_pool};
+
+  // Functional lookups return their hits here
+  channel_type::response_queue_type functional_returned{};
+
+  // The MSHR held for each block, by its handle in the MSHR pool, so that a miss finds the MSHR to merge into without searching them
+  std::unordered_map<uint64_t, champsim::packet_pool<mshr_type>::handle_type> mshr_blocks{};
+  [[nodiscard]] uint64_t mshr_block_key(champsim::address addr) const;
+  void release_mshr_block(champsim::address addr);
+
+  // Compact blocks are seen through a copy of the last set returned by get_set_span(), which write_block() keeps in step
+  set_type set_view{};
+  long view_set = -1;
+  [[nodiscard]] BLOCK read_block(long set, long way) const;
+  void write_block(long set, long way, const BLOCK& blk);
+  void write_block_state(long set, long way, const BLOCK& blk);
 
 public:
   std::vector<channel_type*> upper_levels;
@@ -162,23 +193,45 @@ public:
   champsim::chrono::clock::duration FILL_LATENCY;
   champsim::data::bits OFFSET_BITS;
   set_type block{static_cast<typename set_type::size_type>(NUM_SET * NUM_WAY)};
+  champsim::tag_store block_tags{NUM_SET, NUM_WAY, OFFSET_BITS}; // kept in step with block by every change to a block
+
+private:
+  // The set index is extracted with a shift and mask that are fixed when the cache is built
+  uint64_t set_index_shift = champsim::to_underlying(OFFSET_BITS);
+  uint64_t set_index_mask = (uint64_t{1} << champsim::lg2(NUM_SET)) - 1;
+
+public:
   champsim::bandwidth::maximum_type MAX_TAG, MAX_FILL;
   bool prefetch_as_load;
   bool match_offset_bits;
   bool virtual_prefetch;
+  std::optional<champsim::compact_block_store> compact_blocks; // if engaged, block is empty
   std::vector<access_type> pref_activate_mask;
 
   using stats_type = cache_stats;
 
   stats_type sim_stats, roi_stats;
 
-  std::deque<mshr_type> MSHR;
-  std::deque<mshr_type> inflight_writes;
+  // The MSHRs are allocated when the cache is built, up to a bound past which a very large MSHR file grows as it fills.
+  // The inflight writes share their pool.
+  static constexpr std::size_t MAX_PREALLOCATED_MSHRS = 1024;
+
+private:
+  std::shared_ptr<champsim::packet_pool<mshr_type>> mshr_pool =
+      std::make_shared<champsim::packet_pool<mshr_type>>(std::min<std::size_t>(MSHR_SIZE, MAX_PREALLOCATED_MSHRS));
+
+public:
+  champsim::pooled_queue<mshr_type> MSHR{mshr_pool, std::min<std::size_t>(MSHR_SIZE, MAX_PREALLOCATED_MSHRS)};
+  champsim::pooled_queue<mshr_type> inflight_writes{mshr_pool};
 
   long operate() final;
   void initialize() final;
   void begin_phase() final;
   void end_phase(unsigned cpu) final;
+  [[nodiscard]] champsim::chrono::clock::time_point next_event_time() const final;
+  void skip(long cycles) final;
+  void save_checkpoint(std::ostream& os) const final;
+  void restore_checkpoint(std::istream& is) final;
 
   [[deprecated]] std::size_t get_occupancy(uint8_t queue_type, champsim::address address) const;
   [[deprecated]] std::size_t get_size(uint8_t queue_type, champsim::address address) const;
@@ -219,6 +272,11 @@ public:
 
   void print_deadlock() final;
 
+  // Untimed accesses for functional warming, which bypass the queues, MSHRs, and bandwidth limits
+  [[nodiscard]] std::optional<response_type> functional_lookup(const request_type& packet, bool local_prefetch);
+  [[nodiscard]] std::optional<request_type> functional_fill(const request_type& packet, const response_type& response, bool local_prefetch);
+  [[nodiscard]] std::vector<std::pair<request_type, bool>> take_functional_prefetches();
+
 #include "module_decl.inc"
 
   struct prefetcher_module_concept {
@@ -232,8 +290,11 @@ public:
     virtual uint32_t impl_prefetcher_cache_fill(champsim::address addr, long set, long way, bool prefetch, champsim::address evicted_addr,
                                                 uint32_t metadata_in) = 0;
     virtual void impl_prefetcher_cycle_operate() = 0;
+    [[nodiscard]] virtual bool impl_prefetcher_has_cycle_operate() const = 0;
     virtual void impl_prefetcher_final_stats() = 0;
     virtual void impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target) = 0;
+    virtual void impl_prefetcher_save_checkpoint(std::ostream& os) = 0;
+    virtual void impl_prefetcher_restore_checkpoint(std::istream& is) = 0;
   };
 
   struct replacement_module_concept {
@@ -249,6 +310,8 @@ public:
     virtual void impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
                                              champsim::address victim_addr, access_type type) = 0;
     virtual void impl_replacement_final_stats() = 0;
+    virtual void impl_replacement_save_checkpoint(std::ostream& os) = 0;
+    virtual void impl_replacement_restore_checkpoint(std::istream& is) = 0;
   };
 
   template <typename... Ps>
@@ -266,8 +329,11 @@ public:
     [[nodiscard]] uint32_t impl_prefetcher_cache_fill(champsim::address addr, long set, long way, bool prefetch, champsim::address evicted_addr,
                                                       uint32_t metadata_in) final;
     void impl_prefetcher_cycle_operate() final;
+    [[nodiscard]] bool impl_prefetcher_has_cycle_operate() const final;
     void impl_prefetcher_final_stats() final;
     void impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target) final;
+    void impl_prefetcher_save_checkpoint(std::ostream& os) final;
+    void impl_prefetcher_restore_checkpoint(std::istream& is) final;
   };
 
   template <typename... Rs>
@@ -290,6 +356,8 @@ public:
     void impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
                                      champsim::address victim_addr, access_type type) final;
     void impl_replacement_final_stats() final;
+    void impl_replacement_save_checkpoint(std::ostream& os) final;
+    void impl_replacement_restore_checkpoint(std::istream& is) final;
   };
 
   std::unique_ptr<prefetcher_module_concept> pref_module_pimpl;
@@ -304,6 +372,8 @@ public:
   void impl_prefetcher_cycle_operate() const;
   void impl_prefetcher_final_stats() const;
   void impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target) const;
+  void impl_prefetcher_save_checkpoint(std::ostream& os) const;
+  void impl_prefetcher_restore_checkpoint(std::istream& is) const;
 
   void impl_initialize_replacement() const;
   [[nodiscard]] long impl_find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const BLOCK* current_set, champsim::address ip,
@@ -313,14 +383,21 @@ public:
   void impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
                                    champsim::address victim_addr, access_type type) const;
   void impl_replacement_final_stats() const;
+  void impl_replacement_save_checkpoint(std::ostream& os) const;
+  void impl_replacement_restore_checkpoint(std::istream& is) const;
   // NOLINTEND(readability-make-member-function-const)
 
   template <typename... Ps, typename... Rs>
   explicit CACHE(champsim::cache_builder<champsim::cache_builder_module_type_holder<Ps...>, champsim::cache_builder_module_type_holder<Rs...>> b)
       : champsim::operable(b.m_clock_period), upper_levels(b.m_uls), lower_level(b.m_ll), lower_translate(b.m_lt), NAME(b.m_name), NUM_SET(b.get_num_sets()),
         NUM_WAY(b.get_num_ways()), MSHR_SIZE(b.get_num_mshrs()), PQ_SIZE(b.m_pq_size), HIT_LATENCY(b.get_hit_latency() * b.m_clock_period),
-        FILL_LATENCY(b.get_fill_latency() * b.m_clock_period), OFFSET_BITS(b.m_offset_bits), MAX_TAG(b.get_tag_bandwidth()), MAX_FILL(b.get_fill_bandwidth()),
-        prefetch_as_load(b.m_pref_load), match_offset_bits(b.m_wq_full_addr), virtual_prefetch(b.m_va_pref), pref_activate_mask(b.m_pref_act_mask),
+        FILL_LATENCY(b.get_fill_latency() * b.m_clock_period), OFFSET_BITS(b.m_offset_bits),
+        block(static_cast<set_type::size_type>(b.m_compact_blocks ? 0 : NUM_SET * NUM_WAY)), MAX_TAG(b.get_tag_bandwidth()), MAX_FILL(b.get_fill_bandwidth()),
+        prefetch_as_load(b.m_pref_load), match_offset_bits(b.m_wq_full_addr), virtual_prefetch(b.m_va_pref),
+        compact_blocks(b.m_compact_blocks
+                           ? std::make_optional<champsim::compact_block_store>(std::size_t{NUM_SET} * NUM_WAY, b.m_va_pref, b.m_compact_keep_data)
+                           : std::nullopt),
+        pref_activate_mask(b.m_pref_act_mask),
         pref_module_pimpl(std::make_unique<prefetcher_module_model<Ps...>>(this)), repl_module_pimpl(std::make_unique<replacement_module_model<Rs...>>(this))
   {
   }
@@ -397,6 +474,13 @@ void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_cycle_operate()
   std::apply([&](auto&... p) { (..., process_one(p)); }, intern_);
 }
 
+template <typename... Ps>
+bool CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_has_cycle_operate() const
+{
+  using namespace champsim::modules;
+  return (false || ... || prefetcher::has_cycle_operate<Ps>);
+}
+
 template <typename... Ps>
 void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_final_stats()
 {
@@ -423,6 +507,30 @@ void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_branch_operate(champ
   std::apply([&](auto&... p) { (..., process_one(p)); }, intern_);
 }
 
+template <typename... Ps>
+void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_save_checkpoint(std::ostream& os)
+{
+  [[maybe_unused]] auto process_one = [&](auto& p) {
+    using namespace champsim::modules;
+    if constexpr (prefetcher::has_save_checkpoint<decltype(p), std::ostream&>)
+      p.prefetcher_save_checkpoint(os);
+  };
+
+  std::apply([&](auto&... p) { (..., process_one(p)); }, intern_);
+}
+
+template <typename... Ps>
+void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_restore_checkpoint(std::istream& is)
+{
+  [[maybe_unused]] auto process_one = [&](auto& p) {
+    using namespace champsim::modules;
+    if constexpr (prefetcher::has_restore_checkpoint<decltype(p), std::istream&>)
+      p.prefetcher_restore_checkpoint(is);
+  };
+
+  std::apply([&](auto&... p) { (..., process_one(p)); }, intern_);
+}
+
 template <typename... Rs>
 void CACHE::replacement_module_model<Rs...>::impl_initialize_replacement()
 {
@@ -530,6 +638,30 @@ void CACHE::replacement_module_model<Rs...>::impl_replacement_final_stats()
   std::apply([&](auto&... r) { (..., process_one(r)); }, intern_);
 }
 
+template <typename... Rs>
+void CACHE::replacement_module_model<Rs...>::impl_replacement_save_checkpoint(std::ostream& os)
+{
+  [[maybe_unused]] auto process_one = [&](auto& r) {
+    using namespace champsim::modules;
+    if constexpr (replacement::has_save_checkpoint<decltype(r), std::ostream&>)
+      r.replacement_save_checkpoint(os);
+  };
+
+  std::apply([&](auto&... r) { (..., process_one(r)); }, intern_);
+}
+
+template <typename... Rs>
+void CACHE::replacement_module_model<Rs...>::impl_replacement_restore_checkpoint(std::istream& is)
+{
+  [[maybe_unused]] auto process_one = [&](auto& r) {
+    using namespace champsim::modules;
+    if constexpr (replacement::has_restore_checkpoint<decltype(r), std::istream&>)
+      r.replacement_restore_checkpoint(is);
+  };
+
+  std::apply([&](auto&... r) { (..., process_one(r)); }, intern_);
+}
+
 #ifdef SET_ASIDE_CHAMPSIM_MODULE
 #undef SET_ASIDE_CHAMPSIM_MODULE
 #define CHAMPSIM_MODULE
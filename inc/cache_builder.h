@@ -57,6 +57,8 @@ struct cache_builder_base {
   bool m_pref_load{};
   bool m_wq_full_addr{};
   bool m_va_pref{};
+  bool m_compact_blocks{};
+  bool m_compact_keep_data{};
 
   std::vector<access_type> m_pref_act_mask{access_type::LOAD, access_type::PREFETCH};
   std::vector<champsim::channel*> m_uls{};
@@ -212,6 +214,23 @@ public:
    */
   self_type& reset_virtual_prefetch();
 
+  /**
+   * Specify that the cache should hold only the tag, flags, and prefetch metadata of each block, to save host memory for very large caches.
+   * The virtual address of each block is also held if prefetchers operate in the virtual address space.
+   * Blocks are written back with the address of their first byte.
+   */
+  self_type& set_compact_blocks();
+
+  /**
+   * Specify that the cache should hold compact blocks as with set_compact_blocks(), but also hold the data of each block, as a TLB must.
+   */
+  self_type& set_compact_translation_blocks();
+
+  /**
+   * Specify that the cache should hold every field of each block.
+   */
+  self_type& reset_compact_blocks();
+
   /**
    * Specify the ``access_type`` values that should activate the prefetcher.
    */
@@ -485,6 +504,30 @@ auto champsim::cache_builder<P, R>::reset_virtual_prefetch() -> self_type&
   return *this;
 }
 
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::set_compact_blocks() -> self_type&
+{
+  m_compact_blocks = true;
+  m_compact_keep_data = false;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::set_compact_translation_blocks() -> self_type&
+{
+  m_compact_blocks = true;
+  m_compact_keep_data = true;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::reset_compact_blocks() -> self_type&
+{
+  m_compact_blocks = false;
+  m_compact_keep_data = false;
+  return *this;
+}
+
 template <typename P, typename R>
 template <typename... Elems>
 auto champsim::cache_builder<P, R>::prefetch_activate(Elems... pref_act_elems) -> self_type&
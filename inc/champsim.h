@@ -21,6 +21,7 @@
 #include <cstdlib>
 #include <exception>
 #include <limits>
+#include <string>
 
 #include "extent.h"
 #include "util/bit_enum.h"
@@ -74,6 +75,12 @@ using block_offset = address_slice<block_offset_extent>;
 using page_number = address_slice<page_number_extent>;
 using page_offset = address_slice<page_offset_extent>;
 
+/**
+ * The text that begins each line of progress that the calling thread prints.
+ * It is empty unless several environments are simulated at once, in which case each of their threads names its environment.
+ */
+std::string& output_prefix();
+
 /**
  * Get the lowest possible address for which the space between it and zero is the given size.
  */
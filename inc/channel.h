@@ -19,14 +19,16 @@
 
 #include <array>
 #include <cstdint>
-#include <deque>
 #include <limits>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "access_type.h"
 #include "address.h"
 #include "champsim.h"
+#include "util/packet_pool.h"
+#include "util/small_vector.h"
 
 namespace champsim
 {
@@ -49,6 +51,12 @@ struct cache_queue_stats {
 
 class channel
 {
+public:
+  // Most requests are depended on by few instructions and return to few queues, so these lists are held inline in the packets.
+  // Copying a packet from one queue to the next then does not allocate.
+  using dependency_list_type = champsim::small_vector<uint64_t, 4>;
+
+private:
   struct request {
     bool forward_checked = false;
     bool is_translated = true;
@@ -66,7 +74,7 @@ class channel
     uint64_t instr_id = 0;
     champsim::address ip{};
 
-    std::vector<uint64_t> instr_depend_on_me{};
+    dependency_list_type instr_depend_on_me{};
   };
 
   struct response {
@@ -74,17 +82,21 @@ class channel
     champsim::address v_address{};
     champsim::address data{};
     uint32_t pf_metadata = 0;
-    std::vector<uint64_t> instr_depend_on_me{};
+    dependency_list_type instr_depend_on_me{};
 
-    response(champsim::address addr, champsim::address v_addr, champsim::address data_, uint32_t pf_meta, std::vector<uint64_t> deps)
+    response(champsim::address addr, champsim::address v_addr, champsim::address data_, uint32_t pf_meta, dependency_list_type deps)
         : address(addr), v_address(v_addr), data(data_), pf_metadata(pf_meta), instr_depend_on_me(deps)
     {
     }
-    explicit response(request req) : response(req.address, req.v_address, req.data, req.pf_metadata, req.instr_depend_on_me) {}
+    explicit response(const request& req) : response(req.address, req.v_address, req.data, req.pf_metadata, req.instr_depend_on_me) {}
   };
 
-  template <typename R>
-  bool do_add_queue(R& queue, std::size_t queue_size, const typename R::value_type& packet);
+  template <typename R, typename P>
+  bool do_add_queue(R& queue, std::size_t queue_size, P&& packet);
+
+  // The position of the oldest entry to each block, rebuilt by check_collision() because the queues are drained by their consumers
+  using block_index_type = std::unordered_map<uint64_t, std::size_t>;
+  block_index_type forward_index{}, merge_index{};
 
   std::size_t RQ_SIZE = std::numeric_limits<std::size_t>::max();
   std::size_t PQ_SIZE = std::numeric_limits<std::size_t>::max();
@@ -95,10 +107,16 @@ class channel
 public:
   using response_type = response;
   using request_type = request;
+
+  // Each queue holds its packets in a pool, which is allocated to the queue size when the channel is built, and orders them by handle.
+  // Packets are built in the pool as they are added, so a packet that passes through the hierarchy makes no allocation.
+  using request_queue_type = champsim::pooled_queue<request_type>;
+  using response_queue_type = champsim::pooled_queue<response_type>;
+  using return_list_type = champsim::small_vector<response_queue_type*, 2>;
   using stats_type = cache_queue_stats;
 
-  std::deque<request_type> RQ{}, PQ{}, WQ{};
-  std::deque<response_type> returned{};
+  request_queue_type RQ{}, PQ{}, WQ{};
+  response_queue_type returned{};
 
   stats_type sim_stats{}, roi_stats{};
 
@@ -108,6 +126,9 @@ public:
   bool add_rq(const request_type& packet);
   bool add_wq(const request_type& packet);
   bool add_pq(const request_type& packet);
+  bool add_rq(request_type&& packet);
+  bool add_wq(request_type&& packet);
+  bool add_pq(request_type&& packet);
 
   [[nodiscard]] std::size_t rq_occupancy() const;
   [[nodiscard]] std::size_t wq_occupancy() const;
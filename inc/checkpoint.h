@@ -0,0 +1,110 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace champsim
+{
+struct environment;
+
+namespace checkpoint
+{
+/**
+ * Thrown when a checkpoint cannot be read, or when it was written by a simulator with a different configuration.
+ */
+struct format_error : std::runtime_error {
+  using std::runtime_error::runtime_error;
+};
+
+/**
+ * Write the object representation of a trivially copyable value.
+ * Checkpoints are only meant to be restored by the same binary, so no attempt is made at portability.
+ */
+template <typename T>
+void write(std::ostream& os, const T& value)
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  os.write(reinterpret_cast<const char*>(&value), sizeof(T)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+/**
+ * Read a value written by write().
+ *
+ * \throws format_error If the checkpoint ends before the value.
+ */
+template <typename T>
+void read(std::istream& is, T& value)
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  if (!is.read(reinterpret_cast<char*>(&value), sizeof(T))) // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    throw format_error{"Checkpoint ended unexpectedly"};
+}
+
+/**
+ * Write a table of trivially copyable values, preceded by its length.
+ */
+template <typename T, typename A>
+void write(std::ostream& os, const std::vector<T, A>& values)
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  write(os, static_cast<uint64_t>(std::size(values)));
+  os.write(reinterpret_cast<const char*>(std::data(values)), static_cast<std::streamsize>(std::size(values) * sizeof(T))); // NOLINT
+}
+
+/**
+ * Read a table written by write().
+ * Tables are sized by the configuration, so the vector must already have the length that was written.
+ *
+ * \throws format_error If the lengths differ, or if the checkpoint ends before the table.
+ */
+template <typename T, typename A>
+void read(std::istream& is, std::vector<T, A>& values)
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  uint64_t size{};
+  read(is, size);
+  if (size != std::size(values))
+    throw format_error{"Checkpoint has a table of " + std::to_string(size) + " entries where the configuration has " + std::to_string(std::size(values))};
+  if (!is.read(reinterpret_cast<char*>(std::data(values)), static_cast<std::streamsize>(std::size(values) * sizeof(T)))) // NOLINT
+    throw format_error{"Checkpoint ended unexpectedly"};
+}
+
+/**
+ * Write the warmed state of every operable and of the virtual memory, and the number of instructions that each core has consumed from its trace.
+ * Instructions in flight are not saved, so a restored core begins with an empty pipeline at the first instruction it had not retired.
+ */
+void save(std::ostream& os, environment& env);
+
+/**
+ * Restore the state written by save() into an environment of the same configuration, which has already been initialized.
+ *
+ * \returns The number of instructions that each core had consumed from its trace.
+ * \throws format_error If the checkpoint was not written by the same configuration.
+ */
+std::vector<uint64_t> restore(std::istream& is, environment& env);
+} // namespace checkpoint
+} // namespace champsim
+
+#endif
@@ -0,0 +1,59 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMPACT_BLOCK_STORE_H
+#define COMPACT_BLOCK_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include "address.h"
+#include "block.h"
+#include "tag_store.h"
+
+namespace champsim
+{
+/**
+ * The blocks of a cache, held as only the fields that cannot be found in its tag store.
+ * The address of a block is rebuilt from its tag, so it does not keep the offset within the block.
+ * The virtual address and data of a block are kept only if asked for, and are otherwise read as zero.
+ */
+class compact_block_store
+{
+  std::vector<uint8_t> flags;
+  std::vector<uint32_t> pf_metadata;
+  std::vector<champsim::address> v_address;
+  std::vector<champsim::address> data;
+
+public:
+  compact_block_store(std::size_t num_blocks, bool keep_v_address, bool keep_data);
+
+  [[nodiscard]] champsim::cache_block get(std::size_t index, const champsim::tag_store& tags) const;
+  void assign(std::size_t index, const champsim::cache_block& blk);
+
+  /**
+   * Record only the dirty and prefetch flags of the block at the given index.
+   */
+  void assign_state(std::size_t index, bool dirty, bool prefetch);
+
+  void save_checkpoint(std::ostream& os) const;
+  void restore_checkpoint(std::istream& is);
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,123 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMPACT_TRACE_H
+#define COMPACT_TRACE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "trace_instruction.h"
+
+/**
+ * The compact trace format stores the same instructions as the input_instr format in a variable-length encoding.
+ *
+ * A file begins with the 8-byte magic number, followed by one record for each instruction:
+ *  - A 16-bit little-endian mask of the fields that are present. Bits 0 and 1 hold is_branch and branch_taken, bits 2 through 7 mark the
+ *    nonzero destination and source registers, and bits 8 through 13 mark the nonzero destination and source memory addresses.
+ *    If bit 14 is set, is_branch and branch_taken follow as two raw bytes, since they are not both 0 or 1.
+ *  - The IP, as a zigzag varint difference from the IP that is predicted to follow the previous instruction.
+ *  - Each register that is present, as one byte.
+ *  - Each memory address that is present, as a zigzag varint difference from the last address in the same slot of the same IP,
+ *    or from the last address in the trace if the IP has not been seen recently.
+ *
+ * Both the predicted IP and the previous addresses come from a table of recently seen IPs that the encoder and decoder keep identically.
+ */
+namespace champsim::compact
+{
+constexpr std::array<unsigned char, 8> magic{'C', 'S', 'T', 'R', 'A', 'C', 'E', '2'};
+
+/**
+ * The state shared by the encoder and the decoder, which predicts each field from the ones before it.
+ */
+class codec_state
+{
+public:
+  constexpr static std::size_t num_slots = NUM_INSTR_DESTINATIONS + NUM_INSTR_SOURCES;
+  constexpr static std::size_t table_size = 1 << 14;
+
+  struct entry {
+    uint64_t ip = 0;
+    uint64_t fall_through = 0; // The IP that last followed this one when it did not branch
+    uint64_t target = 0;       // The IP that last followed this one when it branched
+    std::array<uint64_t, num_slots> addresses{};
+  };
+
+private:
+  std::vector<entry> table = std::vector<entry>(table_size);
+  uint64_t last_ip = 0;
+  bool last_taken = false;
+  uint64_t last_address = 0;
+
+  [[nodiscard]] static std::size_t index(uint64_t ip) { return (ip ^ (ip >> 14) ^ (ip >> 28)) % table_size; }
+
+public:
+  /**
+   * \returns The IP that is expected to follow the previous instruction.
+   */
+  [[nodiscard]] uint64_t predict_ip() const;
+
+  /**
+   * \returns The address that the given slot of the given IP is coded against.
+   */
+  [[nodiscard]] uint64_t address_base(uint64_t ip, std::size_t slot) const;
+
+  /**
+   * Learn from an instruction after it has been coded.
+   */
+  void update(const input_instr& instr);
+};
+
+/**
+ * Encodes input_instr records into the compact format.
+ * The magic number is not written, so that the caller may place it.
+ */
+class encoder
+{
+  codec_state state{};
+
+public:
+  constexpr static std::size_t max_record_size = 2 + 2 + 10 + codec_state::num_slots * 11;
+
+  /**
+   * Append the record for the given instruction to the given bytes.
+   */
+  void encode(const input_instr& instr, std::vector<unsigned char>& out);
+};
+
+/**
+ * Decodes compact records into input_instr records. Each record must be decoded exactly once, in order.
+ */
+class decoder
+{
+  codec_state state{};
+
+public:
+  /**
+   * Decode one record from the front of the given bytes, which follow the magic number or the previous record.
+   *
+   * \returns The decoded instruction and the number of bytes that its record occupied, or std::nullopt if the bytes do not hold a complete record.
+   * \throws std::runtime_error if the record is malformed.
+   */
+  std::optional<std::pair<input_instr, std::size_t>> decode(const unsigned char* begin, const unsigned char* end);
+};
+} // namespace champsim::compact
+
+#endif
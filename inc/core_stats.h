@@ -15,6 +15,13 @@ struct cpu_stats {
   long long end_cycles = 0;
   uint64_t total_rob_occupancy_at_branch_mispredict = 0;
 
+  value_recovery_type value_recovery = value_recovery_type::SQUASH;
+  uint64_t value_predictions = 0;           // instructions for which the value predictor was consulted
+  uint64_t value_confident_predictions = 0; // predictions that were used to wake up consumers
+  uint64_t value_mispredictions = 0;        // confident predictions that were wrong
+  uint64_t value_recovery_cycles = 0;       // cycles charged for recovering from value mispredictions
+  uint64_t value_reissued_instrs = 0;       // instructions squashed or reissued by recovery
+
   champsim::stats::event_counter<branch_type> total_branch_types = {};
   champsim::stats::event_counter<branch_type> branch_type_misses = {};
 
@@ -0,0 +1,112 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CVP_TRACEREADER_H
+#define CVP_TRACEREADER_H
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "instruction.h"
+
+namespace champsim
+{
+namespace cvp
+{
+/**
+ * Decode one CVP-1 record from the front of the given bytes.
+ * The record is translated in the same way as the cvp2champsim converter translates it, keeping its values and its instruction class.
+ *
+ * \return The decoded instruction and the number of bytes that its record occupied, or std::nullopt if the bytes do not hold a complete record.
+ * \throws std::runtime_error if the record is malformed.
+ */
+std::optional<std::pair<ooo_model_instr, std::size_t>> decode(uint8_t cpu, const unsigned char* begin, const unsigned char* end);
+} // namespace cvp
+
+/**
+ * A reader for traces in the CVP-1 format, as used by the Championship Value Prediction.
+ * The variable-length records are decoded directly, without conversion to a ChampSim trace format.
+ *
+ * Unlike the converter, this reader does not move data pages that share an address with code pages, since that needs a second pass over the trace.
+ */
+template <typename F>
+class cvp_tracereader
+{
+  uint8_t cpu;
+  F trace_file;
+
+  constexpr static std::size_t read_size = 1 << 16;
+  std::vector<unsigned char> raw_buffer{}; // bytes that have been read but not yet decoded
+  std::deque<ooo_model_instr> instr_buffer{};
+
+  void refill();
+
+public:
+  ooo_model_instr operator()();
+
+  cvp_tracereader(uint8_t cpu_idx, std::string tf) : cpu(cpu_idx), trace_file(tf) { refill(); }
+  cvp_tracereader(uint8_t cpu_idx, F&& file) : cpu(cpu_idx), trace_file(std::move(file)) { refill(); }
+
+  // The instruction buffer is only allowed to empty when the file has run out
+  [[nodiscard]] bool eof() const { return std::empty(instr_buffer); }
+};
+
+template <typename F>
+void cvp_tracereader<F>::refill()
+{
+  std::size_t decoded_bytes = 0;
+  bool exhausted = false;
+  while (std::empty(instr_buffer) && !exhausted) {
+    // Read more of the file behind the bytes that are left over
+    raw_buffer.erase(std::begin(raw_buffer), std::next(std::begin(raw_buffer), static_cast<std::ptrdiff_t>(decoded_bytes)));
+    decoded_bytes = 0;
+    auto old_size = std::size(raw_buffer);
+    raw_buffer.resize(old_size + read_size);
+    trace_file.read(reinterpret_cast<char*>(std::data(raw_buffer) + old_size), static_cast<std::streamsize>(read_size));
+    raw_buffer.resize(old_size + static_cast<std::size_t>(trace_file.gcount()));
+    exhausted = trace_file.eof() || trace_file.gcount() == 0;
+
+    // Decode every complete record
+    const auto* raw_end = std::data(raw_buffer) + std::size(raw_buffer);
+    for (auto decoded = cvp::decode(cpu, std::data(raw_buffer), raw_end); decoded.has_value();
+         decoded = cvp::decode(cpu, std::data(raw_buffer) + decoded_bytes, raw_end)) {
+      instr_buffer.push_back(std::move(decoded->first));
+      decoded_bytes += decoded->second;
+    }
+  }
+
+  raw_buffer.erase(std::begin(raw_buffer), std::next(std::begin(raw_buffer), static_cast<std::ptrdiff_t>(decoded_bytes)));
+}
+
+template <typename F>
+ooo_model_instr cvp_tracereader<F>::operator()()
+{
+  auto retval = instr_buffer.front();
+  instr_buffer.pop_front();
+
+  if (std::empty(instr_buffer)) {
+    refill();
+  }
+
+  return retval;
+}
+} // namespace champsim
+
+#endif
@@ -23,6 +23,7 @@
 #include <fmt/core.h>
 #include <fmt/ranges.h>
 
+#include "util/packet_pool.h"
 #include "util/type_traits.h"
 
 namespace champsim
@@ -56,7 +57,8 @@ void range_print_deadlock(const R& range, std::string kind_name, detail::fmtstr_
   };
 
   auto formatter = [unpacker, &packing_func](auto entry) -> std::string {
-    if constexpr (champsim::is_specialization_v<std::decay_t<decltype(entry)>, std::optional>) {
+    if constexpr (champsim::is_specialization_v<std::decay_t<decltype(entry)>, std::optional>
+                  || champsim::is_specialization_v<std::decay_t<decltype(entry)>, champsim::pooled_slot>) {
       if (!entry.has_value()) {
         return std::string{"empty"};
       }
@@ -24,6 +24,7 @@
 #include <deque>    // for deque
 #include <iterator> // for end
 #include <limits>
+#include <memory>
 #include <optional>
 #include <string>
 
@@ -33,6 +34,7 @@
 #include "dram_stats.h"
 #include "extent_set.h"
 #include "operable.h"
+#include "util/packet_pool.h"
 
 struct DRAM_ADDRESS_MAPPING {
   constexpr static std::size_t SLICER_OFFSET_IDX = 0;
@@ -108,13 +110,16 @@ struct DRAM_CHANNEL final : public champsim::operable {
     champsim::address data{};
     champsim::chrono::clock::time_point ready_time = champsim::chrono::clock::time_point::max();
 
-    std::vector<uint64_t> instr_depend_on_me{};
-    std::vector<std::deque<response_type>*> to_return{};
+    champsim::channel::dependency_list_type instr_depend_on_me{};
+    champsim::channel::return_list_type to_return{};
 
     explicit request_type(const typename champsim::channel::request_type& req);
   };
   using value_type = request_type;
-  using queue_type = std::vector<std::optional<value_type>>;
+
+  // The queue slots hold handles to requests in a pool that the queues share, so that searching the slots does not pass over the requests
+  std::shared_ptr<champsim::packet_pool<value_type>> request_pool;
+  using queue_type = std::vector<champsim::pooled_slot<value_type>>;
   queue_type WQ;
   queue_type RQ;
 
@@ -180,6 +185,7 @@ struct DRAM_CHANNEL final : public champsim::operable {
   void begin_phase() final;
   void end_phase(unsigned cpu) final;
   void print_deadlock() final;
+  [[nodiscard]] champsim::chrono::clock::time_point next_event_time() const final;
 
   std::size_t bank_request_capacity() const;
   std::size_t bankgroup_request_capacity() const;
@@ -216,6 +222,8 @@ public:
   void begin_phase() final;
   void end_phase(unsigned cpu) final;
   void print_deadlock() final;
+  [[nodiscard]] champsim::chrono::clock::time_point next_event_time() const final;
+  void skip(long cycles) final;
 
   [[nodiscard]] champsim::data::bytes size() const;
 };
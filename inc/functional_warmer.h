@@ -0,0 +1,71 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FUNCTIONAL_WARMER_H
+#define FUNCTIONAL_WARMER_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include "address.h"
+#include "cache.h"
+#include "channel.h"
+#include "environment.h"
+#include "instruction.h"
+#include "ooo_cpu.h"
+#include "ptw.h"
+
+namespace champsim
+{
+/**
+ * Warms the predictors, caches, and TLBs by walking the trace in program order, without timing.
+ *
+ * Each access probes the hierarchy directly and fills each level on the way back, with no queues, bandwidth limits, or latencies.
+ * A channel that is not read by a cache or a page table walker, such as the one to the memory controller, responds immediately with its address as the data,
+ * so that a translation that is not modeled maps each page to itself.
+ */
+class functional_warmer
+{
+  using request_type = champsim::channel::request_type;
+  using response_type = champsim::channel::response_type;
+
+  std::map<const champsim::channel*, CACHE*> cache_below{};
+  std::map<const champsim::channel*, PageTableWalker*> walker_below{};
+  std::map<uint32_t, champsim::block_number> last_fetched_block{};
+
+  response_type access(CACHE& cache, request_type packet, bool local_prefetch, bool fill_this_level);
+  champsim::address translate(CACHE& cache, const request_type& packet);
+
+public:
+  functional_warmer(std::vector<std::reference_wrapper<CACHE>> caches, std::vector<std::reference_wrapper<PageTableWalker>> walkers);
+  explicit functional_warmer(environment& env);
+
+  /**
+   * Train the core's predictors with the instruction, fetch it, and perform its memory accesses, as if it had retired.
+   * The core must be in a warmup phase.
+   */
+  void operate(O3_CPU& cpu, ooo_model_instr instr);
+
+  /**
+   * Perform an access through the channel and return the response that the requester would receive.
+   */
+  response_type access(const champsim::channel* channel, const request_type& packet);
+};
+} // namespace champsim
+
+#endif
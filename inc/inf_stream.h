@@ -17,12 +17,16 @@
 #ifndef INF_STREAM_H
 #define INF_STREAM_H
 
+#include <array>
 #include <bzlib.h>
 #include <cassert>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <lzma.h>
 #include <memory>
 #include <zlib.h>
+#include <zstd.h>
 
 namespace champsim
 {
@@ -40,6 +44,37 @@ struct end_deleter {
     delete s;
   }
 };
+
+/**
+ * Presents a zstd context with the buffer members of the other libraries' stream states
+ */
+template <typename Context>
+struct zstd_stream {
+  Context* context;
+  unsigned char* next_in = nullptr;
+  std::size_t avail_in = 0;
+  unsigned char* next_out = nullptr;
+  std::size_t avail_out = 0;
+  std::size_t total_out = 0;
+
+  template <typename F>
+  std::size_t code(F&& func)
+  {
+    ZSTD_inBuffer input{next_in, avail_in, 0};
+    ZSTD_outBuffer output{next_out, avail_out, 0};
+    auto ret = func(context, &output, &input);
+
+    next_in += input.pos;
+    avail_in -= input.pos;
+    next_out += output.pos;
+    avail_out -= output.pos;
+    total_out += output.pos;
+    return ret;
+  }
+};
+
+inline std::size_t zstd_free_cstream(zstd_stream<ZSTD_CCtx>* x) { return ::ZSTD_freeCCtx(x->context); }
+inline std::size_t zstd_free_dstream(zstd_stream<ZSTD_DCtx>* x) { return ::ZSTD_freeDCtx(x->context); }
 } // namespace detail
 
 struct bzip2_tag_t {
@@ -108,7 +143,11 @@ struct gzip_tag_t {
 
   static status_type inflate(inflate_state_type& x)
   {
-    ::inflate(x.get(), Z_BLOCK);
+    // A file may hold several gzip members, each of which is a complete stream
+    if (::inflate(x.get(), Z_BLOCK) == Z_STREAM_END) {
+      ::inflateReset(x.get());
+      return status_type::END;
+    }
     return status_type::CAN_CONTINUE;
   }
 
@@ -180,6 +219,57 @@ struct lzma_tag_t {
     return state;
   }
 };
+
+template <int level = ZSTD_CLEVEL_DEFAULT>
+struct zstd_tag_t {
+  using state_type = detail::zstd_stream<ZSTD_DCtx>;
+  using in_char_type = std::remove_pointer_t<decltype(state_type::next_in)>;
+  using out_char_type = std::remove_pointer_t<decltype(state_type::next_out)>;
+  using deflate_state_type =
+      std::unique_ptr<detail::zstd_stream<ZSTD_CCtx>, detail::end_deleter<detail::zstd_stream<ZSTD_CCtx>, std::size_t, detail::zstd_free_cstream>>;
+  using inflate_state_type =
+      std::unique_ptr<detail::zstd_stream<ZSTD_DCtx>, detail::end_deleter<detail::zstd_stream<ZSTD_DCtx>, std::size_t, detail::zstd_free_dstream>>;
+  using status_type = status_t;
+
+  /**
+   * Compress the available input. A flush ends the current frame, so that each flush begins a frame that can be decompressed on its own.
+   */
+  static status_type deflate(deflate_state_type& x, bool flush)
+  {
+    auto ret = x->code([flush](auto* ctx, auto* output, auto* input) {
+      return ::ZSTD_compressStream2(ctx, output, input, flush ? ZSTD_e_end : ZSTD_e_continue);
+    });
+    if (::ZSTD_isError(ret)) {
+      return status_type::ERROR;
+    }
+    if (flush && ret == 0) {
+      return status_type::END;
+    }
+    return status_type::CAN_CONTINUE;
+  }
+
+  static status_type inflate(inflate_state_type& x)
+  {
+    auto ret = x->code(::ZSTD_decompressStream);
+    if (::ZSTD_isError(ret)) {
+      return status_type::ERROR;
+    }
+    if (ret == 0) {
+      return status_type::END;
+    }
+    return status_type::CAN_CONTINUE;
+  }
+
+  static deflate_state_type new_deflate_state()
+  {
+    deflate_state_type state{new detail::zstd_stream<ZSTD_CCtx>{::ZSTD_createCCtx()}};
+    ::ZSTD_CCtx_setParameter(state->context, ZSTD_c_compressionLevel, level);
+    ::ZSTD_CCtx_setParameter(state->context, ZSTD_c_checksumFlag, 1);
+    return state;
+  }
+
+  static inflate_state_type new_inflate_state() { return inflate_state_type{new detail::zstd_stream<ZSTD_DCtx>{::ZSTD_createDCtx()}}; }
+};
 } // namespace decomp_tags
 
 template <typename Tag, typename StreamType = std::ifstream>
@@ -22,6 +22,8 @@
 #include <cstdint>
 #include <functional>
 #include <limits>
+#include <stdexcept>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -29,6 +31,8 @@
 #include "champsim.h"
 #include "chrono.h"
 #include "trace_instruction.h"
+#include "util/inline_vector.h"
+#include "util/small_vector.h"
 
 // branch types
 enum branch_type {
@@ -48,6 +52,27 @@ using namespace std::literals::string_view_literals;
 inline constexpr std::array branch_type_names{"BRANCH_DIRECT_JUMP"sv, "BRANCH_INDIRECT"sv,      "BRANCH_CONDITIONAL"sv,
                                               "BRANCH_DIRECT_CALL"sv, "BRANCH_INDIRECT_CALL"sv, "BRANCH_RETURN"sv};
 
+// recovery mechanisms for a confident value misprediction
+enum class value_recovery_type {
+  SQUASH = 0, // flush and refetch every younger instruction
+  REISSUE     // reissue only the instructions that consumed the wrong value
+};
+
+inline constexpr std::array value_recovery_type_names{"SQUASH"sv, "REISSUE"sv};
+
+// instruction classes, numbered as in CVP-1 traces
+enum class inst_class : uint8_t {
+  ALU = 0,
+  LOAD,
+  STORE,
+  COND_BRANCH,
+  UNCOND_DIRECT_BRANCH,
+  UNCOND_INDIRECT_BRANCH,
+  FP,
+  SLOW_ALU,
+  UNDEF
+};
+
 namespace champsim
 {
 template <typename T>
@@ -106,8 +131,15 @@ struct ooo_model_instr : champsim::program_ordered<ooo_model_instr> {
   std::array<uint8_t, 2> asid = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()};
 
   branch_type branch{NOT_BRANCH};
+  inst_class instr_class{inst_class::UNDEF}; // only recorded by CVP traces
   champsim::address branch_target{};
 
+  bool value_predicted = false;            // The value predictor was consulted for one of this instruction's destinations
+  bool value_prediction_confident = false; // The prediction was used to wake up consumers early
+  bool value_mispredicted = false;
+  uint8_t value_prediction_slot = 0; // Index into destination_registers of the predicted destination
+  uint64_t predicted_value = 0;
+
   bool dib_checked = false;
   bool fetch_issued = false;
   bool fetch_completed = false;
@@ -119,14 +151,29 @@ struct ooo_model_instr : champsim::program_ordered<ooo_model_instr> {
   unsigned completed_mem_ops = 0;
   int num_reg_dependent = 0;
 
-  std::vector<PHYSICAL_REGISTER_ID> destination_registers = {}; // output registers
-  std::vector<PHYSICAL_REGISTER_ID> source_registers = {};      // input registers
+  // The operands are held inline, bounded by the widest trace format, so that instructions are copied through the pipeline without allocating
+  template <typename T>
+  using destination_list = champsim::inline_vector<T, NUM_INSTR_DESTINATIONS_SPARC>;
+  template <typename T>
+  using source_list = champsim::inline_vector<T, NUM_INSTR_SOURCES>;
+
+  destination_list<PHYSICAL_REGISTER_ID> destination_registers = {}; // output registers
+  source_list<PHYSICAL_REGISTER_ID> source_registers = {};           // input registers
 
-  std::vector<champsim::address> destination_memory = {};
-  std::vector<champsim::address> source_memory = {};
+  destination_list<champsim::address> destination_memory = {};
+  source_list<champsim::address> source_memory = {};
 
-  // these are indices of instructions in the ROB that depend on me
-  std::vector<std::reference_wrapper<ooo_model_instr>> registers_instrs_depend_on_me;
+  // Values recorded by the value-carrying trace format. Each list is parallel to the operand list it names, and all are empty for legacy traces.
+  bool has_values = false;
+  destination_list<uint64_t> destination_register_values = {};
+  destination_list<uint64_t> destination_memory_values = {};
+  source_list<uint64_t> source_memory_values = {};
+  destination_list<uint8_t> destination_memory_size = {};
+  source_list<uint8_t> source_memory_size = {};
+
+  // these are the instructions in the ROB that depend on me. It is only filled once the instruction is in the ROB, where it is no longer copied.
+  // Most instructions have few consumers, so the first few are held inline.
+  champsim::small_vector<ooo_model_instr*, 4> registers_instrs_depend_on_me;
 
 private:
   template <typename T>
@@ -194,6 +241,32 @@ private:
 public:
   ooo_model_instr(uint8_t cpu, input_instr instr) : ooo_model_instr(instr, {cpu, cpu}) {}
   ooo_model_instr(uint8_t /*cpu*/, cloudsuite_instr instr) : ooo_model_instr(instr, {instr.asid[0], instr.asid[1]}) {}
+  ooo_model_instr(uint8_t cpu, value_instr instr) : ooo_model_instr(instr, {cpu, cpu})
+  {
+    if (instr.version != champsim::VALUE_TRACE_VERSION) {
+      throw std::runtime_error{"Unsupported value trace version " + std::to_string(instr.version)};
+    }
+
+    has_values = true;
+
+    // Keep the values aligned with the operands that survived the filtering above
+    for (std::size_t i = 0; i < NUM_INSTR_DESTINATIONS; ++i) {
+      if (instr.destination_registers[i] != 0) {
+        destination_register_values.push_back(instr.destination_register_values[i]);
+      }
+      if (instr.destination_memory[i] != 0) {
+        destination_memory_values.push_back(instr.destination_memory_values[i]);
+        destination_memory_size.push_back(instr.destination_memory_size[i]);
+      }
+    }
+
+    for (std::size_t i = 0; i < NUM_INSTR_SOURCES; ++i) {
+      if (instr.source_memory[i] != 0) {
+        source_memory_values.push_back(instr.source_memory_values[i]);
+        source_memory_size.push_back(instr.source_memory_size[i]);
+      }
+    }
+  }
 
   [[nodiscard]] std::size_t num_mem_ops() const { return std::size(destination_memory) + std::size(source_memory); }
 };
@@ -0,0 +1,107 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MAPPED_TRACEREADER_H
+#define MAPPED_TRACEREADER_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "instruction.h"
+
+namespace champsim
+{
+/**
+ * A read-only mapping of a whole file into memory, which is advised to be read sequentially.
+ */
+class mapped_file
+{
+  const unsigned char* data_ = nullptr;
+  std::size_t size_ = 0;
+
+public:
+  /**
+   * Map the given file.
+   *
+   * \throws std::system_error if the file cannot be opened or mapped, or if it is not a regular file.
+   */
+  explicit mapped_file(const std::string& fname);
+
+  /**
+   * Whether the given file can be mapped. Pipes and devices, which have no size, cannot.
+   */
+  [[nodiscard]] static bool can_map(const std::string& fname);
+
+  mapped_file(mapped_file&& other) noexcept;
+  mapped_file& operator=(mapped_file&& other) noexcept;
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+  ~mapped_file();
+
+  [[nodiscard]] const unsigned char* data() const { return data_; }
+  [[nodiscard]] std::size_t size() const { return size_; }
+};
+
+/**
+ * A reader for uncompressed traces, which decodes each record in place from a mapping of the file.
+ */
+template <typename T>
+class mapped_tracereader
+{
+  static_assert(std::is_trivial_v<T>);
+  static_assert(std::is_standard_layout_v<T>);
+
+  uint8_t cpu;
+  mapped_file trace_file;
+  std::size_t num_records = std::size(trace_file) / sizeof(T);
+  std::size_t next_record = 0;
+
+  [[nodiscard]] const unsigned char* record(std::size_t idx) const { return std::data(trace_file) + idx * sizeof(T); }
+
+public:
+  mapped_tracereader(uint8_t cpu_idx, const std::string& fname) : cpu(cpu_idx), trace_file(fname) {}
+
+  ooo_model_instr operator()()
+  {
+    assert(next_record + 1 < num_records);
+    T trace_instr;
+    std::memcpy(&trace_instr, record(next_record), sizeof(T));
+    ooo_model_instr retval{cpu, trace_instr};
+
+    // The branch target is the IP of the following record, which does not need to be decoded
+    ++next_record;
+    if (retval.is_branch && retval.branch_taken) {
+      decltype(T::ip) target;
+      std::memcpy(&target, record(next_record) + offsetof(T, ip), sizeof(target));
+      retval.branch_target = champsim::address{target};
+    }
+
+    return retval;
+  }
+
+  void skip(uint64_t count) { next_record += std::min<uint64_t>(count, num_records - next_record); }
+
+  // Like bulk_tracereader, the last record only supplies the branch target of the one before it
+  [[nodiscard]] bool eof() const { return next_record + 1 >= num_records; }
+};
+} // namespace champsim
+
+#endif
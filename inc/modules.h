@@ -69,6 +69,22 @@ struct branch_predictor : public bound_to<O3_CPU> {
 
   template <typename T, typename... Args>
   constexpr static bool has_predict_branch = decltype(predict_branch_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  static auto save_checkpoint_member_impl(int) -> decltype(std::declval<T>().branch_predictor_save_checkpoint(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto save_checkpoint_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  static auto restore_checkpoint_member_impl(int) -> decltype(std::declval<T>().branch_predictor_restore_checkpoint(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto restore_checkpoint_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_save_checkpoint = decltype(save_checkpoint_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_restore_checkpoint = decltype(restore_checkpoint_member_impl<T, Args...>(0))::value;
 };
 
 struct btb : public bound_to<O3_CPU> {
@@ -97,6 +113,74 @@ struct btb : public bound_to<O3_CPU> {
 
   template <typename T, typename... Args>
   constexpr static bool has_btb_prediction = decltype(predict_branch_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  static auto save_checkpoint_member_impl(int) -> decltype(std::declval<T>().btb_save_checkpoint(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto save_checkpoint_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  static auto restore_checkpoint_member_impl(int) -> decltype(std::declval<T>().btb_restore_checkpoint(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto restore_checkpoint_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_save_checkpoint = decltype(save_checkpoint_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_restore_checkpoint = decltype(restore_checkpoint_member_impl<T, Args...>(0))::value;
+};
+
+struct value_predictor : public bound_to<O3_CPU> {
+  explicit value_predictor(O3_CPU* cpu) : bound_to<O3_CPU>(cpu) {}
+
+  template <typename T, typename... Args>
+  static auto initialize_member_impl(int) -> decltype(std::declval<T>().initialize_value_predictor(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto initialize_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  static auto predict_value_member_impl(int) -> decltype(std::declval<T>().predict_value(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto predict_value_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  static auto update_value_member_impl(int) -> decltype(std::declval<T>().update_value(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto update_value_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  static auto branch_operate_member_impl(int) -> decltype(std::declval<T>().value_predictor_branch_operate(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto branch_operate_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_initialize = decltype(initialize_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_predict_value = decltype(predict_value_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_update_value = decltype(update_value_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_branch_operate = decltype(branch_operate_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  static auto save_checkpoint_member_impl(int) -> decltype(std::declval<T>().value_predictor_save_checkpoint(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto save_checkpoint_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  static auto restore_checkpoint_member_impl(int) -> decltype(std::declval<T>().value_predictor_restore_checkpoint(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto restore_checkpoint_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_save_checkpoint = decltype(save_checkpoint_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_restore_checkpoint = decltype(restore_checkpoint_member_impl<T, Args...>(0))::value;
 };
 
 struct prefetcher : public bound_to<CACHE> {
@@ -151,6 +235,22 @@ struct prefetcher : public bound_to<CACHE> {
 
   template <typename T, typename... Args>
   constexpr static bool has_branch_operate = decltype(branch_operate_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  static auto save_checkpoint_member_impl(int) -> decltype(std::declval<T>().prefetcher_save_checkpoint(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto save_checkpoint_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  static auto restore_checkpoint_member_impl(int) -> decltype(std::declval<T>().prefetcher_restore_checkpoint(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto restore_checkpoint_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_save_checkpoint = decltype(save_checkpoint_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_restore_checkpoint = decltype(restore_checkpoint_member_impl<T, Args...>(0))::value;
 };
 
 struct replacement : public bound_to<CACHE> {
@@ -195,6 +295,22 @@ struct replacement : public bound_to<CACHE> {
 
   template <typename T, typename... Args>
   constexpr static bool has_final_stats = decltype(final_stats_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  static auto save_checkpoint_member_impl(int) -> decltype(std::declval<T>().replacement_save_checkpoint(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto save_checkpoint_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  static auto restore_checkpoint_member_impl(int) -> decltype(std::declval<T>().replacement_restore_checkpoint(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto restore_checkpoint_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_save_checkpoint = decltype(save_checkpoint_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_restore_checkpoint = decltype(restore_checkpoint_member_impl<T, Args...>(0))::value;
 };
 } // namespace champsim::modules
 
@@ -0,0 +1,85 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef FPCOUNTER_H
+#define FPCOUNTER_H
+
+#include <array>
+#include <cstddef>
+#include <random>
+
+#include "msl/fwcounter.h"
+
+namespace champsim::msl
+{
+/**
+ * A forward-probabilistic counter, as used by value predictors to gain high confidence with few bits.
+ * Each increment takes effect only with a probability that depends on the current value, while a reset is unconditional.
+ *
+ * \tparam WIDTH the bit-width of the value
+ */
+template <std::size_t WIDTH>
+class fpcounter
+{
+  fwcounter<WIDTH> counter{};
+
+public:
+  using value_type = typename fwcounter<WIDTH>::value_type;
+  constexpr static value_type maximum = fwcounter<WIDTH>::maximum;
+
+  /**
+   * The inverse of the probability of incrementing from each value. An entry of 1 always increments, an entry of 16 increments with probability 1/16.
+   */
+  using probability_vector = std::array<unsigned, static_cast<std::size_t>(maximum)>;
+
+  fpcounter() = default;
+  explicit fpcounter(value_type value) : counter(value) {}
+
+  /**
+   * Increment the value with the probability selected from the given vector, saturating at the maximum value.
+   */
+  template <typename URBG>
+  void increment(URBG& rng, const probability_vector& inverse_probability)
+  {
+    if (is_max()) {
+      return;
+    }
+
+    auto inverse = inverse_probability.at(static_cast<std::size_t>(value()));
+    if (inverse <= 1 || std::uniform_int_distribution<unsigned>{0, inverse - 1}(rng) == 0) {
+      ++counter;
+    }
+  }
+
+  /**
+   * Return the value to zero.
+   */
+  void reset() { counter = 0; }
+
+  /**
+   * Detect whether the counter is saturated at its maximum.
+   */
+  [[nodiscard]] bool is_max() const { return counter.is_max(); }
+
+  /**
+   * Unpack the wrapped value.
+   */
+  [[nodiscard]] value_type value() const { return counter.value(); }
+};
+} // namespace champsim::msl
+
+#endif
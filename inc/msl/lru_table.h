@@ -22,10 +22,12 @@
 #include <cstdint>
 #include <optional>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "checkpoint.h"
 #include "extent.h"
 #include "msl/bits.h"
 #include "util/detect.h"
@@ -165,6 +167,57 @@ public:
     return std::exchange(*hit, {}).data;
   }
 
+  /**
+   * Write the contents and recency of the table. The element type must be trivially copyable.
+   */
+  void save_checkpoint(std::ostream& os) const
+  {
+    champsim::checkpoint::write(os, access_count);
+    champsim::checkpoint::write(os, block);
+  }
+
+  /**
+   * Read the contents and recency written by save_checkpoint() from a table of the same size.
+   */
+  void restore_checkpoint(std::istream& is)
+  {
+    champsim::checkpoint::read(is, access_count);
+    champsim::checkpoint::read(is, block);
+  }
+
+  /**
+   * Write the contents and recency of the table, where each element is written by the given function.
+   * This is for element types that are not trivially copyable.
+   */
+  template <typename F>
+  void save_checkpoint(std::ostream& os, F&& write_elem) const
+  {
+    champsim::checkpoint::write(os, access_count);
+    champsim::checkpoint::write(os, static_cast<uint64_t>(std::size(block)));
+    for (const auto& b : block) {
+      champsim::checkpoint::write(os, b.last_used);
+      write_elem(os, b.data);
+    }
+  }
+
+  /**
+   * Read the contents and recency written by save_checkpoint(), where each element is read by the given function.
+   */
+  template <typename F>
+  void restore_checkpoint(std::istream& is, F&& read_elem)
+  {
+    champsim::checkpoint::read(is, access_count);
+    uint64_t size{};
+    champsim::checkpoint::read(is, size);
+    if (size != std::size(block))
+      throw champsim::checkpoint::format_error{"Checkpoint has a table of " + std::to_string(size) + " entries where the configuration has "
+                                               + std::to_string(std::size(block))};
+    for (auto& b : block) {
+      champsim::checkpoint::read(is, b.last_used);
+      read_elem(is, b.data);
+    }
+  }
+
   lru_table(std::size_t sets, std::size_t ways, SetProj set_proj, TagProj tag_proj)
       : set_projection(set_proj), tag_projection(tag_proj), NUM_SET(static_cast<diff_type>(sets)), NUM_WAY(static_cast<diff_type>(ways)), block(sets * ways)
   {
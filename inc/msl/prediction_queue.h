@@ -0,0 +1,69 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PREDICTION_QUEUE_H
+#define PREDICTION_QUEUE_H
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <utility>
+
+#include "address.h"
+
+namespace champsim::msl
+{
+/**
+ * Holds the lookups that a predictor made for its predictions until they are trained.
+ *
+ * Predictions are made and trained in program order, so the lookups are kept in a queue between the two.
+ * The prediction for an instruction on a wrong path is never trained, so its lookup is dropped when a later prediction is trained.
+ *
+ * \tparam T the lookup of one prediction, which names the instruction in a member called ip
+ */
+template <typename T>
+class prediction_queue
+{
+  std::deque<T> entries{};
+
+public:
+  void push(T entry) { entries.push_back(std::move(entry)); }
+
+  /**
+   * Take the lookup of the oldest prediction for the given instruction, dropping those of any older predictions.
+   *
+   * \returns the lookup, or nothing if no prediction for the instruction is held.
+   */
+  std::optional<T> take(champsim::address ip)
+  {
+    while (!std::empty(entries) && entries.front().ip != ip) {
+      entries.pop_front();
+    }
+
+    if (std::empty(entries)) {
+      return std::nullopt;
+    }
+
+    std::optional<T> retval{std::move(entries.front())};
+    entries.pop_front();
+    return retval;
+  }
+
+  [[nodiscard]] std::size_t size() const { return std::size(entries); }
+};
+} // namespace champsim::msl
+
+#endif
@@ -25,12 +25,14 @@
 #include <array>
 #include <bitset>
 #include <deque>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <optional>
 #include <queue>
 #include <stdexcept>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 #include "bandwidth.h"
@@ -42,6 +44,7 @@
 #include "modules.h"
 #include "operable.h"
 #include "register_allocator.h"
+#include "util/circular_buffer.h"
 #include "util/lru_table.h"
 #include "util/to_underlying.h"
 
@@ -61,6 +64,8 @@ public:
   CacheBus(uint32_t cpu_idx, champsim::channel* ll) : lower_level(ll), cpu(cpu_idx) {}
   bool issue_read(request_type packet);
   bool issue_write(request_type packet);
+
+  [[nodiscard]] const channel_type* lower_channel() const { return lower_level; }
 };
 
 struct LSQ_ENTRY : champsim::program_ordered<LSQ_ENTRY> {
@@ -74,9 +79,12 @@ struct LSQ_ENTRY : champsim::program_ordered<LSQ_ENTRY> {
   uint64_t producer_id = std::numeric_limits<uint64_t>::max();
   std::vector<std::reference_wrapper<std::optional<LSQ_ENTRY>>> lq_depend_on_me{};
 
-  LSQ_ENTRY(champsim::address addr, champsim::program_ordered<LSQ_ENTRY>::id_type id, champsim::address ip, std::array<uint8_t, 2> asid);
+  champsim::circular_buffer<ooo_model_instr>::handle_type rob_handle; // The instruction that owns this entry
+
+  LSQ_ENTRY(champsim::address addr, champsim::program_ordered<LSQ_ENTRY>::id_type id, champsim::address ip, std::array<uint8_t, 2> asid,
+            champsim::circular_buffer<ooo_model_instr>::handle_type rob_handle);
   void finish(ooo_model_instr& rob_entry) const;
-  void finish(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end) const;
+  void finish(champsim::circular_buffer<ooo_model_instr>& rob) const;
 };
 
 // cpu
@@ -111,15 +119,25 @@ public:
   dib_type DIB;
 
   // reorder buffer, load/store queue, register file
-  std::deque<ooo_model_instr> IFETCH_BUFFER;
-  std::deque<ooo_model_instr> DISPATCH_BUFFER;
-  std::deque<ooo_model_instr> DECODE_BUFFER;
-  std::deque<ooo_model_instr> ROB;
-  std::deque<ooo_model_instr> DIB_HIT_BUFFER;
+  // Each is allocated to its configured size. Instructions are held in program order, and are found by their handles.
+  // The ROB does not grow, so that the references between its instructions remain valid while they are in flight.
+  using instr_buffer_type = champsim::circular_buffer<ooo_model_instr>;
+  instr_buffer_type IFETCH_BUFFER;
+  instr_buffer_type DISPATCH_BUFFER;
+  instr_buffer_type DECODE_BUFFER;
+  instr_buffer_type ROB;
+  instr_buffer_type DIB_HIT_BUFFER;
 
   std::vector<std::optional<LSQ_ENTRY>> LQ;
   std::deque<LSQ_ENTRY> SQ;
 
+  // Indices into the load/store queues, so that no lookup scans them.
+  // Free LQ slots are taken lowest first. Stores to each address are held in program order.
+  std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<>> LQ_free_slots;
+  std::unordered_multimap<uint64_t, std::size_t> LQ_by_instr;
+  std::unordered_multimap<uint64_t, std::size_t> LQ_by_block;
+  std::unordered_map<uint64_t, std::deque<std::reference_wrapper<LSQ_ENTRY>>> SQ_by_address;
+
   // Constants
   const std::size_t IFETCH_BUFFER_SIZE, DISPATCH_BUFFER_SIZE, DECODE_BUFFER_SIZE, REGISTER_FILE_SIZE, ROB_SIZE, SQ_SIZE, DIB_HIT_BUFFER_SIZE;
   champsim::bandwidth::maximum_type FETCH_WIDTH, DECODE_WIDTH, DISPATCH_WIDTH, SCHEDULER_SIZE, EXEC_WIDTH, DIB_INORDER_WIDTH;
@@ -131,11 +149,25 @@ public:
   champsim::chrono::clock::duration SCHEDULING_LATENCY;
   champsim::chrono::clock::duration EXEC_LATENCY;
   champsim::chrono::clock::duration DIB_HIT_LATENCY;
+  value_recovery_type VALUE_RECOVERY;
 
   champsim::bandwidth::maximum_type L1I_BANDWIDTH, L1D_BANDWIDTH;
 
   RegisterAllocator reg_allocator{REGISTER_FILE_SIZE};
 
+  // wakeup and select
+  // A scheduled instruction waits on one of its invalid source registers at a time, and is ready when all of its sources are valid.
+  // Instructions are held by their handles in the ROB, which are in program order.
+  using wait_list_type = std::vector<instr_buffer_type::handle_type>;
+  std::vector<wait_list_type> register_waiters = std::vector<wait_list_type>(REGISTER_FILE_SIZE);
+  wait_list_type ready_instrs{};
+  wait_list_type inflight_instrs{}; // executed, but not completed
+
+  // The instructions that the scheduler must search, from the oldest that has not executed. Instructions are added as they enter the ROB
+  // and when they are reset, and are dropped once the search finds them executed.
+  wait_list_type unexecuted_instrs{};
+  instr_buffer_type::handle_type unexecuted_tracked_end = 0;
+
   // branch
   champsim::chrono::clock::time_point fetch_resume_time{};
 
@@ -149,6 +181,9 @@ public:
   long operate() final;
   void begin_phase() final;
   void end_phase(unsigned cpu) final;
+  [[nodiscard]] champsim::chrono::clock::time_point next_event_time() const final;
+  void save_checkpoint(std::ostream& os) const final;
+  void restore_checkpoint(std::istream& is) final;
 
   void initialize_instruction();
   long check_dib();
@@ -166,12 +201,21 @@ public:
   bool do_init_instruction(ooo_model_instr& instr);
   bool do_predict_branch(ooo_model_instr& instr);
   void do_check_dib(ooo_model_instr& instr);
-  bool do_fetch_instruction(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end);
+  bool do_fetch_instruction(instr_buffer_type::iterator begin, instr_buffer_type::iterator end);
   void do_dib_update(const ooo_model_instr& instr);
   void do_scheduling(ooo_model_instr& instr);
+  void do_wakeup(ooo_model_instr& instr);
+  void do_complete_register(PHYSICAL_REGISTER_ID physreg);
+  void do_predict_value(ooo_model_instr& instr, std::size_t slot);
   void do_execution(ooo_model_instr& instr);
   void do_memory_scheduling(ooo_model_instr& instr);
   void do_complete_execution(ooo_model_instr& instr);
+  bool do_reset_execution(ooo_model_instr& instr);
+  std::optional<LSQ_ENTRY>& do_allocate_load(champsim::address addr, const ooo_model_instr& instr, instr_buffer_type::handle_type rob_handle);
+  void do_release_load(std::optional<LSQ_ENTRY>& lq_entry);
+  void do_release_store(const LSQ_ENTRY& sq_entry);
+  void do_value_squash(const ooo_model_instr& instr);
+  void do_value_reissue(const ooo_model_instr& instr);
   void do_sq_forward_to_lq(LSQ_ENTRY& sq_entry, LSQ_ENTRY& lq_entry);
 
   void do_finish_store(const LSQ_ENTRY& sq_entry);
@@ -193,6 +237,8 @@ public:
     virtual void impl_initialize_branch_predictor() = 0;
     virtual void impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) = 0;
     virtual bool impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) = 0;
+    virtual void impl_branch_predictor_save_checkpoint(std::ostream& os) = 0;
+    virtual void impl_branch_predictor_restore_checkpoint(std::istream& is) = 0;
   };
 
   struct btb_module_concept {
@@ -201,6 +247,19 @@ public:
     virtual void impl_initialize_btb() = 0;
     virtual void impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) = 0;
     virtual std::pair<champsim::address, bool> impl_btb_prediction(champsim::address ip, uint8_t branch_type) = 0;
+    virtual void impl_btb_save_checkpoint(std::ostream& os) = 0;
+    virtual void impl_btb_restore_checkpoint(std::istream& is) = 0;
+  };
+
+  struct value_module_concept {
+    virtual ~value_module_concept() = default;
+
+    virtual void impl_initialize_value_predictor() = 0;
+    virtual std::pair<uint64_t, bool> impl_predict_value(champsim::address ip, uint8_t destination_register) = 0;
+    virtual void impl_update_value(champsim::address ip, uint64_t actual_value, uint64_t predicted_value, bool confident) = 0;
+    virtual void impl_value_predictor_branch_operate(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) = 0;
+    virtual void impl_value_predictor_save_checkpoint(std::ostream& os) = 0;
+    virtual void impl_value_predictor_restore_checkpoint(std::istream& is) = 0;
   };
 
   template <typename... Bs>
@@ -211,6 +270,8 @@ public:
     void impl_initialize_branch_predictor() final;
     void impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) final;
     [[nodiscard]] bool impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) final;
+    void impl_branch_predictor_save_checkpoint(std::ostream& os) final;
+    void impl_branch_predictor_restore_checkpoint(std::istream& is) final;
   };
 
   template <typename... Ts>
@@ -221,36 +282,70 @@ public:
     void impl_initialize_btb() final;
     void impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) final;
     [[nodiscard]] std::pair<champsim::address, bool> impl_btb_prediction(champsim::address ip, uint8_t branch_type) final;
+    void impl_btb_save_checkpoint(std::ostream& os) final;
+    void impl_btb_restore_checkpoint(std::istream& is) final;
+  };
+
+  template <typename... Vs>
+  struct value_module_model final : value_module_concept {
+    std::tuple<Vs...> intern_;
+    explicit value_module_model(O3_CPU* cpu) : intern_(Vs{cpu}...) { (void)cpu; /* silence -Wunused-but-set-parameter when sizeof...(Vs) == 0 */ }
+
+    void impl_initialize_value_predictor() final;
+    [[nodiscard]] std::pair<uint64_t, bool> impl_predict_value(champsim::address ip, uint8_t destination_register) final;
+    void impl_update_value(champsim::address ip, uint64_t actual_value, uint64_t predicted_value, bool confident) final;
+    void impl_value_predictor_branch_operate(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) final;
+    void impl_value_predictor_save_checkpoint(std::ostream& os) final;
+    void impl_value_predictor_restore_checkpoint(std::istream& is) final;
   };
 
   std::unique_ptr<branch_module_concept> branch_module_pimpl;
   std::unique_ptr<btb_module_concept> btb_module_pimpl;
+  std::unique_ptr<value_module_concept> value_module_pimpl;
 
   // NOLINTBEGIN(readability-make-member-function-const): legacy modules use non-const hooks
   void impl_initialize_branch_predictor() const;
   void impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) const;
   [[nodiscard]] bool impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) const;
+  void impl_branch_predictor_save_checkpoint(std::ostream& os) const;
+  void impl_branch_predictor_restore_checkpoint(std::istream& is) const;
 
   void impl_initialize_btb() const;
   void impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) const;
   [[nodiscard]] std::pair<champsim::address, bool> impl_btb_prediction(champsim::address ip, uint8_t branch_type) const;
+  void impl_btb_save_checkpoint(std::ostream& os) const;
+  void impl_btb_restore_checkpoint(std::istream& is) const;
+
+  void impl_initialize_value_predictor() const;
+  [[nodiscard]] std::pair<uint64_t, bool> impl_predict_value(champsim::address ip, uint8_t destination_register) const;
+  void impl_update_value(champsim::address ip, uint64_t actual_value, uint64_t predicted_value, bool confident) const;
+  void impl_value_predictor_branch_operate(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) const;
+  void impl_value_predictor_save_checkpoint(std::ostream& os) const;
+  void impl_value_predictor_restore_checkpoint(std::istream& is) const;
   // NOLINTEND(readability-make-member-function-const)
 
-  template <typename... Bs, typename... Ts>
-  explicit O3_CPU(champsim::core_builder<champsim::core_builder_module_type_holder<Bs...>, champsim::core_builder_module_type_holder<Ts...>> b)
+  template <typename... Bs, typename... Ts, typename... Vs>
+  explicit O3_CPU(champsim::core_builder<champsim::core_builder_module_type_holder<Bs...>, champsim::core_builder_module_type_holder<Ts...>,
+                                         champsim::core_builder_module_type_holder<Vs...>>
+                      b)
       : champsim::operable(b.m_clock_period), cpu(b.m_cpu),
         DIB(b.m_dib_set, b.m_dib_way, {champsim::data::bits{champsim::lg2(b.m_dib_window)}}, {champsim::data::bits{champsim::lg2(b.m_dib_window)}}),
-        LQ(b.m_lq_size), IFETCH_BUFFER_SIZE(b.m_ifetch_buffer_size), DISPATCH_BUFFER_SIZE(b.m_dispatch_buffer_size), DECODE_BUFFER_SIZE(b.m_decode_buffer_size),
+        IFETCH_BUFFER(b.m_ifetch_buffer_size), DISPATCH_BUFFER(b.m_dispatch_buffer_size), DECODE_BUFFER(b.m_decode_buffer_size),
+        ROB(b.m_rob_size, instr_buffer_type::overflow::error), DIB_HIT_BUFFER(b.m_dib_hit_buffer_size), LQ(b.m_lq_size),
+        IFETCH_BUFFER_SIZE(b.m_ifetch_buffer_size), DISPATCH_BUFFER_SIZE(b.m_dispatch_buffer_size), DECODE_BUFFER_SIZE(b.m_decode_buffer_size),
         REGISTER_FILE_SIZE(b.m_register_file_size), ROB_SIZE(b.m_rob_size), SQ_SIZE(b.m_sq_size), DIB_HIT_BUFFER_SIZE(b.m_dib_hit_buffer_size),
         FETCH_WIDTH(b.m_fetch_width), DECODE_WIDTH(b.m_decode_width), DISPATCH_WIDTH(b.m_dispatch_width), SCHEDULER_SIZE(b.m_schedule_width),
         EXEC_WIDTH(b.m_execute_width), DIB_INORDER_WIDTH(b.m_dib_inorder_width), LQ_WIDTH(b.m_lq_width), SQ_WIDTH(b.m_sq_width), RETIRE_WIDTH(b.m_retire_width),
         BRANCH_MISPREDICT_PENALTY(b.m_mispredict_penalty * b.m_clock_period), DISPATCH_LATENCY(b.m_dispatch_latency * b.m_clock_period),
         DECODE_LATENCY(b.m_decode_latency * b.m_clock_period), SCHEDULING_LATENCY(b.m_schedule_latency * b.m_clock_period),
-        EXEC_LATENCY(b.m_execute_latency * b.m_clock_period), DIB_HIT_LATENCY(b.m_dib_hit_latency * b.m_clock_period), L1I_BANDWIDTH(b.m_l1i_bw),
-        L1D_BANDWIDTH(b.m_l1d_bw), IN_QUEUE_SIZE(2 * champsim::to_underlying(b.m_fetch_width)), L1I_bus(b.m_cpu, b.m_fetch_queues),
+        EXEC_LATENCY(b.m_execute_latency * b.m_clock_period), DIB_HIT_LATENCY(b.m_dib_hit_latency * b.m_clock_period), VALUE_RECOVERY(b.m_value_recovery),
+        L1I_BANDWIDTH(b.m_l1i_bw), L1D_BANDWIDTH(b.m_l1d_bw), IN_QUEUE_SIZE(2 * champsim::to_underlying(b.m_fetch_width)), L1I_bus(b.m_cpu, b.m_fetch_queues),
         L1D_bus(b.m_cpu, b.m_data_queues), l1i(b.m_l1i), branch_module_pimpl(std::make_unique<branch_module_model<Bs...>>(this)),
-        btb_module_pimpl(std::make_unique<btb_module_model<Ts...>>(this))
+        btb_module_pimpl(std::make_unique<btb_module_model<Ts...>>(this)), value_module_pimpl(std::make_unique<value_module_model<Vs...>>(this))
   {
+    for (std::size_t i = 0; i < std::size(LQ); ++i) {
+      LQ_free_slots.push(i);
+    }
   }
 };
 
@@ -311,6 +406,30 @@ bool O3_CPU::branch_module_model<Bs...>::impl_predict_branch(champsim::address i
   return return_type{};
 }
 
+template <typename... Bs>
+void O3_CPU::branch_module_model<Bs...>::impl_branch_predictor_save_checkpoint(std::ostream& os)
+{
+  [[maybe_unused]] auto process_one = [&](auto& b) {
+    using namespace champsim::modules;
+    if constexpr (branch_predictor::has_save_checkpoint<decltype(b), std::ostream&>)
+      b.branch_predictor_save_checkpoint(os);
+  };
+
+  std::apply([&](auto&... b) { (..., process_one(b)); }, intern_);
+}
+
+template <typename... Bs>
+void O3_CPU::branch_module_model<Bs...>::impl_branch_predictor_restore_checkpoint(std::istream& is)
+{
+  [[maybe_unused]] auto process_one = [&](auto& b) {
+    using namespace champsim::modules;
+    if constexpr (branch_predictor::has_restore_checkpoint<decltype(b), std::istream&>)
+      b.branch_predictor_restore_checkpoint(is);
+  };
+
+  std::apply([&](auto&... b) { (..., process_one(b)); }, intern_);
+}
+
 template <typename... Ts>
 void O3_CPU::btb_module_model<Ts...>::impl_initialize_btb()
 {
@@ -369,6 +488,126 @@ std::pair<champsim::address, bool> O3_CPU::btb_module_model<Ts...>::impl_btb_pre
   return return_type{};
 }
 
+template <typename... Ts>
+void O3_CPU::btb_module_model<Ts...>::impl_btb_save_checkpoint(std::ostream& os)
+{
+  [[maybe_unused]] auto process_one = [&](auto& t) {
+    using namespace champsim::modules;
+    if constexpr (btb::has_save_checkpoint<decltype(t), std::ostream&>)
+      t.btb_save_checkpoint(os);
+  };
+
+  std::apply([&](auto&... t) { (..., process_one(t)); }, intern_);
+}
+
+template <typename... Ts>
+void O3_CPU::btb_module_model<Ts...>::impl_btb_restore_checkpoint(std::istream& is)
+{
+  [[maybe_unused]] auto process_one = [&](auto& t) {
+    using namespace champsim::modules;
+    if constexpr (btb::has_restore_checkpoint<decltype(t), std::istream&>)
+      t.btb_restore_checkpoint(is);
+  };
+
+  std::apply([&](auto&... t) { (..., process_one(t)); }, intern_);
+}
+
+template <typename... Vs>
+void O3_CPU::value_module_model<Vs...>::impl_initialize_value_predictor()
+{
+  [[maybe_unused]] auto process_one = [&](auto& v) {
+    using namespace champsim::modules;
+    if constexpr (value_predictor::has_initialize<decltype(v)>)
+      v.initialize_value_predictor();
+  };
+
+  std::apply([&](auto&... v) { (..., process_one(v)); }, intern_);
+}
+
+template <typename... Vs>
+std::pair<uint64_t, bool> O3_CPU::value_module_model<Vs...>::impl_predict_value(champsim::address ip, uint8_t destination_register)
+{
+  using return_type = std::pair<uint64_t, bool>;
+  [[maybe_unused]] auto process_one = [&](auto& v) {
+    using namespace champsim::modules;
+
+    /* Strong addresses, full size */
+    if constexpr (value_predictor::has_predict_value<decltype(v), champsim::address, uint8_t>)
+      return return_type{v.predict_value(ip, destination_register)};
+
+    /* Strong addresses, short size */
+    if constexpr (value_predictor::has_predict_value<decltype(v), champsim::address>)
+      return return_type{v.predict_value(ip)};
+
+    /* Raw integer addresses, full size */
+    if constexpr (value_predictor::has_predict_value<decltype(v), uint64_t, uint8_t>)
+      return return_type{v.predict_value(ip.to<uint64_t>(), destination_register)};
+
+    /* Raw integer addresses, short size */
+    if constexpr (value_predictor::has_predict_value<decltype(v), uint64_t>)
+      return return_type{v.predict_value(ip.to<uint64_t>())};
+
+    return return_type{};
+  };
+
+  if constexpr (sizeof...(Vs) > 0) {
+    return std::apply([&](auto&... v) { return (..., process_one(v)); }, intern_);
+  }
+  return return_type{};
+}
+
+template <typename... Vs>
+void O3_CPU::value_module_model<Vs...>::impl_update_value(champsim::address ip, uint64_t actual_value, uint64_t predicted_value, bool confident)
+{
+  [[maybe_unused]] auto process_one = [&](auto& v) {
+    using namespace champsim::modules;
+    if constexpr (value_predictor::has_update_value<decltype(v), champsim::address, uint64_t, uint64_t, bool>)
+      v.update_value(ip, actual_value, predicted_value, confident);
+    if constexpr (value_predictor::has_update_value<decltype(v), uint64_t, uint64_t, uint64_t, bool>)
+      v.update_value(ip.to<uint64_t>(), actual_value, predicted_value, confident);
+  };
+
+  std::apply([&](auto&... v) { (..., process_one(v)); }, intern_);
+}
+
+template <typename... Vs>
+void O3_CPU::value_module_model<Vs...>::impl_value_predictor_branch_operate(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type)
+{
+  [[maybe_unused]] auto process_one = [&](auto& v) {
+    using namespace champsim::modules;
+    if constexpr (value_predictor::has_branch_operate<decltype(v), champsim::address, champsim::address, bool, uint8_t>)
+      v.value_predictor_branch_operate(ip, target, taken, branch_type);
+    if constexpr (value_predictor::has_branch_operate<decltype(v), uint64_t, uint64_t, bool, uint8_t>)
+      v.value_predictor_branch_operate(ip.to<uint64_t>(), target.to<uint64_t>(), taken, branch_type);
+  };
+
+  std::apply([&](auto&... v) { (..., process_one(v)); }, intern_);
+}
+
+template <typename... Vs>
+void O3_CPU::value_module_model<Vs...>::impl_value_predictor_save_checkpoint(std::ostream& os)
+{
+  [[maybe_unused]] auto process_one = [&](auto& v) {
+    using namespace champsim::modules;
+    if constexpr (value_predictor::has_save_checkpoint<decltype(v), std::ostream&>)
+      v.value_predictor_save_checkpoint(os);
+  };
+
+  std::apply([&](auto&... v) { (..., process_one(v)); }, intern_);
+}
+
+template <typename... Vs>
+void O3_CPU::value_module_model<Vs...>::impl_value_predictor_restore_checkpoint(std::istream& is)
+{
+  [[maybe_unused]] auto process_one = [&](auto& v) {
+    using namespace champsim::modules;
+    if constexpr (value_predictor::has_restore_checkpoint<decltype(v), std::istream&>)
+      v.value_predictor_restore_checkpoint(is);
+  };
+
+  std::apply([&](auto&... v) { (..., process_one(v)); }, intern_);
+}
+
 #ifdef SET_ASIDE_CHAMPSIM_MODULE
 #undef SET_ASIDE_CHAMPSIM_MODULE
 #define CHAMPSIM_MODULE
@@ -17,6 +17,8 @@
 #ifndef OPERABLE_H
 #define OPERABLE_H
 
+#include <iosfwd>
+
 #include "chrono.h"
 
 namespace champsim
@@ -35,12 +37,38 @@ public:
   long _operate();
   long operate_on(const champsim::chrono::clock& clock);
 
+  void _skip(long cycles);
+  long skip_on(const champsim::chrono::clock& clock);
+
   virtual void initialize() {} // LCOV_EXCL_LINE
   virtual long operate() = 0;
   virtual void begin_phase() {}                     // LCOV_EXCL_LINE
   virtual void end_phase(unsigned /*cpu index*/) {} // LCOV_EXCL_LINE
   virtual void print_deadlock() {}                  // LCOV_EXCL_LINE
 
+  /**
+   * The earliest time at which this operable might change its state, assuming that no other operable acts on it before then.
+   * The clock may be moved directly to the earliest event among all operables if every cycle before it would make no progress.
+   * The default, the next cycle, never allows the clock to skip ahead.
+   */
+  [[nodiscard]] virtual champsim::chrono::clock::time_point next_event_time() const { return current_time + clock_period; }
+
+  /**
+   * Account for cycles that passed without being operated, for state that changes every cycle regardless of progress.
+   */
+  virtual void skip(long /*cycles*/) {} // LCOV_EXCL_LINE
+
+  /**
+   * Write the state that outlives the instructions in flight, such as tables and predictors, so that warmup can be skipped by a later run.
+   * Queues and in-flight requests are not included.
+   */
+  virtual void save_checkpoint(std::ostream& /*os*/) const {} // LCOV_EXCL_LINE
+
+  /**
+   * Read the state written by save_checkpoint() by an operable of the same configuration.
+   */
+  virtual void restore_checkpoint(std::istream& /*is*/) {} // LCOV_EXCL_LINE
+
   [[deprecated]] uint64_t current_cycle() const;
 };
 
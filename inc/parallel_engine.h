@@ -0,0 +1,103 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARALLEL_ENGINE_H
+#define PARALLEL_ENGINE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "chrono.h"
+#include "operable.h"
+
+namespace champsim
+{
+struct environment;
+
+/**
+ * A set of operables that only interact with operables outside of the set through channels.
+ */
+struct domain {
+  std::vector<std::reference_wrapper<operable>> operables{};
+
+  /**
+   * Operate every member up to the time of the given clock, in the same order as the serial simulation would.
+   */
+  long operate_on(const champsim::chrono::clock& clock);
+};
+
+struct domain_partition {
+  std::vector<domain> cores{};
+  domain shared{};
+};
+
+/**
+ * Split the environment into a domain for each core and a shared domain.
+ *
+ * A core's domain holds the core and every cache that is reachable from that core alone.
+ * Everything else, including the last-level cache, the page table walkers, and the memory controller, is shared.
+ * The page table walkers are shared because they allocate pages from the same virtual memory, which must happen in a fixed order.
+ */
+domain_partition partition_domains(environment& env);
+
+/**
+ * Operates the per-core domains of an environment on a fixed set of worker threads.
+ *
+ * The core domains run concurrently for a synchronization interval, and then the shared domain runs alone for the same interval.
+ * Since no two domains touch the same channel at the same time, every run is deterministic, regardless of the number of threads.
+ * Requests that cross into the shared domain may be seen up to one interval later than in the serial simulation.
+ */
+class parallel_engine
+{
+  domain_partition partition;
+
+  std::vector<std::thread> workers{};
+  std::mutex mtx{};
+  std::condition_variable start_cv{};
+  std::condition_variable done_cv{};
+  uint64_t generation = 0;
+  std::size_t pending = 0;
+  bool stopping = false;
+  std::exception_ptr error{};
+  std::function<void(std::size_t)> job{};
+
+  void worker_loop(std::size_t worker_idx);
+  void run_on_workers(std::function<void(std::size_t)> work);
+
+public:
+  parallel_engine(environment& env, std::size_t num_threads);
+  ~parallel_engine();
+
+  parallel_engine(const parallel_engine&) = delete;
+  parallel_engine& operator=(const parallel_engine&) = delete;
+
+  [[nodiscard]] std::size_t num_threads() const { return std::size(workers) + 1; }
+  [[nodiscard]] const domain_partition& domains() const { return partition; }
+
+  /**
+   * Operate every domain for the given number of time quanta after the given clock.
+   * The clock itself is not advanced.
+   */
+  long operate_for(const champsim::chrono::clock& start, champsim::chrono::clock::duration time_quantum, long quanta);
+};
+} // namespace champsim
+
+#endif
@@ -18,8 +18,9 @@
 #define PTW_H
 
 #include <array>
-#include <deque>
+#include <functional>
 #include <limits>   // for numeric_limits
+#include <memory>
 #include <optional> // for optional
 #include <string>
 
@@ -29,6 +30,7 @@
 #include "operable.h"
 #include "ptw_builder.h"
 #include "util/lru_table.h"
+#include "util/packet_pool.h"
 #include "waitable.h"
 
 class VirtualMemory;
@@ -55,8 +57,8 @@ class PageTableWalker : public champsim::operable
     champsim::address v_address{};
     champsim::waitable<champsim::address> data{};
 
-    std::vector<uint64_t> instr_depend_on_me{};
-    std::vector<std::deque<response_type>*> to_return{};
+    champsim::channel::dependency_list_type instr_depend_on_me{};
+    champsim::channel::return_list_type to_return{};
 
     uint32_t pf_metadata = 0;
     uint32_t cpu = std::numeric_limits<uint32_t>::max();
@@ -67,16 +69,19 @@ class PageTableWalker : public champsim::operable
     mshr_type(const request_type& req, std::size_t level);
   };
 
-  std::deque<mshr_type> MSHR;
-  std::deque<mshr_type> finished;
-  std::deque<mshr_type> completed;
+  // The steps of a walk move between these queues by handle, through the pool that they share
+  std::shared_ptr<champsim::packet_pool<mshr_type>> mshr_pool = std::make_shared<champsim::packet_pool<mshr_type>>();
+  champsim::pooled_queue<mshr_type> MSHR{mshr_pool};
+  champsim::pooled_queue<mshr_type> finished{mshr_pool};
+  champsim::pooled_queue<mshr_type> completed{mshr_pool};
 
   std::vector<channel_type*> upper_levels;
   channel_type* lower_level;
 
-  std::optional<mshr_type> handle_read(const request_type& pkt, channel_type* ul);
-  std::optional<mshr_type> handle_fill(const mshr_type& fill_mshr);
-  std::optional<mshr_type> step_translation(const mshr_type& source);
+  void begin_walk(mshr_type& step);
+  bool handle_read(const request_type& pkt, channel_type* ul);
+  bool handle_fill(mshr_type& fill_mshr);
+  static request_type step_packet(const mshr_type& source);
 
   void finish_packet(const response_type& packet);
 
@@ -94,9 +99,23 @@ public:
   explicit PageTableWalker(champsim::ptw_builder builder);
 
   long operate() final;
+  [[nodiscard]] champsim::chrono::clock::time_point next_event_time() const final;
 
   void begin_phase() final;
   void print_deadlock() final;
+
+  void save_checkpoint(std::ostream& os) const final;
+  void restore_checkpoint(std::istream& is) final;
+
+  [[nodiscard]] const std::vector<channel_type*>& upper_channels() const { return upper_levels; }
+
+  /**
+   * Walk the page table for the packet without timing, as for functional warming.
+   * Each page table entry is read through the given function in place of the lower level channel.
+   *
+   * \returns The physical address of the page.
+   */
+  champsim::address functional_walk(const request_type& pkt, const std::function<void(const channel_type*, const request_type&)>& read_entry);
 };
 
 #endif
@@ -28,10 +28,12 @@ public:
   PHYSICAL_REGISTER_ID rename_dest_register(int16_t reg, champsim::program_ordered<ooo_model_instr>::id_type producer_id);
   PHYSICAL_REGISTER_ID rename_src_register(int16_t reg);
   void complete_dest_register(PHYSICAL_REGISTER_ID physreg);
+  void invalidate_dest_register(PHYSICAL_REGISTER_ID physreg);
   void retire_dest_register(PHYSICAL_REGISTER_ID physreg);
   void free_register(PHYSICAL_REGISTER_ID physreg);
   bool isValid(PHYSICAL_REGISTER_ID physreg) const;
   bool isAllocated(PHYSICAL_REGISTER_ID archreg) const;
+  champsim::program_ordered<ooo_model_instr>::id_type producer_id(PHYSICAL_REGISTER_ID physreg) const;
   unsigned long count_free_registers() const;
   int count_reg_dependencies(const ooo_model_instr& instr) const;
   void reset_frontend_RAT();
@@ -17,11 +17,13 @@
 #ifndef REPEATABLE_H
 #define REPEATABLE_H
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <fmt/ranges.h>
 
 #include "instruction.h"
+#include "util/detect.h"
 
 namespace champsim
 {
@@ -38,12 +40,31 @@ struct repeatable {
     // Reopen trace if we've reached the end of the file
     if (intern_.eof()) {
       fmt::print("*** Reached end of trace: {}\n", args_);
-      intern_ = T{std::apply([](auto... x) { return T{x...}; }, args_)};
+      rewind();
     }
 
     return intern_();
   }
 
+  template <typename U>
+  using has_skip = decltype(std::declval<U>().skip(uint64_t{}));
+
+  /**
+   * Discard the given number of instructions. A skip past the end of the trace stops at its end, and the trace begins again after it.
+   */
+  void skip(uint64_t count)
+  {
+    if constexpr (champsim::is_detected_v<has_skip, T>) {
+      intern_.skip(count);
+    } else {
+      for (uint64_t i = 0; i < count && !intern_.eof(); ++i) {
+        intern_();
+      }
+    }
+  }
+
+  void rewind() { intern_ = T{std::apply([](auto... x) { return T{x...}; }, args_)}; }
+
   [[nodiscard]] bool eof() const { return false; }
 };
 } // namespace champsim
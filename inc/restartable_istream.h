@@ -0,0 +1,98 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RESTARTABLE_ISTREAM_H
+#define RESTARTABLE_ISTREAM_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "inf_stream.h"
+#include "trace_index.h"
+
+namespace champsim
+{
+/**
+ * A decompressing stream that skips forward by restarting decompression at the last restart point before the destination.
+ * Streams without restart points are read sequentially.
+ */
+template <typename Tag, typename StreamType = std::ifstream>
+class restartable_istream
+{
+  using stream_type = inf_istream<Tag, StreamType>;
+
+  stream_type stream;
+  std::vector<restart_point> points;
+  uint64_t position = 0; // The number of bytes decompressed so far
+
+protected:
+  StreamType& underlying() { return *stream.underlying; }
+  void set_restart_points(std::vector<restart_point> pts) { points = std::move(pts); }
+
+public:
+  /**
+   * Open the given file, restarting at the points in the index beside it, if there is one.
+   */
+  explicit restartable_istream(std::string s) : restartable_istream(StreamType{s, std::ios::binary}, load_restart_points(s)) {}
+  explicit restartable_istream(StreamType&& str, std::vector<restart_point> pts = {}) : stream(std::move(str)), points(std::move(pts)) {}
+
+  restartable_istream& read(char* s, std::streamsize count)
+  {
+    stream.read(s, count);
+    position += static_cast<uint64_t>(stream.gcount());
+    return *this;
+  }
+
+  /**
+   * Discard the given number of decompressed bytes.
+   */
+  void skip(uint64_t count);
+
+  [[nodiscard]] bool eof() const { return stream.eof(); }
+  [[nodiscard]] std::streamsize gcount() const { return stream.gcount(); }
+  [[nodiscard]] bool seekable() const { return !std::empty(points); }
+};
+
+template <typename Tag, typename StreamType>
+void restartable_istream<Tag, StreamType>::skip(uint64_t count)
+{
+  const auto target = position + count;
+
+  auto point = std::upper_bound(std::cbegin(points), std::cend(points), target, [](uint64_t offset, const auto& x) { return offset < x.decompressed_offset; });
+  if (point != std::cbegin(points) && std::prev(point)->decompressed_offset > position) {
+    // Restart decompression at the last point before the target
+    point = std::prev(point);
+    stream.underlying->clear();
+    stream.underlying->seekg(static_cast<std::streamoff>(point->compressed_offset));
+    stream.buffer = std::make_unique<typename stream_type::template inf_streambuf<StreamType>>(stream.underlying.get());
+    stream.eof_ = false;
+    position = point->decompressed_offset;
+  }
+
+  std::array<char, 1 << 12> discard;
+  while (position < target && !eof()) {
+    read(std::data(discard), static_cast<std::streamsize>(std::min<uint64_t>(std::size(discard), target - position)));
+  }
+}
+} // namespace champsim
+
+#endif
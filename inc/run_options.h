@@ -0,0 +1,38 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RUN_OPTIONS_H
+#define RUN_OPTIONS_H
+
+#include <cstddef>
+#include <string>
+
+namespace champsim
+{
+/**
+ * Options that change how the simulation is carried out, rather than what is simulated.
+ */
+struct run_options {
+  bool skip_idle = false;  // Advance the clock over cycles in which nothing can make progress
+  std::size_t threads = 1; // Threads used to operate the per-core domains. A single thread runs the serial simulation.
+  long sync_interval = 1;  // Time quanta that the per-core domains run between synchronizations with the shared domain
+  std::string save_checkpoint{};    // If not empty, write the warmed state to this file at the end of the warmup
+  std::string restore_checkpoint{}; // If not empty, read the warmed state from this file in place of the warmup
+  bool functional_warmup = false;   // Warm the caches, TLBs, and predictors by walking the traces without timing
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,62 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SAMPLED_STATS_H
+#define SAMPLED_STATS_H
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "cache.h"
+#include "dram_controller.h"
+#include "ooo_cpu.h"
+#include "phase_info.h"
+
+namespace champsim
+{
+/**
+ * The statistics of a sampled simulation, estimated from the weighted phases.
+ */
+struct sampled_stats {
+  struct core {
+    std::string name;
+    double ipc = 0;
+    double branch_mpki = 0;
+  };
+
+  struct cache {
+    std::string name;
+    std::size_t cpu = 0;
+    double mpki = 0; // Demand misses, excluding prefetches
+  };
+
+  double total_weight = 0;
+  std::vector<core> cores{};
+  std::vector<cache> caches{};
+};
+
+/**
+ * Combine the region of interest statistics of every phase that has a weight.
+ * The weights are normalized, so they need not sum to one.
+ *
+ * \returns The combined statistics, or nothing if no phase has a weight.
+ */
+std::optional<sampled_stats> combine_weighted(const std::vector<phase_stats>& stats);
+} // namespace champsim
+
+#endif
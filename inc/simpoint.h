@@ -0,0 +1,62 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SIMPOINT_H
+#define SIMPOINT_H
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "cache.h"
+#include "dram_controller.h"
+#include "ooo_cpu.h"
+#include "phase_info.h"
+
+namespace champsim
+{
+/**
+ * A representative interval of a trace, as chosen by SimPoint.
+ */
+struct simpoint {
+  long long interval; // The index of the interval in the trace
+  double weight;      // The fraction of the trace that this interval represents
+};
+
+/**
+ * Read a SimPoint ``.simpoints`` file and its ``.weights`` file.
+ * Each line of the former is an interval index and a cluster id, and each line of the latter is a weight and a cluster id.
+ *
+ * \returns The points, ordered by their position in the trace.
+ * \throws std::runtime_error If a line cannot be read, or a cluster does not have both an interval and a weight.
+ */
+std::vector<simpoint> read_simpoints(std::istream& simpoints, std::istream& weights);
+
+/**
+ * Build the phases that simulate each point in detail.
+ * Each point is preceded by a warmup phase of up to the given length, and the trace is fast-forwarded over the instructions between them.
+ * The same points are used for every trace.
+ *
+ * :param points: The points, ordered by their position in the trace.
+ * :param interval_length: The number of instructions in each SimPoint interval.
+ * :param warmup_length: The number of instructions to warm up before each point.
+ * :param trace_names: The traces to simulate.
+ */
+std::vector<phase_info> simpoint_phases(const std::vector<simpoint>& points, long long interval_length, long long warmup_length,
+                                        const std::vector<std::string>& trace_names);
+} // namespace champsim
+
+#endif
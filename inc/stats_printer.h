@@ -22,6 +22,7 @@
 #include "dram_controller.h"
 #include "ooo_cpu.h"
 #include "phase_info.h"
+#include "sampled_stats.h"
 
 namespace champsim
 {
@@ -38,6 +39,7 @@ public:
   static std::vector<std::string> format(CACHE::stats_type stats);
   static std::vector<std::string> format(DRAM_CHANNEL::stats_type stats);
   static std::vector<std::string> format(phase_stats& stats);
+  static std::vector<std::string> format(const sampled_stats& stats);
 };
 
 class json_printer
@@ -47,5 +49,6 @@ class json_printer
 public:
   json_printer(std::ostream& str) : stream(str) {}
   void print(std::vector<phase_stats>& stats);
+  void print(std::vector<std::vector<phase_stats>>& stats);
 };
 } // namespace champsim
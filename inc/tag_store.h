@@ -0,0 +1,82 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TAG_STORE_H
+#define TAG_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include "address.h"
+#include "block.h"
+#include "champsim.h"
+
+namespace champsim
+{
+/**
+ * The tags of a cache's blocks, held apart from the blocks so that a set can be searched with vector compares.
+ * Each set's tags, shifted down past the offset bits, are contiguous, as are its valid flags.
+ * Blocks are identified by their index in the cache, that is, the set index times the number of ways plus the way.
+ */
+class tag_store
+{
+  std::vector<uint64_t> tags;
+  std::vector<uint8_t> valid;
+  std::size_t num_way;
+  uint64_t offset_shift;
+
+  [[nodiscard]] std::size_t find_first(std::size_t set, uint64_t tag, bool valid_only) const;
+
+public:
+  tag_store(std::size_t num_set, std::size_t num_way, champsim::data::bits offset_bits);
+
+  [[nodiscard]] uint64_t tag_of(champsim::address addr) const;
+
+  /**
+   * Record the tag and valid flag of the block at the given index.
+   */
+  void assign(std::size_t index, const champsim::cache_block& blk);
+
+  [[nodiscard]] bool is_valid(std::size_t index) const;
+
+  /**
+   * \returns the address of the first byte of the block at the given index.
+   */
+  [[nodiscard]] champsim::address address_of(std::size_t index) const;
+
+  /**
+   * \returns the first valid way in the set that holds the address, or the number of ways if none does.
+   */
+  [[nodiscard]] std::size_t find(std::size_t set, champsim::address addr) const;
+
+  /**
+   * \returns the first way in the set that holds or last held the address, or the number of ways if none does.
+   */
+  [[nodiscard]] std::size_t find_any(std::size_t set, champsim::address addr) const;
+
+  /**
+   * \returns the first invalid way in the set, or the number of ways if all are valid.
+   */
+  [[nodiscard]] std::size_t find_invalid(std::size_t set) const;
+
+  void save_checkpoint(std::ostream& os) const;
+  void restore_checkpoint(std::istream& is);
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,104 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRACE_FANOUT_H
+#define TRACE_FANOUT_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "instruction.h"
+#include "tracereader.h"
+
+namespace champsim
+{
+/**
+ * Shares the instructions of a set of traces between several consumers, so that each trace is decoded only once.
+ *
+ * Instructions are decoded in batches, which are kept until every consumer has read past them.
+ * Batches from different traces are decoded concurrently, by whichever consumers reach them first.
+ * A consumer that gets too far ahead of the slowest one waits for it, unless every other consumer is also waiting.
+ * Each consumer must read from its own thread, and must call release() once it will read no further.
+ */
+class trace_fanout
+{
+public:
+  using batch_type = std::vector<ooo_model_instr>;
+
+  constexpr static std::size_t default_batch_size = 4096;
+  constexpr static std::size_t default_max_lead = 64; // in batches
+
+private:
+  struct source {
+    tracereader reader;
+    std::deque<std::shared_ptr<const batch_type>> batches{};
+    uint64_t first_batch = 0; // The sequence number of the front of the batches
+    bool decoding = false;    // A consumer is reading the next batch from the trace, and holds the reader until it is published
+
+    explicit source(tracereader&& rdr) : reader(std::move(rdr)) {}
+  };
+
+  class cursor
+  {
+    trace_fanout* fanout;
+    std::size_t consumer;
+    std::size_t source_idx;
+    std::shared_ptr<const batch_type> current;
+    std::size_t offset = 0;
+
+  public:
+    cursor(trace_fanout* parent, std::size_t consumer_idx, std::size_t src_idx);
+    ooo_model_instr operator()();
+    [[nodiscard]] bool eof() const { return current == nullptr; }
+  };
+
+  mutable std::mutex mutex{};
+  std::condition_variable batch_taken{};
+  std::vector<source> sources{};
+  std::vector<std::vector<uint64_t>> next_batch; // Indexed by consumer, then by source
+  std::vector<bool> active;
+  std::size_t num_waiting = 0;
+  std::size_t batch_size;
+  std::size_t max_lead;
+
+  std::shared_ptr<const batch_type> take_batch(std::size_t consumer, std::size_t source_idx);
+  [[nodiscard]] uint64_t slowest_batch(std::size_t source_idx) const;
+  [[nodiscard]] std::size_t num_active() const;
+  void trim(std::size_t source_idx);
+
+public:
+  trace_fanout(std::vector<tracereader> traces, std::size_t consumers, std::size_t batch_sz = default_batch_size, std::size_t lead = default_max_lead);
+
+  /**
+   * Get the readers for one consumer, one for each trace in the order they were given.
+   */
+  std::vector<tracereader> readers(std::size_t consumer);
+
+  /**
+   * Indicate that the consumer will read no further, so that the others do not wait for it.
+   */
+  void release(std::size_t consumer);
+
+  [[nodiscard]] std::size_t buffered_batches() const;
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,79 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRACE_INDEX_H
+#define TRACE_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * A point in a compressed stream at which a new decompressor may begin, such as the start of a zstd frame, a gzip member, or an xz stream.
+ */
+struct restart_point {
+  uint64_t decompressed_offset = 0;
+  uint64_t compressed_offset = 0;
+};
+
+/**
+ * The contents of a trace index, which is kept in a file beside the trace that it describes.
+ * Each point names the first instruction that is decompressed from the given offset of the compressed trace.
+ */
+struct trace_index {
+  struct entry {
+    uint64_t instruction = 0;
+    uint64_t compressed_offset = 0;
+  };
+
+  std::size_t record_size = 0;
+  std::vector<entry> entries{};
+
+  /**
+   * \returns The restart points of the index, measured in decompressed bytes.
+   */
+  [[nodiscard]] std::vector<restart_point> restart_points() const;
+};
+
+/**
+ * \returns The name of the index file that describes the given trace.
+ */
+std::string trace_index_name(std::string_view trace_name);
+
+/**
+ * Read an index in the text format written by write_trace_index().
+ *
+ * \throws std::runtime_error if the stream does not hold a trace index.
+ */
+trace_index read_trace_index(std::istream& strm);
+
+void write_trace_index(std::ostream& strm, const trace_index& index);
+
+/**
+ * Read the restart points from the index beside the given trace.
+ *
+ * \returns The restart points, or an empty list if the trace has no index.
+ * \throws std::runtime_error if the index exists but cannot be read.
+ */
+std::vector<restart_point> load_restart_points(std::string_view trace_name);
+} // namespace champsim
+
+#endif
@@ -25,6 +25,9 @@ namespace champsim
 constexpr char REG_STACK_POINTER = 6;
 constexpr char REG_FLAGS = 25;
 constexpr char REG_INSTRUCTION_POINTER = 26;
+
+// version stamped into every record of the value-carrying trace format
+constexpr unsigned char VALUE_TRACE_VERSION = 1;
 } // namespace champsim
 
 // instruction format
@@ -64,6 +67,31 @@ struct cloudsuite_instr {
 
   unsigned char asid[2];
 };
+
+// The leading members are laid out exactly as in input_instr, so a value trace can be truncated to a legacy trace record by record.
+struct value_instr {
+  // instruction pointer or PC (Program Counter)
+  unsigned long long ip;
+
+  // branch info
+  unsigned char is_branch;
+  unsigned char branch_taken;
+
+  unsigned char destination_registers[NUM_INSTR_DESTINATIONS]; // output registers
+  unsigned char source_registers[NUM_INSTR_SOURCES];           // input registers
+
+  unsigned long long destination_memory[NUM_INSTR_DESTINATIONS]; // output memory
+  unsigned long long source_memory[NUM_INSTR_SOURCES];           // input memory
+
+  unsigned char version; // champsim::VALUE_TRACE_VERSION
+
+  unsigned char destination_memory_size[NUM_INSTR_DESTINATIONS]; // bytes written to each output memory location
+  unsigned char source_memory_size[NUM_INSTR_SOURCES];           // bytes read from each input memory location
+
+  unsigned long long destination_register_values[NUM_INSTR_DESTINATIONS]; // low 64 bits of each output register after execution
+  unsigned long long destination_memory_values[NUM_INSTR_DESTINATIONS];   // store data
+  unsigned long long source_memory_values[NUM_INSTR_SOURCES];             // load data
+};
 // NOLINTEND(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
 
 #endif
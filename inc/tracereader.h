@@ -17,25 +17,38 @@
 #ifndef TRACEREADER_H
 #define TRACEREADER_H
 
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <deque>
 #include <memory>
 #include <numeric>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <vector>
 
+#include "compact_trace.h"
 #include "instruction.h"
 #include "util/detect.h"
 
 namespace champsim
 {
+/**
+ * The on-disk record formats that a trace may be stored in.
+ */
+enum class trace_format { input, cloudsuite, value, cvp, compact };
+
 class tracereader
 {
-  static uint64_t instr_unique_id; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  static thread_local uint64_t instr_unique_id; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
   struct reader_concept {
     virtual ~reader_concept() = default;
     virtual ooo_model_instr operator()() = 0;
     [[nodiscard]] virtual bool eof() const = 0;
+    virtual void skip(uint64_t count) = 0;
+    virtual void rewind() = 0;
   };
 
   template <typename T>
@@ -46,6 +59,12 @@ class tracereader
     template <typename U>
     using has_eof = decltype(std::declval<U>().eof());
 
+    template <typename U>
+    using has_skip = decltype(std::declval<U>().skip(uint64_t{}));
+
+    template <typename U>
+    using has_rewind = decltype(std::declval<U>().rewind());
+
     ooo_model_instr operator()() override { return intern_(); }
     [[nodiscard]] bool eof() const override
     {
@@ -54,9 +73,30 @@ class tracereader
       }
       return false; // If an eof() member function is not provided, assume the trace never ends.
     }
+
+    void skip(uint64_t count) override
+    {
+      if constexpr (champsim::is_detected_v<has_skip, T>) {
+        intern_.skip(count);
+      } else {
+        for (uint64_t i = 0; i < count && !eof(); ++i) {
+          intern_();
+        }
+      }
+    }
+
+    void rewind() override
+    {
+      if constexpr (champsim::is_detected_v<has_rewind, T>) {
+        intern_.rewind();
+      } else {
+        throw std::logic_error{"This trace cannot return to its beginning"};
+      }
+    }
   };
 
   std::unique_ptr<reader_concept> pimpl_;
+  uint64_t position = 0; // The number of instructions that have been read or skipped
 
 public:
   template <typename T, std::enable_if_t<!std::is_same_v<tracereader, T>, bool> = true>
@@ -68,10 +108,41 @@ public:
   {
     auto retval = (*pimpl_)();
     retval.instr_id = instr_unique_id++;
+    ++position;
     return retval;
   }
 
   [[nodiscard]] auto eof() const { return pimpl_->eof(); }
+
+  /**
+   * Discard the given number of instructions without numbering them, such as those that were skipped between SimPoints.
+   * Readers that provide a skip() member function may do so without decoding the instructions.
+   */
+  void skip(uint64_t count)
+  {
+    pimpl_->skip(count);
+    position += count;
+  }
+
+  /**
+   * Move to the given instruction of the trace, counted from its beginning, such as the first one that had not retired before a checkpoint.
+   * Seeking backward is only possible for readers that provide a rewind() member function.
+   *
+   * \throws std::logic_error if the instruction is behind the current one and the reader cannot return to its beginning.
+   */
+  void seek(uint64_t instr_count)
+  {
+    if (instr_count < position) {
+      pimpl_->rewind();
+      position = 0;
+    }
+    skip(instr_count - position);
+  }
+
+  /**
+   * \returns The number of instructions that have been read or skipped since the beginning of the trace.
+   */
+  [[nodiscard]] uint64_t tell() const { return position; }
 };
 
 template <typename T, typename F>
@@ -88,8 +159,12 @@ class bulk_tracereader
   constexpr static std::size_t refresh_thresh = 1;
   std::deque<ooo_model_instr> instr_buffer;
 
+  template <typename U>
+  using has_skip = decltype(std::declval<U>().skip(uint64_t{}));
+
 public:
   ooo_model_instr operator()();
+  void skip(uint64_t count);
 
   bulk_tracereader(uint8_t cpu_idx, std::string tf) : cpu(cpu_idx), trace_file(tf) {}
   bulk_tracereader(uint8_t cpu_idx, F&& file) : cpu(cpu_idx), trace_file(std::move(file)) {}
@@ -138,9 +213,131 @@ ooo_model_instr bulk_tracereader<T, F>::operator()()
   return retval;
 }
 
+template <typename T, typename F>
+void bulk_tracereader<T, F>::skip(uint64_t count)
+{
+  // Instructions that were already decoded are dropped first
+  auto buffered = std::min<uint64_t>(count, std::size(instr_buffer));
+  instr_buffer.erase(std::begin(instr_buffer), std::next(std::begin(instr_buffer), static_cast<long>(buffered)));
+  count -= buffered;
+
+  if constexpr (champsim::is_detected_v<has_skip, F>) {
+    trace_file.skip(count * sizeof(T));
+  } else {
+    for (uint64_t i = 0; i < count && !eof(); ++i) {
+      (*this)();
+    }
+  }
+}
+
+/**
+ * A reader for traces in the compact format, which holds the same instructions as the input_instr format in a variable-length encoding.
+ * The records are decoded as they are streamed from the file, since each is coded against the ones before it.
+ */
+template <typename F>
+class compact_tracereader
+{
+  uint8_t cpu;
+  F trace_file;
+  compact::decoder decoder{};
+  bool exhausted = false;
+
+  constexpr static std::size_t read_size = 1 << 16;
+  constexpr static std::size_t refresh_thresh = 1;
+  std::vector<unsigned char> raw_buffer{}; // bytes that have been read but not yet decoded
+  std::deque<ooo_model_instr> instr_buffer{};
+
+  void check_magic();
+  void refill();
+
+public:
+  ooo_model_instr operator()();
+
+  /**
+   * \throws std::runtime_error if the file does not begin with the magic number of the compact format.
+   */
+  compact_tracereader(uint8_t cpu_idx, std::string tf) : cpu(cpu_idx), trace_file(tf) { check_magic(); }
+  compact_tracereader(uint8_t cpu_idx, F&& file) : cpu(cpu_idx), trace_file(std::move(file)) { check_magic(); }
+
+  // Like bulk_tracereader, the last record only supplies the branch target of the one before it
+  [[nodiscard]] bool eof() const { return exhausted && std::size(instr_buffer) <= refresh_thresh; }
+};
+
+template <typename F>
+void compact_tracereader<F>::check_magic()
+{
+  std::array<char, std::size(compact::magic)> header;
+  trace_file.read(std::data(header), std::size(header));
+  if (static_cast<std::size_t>(trace_file.gcount()) != std::size(header)
+      || !std::equal(std::begin(header), std::end(header), std::begin(compact::magic),
+                     [](char x, unsigned char y) { return static_cast<unsigned char>(x) == y; })) {
+    throw std::runtime_error{"Trace is not in the compact format"};
+  }
+
+  refill();
+}
+
+template <typename F>
+void compact_tracereader<F>::refill()
+{
+  auto old_count = std::size(instr_buffer);
+  while (std::size(instr_buffer) <= refresh_thresh && !exhausted) {
+    // Read more of the file behind the bytes that are left over
+    auto old_size = std::size(raw_buffer);
+    raw_buffer.resize(old_size + read_size);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    trace_file.read(reinterpret_cast<char*>(std::data(raw_buffer) + old_size), static_cast<std::streamsize>(read_size));
+    raw_buffer.resize(old_size + static_cast<std::size_t>(trace_file.gcount()));
+    exhausted = trace_file.eof() || trace_file.gcount() == 0;
+
+    // Decode every complete record
+    std::size_t decoded_bytes = 0;
+    const auto* raw_end = std::data(raw_buffer) + std::size(raw_buffer);
+    for (auto decoded = decoder.decode(std::data(raw_buffer), raw_end); decoded.has_value();
+         decoded = decoder.decode(std::data(raw_buffer) + decoded_bytes, raw_end)) {
+      instr_buffer.emplace_back(cpu, decoded->first);
+      decoded_bytes += decoded->second;
+    }
+    raw_buffer.erase(std::begin(raw_buffer), std::next(std::begin(raw_buffer), static_cast<std::ptrdiff_t>(decoded_bytes)));
+  }
+
+  // The last instruction that was held back receives its branch target from the first new one
+  auto begin = std::next(std::begin(instr_buffer), static_cast<std::ptrdiff_t>(old_count > 0 ? old_count - 1 : 0));
+  set_branch_targets(begin, std::end(instr_buffer));
+}
+
+template <typename F>
+ooo_model_instr compact_tracereader<F>::operator()()
+{
+  if (std::size(instr_buffer) <= refresh_thresh) {
+    refill();
+  }
+
+  auto retval = instr_buffer.front();
+  instr_buffer.pop_front();
+
+  return retval;
+}
+
 std::string get_fptr_cmd(std::string_view fname);
+
+/**
+ * Determine whether a trace is named as a compressed trace, by the same suffixes that select its decompressor.
+ */
+bool is_compressed_trace_name(std::string_view fname);
+
+/**
+ * Determine whether a trace is named as a CVP-1 trace, that is, with a .cvp extension before any compression extension.
+ */
+bool is_cvp_trace_name(std::string_view fname);
+
+/**
+ * Determine whether a trace is named as a compact trace, that is, with a .cst extension before any compression extension.
+ */
+bool is_compact_trace_name(std::string_view fname);
 } // namespace champsim
 
+champsim::tracereader get_tracereader(const std::string& fname, uint8_t cpu, champsim::trace_format format, bool repeat);
 champsim::tracereader get_tracereader(const std::string& fname, uint8_t cpu, bool is_cloudsuite, bool repeat);
 
 #endif
@@ -0,0 +1,295 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTIL_CIRCULAR_BUFFER_H
+#define UTIL_CIRCULAR_BUFFER_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * A double-ended queue whose elements are held in a ring of slots allocated up front.
+ *
+ * Elements never move while they are in the buffer, so references to them remain valid until they are removed,
+ * and the position of an element is a fixed offset from the head of the ring.
+ * Adding an element to a full buffer doubles its capacity, which moves every element as std::vector would,
+ * unless the buffer was built not to grow.
+ */
+template <typename T>
+class circular_buffer
+{
+  std::vector<std::optional<T>> slots;
+  std::size_t head = 0;
+  std::size_t count = 0;
+  std::size_t num_popped = 0;
+  bool growable = true;
+
+  [[nodiscard]] std::size_t slot_of(std::size_t pos) const
+  {
+    auto idx = head + pos;
+    return idx < std::size(slots) ? idx : idx - std::size(slots);
+  }
+
+  void grow()
+  {
+    std::vector<std::optional<T>> new_slots(std::max<std::size_t>(2 * std::size(slots), 1));
+    for (std::size_t i = 0; i < count; ++i) {
+      new_slots[i] = std::move(slots[slot_of(i)]);
+    }
+    slots = std::move(new_slots);
+    head = 0;
+  }
+
+  template <bool Const>
+  class iterator_base
+  {
+    using buffer_type = std::conditional_t<Const, const circular_buffer, circular_buffer>;
+    buffer_type* buffer = nullptr;
+    std::ptrdiff_t pos = 0;
+
+    friend class circular_buffer;
+    friend class iterator_base<!Const>;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+
+    iterator_base() = default;
+    iterator_base(buffer_type* buf, std::ptrdiff_t p) : buffer(buf), pos(p) {}
+
+    template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+    iterator_base(const iterator_base<OtherConst>& other) : buffer(other.buffer), pos(other.pos) // NOLINT(google-explicit-constructor)
+    {
+    }
+
+    reference operator*() const { return (*buffer)[static_cast<std::size_t>(pos)]; }
+    pointer operator->() const { return &(**this); }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    iterator_base& operator++()
+    {
+      ++pos;
+      return *this;
+    }
+    iterator_base operator++(int)
+    {
+      auto retval = *this;
+      ++(*this);
+      return retval;
+    }
+    iterator_base& operator--()
+    {
+      --pos;
+      return *this;
+    }
+    iterator_base operator--(int)
+    {
+      auto retval = *this;
+      --(*this);
+      return retval;
+    }
+    iterator_base& operator+=(difference_type n)
+    {
+      pos += n;
+      return *this;
+    }
+    iterator_base& operator-=(difference_type n)
+    {
+      pos -= n;
+      return *this;
+    }
+
+    friend iterator_base operator+(iterator_base it, difference_type n) { return it += n; }
+    friend iterator_base operator+(difference_type n, iterator_base it) { return it += n; }
+    friend iterator_base operator-(iterator_base it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos - rhs.pos; }
+
+    friend bool operator==(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos == rhs.pos; }
+    friend bool operator!=(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos != rhs.pos; }
+    friend bool operator<(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos < rhs.pos; }
+    friend bool operator>(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos > rhs.pos; }
+    friend bool operator<=(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos <= rhs.pos; }
+    friend bool operator>=(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos >= rhs.pos; }
+  };
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = iterator_base<false>;
+  using const_iterator = iterator_base<true>;
+
+  /**
+   * A handle identifies an element for as long as it is in the buffer, while elements are added, elements are removed from the front,
+   * or the buffer grows. Removing elements elsewhere changes the handles of the elements after them.
+   */
+  using handle_type = std::size_t;
+
+  /**
+   * Whether adding an element to a full buffer grows it, or is an error. A buffer that does not grow keeps references to its elements valid.
+   */
+  enum class overflow { grow, error };
+
+  explicit circular_buffer(std::size_t capacity = 0, overflow on_overflow = overflow::grow) : slots(capacity), growable(on_overflow == overflow::grow) {}
+
+  [[nodiscard]] iterator begin() { return {this, 0}; }
+  [[nodiscard]] const_iterator begin() const { return {this, 0}; }
+  [[nodiscard]] const_iterator cbegin() const { return begin(); }
+  [[nodiscard]] iterator end() { return {this, static_cast<difference_type>(count)}; }
+  [[nodiscard]] const_iterator end() const { return {this, static_cast<difference_type>(count)}; }
+  [[nodiscard]] const_iterator cend() const { return end(); }
+
+  [[nodiscard]] size_type size() const { return count; }
+  [[nodiscard]] bool empty() const { return count == 0; }
+  [[nodiscard]] size_type capacity() const { return std::size(slots); }
+  [[nodiscard]] bool full() const { return count == std::size(slots); }
+
+  reference operator[](size_type pos) { return *slots[slot_of(pos)]; }
+  const_reference operator[](size_type pos) const { return *slots[slot_of(pos)]; }
+  reference front() { return (*this)[0]; }
+  const_reference front() const { return (*this)[0]; }
+  reference back() { return (*this)[count - 1]; }
+  const_reference back() const { return (*this)[count - 1]; }
+
+  [[nodiscard]] handle_type handle(const_iterator pos) const { return num_popped + static_cast<handle_type>(pos.pos); }
+
+  /**
+   * \returns an iterator to the element with the given handle, or the end of the buffer if it is no longer present.
+   */
+  [[nodiscard]] iterator find(handle_type target)
+  {
+    if (target < num_popped || target - num_popped >= count) {
+      return end();
+    }
+    return std::next(begin(), static_cast<difference_type>(target - num_popped));
+  }
+
+  /**
+   * \throws std::out_of_range if the position is not less than the size.
+   */
+  reference at(size_type pos)
+  {
+    if (pos >= count) {
+      throw std::out_of_range{"circular_buffer::at"};
+    }
+    return (*this)[pos];
+  }
+
+  const_reference at(size_type pos) const
+  {
+    if (pos >= count) {
+      throw std::out_of_range{"circular_buffer::at"};
+    }
+    return (*this)[pos];
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  /**
+   * \throws std::length_error if the buffer is full and was built not to grow.
+   */
+  template <typename... Args>
+  reference emplace_back(Args&&... args)
+  {
+    if (full()) {
+      if (!growable) {
+        throw std::length_error{"circular_buffer::emplace_back"};
+      }
+      grow();
+    }
+    slots[slot_of(count)].emplace(std::forward<Args>(args)...);
+    ++count;
+    return back();
+  }
+
+  void pop_front()
+  {
+    assert(!empty());
+    slots[head].reset();
+    head = slot_of(1);
+    --count;
+    ++num_popped;
+  }
+
+  void pop_back()
+  {
+    assert(!empty());
+    slots[slot_of(count - 1)].reset();
+    --count;
+  }
+
+  void clear()
+  {
+    while (!empty()) {
+      pop_back();
+    }
+  }
+
+  /**
+   * Insert the elements of the range before the given position.
+   * Insertion at the end does not move the existing elements.
+   */
+  template <typename It>
+  iterator insert(const_iterator pos, It first, It last)
+  {
+    const auto offset = pos.pos;
+    const auto old_size = static_cast<difference_type>(count);
+    std::for_each(first, last, [this](const auto& x) { this->push_back(x); });
+    std::rotate(std::next(begin(), offset), std::next(begin(), old_size), end());
+    return std::next(begin(), offset);
+  }
+
+  /**
+   * Remove the elements in the range.
+   * Removal from the front does not move the remaining elements.
+   */
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    const auto offset = first.pos;
+    auto num_erased = last - first;
+    if (offset == 0) {
+      for (; num_erased > 0; --num_erased) {
+        pop_front();
+      }
+    } else {
+      std::move(std::next(begin(), last.pos), end(), std::next(begin(), offset));
+      for (; num_erased > 0; --num_erased) {
+        pop_back();
+      }
+    }
+    return std::next(begin(), offset);
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, std::next(pos)); }
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,155 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTIL_INLINE_VECTOR_H
+#define UTIL_INLINE_VECTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace champsim
+{
+/**
+ * A sequence container with the interface of std::vector, whose elements are stored inline up to a fixed capacity.
+ * It never allocates, and is trivially copyable if its elements are.
+ */
+template <typename T, std::size_t N>
+class inline_vector
+{
+  static_assert(std::is_default_constructible_v<T>);
+
+  std::array<T, N> data_{};
+  std::size_t size_ = 0;
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  inline_vector() = default;
+  inline_vector(std::initializer_list<T> init) { assign(std::begin(init), std::end(init)); }
+
+  template <typename It>
+  inline_vector(It first, It last)
+  {
+    assign(first, last);
+  }
+
+  inline_vector& operator=(std::initializer_list<T> init)
+  {
+    assign(std::begin(init), std::end(init));
+    return *this;
+  }
+
+  template <typename It>
+  void assign(It first, It last)
+  {
+    clear();
+    std::copy(first, last, std::back_inserter(*this));
+  }
+
+  [[nodiscard]] iterator begin() { return std::data(data_); }
+  [[nodiscard]] const_iterator begin() const { return std::data(data_); }
+  [[nodiscard]] const_iterator cbegin() const { return begin(); }
+  [[nodiscard]] iterator end() { return std::next(begin(), static_cast<difference_type>(size_)); }
+  [[nodiscard]] const_iterator end() const { return std::next(begin(), static_cast<difference_type>(size_)); }
+  [[nodiscard]] const_iterator cend() const { return end(); }
+
+  [[nodiscard]] pointer data() { return std::data(data_); }
+  [[nodiscard]] const_pointer data() const { return std::data(data_); }
+  [[nodiscard]] size_type size() const { return size_; }
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+  [[nodiscard]] constexpr static size_type capacity() { return N; }
+  [[nodiscard]] constexpr static size_type max_size() { return N; }
+
+  reference operator[](size_type pos) { return data_[pos]; }
+  const_reference operator[](size_type pos) const { return data_[pos]; }
+  reference front() { return data_.front(); }
+  const_reference front() const { return data_.front(); }
+  reference back() { return data_[size_ - 1]; }
+  const_reference back() const { return data_[size_ - 1]; }
+
+  /**
+   * \throws std::out_of_range if the position is not less than the size.
+   */
+  reference at(size_type pos)
+  {
+    if (pos >= size_) {
+      throw std::out_of_range{"inline_vector::at"};
+    }
+    return data_[pos];
+  }
+
+  const_reference at(size_type pos) const
+  {
+    if (pos >= size_) {
+      throw std::out_of_range{"inline_vector::at"};
+    }
+    return data_[pos];
+  }
+
+  /**
+   * \throws std::length_error if the container is full.
+   */
+  void push_back(const T& value)
+  {
+    if (size_ == N) {
+      throw std::length_error{"inline_vector::push_back"};
+    }
+    data_[size_++] = value;
+  }
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args)
+  {
+    push_back(T{std::forward<Args>(args)...});
+    return back();
+  }
+
+  void pop_back() { --size_; }
+  void clear() { size_ = 0; }
+
+  iterator erase(const_iterator pos) { return erase(pos, std::next(pos)); }
+
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    auto dest = std::next(begin(), std::distance(cbegin(), first));
+    auto new_end = std::copy(last, cend(), dest);
+    size_ = static_cast<size_type>(std::distance(begin(), new_end));
+    return dest;
+  }
+
+  friend bool operator==(const inline_vector& lhs, const inline_vector& rhs)
+  {
+    return std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs));
+  }
+  friend bool operator!=(const inline_vector& lhs, const inline_vector& rhs) { return !(lhs == rhs); }
+};
+} // namespace champsim
+
+#endif
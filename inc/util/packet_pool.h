@@ -0,0 +1,503 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTIL_PACKET_POOL_H
+#define UTIL_PACKET_POOL_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "util/circular_buffer.h"
+
+namespace champsim
+{
+/**
+ * A store of records that are named by small integer handles.
+ *
+ * Released records are reused before new ones are made, so a pool that has reached the most records it holds at once makes no further allocation.
+ * A record does not move while it is held, so references to it remain valid until it is released, even as other records are acquired.
+ */
+template <typename T>
+class packet_pool
+{
+public:
+  using value_type = T;
+  using handle_type = uint32_t;
+
+private:
+  std::deque<std::optional<T>> slots;
+  std::vector<handle_type> free_handles;
+
+public:
+  explicit packet_pool(std::size_t capacity = 0) : slots(capacity)
+  {
+    free_handles.reserve(capacity);
+    for (auto handle = static_cast<handle_type>(capacity); handle > 0; --handle) {
+      free_handles.push_back(handle - 1);
+    }
+  }
+
+  /**
+   * Construct a record in place.
+   *
+   * \throws std::length_error if the pool holds as many records as there are handles.
+   */
+  template <typename... Args>
+  handle_type acquire(Args&&... args)
+  {
+    handle_type handle;
+    if (std::empty(free_handles)) {
+      if (std::size(slots) > std::numeric_limits<handle_type>::max()) {
+        throw std::length_error{"packet_pool::acquire"};
+      }
+      handle = static_cast<handle_type>(std::size(slots));
+      slots.emplace_back();
+    } else {
+      handle = free_handles.back();
+      free_handles.pop_back();
+    }
+    slots[handle].emplace(std::forward<Args>(args)...);
+    return handle;
+  }
+
+  void release(handle_type handle)
+  {
+    assert(slots[handle].has_value());
+    slots[handle].reset();
+    free_handles.push_back(handle);
+  }
+
+  T& operator[](handle_type handle) { return *slots[handle]; }
+  const T& operator[](handle_type handle) const { return *slots[handle]; }
+
+  /**
+   * \returns the number of records that are held.
+   */
+  [[nodiscard]] std::size_t size() const { return std::size(slots) - std::size(free_handles); }
+};
+
+/**
+ * A double-ended queue of records held in a packet_pool, which may be shared with other queues.
+ *
+ * The queue is a ring of handles, so that reordering or removing its entries moves the handles and not the records.
+ * Queues that share a pool pass records between them by handle with transfer() and transfer_if().
+ */
+template <typename T>
+class pooled_queue
+{
+public:
+  using pool_type = packet_pool<T>;
+  using handle_type = typename pool_type::handle_type;
+
+private:
+  std::shared_ptr<pool_type> pool;
+  champsim::circular_buffer<handle_type> ring;
+  std::vector<handle_type> scratch{};
+
+  template <bool Const>
+  class iterator_base
+  {
+    using queue_type = std::conditional_t<Const, const pooled_queue, pooled_queue>;
+    queue_type* queue = nullptr;
+    std::ptrdiff_t pos = 0;
+
+    friend class pooled_queue;
+    friend class iterator_base<!Const>;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+
+    iterator_base() = default;
+    iterator_base(queue_type* q, std::ptrdiff_t p) : queue(q), pos(p) {}
+
+    template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+    iterator_base(const iterator_base<OtherConst>& other) : queue(other.queue), pos(other.pos) // NOLINT(google-explicit-constructor)
+    {
+    }
+
+    reference operator*() const { return (*queue)[static_cast<std::size_t>(pos)]; }
+    pointer operator->() const { return &(**this); }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    iterator_base& operator++()
+    {
+      ++pos;
+      return *this;
+    }
+    iterator_base operator++(int)
+    {
+      auto retval = *this;
+      ++(*this);
+      return retval;
+    }
+    iterator_base& operator--()
+    {
+      --pos;
+      return *this;
+    }
+    iterator_base operator--(int)
+    {
+      auto retval = *this;
+      --(*this);
+      return retval;
+    }
+    iterator_base& operator+=(difference_type n)
+    {
+      pos += n;
+      return *this;
+    }
+    iterator_base& operator-=(difference_type n)
+    {
+      pos -= n;
+      return *this;
+    }
+
+    friend iterator_base operator+(iterator_base it, difference_type n) { return it += n; }
+    friend iterator_base operator+(difference_type n, iterator_base it) { return it += n; }
+    friend iterator_base operator-(iterator_base it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos - rhs.pos; }
+
+    friend bool operator==(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos == rhs.pos; }
+    friend bool operator!=(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos != rhs.pos; }
+    friend bool operator<(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos < rhs.pos; }
+    friend bool operator>(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos > rhs.pos; }
+    friend bool operator<=(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos <= rhs.pos; }
+    friend bool operator>=(const iterator_base& lhs, const iterator_base& rhs) { return lhs.pos >= rhs.pos; }
+  };
+
+  [[nodiscard]] auto ring_at(std::ptrdiff_t pos) const { return std::next(std::begin(ring), pos); }
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = iterator_base<false>;
+  using const_iterator = iterator_base<true>;
+
+  /**
+   * Build a queue with a pool of its own, with room for the given number of records.
+   */
+  explicit pooled_queue(std::size_t capacity = 0) : pooled_queue(std::make_shared<pool_type>(capacity), capacity) {}
+
+  /**
+   * Build a queue whose records are held in the given pool.
+   */
+  explicit pooled_queue(std::shared_ptr<pool_type> shared_pool, std::size_t capacity = 0) : pool(std::move(shared_pool)), ring(capacity) {}
+
+  // A copy holds copies of the records in a pool of its own
+  pooled_queue(const pooled_queue& other) : pooled_queue(std::size(other))
+  {
+    for (const auto& x : other) {
+      push_back(x);
+    }
+  }
+
+  pooled_queue(pooled_queue&& other) noexcept : pool(std::move(other.pool)), ring(std::exchange(other.ring, champsim::circular_buffer<handle_type>{})) {}
+
+  pooled_queue& operator=(const pooled_queue& other)
+  {
+    if (this != &other) {
+      *this = pooled_queue{other};
+    }
+    return *this;
+  }
+
+  pooled_queue& operator=(pooled_queue&& other) noexcept
+  {
+    if (this != &other) {
+      if (pool != nullptr) {
+        clear();
+      }
+      pool = std::move(other.pool);
+      ring = std::exchange(other.ring, champsim::circular_buffer<handle_type>{});
+    }
+    return *this;
+  }
+
+  ~pooled_queue()
+  {
+    if (pool != nullptr) {
+      clear();
+    }
+  }
+
+  [[nodiscard]] iterator begin() { return {this, 0}; }
+  [[nodiscard]] const_iterator begin() const { return {this, 0}; }
+  [[nodiscard]] const_iterator cbegin() const { return begin(); }
+  [[nodiscard]] iterator end() { return {this, static_cast<difference_type>(std::size(ring))}; }
+  [[nodiscard]] const_iterator end() const { return {this, static_cast<difference_type>(std::size(ring))}; }
+  [[nodiscard]] const_iterator cend() const { return end(); }
+
+  [[nodiscard]] size_type size() const { return std::size(ring); }
+  [[nodiscard]] bool empty() const { return std::empty(ring); }
+
+  reference operator[](size_type pos) { return (*pool)[ring[pos]]; }
+  const_reference operator[](size_type pos) const { return (*pool)[ring[pos]]; }
+  reference front() { return (*this)[0]; }
+  const_reference front() const { return (*this)[0]; }
+  reference back() { return (*this)[size() - 1]; }
+  const_reference back() const { return (*this)[size() - 1]; }
+
+  /**
+   * \throws std::out_of_range if the position is not less than the size.
+   */
+  reference at(size_type pos)
+  {
+    if (pos >= size()) {
+      throw std::out_of_range{"pooled_queue::at"};
+    }
+    return (*this)[pos];
+  }
+
+  const_reference at(size_type pos) const
+  {
+    if (pos >= size()) {
+      throw std::out_of_range{"pooled_queue::at"};
+    }
+    return (*this)[pos];
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  /**
+   * Construct a record in the pool, at the back of the queue.
+   */
+  template <typename... Args>
+  reference emplace_back(Args&&... args)
+  {
+    ring.push_back(pool->acquire(std::forward<Args>(args)...));
+    return back();
+  }
+
+  void pop_front()
+  {
+    pool->release(ring.front());
+    ring.pop_front();
+  }
+
+  void pop_back()
+  {
+    pool->release(ring.back());
+    ring.pop_back();
+  }
+
+  void clear()
+  {
+    while (!empty()) {
+      pop_back();
+    }
+  }
+
+  /**
+   * Remove the entries in the range, releasing their records.
+   */
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    for (auto pos = first.pos; pos != last.pos; ++pos) {
+      pool->release(*ring_at(pos));
+    }
+    ring.erase(ring_at(first.pos), ring_at(last.pos));
+    return {this, first.pos};
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, std::next(pos)); }
+
+  /**
+   * Move the entries in the range to the back of a queue that shares this pool, in order.
+   */
+  void transfer(const_iterator first, const_iterator last, pooled_queue& destination)
+  {
+    assert(destination.pool == pool);
+    for (auto pos = first.pos; pos != last.pos; ++pos) {
+      destination.ring.push_back(*ring_at(pos));
+    }
+    ring.erase(ring_at(first.pos), ring_at(last.pos));
+  }
+
+  /**
+   * Move the entries in the range for which the predicate holds to the back of a queue that shares this pool.
+   * The entries that remain keep their order.
+   *
+   * \returns an iterator past the entries of the range that remain.
+   */
+  template <typename F>
+  iterator transfer_if(const_iterator first, const_iterator last, pooled_queue& destination, F&& func)
+  {
+    assert(destination.pool == pool);
+    auto kept = first.pos;
+    for (auto pos = first.pos; pos != last.pos; ++pos) {
+      auto handle = *ring_at(pos);
+      if (func(std::as_const((*pool)[handle]))) {
+        destination.ring.push_back(handle);
+      } else {
+        ring[static_cast<size_type>(kept++)] = handle;
+      }
+    }
+    ring.erase(ring_at(kept), ring_at(last.pos));
+    return {this, kept};
+  }
+
+  /**
+   * Order the entries in the range so that those for which the predicate holds come first, keeping the relative order of each group.
+   * The predicate is applied to each entry exactly once, in order, and may change the entry or acquire records from the pool.
+   *
+   * \returns an iterator to the first entry for which the predicate does not hold.
+   */
+  template <typename F>
+  iterator stable_partition(iterator first, iterator last, F&& func)
+  {
+    scratch.clear();
+    auto kept = first.pos;
+    for (auto pos = first.pos; pos != last.pos; ++pos) {
+      auto handle = *ring_at(pos);
+      if (func((*pool)[handle])) {
+        ring[static_cast<size_type>(kept++)] = handle;
+      } else {
+        scratch.push_back(handle);
+      }
+    }
+    std::copy(std::cbegin(scratch), std::cend(scratch), std::next(std::begin(ring), kept));
+    return {this, kept};
+  }
+
+  /**
+   * \returns the handle of the entry's record, which names it in the pool for as long as it is held, wherever the entry moves.
+   */
+  [[nodiscard]] handle_type handle_at(const_iterator pos) const { return *ring_at(pos.pos); }
+
+  /**
+   * Exchange the positions of two entries.
+   */
+  void swap_entries(const_iterator lhs, const_iterator rhs) { std::iter_swap(std::next(std::begin(ring), lhs.pos), std::next(std::begin(ring), rhs.pos)); }
+};
+
+/**
+ * A slot that holds a record in a packet_pool, or nothing, with the interface of std::optional.
+ * Arrays of these keep their records in a pool that may be shared with other arrays.
+ */
+template <typename T>
+class pooled_slot
+{
+public:
+  using pool_type = packet_pool<T>;
+  using handle_type = typename pool_type::handle_type;
+  using value_type = T;
+
+private:
+  std::shared_ptr<pool_type> pool;
+  std::optional<handle_type> handle{};
+
+public:
+  explicit pooled_slot(std::shared_ptr<pool_type> shared_pool) : pool(std::move(shared_pool)) {}
+
+  // A copy holds a copy of the record in the same pool
+  pooled_slot(const pooled_slot& other) : pool(other.pool)
+  {
+    if (other.has_value()) {
+      emplace(*other);
+    }
+  }
+
+  // A move takes the record, and leaves the other slot empty in the same pool so that it can be filled again
+  pooled_slot(pooled_slot&& other) noexcept : pool(other.pool), handle(std::exchange(other.handle, std::nullopt)) {}
+
+  pooled_slot& operator=(const pooled_slot& other)
+  {
+    if (this != &other) {
+      if (other.has_value()) {
+        emplace(*other);
+      } else {
+        reset();
+      }
+    }
+    return *this;
+  }
+
+  pooled_slot& operator=(pooled_slot&& other) noexcept
+  {
+    if (this != &other) {
+      reset();
+      pool = other.pool;
+      handle = std::exchange(other.handle, std::nullopt);
+    }
+    return *this;
+  }
+
+  pooled_slot& operator=(const T& value)
+  {
+    emplace(value);
+    return *this;
+  }
+
+  pooled_slot& operator=(T&& value)
+  {
+    emplace(std::move(value));
+    return *this;
+  }
+
+  ~pooled_slot() { reset(); }
+
+  [[nodiscard]] bool has_value() const { return handle.has_value(); }
+  explicit operator bool() const { return has_value(); }
+
+  T& value() { return (*pool)[handle.value()]; }
+  const T& value() const { return (*pool)[handle.value()]; }
+  T& operator*() { return (*pool)[*handle]; }
+  const T& operator*() const { return (*pool)[*handle]; }
+  T* operator->() { return &**this; }
+  const T* operator->() const { return &**this; }
+
+  /**
+   * Construct a record in the pool, releasing the record that was held.
+   */
+  template <typename... Args>
+  T& emplace(Args&&... args)
+  {
+    auto acquired = pool->acquire(std::forward<Args>(args)...);
+    reset();
+    handle = acquired;
+    return **this;
+  }
+
+  void reset()
+  {
+    if (handle.has_value()) {
+      pool->release(*handle);
+      handle.reset();
+    }
+  }
+};
+} // namespace champsim
+
+#endif
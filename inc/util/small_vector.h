@@ -0,0 +1,179 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTIL_SMALL_VECTOR_H
+#define UTIL_SMALL_VECTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * A sequence container with the interface of std::vector, whose first elements are stored inline.
+ * It allocates only once it holds more than N elements, after which its elements are held in a std::vector until it is cleared.
+ */
+template <typename T, std::size_t N>
+class small_vector
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+
+  std::array<T, N> inline_data{};
+  std::size_t inline_size = 0;
+  std::vector<T> spilled{};
+  bool is_spilled = false;
+
+  void spill()
+  {
+    spilled.reserve(2 * N);
+    spilled.assign(std::cbegin(inline_data), std::next(std::cbegin(inline_data), static_cast<std::ptrdiff_t>(inline_size)));
+    inline_size = 0;
+    is_spilled = true;
+  }
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  small_vector() = default;
+  small_vector(std::initializer_list<T> init) { assign(std::begin(init), std::end(init)); }
+
+  template <typename It>
+  small_vector(It first, It last)
+  {
+    assign(first, last);
+  }
+
+  small_vector(const small_vector& other) { assign(std::begin(other), std::end(other)); }
+  small_vector(small_vector&& other) noexcept
+      : inline_data(other.inline_data), inline_size(other.inline_size), spilled(std::move(other.spilled)), is_spilled(other.is_spilled)
+  {
+    other.clear();
+  }
+
+  small_vector& operator=(const small_vector& other)
+  {
+    if (this != &other) {
+      assign(std::begin(other), std::end(other));
+    }
+    return *this;
+  }
+
+  small_vector& operator=(small_vector&& other) noexcept
+  {
+    if (this != &other) {
+      inline_data = other.inline_data;
+      inline_size = other.inline_size;
+      spilled = std::move(other.spilled);
+      is_spilled = other.is_spilled;
+      other.clear();
+    }
+    return *this;
+  }
+
+  template <typename It>
+  void assign(It first, It last)
+  {
+    clear();
+    std::copy(first, last, std::back_inserter(*this));
+  }
+
+  [[nodiscard]] iterator begin() { return data(); }
+  [[nodiscard]] const_iterator begin() const { return data(); }
+  [[nodiscard]] const_iterator cbegin() const { return begin(); }
+  [[nodiscard]] iterator end() { return std::next(begin(), static_cast<difference_type>(size())); }
+  [[nodiscard]] const_iterator end() const { return std::next(begin(), static_cast<difference_type>(size())); }
+  [[nodiscard]] const_iterator cend() const { return end(); }
+
+  [[nodiscard]] pointer data() { return is_spilled ? std::data(spilled) : std::data(inline_data); }
+  [[nodiscard]] const_pointer data() const { return is_spilled ? std::data(spilled) : std::data(inline_data); }
+  [[nodiscard]] size_type size() const { return is_spilled ? std::size(spilled) : inline_size; }
+  [[nodiscard]] bool empty() const { return size() == 0; }
+  [[nodiscard]] constexpr static size_type inline_capacity() { return N; }
+
+  reference operator[](size_type pos) { return data()[pos]; }
+  const_reference operator[](size_type pos) const { return data()[pos]; }
+  reference front() { return *begin(); }
+  const_reference front() const { return *begin(); }
+  reference back() { return *std::prev(end()); }
+  const_reference back() const { return *std::prev(end()); }
+
+  void push_back(const T& value)
+  {
+    if (!is_spilled && inline_size == N) {
+      spill();
+    }
+
+    if (is_spilled) {
+      spilled.push_back(value);
+    } else {
+      inline_data[inline_size++] = value;
+    }
+  }
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args)
+  {
+    push_back(T{std::forward<Args>(args)...});
+    return back();
+  }
+
+  void pop_back() { erase(std::prev(end())); }
+
+  void clear()
+  {
+    spilled = std::vector<T>{};
+    inline_size = 0;
+    is_spilled = false;
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, std::next(pos)); }
+
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    auto offset = std::distance(cbegin(), first);
+    auto dest = std::next(begin(), offset);
+    auto new_end = std::copy(last, cend(), dest);
+    if (is_spilled) {
+      spilled.resize(static_cast<size_type>(std::distance(begin(), new_end)));
+    } else {
+      inline_size = static_cast<size_type>(std::distance(begin(), new_end));
+    }
+    return std::next(begin(), offset);
+  }
+
+  friend bool operator==(const small_vector& lhs, const small_vector& rhs)
+  {
+    return std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs));
+  }
+  friend bool operator!=(const small_vector& lhs, const small_vector& rhs) { return !(lhs == rhs); }
+};
+} // namespace champsim
+
+#endif
@@ -19,6 +19,7 @@
 
 #include <cstdint>
 #include <deque>
+#include <iosfwd>
 #include <map>
 #include <optional>
 #include <random>
@@ -118,6 +119,16 @@ public:
    * :returns: A pair of the page table page address and the latency to be applied to the operation.
    */
   std::pair<champsim::address, champsim::chrono::clock::duration> get_pte_pa(uint32_t cpu_num, champsim::page_number vaddr, std::size_t level);
+
+  /**
+   * Write the page mappings, the page table, and the position in the free list.
+   */
+  void save_checkpoint(std::ostream& os) const;
+
+  /**
+   * Read the state written by save_checkpoint() into a virtual memory of the same configuration that has not yet allocated any pages.
+   */
+  void restore_checkpoint(std::istream& is);
 };
 
 #endif
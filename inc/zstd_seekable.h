@@ -0,0 +1,114 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ZSTD_SEEKABLE_H
+#define ZSTD_SEEKABLE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "inf_stream.h"
+#include "restartable_istream.h"
+
+namespace champsim
+{
+/**
+ * One frame of a file in the zstd seekable format, which is a sequence of independent frames followed by a table of their sizes.
+ */
+struct zstd_seek_entry {
+  uint64_t compressed_offset = 0;
+  uint64_t decompressed_offset = 0;
+  uint32_t compressed_size = 0;
+  uint32_t decompressed_size = 0;
+};
+
+/**
+ * Read the seek table from the end of a stream, and return the stream to its beginning.
+ *
+ * \returns The frames of the stream, or an empty table if the stream does not end in a seek table.
+ */
+std::vector<zstd_seek_entry> read_zstd_seek_table(std::istream& strm);
+
+/**
+ * Write a seek table for the given frames, as a skippable frame that decompressors ignore.
+ */
+void write_zstd_seek_table(std::ostream& strm, const std::vector<zstd_seek_entry>& frames);
+
+/**
+ * Compresses a stream in the zstd seekable format, beginning a new frame after each given number of uncompressed bytes.
+ */
+class zstd_seekable_ostream
+{
+  using tag_type = decomp_tags::zstd_tag_t<>;
+
+  std::ostream& dest;
+  std::size_t frame_size;
+  tag_type::deflate_state_type state = tag_type::new_deflate_state();
+  std::vector<zstd_seek_entry> frames{};
+  zstd_seek_entry current_frame{};
+
+  void compress(const char* s, std::size_t count, bool end_frame);
+
+public:
+  constexpr static std::size_t default_frame_size = 1 << 22;
+
+  explicit zstd_seekable_ostream(std::ostream& strm, std::size_t frame_sz = default_frame_size);
+
+  zstd_seekable_ostream& write(const char* s, std::size_t count);
+
+  /**
+   * End the last frame and write the seek table. Nothing may be written afterward.
+   */
+  void close();
+
+  [[nodiscard]] const std::vector<zstd_seek_entry>& frame_table() const { return frames; }
+};
+
+/**
+ * A decompressing stream for zstd files, which skips forward by jumping to the frame that holds the destination if the file has a seek table.
+ * Files without a seek table use the index beside them instead, if there is one, or are read sequentially.
+ */
+template <typename StreamType = std::ifstream>
+class zstd_seekable_istream : public restartable_istream<decomp_tags::zstd_tag_t<>, StreamType>
+{
+  using base_type = restartable_istream<decomp_tags::zstd_tag_t<>, StreamType>;
+
+  void use_seek_table()
+  {
+    auto frames = read_zstd_seek_table(this->underlying());
+    if (!std::empty(frames)) {
+      std::vector<restart_point> loaded_points;
+      std::transform(std::cbegin(frames), std::cend(frames), std::back_inserter(loaded_points),
+                     [](const zstd_seek_entry& x) { return restart_point{x.decompressed_offset, x.compressed_offset}; });
+      this->set_restart_points(std::move(loaded_points));
+    }
+  }
+
+public:
+  explicit zstd_seekable_istream(std::string s) : base_type(s) { use_seek_table(); }
+  explicit zstd_seekable_istream(StreamType&& str) : base_type(std::move(str)) { use_seek_table(); }
+};
+} // namespace champsim
+
+#endif
@@ -1,6 +1,7 @@
 #include "ip_stride.h"
 
 #include "cache.h"
+#include "checkpoint.h"
 
 uint32_t ip_stride::prefetcher_cache_operate(champsim::address addr, champsim::address ip, uint8_t cache_hit, bool useful_prefetch, access_type type,
                                              uint32_t metadata_in)
@@ -57,3 +58,8 @@ uint32_t ip_stride::prefetcher_cache_fill(champsim::address addr, long set, long
 {
   return metadata_in;
 }
+
+// A lookahead still in progress is not kept. The next access by its IP starts another.
+void ip_stride::prefetcher_save_checkpoint(std::ostream& os) const { table.save_checkpoint(os); }
+
+void ip_stride::prefetcher_restore_checkpoint(std::istream& is) { table.restore_checkpoint(is); }
@@ -2,6 +2,7 @@
 #define IP_STRIDE_H
 
 #include <cstdint>
+#include <iosfwd>
 #include <optional>
 
 #include "address.h"
@@ -48,6 +49,8 @@ public:
                                     uint32_t metadata_in);
   uint32_t prefetcher_cache_fill(champsim::address addr, long set, long way, uint8_t prefetch, champsim::address evicted_addr, uint32_t metadata_in);
   void prefetcher_cycle_operate();
+  void prefetcher_save_checkpoint(std::ostream& os) const;
+  void prefetcher_restore_checkpoint(std::istream& is);
 };
 
 #endif
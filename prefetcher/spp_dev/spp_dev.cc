@@ -3,6 +3,8 @@
 #include <cassert>
 #include <iostream>
 
+#include "checkpoint.h"
+
 void spp_dev::prefetcher_initialize()
 {
   std::cout << "Initialize SIGNATURE TABLE" << std::endl;
@@ -556,3 +558,56 @@ uint32_t spp_dev::GLOBAL_REGISTER::check_entry(offset_type page_offset)
 
   return max_conf_way;
 }
+
+// The tables are written member by member, since each one holds a pointer back to the prefetcher
+void spp_dev::prefetcher_save_checkpoint(std::ostream& os) const
+{
+  champsim::checkpoint::write(os, ST.valid);
+  champsim::checkpoint::write(os, ST.tag);
+  champsim::checkpoint::write(os, ST.last_offset);
+  champsim::checkpoint::write(os, ST.sig);
+  champsim::checkpoint::write(os, ST.lru);
+
+  champsim::checkpoint::write(os, PT.delta);
+  champsim::checkpoint::write(os, PT.c_delta);
+  champsim::checkpoint::write(os, PT.c_sig);
+
+  champsim::checkpoint::write(os, FILTER.remainder_tag);
+  champsim::checkpoint::write(os, FILTER.valid);
+  champsim::checkpoint::write(os, FILTER.useful);
+
+  champsim::checkpoint::write(os, GHR.pf_useful);
+  champsim::checkpoint::write(os, GHR.pf_issued);
+  champsim::checkpoint::write(os, GHR.global_accuracy);
+  champsim::checkpoint::write(os, GHR.valid);
+  champsim::checkpoint::write(os, GHR.sig);
+  champsim::checkpoint::write(os, GHR.confidence);
+  champsim::checkpoint::write(os, GHR.offset);
+  champsim::checkpoint::write(os, GHR.delta);
+}
+
+void spp_dev::prefetcher_restore_checkpoint(std::istream& is)
+{
+  champsim::checkpoint::read(is, ST.valid);
+  champsim::checkpoint::read(is, ST.tag);
+  champsim::checkpoint::read(is, ST.last_offset);
+  champsim::checkpoint::read(is, ST.sig);
+  champsim::checkpoint::read(is, ST.lru);
+
+  champsim::checkpoint::read(is, PT.delta);
+  champsim::checkpoint::read(is, PT.c_delta);
+  champsim::checkpoint::read(is, PT.c_sig);
+
+  champsim::checkpoint::read(is, FILTER.remainder_tag);
+  champsim::checkpoint::read(is, FILTER.valid);
+  champsim::checkpoint::read(is, FILTER.useful);
+
+  champsim::checkpoint::read(is, GHR.pf_useful);
+  champsim::checkpoint::read(is, GHR.pf_issued);
+  champsim::checkpoint::read(is, GHR.global_accuracy);
+  champsim::checkpoint::read(is, GHR.valid);
+  champsim::checkpoint::read(is, GHR.sig);
+  champsim::checkpoint::read(is, GHR.confidence);
+  champsim::checkpoint::read(is, GHR.offset);
+  champsim::checkpoint::read(is, GHR.delta);
+}
@@ -3,6 +3,7 @@
 #include <algorithm>
 
 #include "cache.h"
+#include "checkpoint.h"
 
 template <typename T>
 auto va_ampm_lite::page_and_offset(T addr) -> std::pair<champsim::page_number, block_in_page>
@@ -80,3 +81,30 @@ uint32_t va_ampm_lite::prefetcher_cache_fill(champsim::address addr, long set, l
 {
   return metadata_in;
 }
+
+// The access maps are not trivially copyable, so each region is written a block at a time
+void va_ampm_lite::prefetcher_save_checkpoint(std::ostream& os) const
+{
+  regions.save_checkpoint(os, [](std::ostream& region_os, const region_type& region) {
+    champsim::checkpoint::write(region_os, region.vpn);
+    for (std::size_t i = 0; i < std::size(region.access_map); ++i) {
+      champsim::checkpoint::write(region_os, static_cast<uint8_t>(region.access_map[i]));
+      champsim::checkpoint::write(region_os, static_cast<uint8_t>(region.prefetch_map[i]));
+    }
+  });
+}
+
+void va_ampm_lite::prefetcher_restore_checkpoint(std::istream& is)
+{
+  regions.restore_checkpoint(is, [](std::istream& region_is, region_type& region) {
+    uint8_t accessed{};
+    uint8_t prefetched{};
+    champsim::checkpoint::read(region_is, region.vpn);
+    for (std::size_t i = 0; i < std::size(region.access_map); ++i) {
+      champsim::checkpoint::read(region_is, accessed);
+      champsim::checkpoint::read(region_is, prefetched);
+      region.access_map[i] = (accessed != 0);
+      region.prefetch_map[i] = (prefetched != 0);
+    }
+  });
+}
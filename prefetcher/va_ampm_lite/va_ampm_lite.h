@@ -4,6 +4,7 @@
 #include <array>
 #include <bitset>
 #include <cstdint>
+#include <iosfwd>
 #include <vector>
 
 #include "champsim.h"
@@ -48,6 +49,8 @@ public:
   uint32_t prefetcher_cache_operate(champsim::address addr, champsim::address ip, uint8_t cache_hit, bool useful_prefetch, access_type type,
                                     uint32_t metadata_in);
   uint32_t prefetcher_cache_fill(champsim::address addr, long set, long way, uint8_t prefetch, champsim::address evicted_addr, uint32_t metadata_in);
+  void prefetcher_save_checkpoint(std::ostream& os) const;
+  void prefetcher_restore_checkpoint(std::istream& is);
 
   // void prefetcher_cycle_operate() {}
   // void prefetcher_final_stats() {}
@@ -6,6 +6,7 @@
 #include <utility>
 
 #include "champsim.h"
+#include "checkpoint.h"
 
 drrip::drrip(CACHE* cache) : replacement(cache), NUM_SET(cache->NUM_SET), NUM_WAY(cache->NUM_WAY), rrpv(static_cast<std::size_t>(NUM_SET * NUM_WAY))
 {
@@ -85,3 +86,19 @@ long drrip::find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, co
   assert(victim < end);
   return std::distance(begin, victim); // cast protected by assertions
 }
+
+// The leader sets of each core are drawn from knuth_b{1} in the constructor, so a restored cache duels on the same sets.
+// Only PSEL, the BIP throttle, and the RRPVs are saved.
+void drrip::replacement_save_checkpoint(std::ostream& os) const
+{
+  champsim::checkpoint::write(os, bip_counter);
+  champsim::checkpoint::write(os, PSEL);
+  champsim::checkpoint::write(os, rrpv);
+}
+
+void drrip::replacement_restore_checkpoint(std::istream& is)
+{
+  champsim::checkpoint::read(is, bip_counter);
+  champsim::checkpoint::read(is, PSEL);
+  champsim::checkpoint::read(is, rrpv);
+}
@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <cassert>
 
+#include "checkpoint.h"
+
 lru::lru(CACHE* cache) : lru(cache, cache->NUM_SET, cache->NUM_WAY) {}
 
 lru::lru(CACHE* cache, long sets, long ways) : replacement(cache), NUM_WAY(ways), last_used_cycles(static_cast<std::size_t>(sets * ways), 0) {}
@@ -34,3 +36,15 @@ void lru::update_replacement_state(uint32_t triggering_cpu, long set, long way,
   if (hit && access_type{type} != access_type::WRITE) // Skip this for writeback hits
     last_used_cycles.at((std::size_t)(set * NUM_WAY + way)) = cycle++;
 }
+
+void lru::replacement_save_checkpoint(std::ostream& os) const
+{
+  champsim::checkpoint::write(os, cycle);
+  champsim::checkpoint::write(os, last_used_cycles);
+}
+
+void lru::replacement_restore_checkpoint(std::istream& is)
+{
+  champsim::checkpoint::read(is, cycle);
+  champsim::checkpoint::read(is, last_used_cycles);
+}
@@ -1,5 +1,7 @@
 #include "random.h"
 
+#include "checkpoint.h"
+
 random::random(CACHE* cache) : random(cache, cache->NUM_WAY) {}
 
 random::random(CACHE* cache, long ways) : replacement(cache), dist(0, ways - 1) {}
@@ -9,3 +11,7 @@ long random::find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, c
 {
   return dist(rng);
 }
+
+void random::replacement_save_checkpoint(std::ostream& os) const { champsim::checkpoint::write(os, rng); }
+
+void random::replacement_restore_checkpoint(std::istream& is) { champsim::checkpoint::read(is, rng); }
@@ -1,6 +1,7 @@
 #ifndef REPLACEMENT_RANDOM_H
 #define REPLACEMENT_RANDOM_H
 
+#include <iosfwd>
 #include <random>
 
 #include "cache.h"
@@ -18,6 +19,8 @@ struct random : public champsim::modules::replacement {
   // void update_replacement_state(uint32_t triggering_cpu, long set, long way, uint64_t full_addr, uint64_t ip, uint64_t victim_addr, access_type type, uint8_t
   // hit);
   //  void replacement_final_stats()
+  void replacement_save_checkpoint(std::ostream& os) const;
+  void replacement_restore_checkpoint(std::istream& is);
 };
 
 #endif
@@ -5,6 +5,7 @@
 #include <random>
 
 #include "champsim.h"
+#include "checkpoint.h"
 
 // initialize replacement state
 ship::ship(CACHE* cache)
@@ -95,3 +96,20 @@ void ship::update_replacement_state(uint32_t triggering_cpu, long set, long way,
       get_rrpv(set, way) = maxRRPV;
   }
 }
+
+// rand_sets is drawn from knuth_b{1} in the constructor, so the saved sampler entries line up with the same sets when they are restored
+void ship::replacement_save_checkpoint(std::ostream& os) const
+{
+  champsim::checkpoint::write(os, access_count);
+  champsim::checkpoint::write(os, sampler);
+  champsim::checkpoint::write(os, rrpv_values);
+  champsim::checkpoint::write(os, SHCT);
+}
+
+void ship::replacement_restore_checkpoint(std::istream& is)
+{
+  champsim::checkpoint::read(is, access_count);
+  champsim::checkpoint::read(is, sampler);
+  champsim::checkpoint::read(is, rrpv_values);
+  champsim::checkpoint::read(is, SHCT);
+}
@@ -2,6 +2,7 @@
 #define REPLACEMENT_SHIP_H
 
 #include <array>
+#include <iosfwd>
 #include <vector>
 
 #include "cache.h"
@@ -48,6 +49,8 @@ public:
                    champsim::address full_addr, access_type type);
   void update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr,
                                 access_type type, uint8_t hit);
+  void replacement_save_checkpoint(std::ostream& os) const;
+  void replacement_restore_checkpoint(std::istream& is);
 
   // use this function to print out your own stats at the end of simulation
   // void replacement_final_stats() {}
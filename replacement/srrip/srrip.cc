@@ -5,6 +5,7 @@
 #include <unordered_map>
 
 #include "cache.h"
+#include "checkpoint.h"
 
 srrip::srrip(CACHE* cache) : srrip(cache, cache->NUM_SET, cache->NUM_WAY) {}
 
@@ -44,3 +45,15 @@ long srrip_set_helper::victim()
 }
 
 void srrip_set_helper::update(long way, bool hit) { get_rrpv(way) = hit ? 0 : (maxRRPV - 1); }
+
+void srrip::replacement_save_checkpoint(std::ostream& os) const
+{
+  for (const auto& set : sets)
+    champsim::checkpoint::write(os, set.rrpv_values);
+}
+
+void srrip::replacement_restore_checkpoint(std::istream& is)
+{
+  for (auto& set : sets)
+    champsim::checkpoint::read(is, set.rrpv_values);
+}
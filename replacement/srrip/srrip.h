@@ -2,6 +2,7 @@
 #define REPLACEMENT_SRRIP_H
 
 #include <cstdint>
+#include <iosfwd>
 #include <vector>
 
 #include "cache.h"
@@ -32,6 +33,8 @@ struct srrip : public champsim::modules::replacement {
                    champsim::address full_addr, access_type type);
   void update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr,
                                 access_type type, uint8_t hit);
+  void replacement_save_checkpoint(std::ostream& os) const;
+  void replacement_restore_checkpoint(std::istream& is);
 
   // use this function to print out your own stats at the end of simulation
   // void replacement_final_stats() {}
@@ -25,10 +25,10 @@
 
 #include "bandwidth.h"
 #include "champsim.h"
+#include "checkpoint.h"
 #include "chrono.h"
 #include "deadlock.h"
 #include "instruction.h"
-#include "util/algorithm.h"
 #include "util/bits.h"
 #include "util/span.h"
 
@@ -38,8 +38,9 @@ CACHE::CACHE(CACHE&& other)
       upper_levels(std::move(other.upper_levels)), lower_level(std::move(other.lower_level)), lower_translate(std::move(other.lower_translate)),
 
       cpu(other.cpu), NAME(std::move(other.NAME)), NUM_SET(other.NUM_SET), NUM_WAY(other.NUM_WAY), MSHR_SIZE(other.MSHR_SIZE), PQ_SIZE(other.PQ_SIZE),
-      HIT_LATENCY(other.HIT_LATENCY), FILL_LATENCY(other.FILL_LATENCY), OFFSET_BITS(other.OFFSET_BITS), block(std::move(other.block)), MAX_TAG(other.MAX_TAG),
-      MAX_FILL(other.MAX_FILL), prefetch_as_load(other.prefetch_as_load), match_offset_bits(other.match_offset_bits), virtual_prefetch(other.virtual_prefetch),
+      HIT_LATENCY(other.HIT_LATENCY), FILL_LATENCY(other.FILL_LATENCY), OFFSET_BITS(other.OFFSET_BITS), block(std::move(other.block)),
+      block_tags(std::move(other.block_tags)), MAX_TAG(other.MAX_TAG), MAX_FILL(other.MAX_FILL), prefetch_as_load(other.prefetch_as_load),
+      match_offset_bits(other.match_offset_bits), virtual_prefetch(other.virtual_prefetch), compact_blocks(std::move(other.compact_blocks)),
       pref_activate_mask(std::move(other.pref_activate_mask)),
 
       sim_stats(std::move(other.sim_stats)), roi_stats(std::move(other.roi_stats)),
@@ -71,13 +72,17 @@ auto CACHE::operator=(CACHE&& other) -> CACHE&
   this->HIT_LATENCY = other.HIT_LATENCY;
   this->FILL_LATENCY = other.FILL_LATENCY;
   this->OFFSET_BITS = other.OFFSET_BITS;
+  this->set_index_shift = other.set_index_shift;
+  this->set_index_mask = other.set_index_mask;
   ;
   this->block = std::move(other.block);
+  this->block_tags = std::move(other.block_tags);
   this->MAX_TAG = other.MAX_TAG;
   this->MAX_FILL = other.MAX_FILL;
   this->prefetch_as_load = other.prefetch_as_load;
   this->match_offset_bits = other.match_offset_bits;
   this->virtual_prefetch = other.virtual_prefetch;
+  this->compact_blocks = std::move(other.compact_blocks);
   this->pref_activate_mask = std::move(other.pref_activate_mask);
 
   this->sim_stats = std::move(other.sim_stats);
@@ -104,41 +109,46 @@ CACHE::mshr_type::mshr_type(const tag_lookup_type& req, champsim::chrono::clock:
 {
 }
 
-CACHE::mshr_type CACHE::mshr_type::merge(mshr_type predecessor, mshr_type successor)
+void CACHE::mshr_type::merge(const tag_lookup_type& successor, champsim::chrono::clock::time_point successor_enqueued)
 {
-  std::vector<uint64_t> merged_instr{};
-  std::vector<std::deque<response_type>*> merged_return{};
-
-  std::set_union(std::begin(predecessor.instr_depend_on_me), std::end(predecessor.instr_depend_on_me), std::begin(successor.instr_depend_on_me),
-                 std::end(successor.instr_depend_on_me), std::back_inserter(merged_instr));
-  std::set_union(std::begin(predecessor.to_return), std::end(predecessor.to_return), std::begin(successor.to_return), std::end(successor.to_return),
-                 std::back_inserter(merged_return));
-
-  mshr_type retval{(successor.type == access_type::PREFETCH) ? predecessor : successor};
-
-  // set the time enqueued to the predecessor unless its a demand into prefetch, in which case we use the successor
-  retval.time_enqueued =
-      ((successor.type != access_type::PREFETCH && predecessor.type == access_type::PREFETCH)) ? successor.time_enqueued : predecessor.time_enqueued;
-  retval.instr_depend_on_me = merged_instr;
-  retval.to_return = merged_return;
-  retval.data_promise = predecessor.data_promise;
-
   if constexpr (champsim::debug_print) {
     if (successor.type == access_type::PREFETCH) {
       fmt::print("[MSHR] {} address {} type: {} into address {} type: {}\n", __func__, successor.address,
-                 access_type_names.at(champsim::to_underlying(successor.type)), predecessor.address,
-                 access_type_names.at(champsim::to_underlying(successor.type)));
+                 access_type_names.at(champsim::to_underlying(successor.type)), address, access_type_names.at(champsim::to_underlying(successor.type)));
     } else {
-      fmt::print("[MSHR] {} address {} type: {} into address {} type: {}\n", __func__, predecessor.address,
-                 access_type_names.at(champsim::to_underlying(predecessor.type)), successor.address,
-                 access_type_names.at(champsim::to_underlying(successor.type)));
+      fmt::print("[MSHR] {} address {} type: {} into address {} type: {}\n", __func__, address, access_type_names.at(champsim::to_underlying(type)),
+                 successor.address, access_type_names.at(champsim::to_underlying(successor.type)));
     }
   }
 
-  return retval;
+  champsim::channel::dependency_list_type merged_instr{};
+  champsim::channel::return_list_type merged_return{};
+
+  std::set_union(std::begin(instr_depend_on_me), std::end(instr_depend_on_me), std::begin(successor.instr_depend_on_me), std::end(successor.instr_depend_on_me),
+                 std::back_inserter(merged_instr));
+  std::set_union(std::begin(to_return), std::end(to_return), std::begin(successor.to_return), std::end(successor.to_return), std::back_inserter(merged_return));
+
+  // set the time enqueued to the predecessor unless its a demand into prefetch, in which case we use the successor
+  if (successor.type != access_type::PREFETCH && type == access_type::PREFETCH) {
+    time_enqueued = successor_enqueued;
+  }
+
+  // A demand takes the place of the request it merges into, which keeps its data promise
+  if (successor.type != access_type::PREFETCH) {
+    address = successor.address;
+    v_address = successor.v_address;
+    ip = successor.ip;
+    instr_id = successor.instr_id;
+    cpu = successor.cpu;
+    type = successor.type;
+    prefetch_from_this = successor.prefetch_from_this;
+  }
+
+  instr_depend_on_me = std::move(merged_instr);
+  to_return = std::move(merged_return);
 }
 
-auto CACHE::fill_block(mshr_type mshr, uint32_t metadata) -> BLOCK
+auto CACHE::fill_block(const mshr_type& mshr, uint32_t metadata) -> BLOCK
 {
   CACHE::BLOCK to_fill;
   to_fill.valid = true;
@@ -159,6 +169,38 @@ auto CACHE::matches_address(champsim::address addr) const
   };
 }
 
+uint64_t CACHE::mshr_block_key(champsim::address addr) const { return block_tags.tag_of(addr); }
+
+void CACHE::release_mshr_block(champsim::address addr) { mshr_blocks.erase(mshr_block_key(addr)); }
+
+auto CACHE::read_block(long set, long way) const -> BLOCK
+{
+  const auto index = static_cast<std::size_t>(set * NUM_WAY + way);
+  return compact_blocks.has_value() ? compact_blocks->get(index, block_tags) : block.at(index);
+}
+
+void CACHE::write_block(long set, long way, const BLOCK& blk)
+{
+  const auto index = static_cast<std::size_t>(set * NUM_WAY + way);
+  if (compact_blocks.has_value()) {
+    compact_blocks->assign(index, blk);
+    if (set == view_set) {
+      set_view.at(static_cast<std::size_t>(way)) = blk;
+    }
+  } else {
+    block.at(index) = blk;
+  }
+  block_tags.assign(index, blk);
+}
+
+void CACHE::write_block_state(long set, long way, const BLOCK& blk)
+{
+  // Blocks that are not compact are changed in place through their set span, and a change of state leaves the tag store as it was
+  if (compact_blocks.has_value()) {
+    compact_blocks->assign_state(static_cast<std::size_t>(set * NUM_WAY + way), blk.dirty, blk.prefetch);
+  }
+}
+
 template <typename T>
 champsim::address CACHE::module_address(const T& element) const
 {
@@ -166,13 +208,14 @@ champsim::address CACHE::module_address(const T& element) const
   return champsim::address{address.slice_upper(match_offset_bits ? champsim::data::bits{} : OFFSET_BITS)};
 }
 
-bool CACHE::handle_fill(const mshr_type& fill_mshr)
+template <typename F>
+bool CACHE::do_fill(const mshr_type& fill_mshr, F&& issue_writeback)
 {
   cpu = fill_mshr.cpu;
 
   // find victim
   auto [set_begin, set_end] = get_set_span(fill_mshr.address);
-  auto way = std::find_if_not(set_begin, set_end, [](auto x) { return x.valid; });
+  auto way = std::next(set_begin, static_cast<long>(block_tags.find_invalid(static_cast<std::size_t>(get_set_index(fill_mshr.address)))));
   if (way == set_end) {
     way = std::next(set_begin, impl_find_victim(fill_mshr.cpu, fill_mshr.instr_id, get_set_index(fill_mshr.address), &*set_begin, fill_mshr.ip,
                                                 fill_mshr.address, fill_mshr.type));
@@ -206,7 +249,7 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
                  fill_mshr.data_promise->pf_metadata);
     }
 
-    auto success = lower_level->add_wq(writeback_packet);
+    auto success = issue_writeback(std::move(writeback_packet));
     if (!success) {
       return false;
     }
@@ -232,6 +275,7 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
     }
 
     *way = fill_block(fill_mshr, metadata_thru);
+    write_block(get_set_index(fill_mshr.address), way_idx, *way);
   }
 
   // COLLECT STATS
@@ -239,21 +283,25 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
     sim_stats.total_miss_latency_cycles += (current_time - (fill_mshr.time_enqueued + clock_period)) / clock_period;
   sim_stats.mshr_return.increment(std::pair{fill_mshr.type, fill_mshr.cpu});
 
-  response_type response{fill_mshr.address, fill_mshr.v_address, fill_mshr.data_promise->data, metadata_thru, fill_mshr.instr_depend_on_me};
   for (auto* ret : fill_mshr.to_return) {
-    ret->push_back(response);
+    ret->emplace_back(fill_mshr.address, fill_mshr.v_address, fill_mshr.data_promise->data, metadata_thru, fill_mshr.instr_depend_on_me);
   }
 
   return true;
 }
 
+bool CACHE::handle_fill(const mshr_type& fill_mshr)
+{
+  return do_fill(fill_mshr, [this](request_type&& writeback_packet) { return lower_level->add_wq(std::move(writeback_packet)); });
+}
+
 bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
 {
   cpu = handle_pkt.cpu;
 
   // access cache
   auto [set_begin, set_end] = get_set_span(handle_pkt.address);
-  auto way = std::find_if(set_begin, set_end, [matcher = matches_address(handle_pkt.address)](const auto& x) { return x.valid && matcher(x); });
+  auto way = std::next(set_begin, static_cast<long>(block_tags.find(static_cast<std::size_t>(get_set_index(handle_pkt.address)), handle_pkt.address)));
   const auto hit = (way != set_end);
   const auto useful_prefetch = (hit && way->prefetch && !handle_pkt.prefetch_from_this);
 
@@ -276,27 +324,29 @@ bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
   if (hit) {
     sim_stats.hits.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
 
-    response_type response{handle_pkt.address, handle_pkt.v_address, way->data, metadata_thru, handle_pkt.instr_depend_on_me};
     for (auto* ret : handle_pkt.to_return) {
-      ret->push_back(response);
+      ret->emplace_back(handle_pkt.address, handle_pkt.v_address, way->data, metadata_thru, handle_pkt.instr_depend_on_me);
     }
 
-    way->dirty |= (handle_pkt.type == access_type::WRITE);
+    const bool dirtied = (handle_pkt.type == access_type::WRITE) && !way->dirty;
+    way->dirty |= dirtied;
 
     // update prefetch stats and reset prefetch bit
     if (useful_prefetch) {
       ++sim_stats.pf_useful;
       way->prefetch = false;
     }
+
+    if (dirtied || useful_prefetch) {
+      write_block_state(get_set_index(handle_pkt.address), way_idx, *way);
+    }
   }
 
   return hit;
 }
 
-auto CACHE::mshr_and_forward_packet(const tag_lookup_type& handle_pkt) -> std::pair<mshr_type, request_type>
+auto CACHE::forward_packet(const tag_lookup_type& handle_pkt) -> request_type
 {
-  mshr_type to_allocate{handle_pkt, current_time};
-
   request_type fwd_pkt;
 
   fwd_pkt.asid[0] = handle_pkt.asid[0];
@@ -314,7 +364,7 @@ auto CACHE::mshr_and_forward_packet(const tag_lookup_type& handle_pkt) -> std::p
   fwd_pkt.instr_depend_on_me = handle_pkt.instr_depend_on_me;
   fwd_pkt.response_requested = (!handle_pkt.prefetch_from_this || !handle_pkt.skip_fill);
 
-  return std::pair{std::move(to_allocate), std::move(fwd_pkt)};
+  return fwd_pkt;
 }
 
 bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
@@ -325,44 +375,44 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
                current_time.time_since_epoch() / clock_period);
   }
 
-  mshr_type to_allocate{handle_pkt, current_time};
-
   cpu = handle_pkt.cpu;
 
-  auto mshr_pkt = mshr_and_forward_packet(handle_pkt);
-
   // check mshr
-  auto mshr_entry = std::find_if(std::begin(MSHR), std::end(MSHR), matches_address(handle_pkt.address));
+  auto mshr_block = mshr_blocks.find(mshr_block_key(handle_pkt.address));
   bool mshr_full = (MSHR.size() == MSHR_SIZE);
 
-  if (mshr_entry != MSHR.end()) // miss already inflight
+  if (mshr_block != std::end(mshr_blocks)) // miss already inflight
   {
-    if (mshr_entry->type == access_type::PREFETCH && handle_pkt.type != access_type::PREFETCH) {
+    auto& mshr_entry = (*mshr_pool)[mshr_block->second];
+    if (mshr_entry.type == access_type::PREFETCH && handle_pkt.type != access_type::PREFETCH) {
       // Mark the prefetch as useful
-      if (mshr_entry->prefetch_from_this) {
+      if (mshr_entry.prefetch_from_this) {
         ++sim_stats.pf_useful;
       }
     }
 
     // COLLECT STATS
-    sim_stats.mshr_merge.increment(std::pair{to_allocate.type, to_allocate.cpu});
+    sim_stats.mshr_merge.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
 
-    *mshr_entry = mshr_type::merge(*mshr_entry, to_allocate);
+    mshr_entry.merge(handle_pkt, current_time);
   } else {
     if (mshr_full) { // not enough MSHR resource
       return false;  // TODO should we allow prefetches anyway if they will not be filled to this level?
     }
 
+    auto fwd_pkt = forward_packet(handle_pkt);
+    const bool response_requested = fwd_pkt.response_requested;
     const bool send_to_rq = (prefetch_as_load || handle_pkt.type != access_type::PREFETCH);
-    bool success = send_to_rq ? lower_level->add_rq(mshr_pkt.second) : lower_level->add_pq(mshr_pkt.second);
+    bool success = send_to_rq ? lower_level->add_rq(std::move(fwd_pkt)) : lower_level->add_pq(std::move(fwd_pkt));
 
     if (!success) {
       return false;
     }
 
     // Allocate an MSHR
-    if (mshr_pkt.second.response_requested) {
-      MSHR.emplace_back(std::move(mshr_pkt.first));
+    if (response_requested) {
+      MSHR.emplace_back(handle_pkt, current_time);
+      mshr_blocks.emplace(mshr_block_key(handle_pkt.address), MSHR.handle_at(std::prev(std::cend(MSHR))));
     }
   }
 
@@ -379,39 +429,54 @@ bool CACHE::handle_write(const tag_lookup_type& handle_pkt)
                current_time.time_since_epoch() / clock_period);
   }
 
-  mshr_type to_allocate{handle_pkt, current_time};
+  auto& to_allocate = inflight_writes.emplace_back(handle_pkt, current_time);
   to_allocate.data_promise.ready_at(current_time + (warmup ? champsim::chrono::clock::duration{} : FILL_LATENCY));
-  inflight_writes.push_back(to_allocate);
 
   sim_stats.misses.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
 
   return true;
 }
 
-template <bool UpdateRequest>
-auto CACHE::initiate_tag_check(champsim::channel* ul)
+auto CACHE::initiate_tag_check()
 {
-  return [time = current_time + (warmup ? champsim::chrono::clock::duration{} : HIT_LATENCY), ul](const auto& entry) {
-    CACHE::tag_lookup_type retval{entry};
-    retval.event_cycle = time;
-
-    if constexpr (UpdateRequest) {
-      if (entry.response_requested) {
-        retval.to_return = {&ul->returned};
-      }
-    } else {
-      (void)ul; // supress warning about ul being unused
-    }
+  return [time = current_time + (warmup ? champsim::chrono::clock::duration{} : HIT_LATENCY)](tag_lookup_type& entry) {
+    entry.event_cycle = time;
 
     if constexpr (champsim::debug_print) {
-      fmt::print("[TAG] initiate_tag_check instr_id: {} address: {} v_address: {} type: {} response_requested: {}\n", retval.instr_id, retval.address,
-                 retval.v_address, access_type_names.at(champsim::to_underlying(retval.type)), !std::empty(retval.to_return));
+      fmt::print("[TAG] initiate_tag_check instr_id: {} address: {} v_address: {} type: {} response_requested: {}\n", entry.instr_id, entry.address,
+                 entry.v_address, access_type_names.at(champsim::to_underlying(entry.type)), !std::empty(entry.to_return));
     }
-
-    return retval;
   };
 }
 
+template <typename F>
+long CACHE::initiate_tag_checks(lookup_queue_type& queue, champsim::bandwidth sz, F&& test_func)
+{
+  // Lookups that are already held by this cache join the tag checks by handle
+  auto [begin, end] = champsim::get_span_p(std::begin(queue), std::end(queue), sz, std::forward<F>(test_func));
+  auto retval = std::distance(begin, end);
+  std::for_each(begin, end, initiate_tag_check());
+  queue.transfer(begin, end, inflight_tag_check);
+  return retval;
+}
+
+template <typename F>
+long CACHE::initiate_tag_checks(channel_type* ul, channel_type::request_queue_type& queue, champsim::bandwidth sz, F&& test_func)
+{
+  // Requests from an upper level are built into lookups in place
+  auto [begin, end] = champsim::get_span_p(std::cbegin(queue), std::cend(queue), sz, std::forward<F>(test_func));
+  auto retval = std::distance(begin, end);
+  std::for_each(begin, end, [this, ul, initiate = initiate_tag_check()](const request_type& pkt) {
+    auto& entry = this->inflight_tag_check.emplace_back(pkt);
+    if (pkt.response_requested) {
+      entry.to_return = {&ul->returned};
+    }
+    initiate(entry);
+  });
+  queue.erase(begin, end);
+  return retval;
+}
+
 long CACHE::operate()
 {
   long progress{0};
@@ -446,6 +511,9 @@ long CACHE::operate()
                                                        [time = current_time](const auto& x) { return x.data_promise.is_ready_at(time); });
     auto complete_end = std::find_if_not(fill_begin, fill_end, [this](const auto& x) { return this->handle_fill(x); });
     fill_bw.consume(std::distance(fill_begin, complete_end));
+    if (&q.get() == &MSHR) {
+      std::for_each(fill_begin, complete_end, [this](const auto& x) { this->release_mshr_block(x.address); });
+    }
     q.get().erase(fill_begin, complete_end);
   }
 
@@ -456,8 +524,7 @@ long CACHE::operate()
   auto can_translate = [avail = (std::size(translation_stash) < static_cast<std::size_t>(MSHR_SIZE))](const auto& entry) {
     return avail || entry.is_translated;
   };
-  auto stash_bandwidth_consumed =
-      champsim::transform_while_n(translation_stash, std::back_inserter(inflight_tag_check), initiate_tag_bw, is_translated, initiate_tag_check<false>());
+  auto stash_bandwidth_consumed = initiate_tag_checks(translation_stash, initiate_tag_bw, is_translated);
   initiate_tag_bw.consume(stash_bandwidth_consumed);
   std::vector<long long> channels_bandwidth_consumed{};
 
@@ -476,15 +543,13 @@ long CACHE::operate()
       // this needs to be in this loop, we need to ensure that for cases where bandwidth doesn't divide nicely across upstreams,
       // we don't accidentally consume more bandwidth than expected
       champsim::bandwidth per_upper_tag_bw{std::min(per_upper_bandwidth, champsim::bandwidth::maximum_type{initiate_tag_bw.amount_remaining()})};
-      auto bandwidth_consumed =
-          champsim::transform_while_n(q.get(), std::back_inserter(inflight_tag_check), per_upper_tag_bw, can_translate, initiate_tag_check<true>(ul));
+      auto bandwidth_consumed = initiate_tag_checks(ul, q.get(), per_upper_tag_bw, can_translate);
       channels_bandwidth_consumed.push_back(bandwidth_consumed);
       initiate_tag_bw.consume(bandwidth_consumed);
     }
   }
 
-  auto pq_bandwidth_consumed =
-      champsim::transform_while_n(internal_PQ, std::back_inserter(inflight_tag_check), initiate_tag_bw, can_translate, initiate_tag_check<false>());
+  auto pq_bandwidth_consumed = initiate_tag_checks(internal_PQ, initiate_tag_bw, can_translate);
   initiate_tag_bw.consume(pq_bandwidth_consumed);
 
   // Issue translations
@@ -492,10 +557,10 @@ long CACHE::operate()
   std::for_each(std::begin(translation_stash), std::end(translation_stash), [this](auto& x) { this->issue_translation(x); });
 
   // Find entries that would be ready except that they have not finished translation, move them to the stash
-  auto [last_not_missed, stash_end] = champsim::extract_if(std::begin(inflight_tag_check), std::end(inflight_tag_check), std::back_inserter(translation_stash),
-                                                           [is_ready, is_translated](const auto& x) { return is_ready(x) && !is_translated(x); });
-  progress += std::distance(last_not_missed, std::end(inflight_tag_check));
-  inflight_tag_check.erase(last_not_missed, std::end(inflight_tag_check));
+  const auto num_tag_checks = std::size(inflight_tag_check);
+  inflight_tag_check.transfer_if(std::begin(inflight_tag_check), std::end(inflight_tag_check), translation_stash,
+                                 [is_ready, is_translated](const auto& x) { return is_ready(x) && !is_translated(x); });
+  progress += static_cast<long>(num_tag_checks - std::size(inflight_tag_check));
 
   // Perform tag checks
   auto do_handle_miss = [this](const auto& pkt) {
@@ -508,8 +573,8 @@ long CACHE::operate()
   auto [tag_check_ready_begin, tag_check_ready_end] =
       champsim::get_span_p(std::begin(inflight_tag_check), std::end(inflight_tag_check), tag_check_bw,
                            [is_ready, is_translated](const auto& pkt) { return is_ready(pkt) && is_translated(pkt); });
-  auto hits_end = std::stable_partition(tag_check_ready_begin, tag_check_ready_end, [this](const auto& pkt) { return this->try_hit(pkt); });
-  auto finish_tag_check_end = std::stable_partition(hits_end, tag_check_ready_end, do_handle_miss);
+  auto hits_end = inflight_tag_check.stable_partition(tag_check_ready_begin, tag_check_ready_end, [this](const auto& pkt) { return this->try_hit(pkt); });
+  auto finish_tag_check_end = inflight_tag_check.stable_partition(hits_end, tag_check_ready_end, do_handle_miss);
   tag_check_bw.consume(std::distance(tag_check_ready_begin, finish_tag_check_end));
   inflight_tag_check.erase(tag_check_ready_begin, finish_tag_check_end);
 
@@ -525,11 +590,87 @@ long CACHE::operate()
   return progress + fill_bw.amount_consumed() + initiate_tag_bw.amount_consumed() + tag_check_bw.amount_consumed();
 }
 
+champsim::chrono::clock::time_point CACHE::next_event_time() const
+{
+  // Returns, new requests, and retries of blocked tag checks or fills are handled every cycle, and may update stats or module state even when they fail
+  auto has_requests = [](const champsim::channel* ul) {
+    return !std::empty(ul->RQ) || !std::empty(ul->WQ) || !std::empty(ul->PQ);
+  };
+  auto needs_retry = [time = current_time](const tag_lookup_type& entry) {
+    return entry.is_translated ? entry.event_cycle <= time : !entry.translate_issued;
+  };
+  auto is_ready = [time = current_time](const mshr_type& entry) {
+    return entry.data_promise.is_ready_at(time);
+  };
+
+  if (pref_module_pimpl->impl_prefetcher_has_cycle_operate() || !std::empty(lower_level->returned)
+      || (lower_translate != nullptr && !std::empty(lower_translate->returned)) || !std::empty(internal_PQ)
+      || std::any_of(std::begin(upper_levels), std::end(upper_levels), has_requests)
+      || std::any_of(std::begin(inflight_tag_check), std::end(inflight_tag_check), needs_retry)
+      || std::any_of(std::begin(translation_stash), std::end(translation_stash), needs_retry)
+      || std::any_of(std::begin(MSHR), std::end(MSHR), is_ready) || std::any_of(std::begin(inflight_writes), std::end(inflight_writes), is_ready)) {
+    return current_time + clock_period;
+  }
+
+  // Otherwise, wait for the next tag check or fill to become ready
+  auto next_event = champsim::chrono::clock::time_point::max();
+  for (const auto& entry : inflight_tag_check) {
+    next_event = std::min(next_event, entry.event_cycle);
+  }
+  for (const auto& entry : MSHR) {
+    next_event = std::min(next_event, entry.data_promise.ready_time());
+  }
+  for (const auto& entry : inflight_writes) {
+    next_event = std::min(next_event, entry.data_promise.ready_time());
+  }
+  return next_event;
+}
+
+void CACHE::skip(long cycles)
+{
+  // The upper levels are rotated once per cycle
+  if (std::size(upper_levels) > 1) {
+    auto shift = static_cast<std::size_t>(cycles) % std::size(upper_levels);
+    std::rotate(std::begin(upper_levels), std::next(std::begin(upper_levels), static_cast<long>(shift)), std::end(upper_levels));
+  }
+}
+
+void CACHE::save_checkpoint(std::ostream& os) const
+{
+  if (compact_blocks.has_value()) {
+    block_tags.save_checkpoint(os);
+    compact_blocks->save_checkpoint(os);
+  } else {
+    champsim::checkpoint::write(os, block);
+  }
+  impl_prefetcher_save_checkpoint(os);
+  impl_replacement_save_checkpoint(os);
+}
+
+void CACHE::restore_checkpoint(std::istream& is)
+{
+  if (compact_blocks.has_value()) {
+    block_tags.restore_checkpoint(is);
+    compact_blocks->restore_checkpoint(is);
+  } else {
+    champsim::checkpoint::read(is, block);
+    for (std::size_t index = 0; index < std::size(block); ++index) {
+      block_tags.assign(index, block[index]);
+    }
+  }
+  view_set = -1;
+  impl_prefetcher_restore_checkpoint(is);
+  impl_replacement_restore_checkpoint(is);
+}
+
 // LCOV_EXCL_START exclude deprecated function
 uint64_t CACHE::get_set(uint64_t address) const { return static_cast<uint64_t>(get_set_index(champsim::address{address})); }
 // LCOV_EXCL_STOP
 
-long CACHE::get_set_index(champsim::address address) const { return address.slice(champsim::dynamic_extent{OFFSET_BITS, champsim::lg2(NUM_SET)}).to<long>(); }
+long CACHE::get_set_index(champsim::address address) const
+{
+  return static_cast<long>((address.to<uint64_t>() >> set_index_shift) & set_index_mask);
+}
 
 template <typename It>
 std::pair<It, It> get_span(It anchor, typename std::iterator_traits<It>::difference_type set_idx, typename std::iterator_traits<It>::difference_type num_way)
@@ -542,35 +683,37 @@ auto CACHE::get_set_span(champsim::address address) -> std::pair<set_type::itera
 {
   const auto set_idx = get_set_index(address);
   assert(set_idx < NUM_SET);
+  if (compact_blocks.has_value()) {
+    set_view.resize(NUM_WAY);
+    for (long way = 0; way < NUM_WAY; ++way) {
+      set_view[static_cast<std::size_t>(way)] = read_block(set_idx, way);
+    }
+    view_set = set_idx;
+    return {std::begin(set_view), std::end(set_view)};
+  }
   return get_span(std::begin(block), static_cast<set_type::difference_type>(set_idx), NUM_WAY); // safe cast because of prior assert
 }
 
-auto CACHE::get_set_span(champsim::address address) const -> std::pair<set_type::const_iterator, set_type::const_iterator>
-{
-  const auto set_idx = get_set_index(address);
-  assert(set_idx < NUM_SET);
-  return get_span(std::cbegin(block), static_cast<set_type::difference_type>(set_idx), NUM_WAY); // safe cast because of prior assert
-}
-
 // LCOV_EXCL_START exclude deprecated function
 uint64_t CACHE::get_way(uint64_t address, uint64_t /*unused set index*/) const
 {
   champsim::address intern_addr{address};
-  auto [begin, end] = get_set_span(intern_addr);
-  return static_cast<uint64_t>(std::distance(begin, std::find_if(begin, end, matches_address(champsim::address{address}))));
+  return static_cast<uint64_t>(block_tags.find_any(static_cast<std::size_t>(get_set_index(intern_addr)), intern_addr));
 }
 // LCOV_EXCL_STOP
 
 long CACHE::invalidate_entry(champsim::address inval_addr)
 {
-  auto [begin, end] = get_set_span(inval_addr);
-  auto inv_way = std::find_if(begin, end, matches_address(inval_addr));
+  const auto set_idx = get_set_index(inval_addr);
+  const auto inv_way = static_cast<long>(block_tags.find_any(static_cast<std::size_t>(set_idx), inval_addr));
 
-  if (inv_way != end) {
-    inv_way->valid = false;
+  if (inv_way < NUM_WAY) {
+    auto inv_block = read_block(set_idx, inv_way);
+    inv_block.valid = false;
+    write_block(set_idx, inv_way, inv_block);
   }
 
-  return std::distance(begin, inv_way);
+  return inv_way;
 }
 
 bool CACHE::prefetch_line(champsim::address pf_addr, bool fill_this_level, uint32_t prefetch_metadata)
@@ -611,7 +754,7 @@ void CACHE::finish_packet(const response_type& packet)
 {
   // check MSHR information
   auto mshr_entry = std::find_if(std::begin(MSHR), std::end(MSHR), matches_address(packet.address));
-  auto first_unreturned = std::find_if(MSHR.begin(), MSHR.end(), [](auto x) { return x.data_promise.has_unknown_readiness(); });
+  auto first_unreturned = std::find_if(MSHR.begin(), MSHR.end(), [](const auto& x) { return x.data_promise.has_unknown_readiness(); });
 
   // sanity check
   if (mshr_entry == MSHR.end()) {
@@ -629,7 +772,7 @@ void CACHE::finish_packet(const response_type& packet)
 
   // Order this entry after previously-returned entries, but before non-returned
   // entries
-  std::iter_swap(mshr_entry, first_unreturned);
+  MSHR.swap_entries(mshr_entry, first_unreturned);
 }
 
 void CACHE::finish_translation(const response_type& packet)
@@ -650,7 +793,7 @@ void CACHE::finish_translation(const response_type& packet)
 
   // Restart stashed translations
   auto finish_begin = std::find_if_not(std::begin(translation_stash), std::end(translation_stash), [](const auto& x) { return x.is_translated; });
-  auto finish_end = std::stable_partition(finish_begin, std::end(translation_stash), matches_vpage);
+  auto finish_end = translation_stash.stable_partition(finish_begin, std::end(translation_stash), matches_vpage);
   std::for_each(finish_begin, finish_end, mark_translated);
 
   // Find all packets that match the page of the returned packet
@@ -679,7 +822,7 @@ void CACHE::issue_translation(tag_lookup_type& q_entry) const
     fwd_pkt.instr_depend_on_me = q_entry.instr_depend_on_me;
     fwd_pkt.is_translated = true;
 
-    q_entry.translate_issued = lower_translate->add_rq(fwd_pkt);
+    q_entry.translate_issued = lower_translate->add_rq(std::move(fwd_pkt));
     if constexpr (champsim::debug_print) {
       if (q_entry.translate_issued) {
         fmt::print("[TRANSLATE] do_issue_translation instr_id: {} paddr: {} vaddr: {} type: {}\n", q_entry.instr_id, q_entry.address, q_entry.v_address,
@@ -689,6 +832,59 @@ void CACHE::issue_translation(tag_lookup_type& q_entry) const
   }
 }
 
+auto CACHE::functional_lookup(const request_type& packet, bool local_prefetch) -> std::optional<response_type>
+{
+  tag_lookup_type handle_pkt{packet, local_prefetch, false};
+  handle_pkt.to_return = {&functional_returned};
+
+  if (try_hit(handle_pkt)) {
+    std::optional<response_type> retval{std::move(functional_returned.front())};
+    functional_returned.clear();
+    return retval;
+  }
+
+  sim_stats.misses.increment(std::pair{packet.type, packet.cpu});
+  return std::nullopt;
+}
+
+auto CACHE::functional_fill(const request_type& packet, const response_type& response, bool local_prefetch) -> std::optional<request_type>
+{
+  // The request is enqueued one cycle ago, so that it counts no miss latency
+  mshr_type fill_mshr{tag_lookup_type{packet, local_prefetch, false}, current_time - clock_period};
+  fill_mshr.data_promise = champsim::waitable{mshr_type::returned_value{response.data, response.pf_metadata}, current_time};
+
+  std::optional<request_type> writeback{};
+  do_fill(fill_mshr, [&writeback](request_type&& writeback_packet) {
+    writeback = std::move(writeback_packet);
+    return true;
+  });
+  return writeback;
+}
+
+auto CACHE::take_functional_prefetches() -> std::vector<std::pair<request_type, bool>>
+{
+  std::vector<std::pair<request_type, bool>> retval;
+  for (const auto& entry : internal_PQ) {
+    request_type pf_packet;
+    pf_packet.asid[0] = entry.asid[0];
+    pf_packet.asid[1] = entry.asid[1];
+    pf_packet.type = entry.type;
+    pf_packet.pf_metadata = entry.pf_metadata;
+    pf_packet.cpu = entry.cpu;
+    pf_packet.address = entry.address;
+    pf_packet.v_address = entry.v_address;
+    pf_packet.data = entry.data;
+    pf_packet.instr_id = entry.instr_id;
+    pf_packet.ip = entry.ip;
+    pf_packet.is_translated = entry.is_translated;
+
+    retval.emplace_back(pf_packet, !entry.skip_fill);
+  }
+  internal_PQ.clear();
+
+  return retval;
+}
+
 std::size_t CACHE::get_mshr_occupancy() const { return std::size(MSHR); }
 
 std::vector<std::size_t> CACHE::get_rq_occupancy() const
@@ -810,6 +1006,10 @@ void CACHE::impl_prefetcher_cycle_operate() const { pref_module_pimpl->impl_pref
 
 void CACHE::impl_prefetcher_final_stats() const { pref_module_pimpl->impl_prefetcher_final_stats(); }
 
+void CACHE::impl_prefetcher_save_checkpoint(std::ostream& os) const { pref_module_pimpl->impl_prefetcher_save_checkpoint(os); }
+
+void CACHE::impl_prefetcher_restore_checkpoint(std::istream& is) const { pref_module_pimpl->impl_prefetcher_restore_checkpoint(is); }
+
 void CACHE::impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target) const
 {
   pref_module_pimpl->impl_prefetcher_branch_operate(ip, branch_type, branch_target);
@@ -837,6 +1037,10 @@ void CACHE::impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long
 
 void CACHE::impl_replacement_final_stats() const { repl_module_pimpl->impl_replacement_final_stats(); }
 
+void CACHE::impl_replacement_save_checkpoint(std::ostream& os) const { repl_module_pimpl->impl_replacement_save_checkpoint(os); }
+
+void CACHE::impl_replacement_restore_checkpoint(std::istream& is) const { repl_module_pimpl->impl_replacement_restore_checkpoint(is); }
+
 void CACHE::initialize()
 {
   impl_prefetcher_initialize();
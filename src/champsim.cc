@@ -18,15 +18,27 @@
 
 #include <algorithm>
 #include <chrono>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
 #include <numeric>
+#include <string>
+#include <string_view>
 #include <vector>
 #include <fmt/chrono.h>
 #include <fmt/core.h>
 
+#include "checkpoint.h"
 #include "environment.h"
+#include "functional_warmer.h"
 #include "ooo_cpu.h"
 #include "operable.h"
+#include "parallel_engine.h"
 #include "phase_info.h"
+#include "run_options.h"
+#include "trace_fanout.h"
 #include "tracereader.h"
 
 constexpr int DEADLOCK_CYCLE{500};
@@ -37,6 +49,27 @@ std::chrono::seconds elapsed_time() { return std::chrono::duration_cast<std::chr
 
 namespace champsim
 {
+std::string& output_prefix()
+{
+  thread_local std::string prefix{};
+  return prefix;
+}
+
+/**
+ * Read from the traces into each core's input queue.
+ * The queues are sized so that they do not run dry in the given number of cycles between fills.
+ */
+void fill_input_queues(environment& env, std::vector<tracereader>& traces, const std::vector<std::size_t>& trace_index, long cycles_between_fills)
+{
+  for (O3_CPU& cpu : env.cpu_view()) {
+    auto& trace = traces.at(trace_index.at(cpu.cpu));
+    for (auto pkt_count = cpu.IN_QUEUE_SIZE * cycles_between_fills - static_cast<long>(std::size(cpu.input_queue)); !trace.eof() && pkt_count > 0;
+         --pkt_count) {
+      cpu.input_queue.push_back(trace());
+    }
+  }
+}
+
 long do_cycle(environment& env, std::vector<tracereader>& traces, std::vector<std::size_t> trace_index, champsim::chrono::clock& global_clock)
 {
   auto operables = env.operable_view();
@@ -50,20 +83,133 @@ long do_cycle(environment& env, std::vector<tracereader>& traces, std::vector<st
   }
 
   // Read from trace
-  for (O3_CPU& cpu : env.cpu_view()) {
-    auto& trace = traces.at(trace_index.at(cpu.cpu));
-    for (auto pkt_count = cpu.IN_QUEUE_SIZE - static_cast<long>(std::size(cpu.input_queue)); !trace.eof() && pkt_count > 0; --pkt_count) {
-      cpu.input_queue.push_back(trace());
+  fill_input_queues(env, traces, trace_index, 1);
+
+  return progress;
+}
+
+long do_parallel_cycles(environment& env, parallel_engine& engine, std::vector<tracereader>& traces, std::vector<std::size_t> trace_index,
+                        champsim::chrono::clock& global_clock, champsim::chrono::clock::duration time_quantum, long quanta)
+{
+  auto progress = engine.operate_for(global_clock, time_quantum, quanta);
+  global_clock.tick(quanta * time_quantum);
+
+  // The traces are only read between intervals, so that instructions are numbered in the same order regardless of the number of threads
+  fill_input_queues(env, traces, trace_index, quanta);
+
+  return progress;
+}
+
+/**
+ * The number of time quanta that the clock may be advanced by without any operable making progress.
+ * Operables are skipped as a whole, so every cycle that a skipped quantum would have operated must come before the earliest event.
+ */
+long idle_quanta(environment& env, const champsim::chrono::clock& global_clock, champsim::chrono::clock::duration time_quantum)
+{
+  auto operables = env.operable_view();
+  auto next_event = std::accumulate(std::cbegin(operables), std::cend(operables), champsim::chrono::clock::time_point::max(),
+                                    [](const auto acc, const operable& y) { return std::min(acc, y.next_event_time()); });
+  auto longest_period = std::accumulate(std::cbegin(operables), std::cend(operables), champsim::chrono::clock::duration::zero(),
+                                        [](const auto acc, const operable& y) { return std::max(acc, y.clock_period); });
+
+  if (next_event == champsim::chrono::clock::time_point::max() || next_event - longest_period <= global_clock.now()) {
+    return 0;
+  }
+
+  return static_cast<long>((next_event - longest_period - global_clock.now()) / time_quantum);
+}
+
+/**
+ * Warm each core with the given number of instructions from its trace, without operating any component.
+ * The cores take turns one instruction at a time, so that their accesses to the shared caches are interleaved.
+ */
+void do_functional_warmup(environment& env, std::vector<tracereader>& traces, const std::vector<std::size_t>& trace_index, long long length,
+                          std::string_view phase_name)
+{
+  auto operables = env.operable_view();
+  auto cpus = env.cpu_view();
+  functional_warmer warmer{env};
+
+  std::vector<bool> phase_complete(std::size(cpus), false);
+  while (!std::accumulate(std::begin(phase_complete), std::end(phase_complete), true, std::logical_and{})) {
+    auto next_phase_complete = phase_complete;
+
+    for (O3_CPU& cpu : cpus) {
+      if (phase_complete[cpu.cpu]) {
+        continue;
+      }
+
+      // Instructions that an earlier phase read but did not fetch come first
+      auto& trace = traces.at(trace_index.at(cpu.cpu));
+      if (!std::empty(cpu.input_queue)) {
+        warmer.operate(cpu, cpu.input_queue.front());
+        cpu.input_queue.pop_front();
+      } else if (!trace.eof()) {
+        warmer.operate(cpu, trace());
+      }
+
+      next_phase_complete[cpu.cpu] = (cpu.sim_instr() >= length);
+    }
+
+    // If any trace reaches EOF, terminate all phases
+    if (std::any_of(std::begin(traces), std::end(traces), [](const auto& tr) { return tr.eof(); })) {
+      std::fill(std::begin(next_phase_complete), std::end(next_phase_complete), true);
     }
+
+    for (O3_CPU& cpu : cpus) {
+      if (next_phase_complete[cpu.cpu] != phase_complete[cpu.cpu]) {
+        for (champsim::operable& op : operables) {
+          op.end_phase(cpu.cpu);
+        }
+
+        fmt::print("{}{} finished CPU {} instructions: {} functionally (Simulation time: {:%H hr %M min %S sec})\n", output_prefix(), phase_name, cpu.cpu,
+                   cpu.sim_instr(), elapsed_time());
+      }
+    }
+
+    phase_complete = next_phase_complete;
   }
+}
 
-  return progress;
+phase_stats collect_stats(const phase_info& phase, environment& env)
+{
+  phase_stats stats;
+  stats.name = phase.name;
+  stats.weight = phase.weight;
+
+  for (std::size_t i = 0; i < std::size(phase.trace_index); ++i) {
+    stats.trace_names.push_back(phase.trace_names.at(phase.trace_index.at(i)));
+  }
+
+  auto cpus = env.cpu_view();
+  std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.sim_cpu_stats), [](const O3_CPU& cpu) { return cpu.sim_stats; });
+  std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.roi_cpu_stats), [](const O3_CPU& cpu) { return cpu.roi_stats; });
+
+  auto caches = env.cache_view();
+  std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.sim_cache_stats), [](const CACHE& cache) { return cache.sim_stats; });
+  std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.roi_cache_stats), [](const CACHE& cache) { return cache.roi_stats; });
+
+  auto dram = env.dram_view();
+  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.sim_dram_stats),
+                 [](const DRAM_CHANNEL& chan) { return chan.sim_stats; });
+  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.roi_dram_stats),
+                 [](const DRAM_CHANNEL& chan) { return chan.roi_stats; });
+
+  return stats;
 }
 
-phase_stats do_phase(const phase_info& phase, environment& env, std::vector<tracereader>& traces, champsim::chrono::clock& global_clock)
+phase_stats do_phase(const phase_info& phase, environment& env, std::vector<tracereader>& traces, champsim::chrono::clock& global_clock,
+                     const run_options& options, parallel_engine* engine)
 {
   auto operables = env.operable_view();
-  auto [phase_name, is_warmup, length, trace_index, trace_names] = phase;
+  auto [phase_name, is_warmup, length, trace_index, trace_names, fast_forward, weight] = phase;
+
+  // Skip over the instructions between sampled intervals
+  if (fast_forward > 0) {
+    for (auto idx : trace_index) {
+      traces.at(idx).skip(static_cast<uint64_t>(fast_forward));
+    }
+  }
 
   // Initialize phase
   for (champsim::operable& op : operables) {
@@ -71,6 +217,11 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
     op.begin_phase();
   }
 
+  if (is_warmup && options.functional_warmup) {
+    do_functional_warmup(env, traces, trace_index, length, phase_name);
+    return collect_stats(phase, env);
+  }
+
   const auto time_quantum = std::accumulate(std::cbegin(operables), std::cend(operables), champsim::chrono::clock::duration::max(),
                                             [](const auto acc, const operable& y) { return std::min(acc, y.clock_period); });
 
@@ -86,18 +237,25 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
   std::vector<bool> phase_complete(std::size(env.cpu_view()), false);
   while (!std::accumulate(std::begin(phase_complete), std::end(phase_complete), true, std::logical_and{})) {
     auto next_phase_complete = phase_complete;
-    global_clock.tick(time_quantum);
 
-    auto progress = do_cycle(env, traces, trace_index, global_clock);
+    long progress{0};
+    long elapsed_quanta{1};
+    if (engine != nullptr) {
+      elapsed_quanta = options.sync_interval;
+      progress = do_parallel_cycles(env, *engine, traces, trace_index, global_clock, time_quantum, elapsed_quanta);
+    } else {
+      global_clock.tick(time_quantum);
+      progress = do_cycle(env, traces, trace_index, global_clock);
+    }
 
     if (progress == 0) {
-      ++stalled_cycle;
+      stalled_cycle += static_cast<int>(elapsed_quanta);
     } else {
       stalled_cycle = 0;
     }
 
     // Livelock detect, every livelock_period cycles, check progress and alert the user
-    livelock_timer++;
+    livelock_timer += static_cast<uint64_t>(elapsed_quanta);
     if (livelock_timer >= livelock_period) {
       // for each cpu
       for (O3_CPU& cpu : env.cpu_view()) {
@@ -107,11 +265,11 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
           if (livelock_ipc <= *thres) {
             if (std::distance(std::begin(livelock_threshold), thres) == 0) {
               livelock_trigger = true;
-              fmt::print("{} CPU {} panic: IPC {:.5g} < {:.5g}\n", phase_name, cpu.cpu, livelock_ipc, *thres);
+              fmt::print("{}{} CPU {} panic: IPC {:.5g} < {:.5g}\n", output_prefix(), phase_name, cpu.cpu, livelock_ipc, *thres);
             } else if (std::distance(std::begin(livelock_threshold), thres) == 1)
-              fmt::print("{} CPU {} critical: IPC {:.5g} < {:.5g}\n", phase_name, cpu.cpu, livelock_ipc, *thres);
+              fmt::print("{}{} CPU {} critical: IPC {:.5g} < {:.5g}\n", output_prefix(), phase_name, cpu.cpu, livelock_ipc, *thres);
             else
-              fmt::print("{} CPU {} warning: IPC {:.5g} < {:.5g}\n", phase_name, cpu.cpu, livelock_ipc, *thres);
+              fmt::print("{}{} CPU {} warning: IPC {:.5g} < {:.5g}\n", output_prefix(), phase_name, cpu.cpu, livelock_ipc, *thres);
 
             break;
           }
@@ -143,59 +301,112 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
           op.end_phase(cpu.cpu);
         }
 
-        fmt::print("{} finished CPU {} instructions: {} cycles: {} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n", phase_name, cpu.cpu,
-                   cpu.sim_instr(), cpu.sim_cycle(), std::ceil(cpu.sim_instr()) / std::ceil(cpu.sim_cycle()), elapsed_time());
+        fmt::print("{}{} finished CPU {} instructions: {} cycles: {} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n", output_prefix(),
+                   phase_name, cpu.cpu, cpu.sim_instr(), cpu.sim_cycle(), std::ceil(cpu.sim_instr()) / std::ceil(cpu.sim_cycle()), elapsed_time());
       }
     }
 
     phase_complete = next_phase_complete;
-  }
 
-  for (O3_CPU& cpu : env.cpu_view()) {
-    fmt::print("{} complete CPU {} instructions: {} cycles: {} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n", phase_name, cpu.cpu,
-               cpu.sim_instr(), cpu.sim_cycle(), std::ceil(cpu.sim_instr()) / std::ceil(cpu.sim_cycle()), elapsed_time());
-  }
-
-  phase_stats stats;
-  stats.name = phase.name;
+    // Jump over cycles in which nothing can happen. Each skipped quantum counts toward deadlock and livelock detection as if it had been operated.
+    if (options.skip_idle && progress == 0) {
+      auto skipped = std::min({idle_quanta(env, global_clock, time_quantum), static_cast<long>(DEADLOCK_CYCLE - stalled_cycle - 1),
+                               static_cast<long>(livelock_period - livelock_timer - 1)});
+      if (skipped > 0) {
+        global_clock.tick(skipped * time_quantum);
+        for (champsim::operable& op : operables) {
+          op.skip_on(global_clock);
+        }
 
-  for (std::size_t i = 0; i < std::size(trace_index); ++i) {
-    stats.trace_names.push_back(trace_names.at(trace_index.at(i)));
+        stalled_cycle += static_cast<int>(skipped);
+        livelock_timer += static_cast<uint64_t>(skipped);
+      }
+    }
   }
 
-  auto cpus = env.cpu_view();
-  std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.sim_cpu_stats), [](const O3_CPU& cpu) { return cpu.sim_stats; });
-  std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.roi_cpu_stats), [](const O3_CPU& cpu) { return cpu.roi_stats; });
-
-  auto caches = env.cache_view();
-  std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.sim_cache_stats), [](const CACHE& cache) { return cache.sim_stats; });
-  std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.roi_cache_stats), [](const CACHE& cache) { return cache.roi_stats; });
-
-  auto dram = env.dram_view();
-  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.sim_dram_stats),
-                 [](const DRAM_CHANNEL& chan) { return chan.sim_stats; });
-  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.roi_dram_stats),
-                 [](const DRAM_CHANNEL& chan) { return chan.roi_stats; });
+  for (O3_CPU& cpu : env.cpu_view()) {
+    fmt::print("{}{} complete CPU {} instructions: {} cycles: {} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n", output_prefix(),
+               phase_name, cpu.cpu, cpu.sim_instr(), cpu.sim_cycle(), std::ceil(cpu.sim_instr()) / std::ceil(cpu.sim_cycle()), elapsed_time());
+  }
 
-  return stats;
+  return collect_stats(phase, env);
 }
 
 // simulation entry point
-std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces)
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, const run_options& options)
 {
   for (champsim::operable& op : env.operable_view()) {
     op.initialize();
   }
 
+  std::unique_ptr<parallel_engine> engine{};
+  if (options.threads > 1) {
+    engine = std::make_unique<parallel_engine>(env, options.threads);
+    fmt::print("{}Parallel simulation: {} threads, {} core domains, synchronizing every {} cycles\n", output_prefix(), engine->num_threads(),
+               std::size(engine->domains().cores), options.sync_interval);
+  }
+
+  const bool restored = !options.restore_checkpoint.empty();
+  if (restored) {
+    std::ifstream checkpoint_file{options.restore_checkpoint, std::ios::binary};
+    auto trace_positions = checkpoint::restore(checkpoint_file, env);
+
+    // Resume each trace at the first instruction that had not retired
+    auto first_simulation = std::find_if(std::begin(phases), std::end(phases), [](const phase_info& phase) { return !phase.is_warmup; });
+    if (first_simulation != std::end(phases)) {
+      for (std::size_t cpu_idx = 0; cpu_idx < std::size(trace_positions); ++cpu_idx) {
+        traces.at(first_simulation->trace_index.at(cpu_idx)).seek(trace_positions.at(cpu_idx));
+      }
+    }
+    fmt::print("{}Restored checkpoint {} in place of the warmup (Simulation time: {:%H hr %M min %S sec})\n", output_prefix(), options.restore_checkpoint,
+               elapsed_time());
+  }
+
   champsim::chrono::clock global_clock;
   std::vector<phase_stats> results;
   for (auto phase : phases) {
-    auto stats = do_phase(phase, env, traces, global_clock);
+    if (restored && phase.is_warmup) {
+      continue;
+    }
+
+    auto stats = do_phase(phase, env, traces, global_clock, options, engine.get());
     if (!phase.is_warmup) {
       results.push_back(stats);
+    } else if (!options.save_checkpoint.empty()) {
+      std::ofstream checkpoint_file{options.save_checkpoint, std::ios::binary};
+      checkpoint::save(checkpoint_file, env);
+      fmt::print("{}Saved checkpoint {}\n", output_prefix(), options.save_checkpoint);
     }
   }
 
   return results;
 }
+
+// simulation entry point for several configurations, which share one decode of the traces
+std::vector<std::vector<phase_stats>> main(std::vector<std::reference_wrapper<environment>> envs, std::vector<phase_info>& phases,
+                                           std::vector<tracereader> traces, const run_options& options)
+{
+  trace_fanout fanout{std::move(traces), std::size(envs)};
+
+  std::vector<std::future<std::vector<phase_stats>>> futures;
+  for (std::size_t i = 0; i < std::size(envs); ++i) {
+    futures.push_back(std::async(std::launch::async, [&fanout, &phases, &options, env = envs.at(i), i] {
+      // Every line that this configuration prints names it, since the configurations print at the same time
+      output_prefix() = fmt::format("[Configuration {}] ", i);
+      try {
+        auto env_traces = fanout.readers(i);
+        auto results = main(env.get(), phases, env_traces, options);
+        fanout.release(i);
+        return results;
+      } catch (...) {
+        fanout.release(i);
+        throw;
+      }
+    }));
+  }
+
+  std::vector<std::vector<phase_stats>> results;
+  std::transform(std::begin(futures), std::end(futures), std::back_inserter(results), [](auto& fut) { return fut.get(); });
+  return results;
+}
 } // namespace champsim
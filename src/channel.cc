@@ -16,40 +16,67 @@
 
 #include "channel.h"
 
+#include <algorithm>
 #include <cassert>
 #include <fmt/core.h>
+#include <unordered_map>
+#include <utility>
 
 #include "cache.h"
 #include "champsim.h"
 #include "instruction.h"
 #include "util/to_underlying.h" // for to_underlying
 
+namespace
+{
+// Very large and unbounded queues are only partly allocated up front, and grow as they are filled
+constexpr std::size_t MAX_INITIAL_CAPACITY = 1024;
+std::size_t initial_capacity(std::size_t queue_size) { return std::min(queue_size, MAX_INITIAL_CAPACITY); }
+} // namespace
+
 champsim::channel::channel(std::size_t rq_size, std::size_t pq_size, std::size_t wq_size, champsim::data::bits offset_bits, bool match_offset)
-    : RQ_SIZE(rq_size), PQ_SIZE(pq_size), WQ_SIZE(wq_size), OFFSET_BITS(offset_bits), match_offset_bits(match_offset)
+    : RQ_SIZE(rq_size), PQ_SIZE(pq_size), WQ_SIZE(wq_size), OFFSET_BITS(offset_bits), match_offset_bits(match_offset), RQ(::initial_capacity(rq_size)),
+      PQ(::initial_capacity(pq_size)), WQ(::initial_capacity(wq_size))
+{
+}
+
+namespace
 {
+uint64_t block_key(champsim::address addr, champsim::data::bits shamt) { return addr.slice_upper(shamt).to<uint64_t>(); }
+
+template <typename Iter>
+void index_blocks(Iter begin, Iter end, champsim::data::bits shamt, std::unordered_map<uint64_t, std::size_t>& index)
+{
+  index.clear();
+  for (auto it = begin; it != end; ++it) {
+    index.try_emplace(block_key(it->address, shamt), static_cast<std::size_t>(std::distance(begin, it)));
+  }
 }
 
-template <typename Iter, typename F>
-bool do_collision_for(Iter begin, Iter end, champsim::channel::request_type& packet, champsim::data::bits shamt, F&& func)
+template <typename Q, typename F>
+bool do_collision_for(Q& queue, const std::unordered_map<uint64_t, std::size_t>& index, champsim::channel::request_type& packet, champsim::data::bits shamt,
+                      F&& func)
 {
   // We make sure that both merge packet address have been translated. If
   // not this can happen: package with address virtual and physical X
   // (not translated) is inserted, package with physical address
   // (already translated) X.
-  if (auto found =
-          std::find_if(begin, end, [match = packet.address.slice_upper(shamt), shamt](const auto& x) { return x.address.slice_upper(shamt) == match; });
-      found != end && packet.is_translated == found->is_translated) {
-    func(packet, *found);
-    return true;
+  if (auto found = index.find(block_key(packet.address, shamt)); found != std::end(index)) {
+    auto& destination = queue[found->second];
+    if (packet.is_translated == destination.is_translated) {
+      func(packet, destination);
+      return true;
+    }
   }
 
   return false;
 }
 
-template <typename Iter>
-bool do_collision_for_merge(Iter begin, Iter end, champsim::channel::request_type& packet, champsim::data::bits shamt)
+template <typename Q>
+bool do_collision_for_merge(Q& queue, const std::unordered_map<uint64_t, std::size_t>& index, champsim::channel::request_type& packet,
+                            champsim::data::bits shamt)
 {
-  return do_collision_for(begin, end, packet, shamt, [](champsim::channel::request_type& source, champsim::channel::request_type& destination) {
+  return do_collision_for(queue, index, packet, shamt, [](champsim::channel::request_type& source, champsim::channel::request_type& destination) {
     destination.response_requested |= source.response_requested;
     auto instr_copy = std::move(destination.instr_depend_on_me);
 
@@ -58,64 +85,79 @@ bool do_collision_for_merge(Iter begin, Iter end, champsim::channel::request_typ
   });
 }
 
-template <typename Iter>
-bool do_collision_for_return(Iter begin, Iter end, champsim::channel::request_type& packet, champsim::data::bits shamt,
-                             std::deque<champsim::channel::response_type>& returned)
+template <typename Q>
+bool do_collision_for_return(Q& queue, const std::unordered_map<uint64_t, std::size_t>& index, champsim::channel::request_type& packet,
+                             champsim::data::bits shamt, champsim::channel::response_queue_type& returned)
 {
-  return do_collision_for(begin, end, packet, shamt, [&](champsim::channel::request_type& source, champsim::channel::request_type& destination) {
+  return do_collision_for(queue, index, packet, shamt, [&](champsim::channel::request_type& source, champsim::channel::request_type& destination) {
     if (source.response_requested) {
       returned.emplace_back(source.address, source.v_address, destination.data, destination.pf_metadata, source.instr_depend_on_me);
     }
   });
 }
+} // namespace
 
 void champsim::channel::check_collision()
 {
   auto write_shamt = match_offset_bits ? champsim::data::bits{} : OFFSET_BITS;
   auto read_shamt = OFFSET_BITS;
 
+  auto wq_it = std::find_if(std::begin(WQ), std::end(WQ), std::not_fn(&request_type::forward_checked));
+  auto rq_it = std::find_if(std::begin(RQ), std::end(RQ), std::not_fn(&request_type::forward_checked));
+  auto pq_it = std::find_if(std::begin(PQ), std::end(PQ), std::not_fn(&request_type::forward_checked));
+  if (wq_it == std::end(WQ) && rq_it == std::end(RQ) && pq_it == std::end(PQ)) {
+    return;
+  }
+
   // Check WQ for duplicates, merging if they are found
-  for (auto wq_it = std::find_if(std::begin(WQ), std::end(WQ), std::not_fn(&request_type::forward_checked)); wq_it != std::end(WQ);) {
-    if (do_collision_for_merge(std::begin(WQ), wq_it, *wq_it, write_shamt)) {
+  // Merged packets are always the youngest checked so far, so removing them does not move the indexed entries
+  index_blocks(std::begin(WQ), wq_it, write_shamt, forward_index);
+  while (wq_it != std::end(WQ)) {
+    if (do_collision_for_merge(WQ, forward_index, *wq_it, write_shamt)) {
       sim_stats.WQ_MERGED++;
       wq_it = WQ.erase(wq_it);
     } else {
       wq_it->forward_checked = true;
+      forward_index.try_emplace(block_key(wq_it->address, write_shamt), static_cast<std::size_t>(std::distance(std::begin(WQ), wq_it)));
       ++wq_it;
     }
   }
 
   // Check RQ for forwarding from WQ (return if found), then for duplicates (merge if found)
-  for (auto rq_it = std::find_if(std::begin(RQ), std::end(RQ), std::not_fn(&request_type::forward_checked)); rq_it != std::end(RQ);) {
-    if (do_collision_for_return(std::begin(WQ), std::end(WQ), *rq_it, write_shamt, returned)) {
+  index_blocks(std::begin(RQ), rq_it, read_shamt, merge_index);
+  while (rq_it != std::end(RQ)) {
+    if (do_collision_for_return(WQ, forward_index, *rq_it, write_shamt, returned)) {
       sim_stats.WQ_FORWARD++;
       rq_it = RQ.erase(rq_it);
-    } else if (do_collision_for_merge(std::begin(RQ), rq_it, *rq_it, read_shamt)) {
+    } else if (do_collision_for_merge(RQ, merge_index, *rq_it, read_shamt)) {
       sim_stats.RQ_MERGED++;
       rq_it = RQ.erase(rq_it);
     } else {
       rq_it->forward_checked = true;
+      merge_index.try_emplace(block_key(rq_it->address, read_shamt), static_cast<std::size_t>(std::distance(std::begin(RQ), rq_it)));
       ++rq_it;
     }
   }
 
   // Check PQ for forwarding from WQ (return if found), then for duplicates (merge if found)
-  for (auto pq_it = std::find_if(std::begin(PQ), std::end(PQ), std::not_fn(&request_type::forward_checked)); pq_it != std::end(PQ);) {
-    if (do_collision_for_return(std::begin(WQ), std::end(WQ), *pq_it, write_shamt, returned)) {
+  index_blocks(std::begin(PQ), pq_it, read_shamt, merge_index);
+  while (pq_it != std::end(PQ)) {
+    if (do_collision_for_return(WQ, forward_index, *pq_it, write_shamt, returned)) {
       sim_stats.WQ_FORWARD++;
       pq_it = PQ.erase(pq_it);
-    } else if (do_collision_for_merge(std::begin(PQ), pq_it, *pq_it, read_shamt)) {
+    } else if (do_collision_for_merge(PQ, merge_index, *pq_it, read_shamt)) {
       sim_stats.PQ_MERGED++;
       pq_it = PQ.erase(pq_it);
     } else {
       pq_it->forward_checked = true;
+      merge_index.try_emplace(block_key(pq_it->address, read_shamt), static_cast<std::size_t>(std::distance(std::begin(PQ), pq_it)));
       ++pq_it;
     }
   }
 }
 
-template <typename R>
-bool champsim::channel::do_add_queue(R& queue, std::size_t queue_size, const typename R::value_type& packet)
+template <typename R, typename P>
+bool champsim::channel::do_add_queue(R& queue, std::size_t queue_size, P&& packet)
 {
   // check occupancy
   if (std::size(queue) >= queue_size) {
@@ -123,14 +165,19 @@ bool champsim::channel::do_add_queue(R& queue, std::size_t queue_size, const typ
   }
 
   // Insert the packet ahead of the translation misses
-  auto fwd_pkt = packet;
-  fwd_pkt.forward_checked = false;
-  queue.push_back(fwd_pkt);
+  queue.emplace_back(std::forward<P>(packet)).forward_checked = false;
 
   return true;
 }
 
-bool champsim::channel::add_rq(const request_type& packet)
+// Packets that are added by reference are copied into the queue, while those that are added by value are moved into it
+bool champsim::channel::add_rq(const request_type& packet) { return add_rq(request_type{packet}); }
+
+bool champsim::channel::add_wq(const request_type& packet) { return add_wq(request_type{packet}); }
+
+bool champsim::channel::add_pq(const request_type& packet) { return add_pq(request_type{packet}); }
+
+bool champsim::channel::add_rq(request_type&& packet)
 {
   if constexpr (champsim::debug_print) {
     fmt::print("[channel_rq] {} instr_id: {} address: {} v_address: {} type: {}\n", __func__, packet.instr_id, packet.address, packet.v_address,
@@ -139,7 +186,7 @@ bool champsim::channel::add_rq(const request_type& packet)
 
   sim_stats.RQ_ACCESS++;
 
-  auto result = do_add_queue(RQ, RQ_SIZE, packet);
+  auto result = do_add_queue(RQ, RQ_SIZE, std::move(packet));
 
   if (result) {
     sim_stats.RQ_TO_CACHE++;
@@ -150,7 +197,7 @@ bool champsim::channel::add_rq(const request_type& packet)
   return result;
 }
 
-bool champsim::channel::add_wq(const request_type& packet)
+bool champsim::channel::add_wq(request_type&& packet)
 {
   if constexpr (champsim::debug_print) {
     fmt::print("[channel_wq] {} instr_id: {} address: {} v_address: {} type: {}\n", __func__, packet.instr_id, packet.address, packet.v_address,
@@ -159,7 +206,7 @@ bool champsim::channel::add_wq(const request_type& packet)
 
   sim_stats.WQ_ACCESS++;
 
-  auto result = do_add_queue(WQ, WQ_SIZE, packet);
+  auto result = do_add_queue(WQ, WQ_SIZE, std::move(packet));
 
   if (result) {
     sim_stats.WQ_TO_CACHE++;
@@ -170,7 +217,7 @@ bool champsim::channel::add_wq(const request_type& packet)
   return result;
 }
 
-bool champsim::channel::add_pq(const request_type& packet)
+bool champsim::channel::add_pq(request_type&& packet)
 {
   if constexpr (champsim::debug_print) {
     fmt::print("[channel_pq] {} instr_id: {} address: {} v_address: {} type: {}\n", __func__, packet.instr_id, packet.address, packet.v_address,
@@ -179,8 +226,7 @@ bool champsim::channel::add_pq(const request_type& packet)
 
   sim_stats.PQ_ACCESS++;
 
-  auto fwd_pkt = packet;
-  auto result = do_add_queue(PQ, PQ_SIZE, fwd_pkt);
+  auto result = do_add_queue(PQ, PQ_SIZE, std::move(packet));
   if (result) {
     sim_stats.PQ_TO_CACHE++;
   } else {
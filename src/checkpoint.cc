@@ -0,0 +1,147 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "checkpoint.h"
+
+#include <algorithm>
+#include <array>
+#include <sstream>
+#include <string>
+
+#include "environment.h"
+#include "vmem.h"
+
+namespace
+{
+constexpr std::array<char, 8> checkpoint_magic{'C', 'H', 'A', 'M', 'P', 'C', 'K', 'P'};
+constexpr uint32_t checkpoint_version = 3;
+
+/**
+ * Each section is preceded by its length, so that a component that reads more or less than was written is caught at that component.
+ */
+template <typename F>
+void write_section(std::ostream& os, F&& func)
+{
+  std::ostringstream section;
+  func(section);
+  auto contents = section.str();
+  champsim::checkpoint::write(os, static_cast<uint64_t>(std::size(contents)));
+  os.write(std::data(contents), static_cast<std::streamsize>(std::size(contents)));
+}
+
+template <typename F>
+void read_section(std::istream& is, std::size_t index, F&& func)
+{
+  uint64_t size{};
+  champsim::checkpoint::read(is, size);
+  std::string contents(size, '\0');
+  if (!is.read(std::data(contents), static_cast<std::streamsize>(size)))
+    throw champsim::checkpoint::format_error{"Checkpoint ended unexpectedly"};
+
+  std::istringstream section{contents};
+  func(section);
+  if (section.peek() != std::istringstream::traits_type::eof())
+    throw champsim::checkpoint::format_error{"Checkpoint section " + std::to_string(index) + " does not match the configuration"};
+}
+
+void check_count(uint64_t saved, std::size_t configured, const std::string& what)
+{
+  if (saved != configured)
+    throw champsim::checkpoint::format_error{"Checkpoint has " + std::to_string(saved) + " " + what + ", but the configuration has "
+                                             + std::to_string(configured)};
+}
+
+// The page table walkers may share a virtual memory, which should only be saved once
+std::vector<VirtualMemory*> unique_vmems(champsim::environment& env)
+{
+  std::vector<VirtualMemory*> retval;
+  for (PageTableWalker& ptw : env.ptw_view()) {
+    if (ptw.vmem != nullptr && std::find(std::begin(retval), std::end(retval), ptw.vmem) == std::end(retval)) {
+      retval.push_back(ptw.vmem);
+    }
+  }
+  return retval;
+}
+} // namespace
+
+void champsim::checkpoint::save(std::ostream& os, environment& env)
+{
+  auto operables = env.operable_view();
+  auto vmems = unique_vmems(env);
+  auto cpus = env.cpu_view();
+
+  write(os, checkpoint_magic);
+  write(os, checkpoint_version);
+  write(os, static_cast<uint64_t>(std::size(operables)));
+  write(os, static_cast<uint64_t>(std::size(vmems)));
+  write(os, static_cast<uint64_t>(std::size(cpus)));
+
+  for (const champsim::operable& op : operables) {
+    write_section(os, [&](std::ostream& section) { op.save_checkpoint(section); });
+  }
+  for (const auto* vmem : vmems) {
+    write_section(os, [&](std::ostream& section) { vmem->save_checkpoint(section); });
+  }
+
+  // The trace position is the number of retired instructions. Instructions still in flight are not saved, and are read from the trace again on restore.
+  for (const O3_CPU& cpu : cpus) {
+    write(os, static_cast<uint64_t>(cpu.num_retired));
+  }
+
+  if (!os)
+    throw std::runtime_error{"Checkpoint could not be written"};
+}
+
+std::vector<uint64_t> champsim::checkpoint::restore(std::istream& is, environment& env)
+{
+  auto operables = env.operable_view();
+  auto vmems = unique_vmems(env);
+  auto cpus = env.cpu_view();
+
+  std::array<char, std::size(checkpoint_magic)> magic{};
+  uint32_t version{};
+  read(is, magic);
+  read(is, version);
+  if (magic != checkpoint_magic)
+    throw format_error{"File is not a checkpoint"};
+  if (version != checkpoint_version)
+    throw format_error{"Unsupported checkpoint version " + std::to_string(version)};
+
+  uint64_t num_operables{};
+  uint64_t num_vmems{};
+  uint64_t num_cpus{};
+  read(is, num_operables);
+  read(is, num_vmems);
+  read(is, num_cpus);
+  check_count(num_operables, std::size(operables), "operables");
+  check_count(num_vmems, std::size(vmems), "virtual memories");
+  check_count(num_cpus, std::size(cpus), "cores");
+
+  std::size_t index{0};
+  for (champsim::operable& op : operables) {
+    read_section(is, index++, [&](std::istream& section) { op.restore_checkpoint(section); });
+  }
+  for (auto* vmem : vmems) {
+    read_section(is, index++, [&](std::istream& section) { vmem->restore_checkpoint(section); });
+  }
+
+  std::vector<uint64_t> trace_positions(std::size(cpus));
+  for (auto& position : trace_positions) {
+    read(is, position);
+  }
+
+  return trace_positions;
+}
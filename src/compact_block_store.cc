@@ -0,0 +1,80 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "compact_block_store.h"
+
+#include "checkpoint.h"
+
+namespace
+{
+constexpr uint8_t prefetch_flag = 0x1;
+constexpr uint8_t dirty_flag = 0x2;
+} // namespace
+
+champsim::compact_block_store::compact_block_store(std::size_t num_blocks, bool keep_v_address, bool keep_data)
+    : flags(num_blocks), pf_metadata(num_blocks), v_address(keep_v_address ? num_blocks : 0), data(keep_data ? num_blocks : 0)
+{
+}
+
+champsim::cache_block champsim::compact_block_store::get(std::size_t index, const champsim::tag_store& tags) const
+{
+  champsim::cache_block blk;
+  blk.valid = tags.is_valid(index);
+  blk.prefetch = (flags.at(index) & prefetch_flag) != 0;
+  blk.dirty = (flags.at(index) & dirty_flag) != 0;
+  blk.address = tags.address_of(index);
+  blk.pf_metadata = pf_metadata.at(index);
+  if (!std::empty(v_address)) {
+    blk.v_address = v_address.at(index);
+  }
+  if (!std::empty(data)) {
+    blk.data = data.at(index);
+  }
+  return blk;
+}
+
+void champsim::compact_block_store::assign(std::size_t index, const champsim::cache_block& blk)
+{
+  assign_state(index, blk.dirty, blk.prefetch);
+  pf_metadata.at(index) = blk.pf_metadata;
+  if (!std::empty(v_address)) {
+    v_address.at(index) = blk.v_address;
+  }
+  if (!std::empty(data)) {
+    data.at(index) = blk.data;
+  }
+}
+
+void champsim::compact_block_store::assign_state(std::size_t index, bool dirty, bool prefetch)
+{
+  flags.at(index) = static_cast<uint8_t>((prefetch ? prefetch_flag : 0) | (dirty ? dirty_flag : 0));
+}
+
+void champsim::compact_block_store::save_checkpoint(std::ostream& os) const
+{
+  champsim::checkpoint::write(os, flags);
+  champsim::checkpoint::write(os, pf_metadata);
+  champsim::checkpoint::write(os, v_address);
+  champsim::checkpoint::write(os, data);
+}
+
+void champsim::compact_block_store::restore_checkpoint(std::istream& is)
+{
+  champsim::checkpoint::read(is, flags);
+  champsim::checkpoint::read(is, pf_metadata);
+  champsim::checkpoint::read(is, v_address);
+  champsim::checkpoint::read(is, data);
+}
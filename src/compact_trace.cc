@@ -0,0 +1,233 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "compact_trace.h"
+
+#include <iterator>
+#include <stdexcept>
+
+namespace
+{
+constexpr unsigned is_branch_bit = 0;
+constexpr unsigned branch_taken_bit = 1;
+constexpr unsigned register_bits = 2;
+constexpr unsigned memory_bits = register_bits + NUM_INSTR_DESTINATIONS + NUM_INSTR_SOURCES;
+constexpr unsigned raw_branch_bit = 14;
+constexpr unsigned reserved_bit = 15;
+constexpr std::size_t max_varint_size = 10;
+
+uint64_t zigzag(uint64_t difference)
+{
+  auto value = static_cast<int64_t>(difference);
+  return (difference << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+uint64_t unzigzag(uint64_t value) { return (value >> 1) ^ (~(value & 1) + 1); }
+
+void put_varint(uint64_t value, std::vector<unsigned char>& out)
+{
+  while (value >= 0x80) {
+    out.push_back(static_cast<unsigned char>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<unsigned char>(value));
+}
+
+unsigned char* register_slot(input_instr& instr, std::size_t slot)
+{
+  return slot < NUM_INSTR_DESTINATIONS ? &instr.destination_registers[slot] : &instr.source_registers[slot - NUM_INSTR_DESTINATIONS];
+}
+
+unsigned char register_slot(const input_instr& instr, std::size_t slot)
+{
+  return slot < NUM_INSTR_DESTINATIONS ? instr.destination_registers[slot] : instr.source_registers[slot - NUM_INSTR_DESTINATIONS];
+}
+
+unsigned long long* memory_slot(input_instr& instr, std::size_t slot)
+{
+  return slot < NUM_INSTR_DESTINATIONS ? &instr.destination_memory[slot] : &instr.source_memory[slot - NUM_INSTR_DESTINATIONS];
+}
+
+unsigned long long memory_slot(const input_instr& instr, std::size_t slot)
+{
+  return slot < NUM_INSTR_DESTINATIONS ? instr.destination_memory[slot] : instr.source_memory[slot - NUM_INSTR_DESTINATIONS];
+}
+
+// Reads fields from the front of a byte range, remembering whether the range ran out
+struct byte_cursor {
+  const unsigned char* current;
+  const unsigned char* end;
+  bool complete = true;
+
+  unsigned char take_byte()
+  {
+    if (current == end) {
+      complete = false;
+      return 0;
+    }
+    return *current++;
+  }
+
+  uint64_t take_varint()
+  {
+    uint64_t retval = 0;
+    for (std::size_t i = 0; i < max_varint_size && complete; ++i) {
+      auto byte = take_byte();
+      retval |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+      if ((byte & 0x80) == 0) {
+        return retval;
+      }
+    }
+
+    if (complete) {
+      throw std::runtime_error{"Compact trace record has an overlong varint"};
+    }
+    return retval;
+  }
+};
+} // namespace
+
+uint64_t champsim::compact::codec_state::predict_ip() const
+{
+  const auto& previous = table[index(last_ip)];
+  auto predicted = last_taken ? previous.target : previous.fall_through;
+  if (previous.ip != last_ip || predicted == 0) {
+    return last_ip;
+  }
+  return predicted;
+}
+
+uint64_t champsim::compact::codec_state::address_base(uint64_t ip, std::size_t slot) const
+{
+  const auto& current = table[index(ip)];
+  if (current.ip != ip || current.addresses[slot] == 0) {
+    return last_address;
+  }
+  return current.addresses[slot];
+}
+
+void champsim::compact::codec_state::update(const input_instr& instr)
+{
+  // Remember where the previous instruction went
+  auto& previous = table[index(last_ip)];
+  if (previous.ip == last_ip) {
+    (last_taken ? previous.target : previous.fall_through) = instr.ip;
+  }
+
+  auto& current = table[index(instr.ip)];
+  if (current.ip != instr.ip) {
+    current = entry{};
+    current.ip = instr.ip;
+  }
+
+  for (std::size_t slot = 0; slot < num_slots; ++slot) {
+    if (auto address = ::memory_slot(instr, slot); address != 0) {
+      current.addresses[slot] = address;
+      last_address = address;
+    }
+  }
+
+  last_ip = instr.ip;
+  last_taken = instr.is_branch && instr.branch_taken;
+}
+
+void champsim::compact::encoder::encode(const input_instr& instr, std::vector<unsigned char>& out)
+{
+  unsigned mask = 0;
+  bool raw_branch = instr.is_branch > 1 || instr.branch_taken > 1;
+  if (raw_branch) {
+    mask |= 1u << raw_branch_bit;
+  } else {
+    mask |= static_cast<unsigned>(instr.is_branch) << is_branch_bit;
+    mask |= static_cast<unsigned>(instr.branch_taken) << branch_taken_bit;
+  }
+  for (std::size_t slot = 0; slot < codec_state::num_slots; ++slot) {
+    if (::register_slot(instr, slot) != 0) {
+      mask |= 1u << (register_bits + slot);
+    }
+    if (::memory_slot(instr, slot) != 0) {
+      mask |= 1u << (memory_bits + slot);
+    }
+  }
+
+  out.push_back(static_cast<unsigned char>(mask));
+  out.push_back(static_cast<unsigned char>(mask >> 8));
+  if (raw_branch) {
+    out.push_back(instr.is_branch);
+    out.push_back(instr.branch_taken);
+  }
+
+  ::put_varint(::zigzag(instr.ip - state.predict_ip()), out);
+
+  for (std::size_t slot = 0; slot < codec_state::num_slots; ++slot) {
+    if (auto reg = ::register_slot(instr, slot); reg != 0) {
+      out.push_back(reg);
+    }
+  }
+
+  for (std::size_t slot = 0; slot < codec_state::num_slots; ++slot) {
+    if (auto address = ::memory_slot(instr, slot); address != 0) {
+      ::put_varint(::zigzag(address - state.address_base(instr.ip, slot)), out);
+    }
+  }
+
+  state.update(instr);
+}
+
+auto champsim::compact::decoder::decode(const unsigned char* begin, const unsigned char* end) -> std::optional<std::pair<input_instr, std::size_t>>
+{
+  ::byte_cursor cursor{begin, end};
+  input_instr retval{};
+
+  unsigned mask = cursor.take_byte();
+  mask |= static_cast<unsigned>(cursor.take_byte()) << 8;
+  if (!cursor.complete) {
+    return std::nullopt;
+  }
+  if (mask & (1u << reserved_bit)) {
+    throw std::runtime_error{"Compact trace record has an unknown field"};
+  }
+
+  if (mask & (1u << raw_branch_bit)) {
+    retval.is_branch = cursor.take_byte();
+    retval.branch_taken = cursor.take_byte();
+  } else {
+    retval.is_branch = (mask >> is_branch_bit) & 1;
+    retval.branch_taken = (mask >> branch_taken_bit) & 1;
+  }
+
+  retval.ip = state.predict_ip() + ::unzigzag(cursor.take_varint());
+
+  for (std::size_t slot = 0; slot < codec_state::num_slots; ++slot) {
+    if (mask & (1u << (register_bits + slot))) {
+      *::register_slot(retval, slot) = cursor.take_byte();
+    }
+  }
+
+  for (std::size_t slot = 0; slot < codec_state::num_slots; ++slot) {
+    if (mask & (1u << (memory_bits + slot))) {
+      *::memory_slot(retval, slot) = state.address_base(retval.ip, slot) + ::unzigzag(cursor.take_varint());
+    }
+  }
+
+  if (!cursor.complete) {
+    return std::nullopt;
+  }
+
+  // The state only learns from complete records, so that an incomplete one can be decoded again once the rest of it has been read
+  state.update(retval);
+  return std::pair{retval, static_cast<std::size_t>(std::distance(begin, cursor.current))};
+}
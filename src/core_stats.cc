@@ -8,6 +8,12 @@ cpu_stats operator-(cpu_stats lhs, cpu_stats rhs)
   lhs.end_cycles -= rhs.end_cycles;
   lhs.total_rob_occupancy_at_branch_mispredict -= rhs.total_rob_occupancy_at_branch_mispredict;
 
+  lhs.value_predictions -= rhs.value_predictions;
+  lhs.value_confident_predictions -= rhs.value_confident_predictions;
+  lhs.value_mispredictions -= rhs.value_mispredictions;
+  lhs.value_recovery_cycles -= rhs.value_recovery_cycles;
+  lhs.value_reissued_instrs -= rhs.value_reissued_instrs;
+
   lhs.total_branch_types -= rhs.total_branch_types;
   lhs.branch_type_misses -= rhs.branch_type_misses;
 
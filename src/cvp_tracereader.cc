@@ -0,0 +1,168 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cvp_tracereader.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+constexpr unsigned char REG_AX = 56;
+constexpr unsigned char REG_LINK = 30; // ARM links the return address in X30
+
+// Reads little-endian fields from the front of a byte range, remembering whether the range ran out
+struct byte_cursor {
+  const unsigned char* current;
+  const unsigned char* end;
+  bool complete = true;
+
+  template <typename T>
+  T take(std::size_t bytes = sizeof(T))
+  {
+    T retval{};
+    if (static_cast<std::size_t>(std::distance(current, end)) < bytes) {
+      complete = false;
+      current = end;
+      return retval;
+    }
+    std::memcpy(&retval, current, std::min(bytes, sizeof(T)));
+    current += bytes;
+    return retval;
+  }
+};
+
+// Registers that collide with the ones ChampSim uses to classify branches are moved out of the way
+unsigned char remap_register(unsigned char reg)
+{
+  if (reg == champsim::REG_INSTRUCTION_POINTER)
+    return 64;
+  if (reg == champsim::REG_STACK_POINTER)
+    return 65;
+  if (reg == champsim::REG_FLAGS)
+    return 66;
+  if (reg == 0)
+    return 67;
+  return reg;
+}
+} // namespace
+
+std::optional<std::pair<ooo_model_instr, std::size_t>> champsim::cvp::decode(uint8_t cpu, const unsigned char* begin, const unsigned char* end)
+{
+  byte_cursor cursor{begin, end};
+
+  auto pc = cursor.take<uint64_t>();
+  auto type = cursor.take<uint8_t>();
+  if (cursor.complete && type > static_cast<uint8_t>(inst_class::UNDEF)) {
+    throw std::runtime_error{"Unknown CVP instruction class " + std::to_string(type)};
+  }
+
+  auto iclass = static_cast<inst_class>(type);
+  bool branch = (iclass == inst_class::COND_BRANCH || iclass == inst_class::UNCOND_DIRECT_BRANCH || iclass == inst_class::UNCOND_INDIRECT_BRANCH);
+
+  uint64_t ea = 0;
+  uint8_t access_size = 0;
+  bool taken = false;
+  uint64_t target = 0;
+  if (iclass == inst_class::LOAD || iclass == inst_class::STORE) {
+    ea = cursor.take<uint64_t>();
+    access_size = cursor.take<uint8_t>();
+  } else if (branch) {
+    taken = cursor.take<uint8_t>();
+    target = taken ? cursor.take<uint64_t>() : pc + 4;
+  }
+
+  std::array<unsigned char, 256> input_names{};
+  auto num_inputs = cursor.take<uint8_t>();
+  for (std::size_t i = 0; i < num_inputs; ++i) {
+    input_names[i] = cursor.take<unsigned char>();
+  }
+
+  std::array<unsigned char, 256> output_names{};
+  auto num_outputs = cursor.take<uint8_t>();
+  for (std::size_t i = 0; i < num_outputs; ++i) {
+    output_names[i] = cursor.take<unsigned char>();
+  }
+
+  // Only the low 64 bits of each output are kept, but SIMD outputs occupy 128 bits in the record
+  std::array<uint64_t, 256> output_values{};
+  for (std::size_t i = 0; i < num_outputs && cursor.complete; ++i) {
+    if (output_names[i] <= 31 || output_names[i] == 64) {
+      output_values[i] = cursor.take<uint64_t>();
+    } else if (output_names[i] < 64) {
+      output_values[i] = cursor.take<uint64_t>(16);
+    } else {
+      throw std::runtime_error{"Unknown CVP output register " + std::to_string(output_names[i])};
+    }
+  }
+
+  if (!cursor.complete) {
+    return std::nullopt;
+  }
+
+  value_instr vi{};
+  vi.ip = pc;
+  vi.version = champsim::VALUE_TRACE_VERSION;
+
+  if (branch) {
+    vi.is_branch = true;
+    vi.branch_taken = taken;
+    vi.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    vi.destination_register_values[0] = target; // the new IP is the target (or the fallthrough)
+
+    bool is_return = (num_inputs == 1 && input_names[0] == REG_LINK);
+    bool is_call = (num_outputs == 1 && output_names[0] == REG_LINK);
+    if (iclass == inst_class::COND_BRANCH) {
+      vi.source_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+      vi.source_registers[1] = champsim::REG_FLAGS;
+    } else if (is_return) {
+      vi.destination_registers[1] = champsim::REG_STACK_POINTER;
+      vi.source_registers[0] = champsim::REG_STACK_POINTER;
+    } else if (is_call) {
+      vi.destination_registers[1] = champsim::REG_STACK_POINTER;
+      vi.source_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+      vi.source_registers[1] = champsim::REG_STACK_POINTER;
+      if (iclass == inst_class::UNCOND_INDIRECT_BRANCH) {
+        vi.source_registers[2] = REG_AX;
+      }
+    } else if (iclass == inst_class::UNCOND_INDIRECT_BRANCH) {
+      vi.source_registers[0] = REG_AX;
+    }
+  } else {
+    // Only the first output is modeled, and an instruction without outputs still occupies a register
+    vi.destination_registers[0] = remap_register(num_outputs > 0 ? output_names[0] : 0);
+    vi.destination_register_values[0] = output_values[0];
+    std::transform(std::begin(input_names), std::next(std::begin(input_names), std::min<std::size_t>(num_inputs, NUM_INSTR_SOURCES)),
+                   std::begin(vi.source_registers), remap_register);
+
+    if (iclass == inst_class::LOAD) {
+      vi.source_memory[0] = ea;
+      vi.source_memory_size[0] = access_size;
+      vi.source_memory_values[0] = output_values[0]; // the loaded value is what lands in the destination register
+    } else if (iclass == inst_class::STORE) {
+      // CVP traces do not record store data, so only the size is known
+      vi.destination_memory[0] = ea;
+      vi.destination_memory_size[0] = access_size;
+    }
+  }
+
+  ooo_model_instr retval{cpu, vi};
+  retval.instr_class = iclass;
+  retval.branch_target = (retval.is_branch && retval.branch_taken) ? champsim::address{target} : champsim::address{};
+  return std::pair{retval, static_cast<std::size_t>(std::distance(begin, cursor.current))};
+}
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <cfenv>
 #include <cmath>
+#include <functional>
 #include <fmt/core.h>
 
 #include "deadlock.h"
@@ -43,7 +44,8 @@ MEMORY_CONTROLLER::MEMORY_CONTROLLER(champsim::chrono::picoseconds dbus_period,
 DRAM_CHANNEL::DRAM_CHANNEL(champsim::chrono::picoseconds dbus_period, champsim::chrono::picoseconds mc_period, std::size_t t_rp, std::size_t t_rcd,
                            std::size_t t_cas, std::size_t t_ras, champsim::chrono::microseconds refresh_period, std::size_t refreshes_per_period,
                            champsim::data::bytes width, std::size_t rq_size, std::size_t wq_size, DRAM_ADDRESS_MAPPING addr_mapper)
-    : champsim::operable(mc_period), address_mapping(addr_mapper), WQ{wq_size}, RQ{rq_size}, channel_width(width),
+    : champsim::operable(mc_period), address_mapping(addr_mapper), request_pool(std::make_shared<champsim::packet_pool<value_type>>(rq_size + wq_size)),
+      WQ(wq_size, champsim::pooled_slot<value_type>{request_pool}), RQ(rq_size, champsim::pooled_slot<value_type>{request_pool}), channel_width(width),
       DRAM_ROWS_PER_REFRESH(address_mapping.rows() / refreshes_per_period), tRP(t_rp * mc_period), tRCD(t_rcd * mc_period), tCAS(t_cas * mc_period),
       tRAS(t_ras * mc_period), tREF(refresh_period / refreshes_per_period),
       tRFC(std::chrono::duration_cast<champsim::chrono::clock::duration>(
@@ -111,9 +113,8 @@ long DRAM_CHANNEL::operate()
   if (warmup) {
     for (auto& entry : RQ) {
       if (entry.has_value()) {
-        response_type response{entry->address, entry->v_address, entry->data, entry->pf_metadata, entry->instr_depend_on_me};
         for (auto* ret : entry.value().to_return) {
-          ret->push_back(response);
+          ret->emplace_back(entry->address, entry->v_address, entry->data, entry->pf_metadata, entry->instr_depend_on_me);
         }
 
         ++progress;
@@ -145,10 +146,9 @@ long DRAM_CHANNEL::finish_dbus_request()
   long progress{0};
 
   if (active_request != std::end(bank_request) && active_request->ready_time <= current_time) {
-    response_type response{active_request->pkt->value().address, active_request->pkt->value().v_address, active_request->pkt->value().data,
-                           active_request->pkt->value().pf_metadata, active_request->pkt->value().instr_depend_on_me};
-    for (auto* ret : active_request->pkt->value().to_return) {
-      ret->push_back(response);
+    const auto& finished = active_request->pkt->value();
+    for (auto* ret : finished.to_return) {
+      ret->emplace_back(finished.address, finished.v_address, finished.data, finished.pf_metadata, finished.instr_depend_on_me);
     }
 
     active_request->valid = false;
@@ -365,6 +365,66 @@ long DRAM_CHANNEL::service_packet(DRAM_CHANNEL::queue_type::iterator pkt)
   return progress;
 }
 
+champsim::chrono::clock::time_point MEMORY_CONTROLLER::next_event_time() const
+{
+  auto has_requests = [](const channel_type* ul) {
+    return !std::empty(ul->RQ) || !std::empty(ul->WQ) || !std::empty(ul->PQ);
+  };
+  if (std::any_of(std::begin(queues), std::end(queues), has_requests)) {
+    return current_time + clock_period;
+  }
+
+  auto next_event = champsim::chrono::clock::time_point::max();
+  for (const auto& chan : channels) {
+    next_event = std::min(next_event, chan.next_event_time());
+  }
+  return next_event;
+}
+
+void MEMORY_CONTROLLER::skip(long cycles)
+{
+  // The channels are operated once per cycle of the controller
+  for (auto& chan : channels) {
+    chan._skip(cycles);
+  }
+}
+
+champsim::chrono::clock::time_point DRAM_CHANNEL::next_event_time() const
+{
+  auto has_request = [](const auto& entry) {
+    return entry.has_value();
+  };
+  auto is_unchecked = [](const auto& entry) {
+    return entry.has_value() && !entry->forward_checked;
+  };
+  // A request that is ready for the data bus but must wait for it is counted as congestion every cycle
+  auto is_busy = [time = current_time](const BANK_REQUEST& b_req) {
+    return b_req.under_refresh || (b_req.need_refresh && !b_req.valid) || (b_req.valid && b_req.ready_time <= time);
+  };
+
+  bool returns_immediately = warmup && (std::any_of(std::begin(RQ), std::end(RQ), has_request) || std::any_of(std::begin(WQ), std::end(WQ), has_request));
+  if (returns_immediately || std::any_of(std::begin(RQ), std::end(RQ), is_unchecked) || std::any_of(std::begin(WQ), std::end(WQ), is_unchecked)
+      || std::any_of(std::begin(bank_request), std::end(bank_request), is_busy)) {
+    return current_time + clock_period;
+  }
+
+  // Otherwise, wait for the next refresh, bank to finish, or packet to become ready to schedule
+  auto next_event = last_refresh + tREF;
+  for (const auto& b_req : bank_request) {
+    if (b_req.valid) {
+      next_event = std::min(next_event, b_req.ready_time);
+    }
+  }
+  for (auto q : {std::cref(RQ), std::cref(WQ)}) {
+    for (const auto& entry : q.get()) {
+      if (entry.has_value() && !entry->scheduled && entry->ready_time > current_time) {
+        next_event = std::min(next_event, entry->ready_time);
+      }
+    }
+  }
+  return next_event;
+}
+
 void MEMORY_CONTROLLER::initialize()
 {
   using namespace champsim::data::data_literals;
@@ -452,10 +512,9 @@ void DRAM_CHANNEL::check_read_collision()
       };
       // write forward
       if (auto wq_it = std::find_if(std::begin(WQ), std::end(WQ), checker); wq_it != std::end(WQ)) {
-        response_type response{rq_it->value().address, rq_it->value().v_address, wq_it->value().data, rq_it->value().pf_metadata,
-                               rq_it->value().instr_depend_on_me};
         for (auto* ret : rq_it->value().to_return) {
-          ret->push_back(response);
+          ret->emplace_back(rq_it->value().address, rq_it->value().v_address, wq_it->value().data, rq_it->value().pf_metadata,
+                            rq_it->value().instr_depend_on_me);
         }
 
         rq_it->reset();
@@ -520,7 +579,7 @@ bool MEMORY_CONTROLLER::add_rq(const request_type& packet, champsim::channel* ul
 
   if (auto rq_it = std::find_if_not(std::begin(channel.RQ), std::end(channel.RQ), [this](const auto& pkt) { return pkt.has_value(); });
       rq_it != std::end(channel.RQ)) {
-    *rq_it = DRAM_CHANNEL::request_type{packet};
+    rq_it->emplace(packet);
     rq_it->value().forward_checked = false;
     rq_it->value().scheduled = false;
     rq_it->value().ready_time = current_time;
@@ -540,7 +599,7 @@ bool MEMORY_CONTROLLER::add_wq(const request_type& packet)
   // search for the empty index
   if (auto wq_it = std::find_if_not(std::begin(channel.WQ), std::end(channel.WQ), [](const auto& pkt) { return pkt.has_value(); });
       wq_it != std::end(channel.WQ)) {
-    *wq_it = DRAM_CHANNEL::request_type{packet};
+    wq_it->emplace(packet);
     wq_it->value().forward_checked = false;
     wq_it->value().scheduled = false;
     wq_it->value().ready_time = current_time;
@@ -0,0 +1,145 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "functional_warmer.h"
+
+#include <fmt/core.h>
+
+#include "champsim.h"
+
+namespace
+{
+champsim::channel::request_type core_request(const O3_CPU& cpu, const ooo_model_instr& instr, champsim::address v_address, access_type type)
+{
+  champsim::channel::request_type packet;
+  packet.address = v_address;
+  packet.v_address = v_address;
+  packet.is_translated = false;
+  packet.cpu = cpu.cpu;
+  packet.type = type;
+  packet.instr_id = instr.instr_id;
+  packet.ip = instr.ip;
+  packet.response_requested = (type != access_type::WRITE);
+  return packet;
+}
+} // namespace
+
+champsim::functional_warmer::functional_warmer(std::vector<std::reference_wrapper<CACHE>> caches, std::vector<std::reference_wrapper<PageTableWalker>> walkers)
+{
+  for (CACHE& cache : caches) {
+    for (const auto* ul : cache.upper_levels) {
+      cache_below.insert_or_assign(ul, &cache);
+    }
+  }
+
+  for (PageTableWalker& walker : walkers) {
+    for (const auto* ul : walker.upper_channels()) {
+      walker_below.insert_or_assign(ul, &walker);
+    }
+  }
+}
+
+champsim::functional_warmer::functional_warmer(environment& env) : functional_warmer(env.cache_view(), env.ptw_view()) {}
+
+void champsim::functional_warmer::operate(O3_CPU& cpu, ooo_model_instr instr)
+{
+  cpu.do_init_instruction(instr);
+
+  // Each block is fetched once for a run of instructions within it, unless the decoded instruction buffer supplies them
+  if (!cpu.DIB.check_hit(instr.ip).has_value()) {
+    auto [last_block, first_fetch] = last_fetched_block.try_emplace(cpu.cpu, instr.ip);
+    if (first_fetch || last_block->second != champsim::block_number{instr.ip}) {
+      last_block->second = champsim::block_number{instr.ip};
+      access(cpu.L1I_bus.lower_channel(), ::core_request(cpu, instr, instr.ip, access_type::LOAD));
+    }
+    cpu.do_dib_update(instr);
+  }
+
+  for (auto address : instr.source_memory) {
+    access(cpu.L1D_bus.lower_channel(), ::core_request(cpu, instr, address, access_type::LOAD));
+  }
+
+  for (auto address : instr.destination_memory) {
+    access(cpu.L1D_bus.lower_channel(), ::core_request(cpu, instr, address, access_type::WRITE));
+  }
+
+  ++cpu.num_retired;
+}
+
+auto champsim::functional_warmer::access(const champsim::channel* channel, const request_type& packet) -> response_type
+{
+  if (auto cache = cache_below.find(channel); cache != std::end(cache_below)) {
+    return access(*cache->second, packet, false, true);
+  }
+
+  if (auto walker = walker_below.find(channel); walker != std::end(walker_below)) {
+    auto translation = walker->second->functional_walk(packet, [this](const champsim::channel* ll, const request_type& pte) { this->access(ll, pte); });
+    return response_type{packet.address, packet.address, translation, packet.pf_metadata, packet.instr_depend_on_me};
+  }
+
+  return response_type{packet.address, packet.v_address, packet.address, packet.pf_metadata, packet.instr_depend_on_me};
+}
+
+auto champsim::functional_warmer::access(CACHE& cache, request_type packet, bool local_prefetch, bool fill_this_level) -> response_type
+{
+  if (!packet.is_translated) {
+    packet.address = translate(cache, packet);
+    packet.is_translated = true;
+  }
+
+  auto response = cache.functional_lookup(packet, local_prefetch);
+  if (!response.has_value()) {
+    if (packet.type == access_type::WRITE && !cache.match_offset_bits) {
+      response = response_type{packet}; // Writebacks are filled without reading the lower level
+    } else {
+      auto fwd_pkt = packet;
+      fwd_pkt.type = (packet.type == access_type::WRITE) ? access_type::RFO : packet.type;
+      response = access(cache.lower_level, fwd_pkt);
+    }
+
+    if (fill_this_level) {
+      if (auto writeback = cache.functional_fill(packet, *response, local_prefetch); writeback.has_value()) {
+        access(cache.lower_level, *writeback);
+      }
+    }
+  }
+
+  // The prefetcher operates once per demand access. Prefetches that it issues while its own prefetches are handled wait for the next demand access.
+  if (!local_prefetch) {
+    cache.impl_prefetcher_cycle_operate();
+    for (const auto& [pf_packet, fill_prefetch] : cache.take_functional_prefetches()) {
+      access(cache, pf_packet, true, fill_prefetch);
+    }
+  }
+
+  if constexpr (champsim::debug_print) {
+    fmt::print("[{}] {} address: {} v_address: {} data: {} type: {}\n", cache.NAME, __func__, packet.address, packet.v_address, response->data,
+               access_type_names.at(champsim::to_underlying(packet.type)));
+  }
+
+  return *response;
+}
+
+champsim::address champsim::functional_warmer::translate(CACHE& cache, const request_type& packet)
+{
+  request_type fwd_pkt = packet;
+  fwd_pkt.type = access_type::LOAD;
+  fwd_pkt.is_translated = true;
+  fwd_pkt.response_requested = true;
+
+  auto response = access(cache.lower_translate, fwd_pkt);
+  return champsim::address{champsim::splice(champsim::page_number{response.data}, champsim::page_offset{packet.v_address})};
+}
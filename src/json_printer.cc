@@ -15,6 +15,7 @@
  */
 
 #include <algorithm>
+#include <iterator>
 #include <utility>
 #include <nlohmann/json.hpp>
 
@@ -36,7 +37,14 @@ void to_json(nlohmann::json& j, const O3_CPU::stats_type& stats)
   j = nlohmann::json{{"instructions", stats.instrs()},
                      {"cycles", stats.cycles()},
                      {"Avg ROB occupancy at mispredict", std::ceil(stats.total_rob_occupancy_at_branch_mispredict) / std::ceil(total_mispredictions)},
-                     {"mispredict", mpki}};
+                     {"mispredict", mpki},
+                     {"value prediction",
+                      {{"predictions", stats.value_predictions},
+                       {"confident", stats.value_confident_predictions},
+                       {"mispredictions", stats.value_mispredictions},
+                       {"recovery", std::string{value_recovery_type_names.at(champsim::to_underlying(stats.value_recovery))}},
+                       {"recovery cycles", stats.value_recovery_cycles},
+                       {"reissued instructions", stats.value_reissued_instrs}}}};
 }
 
 void to_json(nlohmann::json& j, const CACHE::stats_type& stats)
@@ -105,8 +113,45 @@ void to_json(nlohmann::json& j, const champsim::phase_stats stats)
   std::map<std::string, nlohmann::json> statsmap{{"name", stats.name}, {"traces", stats.trace_names}};
   statsmap.emplace("roi", roi_stats);
   statsmap.emplace("sim", sim_stats);
+  if (stats.weight.has_value()) {
+    statsmap.emplace("weight", stats.weight.value());
+  }
   j = statsmap;
 }
+
+void to_json(nlohmann::json& j, const champsim::sampled_stats& stats)
+{
+  std::vector<nlohmann::json> cores;
+  for (const auto& core : stats.cores) {
+    cores.push_back(nlohmann::json{{"name", core.name}, {"IPC", core.ipc}, {"branch MPKI", core.branch_mpki}});
+  }
+
+  std::map<std::string, nlohmann::json> caches;
+  for (const auto& cache : stats.caches) {
+    caches[cache.name].emplace_back(cache.mpki);
+  }
+
+  j = nlohmann::json{{"total weight", stats.total_weight}, {"cores", cores}, {"demand MPKI", caches}};
+}
 } // namespace champsim
 
-void champsim::json_printer::print(std::vector<phase_stats>& stats) { stream << nlohmann::json::array_t{std::begin(stats), std::end(stats)}; }
+namespace
+{
+nlohmann::json run_json(const std::vector<champsim::phase_stats>& stats)
+{
+  nlohmann::json::array_t phases{std::begin(stats), std::end(stats)};
+  if (auto sampled = champsim::combine_weighted(stats); sampled.has_value()) {
+    return nlohmann::json{{"phases", phases}, {"weighted", sampled.value()}};
+  }
+  return phases;
+}
+} // namespace
+
+void champsim::json_printer::print(std::vector<phase_stats>& stats) { stream << ::run_json(stats); }
+
+void champsim::json_printer::print(std::vector<std::vector<phase_stats>>& stats)
+{
+  nlohmann::json::array_t configurations;
+  std::transform(std::begin(stats), std::end(stats), std::back_inserter(configurations), ::run_json);
+  stream << configurations;
+}
@@ -16,8 +16,10 @@
 
 #include <algorithm>
 #include <fstream>
+#include <functional>
 #include <numeric>
 #include <string>
+#include <tuple>
 #include <vector>
 #include <CLI/CLI.hpp>
 #include <fmt/core.h>
@@ -31,14 +33,18 @@
 #include "environment.h"
 #include "ooo_cpu.h" // for O3_CPU
 #include "phase_info.h"
+#include "run_options.h"
+#include "simpoint.h"
 #include "stats_printer.h"
 #include "tracereader.h"
 #include "vmem.h"
 
 namespace champsim
 {
-std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces);
-}
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, const run_options& options);
+std::vector<std::vector<phase_stats>> main(std::vector<std::reference_wrapper<environment>> envs, std::vector<phase_info>& phases,
+                                           std::vector<tracereader> traces, const run_options& options);
+} // namespace champsim
 
 #ifndef CHAMPSIM_TEST_BUILD
 using configured_environment = champsim::configured::generated_environment<CHAMPSIM_BUILD>;
@@ -47,6 +53,29 @@ const std::size_t NUM_CPUS = configured_environment::num_cpus;
 
 const unsigned BLOCK_SIZE = configured_environment::block_size;
 const unsigned PAGE_SIZE = configured_environment::page_size;
+
+#ifdef CHAMPSIM_SWEEP_BUILDS
+/**
+ * The configurations that are simulated alongside CHAMPSIM_BUILD, each reading the same decoded traces.
+ * They must agree with it on the values that are global to the binary.
+ */
+template <unsigned long long... IDs>
+struct sweep_environments {
+  static_assert(((champsim::configured::generated_environment<IDs>::num_cpus == configured_environment::num_cpus) && ...));
+  static_assert(((champsim::configured::generated_environment<IDs>::block_size == configured_environment::block_size) && ...));
+  static_assert(((champsim::configured::generated_environment<IDs>::page_size == configured_environment::page_size) && ...));
+
+  std::tuple<champsim::configured::generated_environment<IDs>...> envs{};
+
+  std::vector<std::reference_wrapper<champsim::environment>> view()
+  {
+    return std::apply([](auto&... env) { return std::vector<std::reference_wrapper<champsim::environment>>{std::ref<champsim::environment>(env)...}; },
+                      envs);
+  }
+};
+
+using configured_sweep = sweep_environments<CHAMPSIM_SWEEP_BUILDS>;
+#endif
 #endif
 const unsigned LOG2_BLOCK_SIZE = champsim::lg2(BLOCK_SIZE);
 const unsigned LOG2_PAGE_SIZE = champsim::lg2(PAGE_SIZE);
@@ -55,23 +84,63 @@ const unsigned LOG2_PAGE_SIZE = champsim::lg2(PAGE_SIZE);
 int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
 {
   configured_environment gen_environment{};
+#ifdef CHAMPSIM_SWEEP_BUILDS
+  configured_sweep sweep_environment{};
+  auto environments = sweep_environment.view();
+  environments.insert(std::begin(environments), std::ref<champsim::environment>(gen_environment));
+#else
+  std::vector<std::reference_wrapper<champsim::environment>> environments{std::ref<champsim::environment>(gen_environment)};
+#endif
 
   CLI::App app{"A microarchitecture simulator for research and education"};
 
   bool knob_cloudsuite{false};
+  bool knob_values{false};
+  bool knob_cvp{false};
+  bool knob_compact{false};
+  champsim::run_options run_options{};
   long long warmup_instructions = 0;
   long long simulation_instructions = std::numeric_limits<long long>::max();
   std::string json_file_name;
+  std::string simpoints_file_name;
+  std::string weights_file_name;
+  long long simpoint_interval = 0;
   std::vector<std::string> trace_names;
 
   auto set_heartbeat_callback = [&](auto) {
-    for (O3_CPU& cpu : gen_environment.cpu_view()) {
-      cpu.show_heartbeat = false;
+    for (champsim::environment& env : environments) {
+      for (O3_CPU& cpu : env.cpu_view()) {
+        cpu.show_heartbeat = false;
+      }
     }
   };
 
-  app.add_flag("-c,--cloudsuite", knob_cloudsuite, "Read all traces using the cloudsuite format");
+  auto* cloudsuite_option = app.add_flag("-c,--cloudsuite", knob_cloudsuite, "Read all traces using the cloudsuite format");
+  auto* values_option = app.add_flag("--values", knob_values, "Read all traces using the value-carrying trace format")->excludes(cloudsuite_option);
+  auto* cvp_option =
+      app.add_flag("--cvp", knob_cvp, "Read all traces using the CVP-1 format. Traces named *.cvp[.gz|.xz|.bz2|.zst] are read this way without this flag.")
+          ->excludes(cloudsuite_option)
+          ->excludes(values_option);
+  app.add_flag("--compact", knob_compact,
+               "Read all traces using the compact format. Traces named *.cst[.gz|.xz|.bz2|.zst] are read this way without this flag.")
+      ->excludes(cloudsuite_option)
+      ->excludes(values_option)
+      ->excludes(cvp_option);
   app.add_flag("--hide-heartbeat", set_heartbeat_callback, "Hide the heartbeat output");
+  app.add_flag("--skip-idle-cycles", run_options.skip_idle, "Advance the clock directly to the next event when no component can make progress");
+  app.add_flag("--functional-warmup", run_options.functional_warmup,
+               "Warm the caches, TLBs, and predictors by walking the warmup instructions in program order, without timing");
+  app.add_option("--threads", run_options.threads, "The number of threads that operate the cores and their private caches. One thread runs serially.")
+      ->check(CLI::PositiveNumber);
+  app.add_option("--sync-interval", run_options.sync_interval,
+                 "The number of cycles that cores run in parallel between synchronizations with the shared caches and memory")
+      ->check(CLI::PositiveNumber);
+  auto* save_checkpoint_option =
+      app.add_option("--save-checkpoint", run_options.save_checkpoint, "Write the warmed state of the caches, predictors, and page tables to this file");
+  auto* restore_checkpoint_option =
+      app.add_option("--restore-checkpoint", run_options.restore_checkpoint, "Read the warmed state from this file instead of running the warmup phase")
+          ->check(CLI::ExistingFile)
+          ->excludes(save_checkpoint_option);
   auto* warmup_instr_option = app.add_option("-w,--warmup-instructions", warmup_instructions, "The number of instructions in the warmup phase");
   auto* deprec_warmup_instr_option =
       app.add_option("--warmup_instructions", warmup_instructions, "[deprecated] use --warmup-instructions instead")->excludes(warmup_instr_option);
@@ -80,6 +149,20 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   auto* deprec_sim_instr_option =
       app.add_option("--simulation_instructions", simulation_instructions, "[deprecated] use --simulation-instructions instead")->excludes(sim_instr_option);
 
+  auto* simpoints_option = app.add_option("--simpoints", simpoints_file_name,
+                                          "Simulate the points in this SimPoint .simpoints file, each after a warmup of --warmup-instructions")
+                               ->check(CLI::ExistingFile)
+                               ->excludes(sim_instr_option)
+                               ->excludes(deprec_sim_instr_option)
+                               ->excludes(save_checkpoint_option)
+                               ->excludes(restore_checkpoint_option);
+  auto* weights_option = app.add_option("--weights", weights_file_name, "The SimPoint .weights file that accompanies --simpoints")->check(CLI::ExistingFile);
+  auto* interval_option =
+      app.add_option("--simpoint-interval", simpoint_interval, "The number of instructions in each SimPoint interval")->check(CLI::PositiveNumber);
+  simpoints_option->needs(weights_option)->needs(interval_option);
+  weights_option->needs(simpoints_option);
+  interval_option->needs(simpoints_option);
+
   auto* json_option =
       app.add_option("--json", json_file_name, "The name of the file to receive JSON output. If no name is specified, stdout will be used")->expected(0, 1);
 
@@ -98,16 +181,43 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
     fmt::print("WARNING: option --simulation_instructions is deprecated. Use --simulation-instructions instead.\n");
   }
 
+  if (std::size(environments) > 1 && (save_checkpoint_option->count() > 0 || restore_checkpoint_option->count() > 0)) {
+    fmt::print(stderr, "Checkpoints hold the state of a single configuration and cannot be used with several configurations\n");
+    return 1;
+  }
+
   if (simulation_given && !warmup_given) {
     // Warmup is 20% by default
     // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
     warmup_instructions = simulation_instructions / 5;
   }
 
+  auto trace_format = champsim::trace_format::input;
+  if (knob_cloudsuite) {
+    trace_format = champsim::trace_format::cloudsuite;
+  }
+  if (knob_values) {
+    trace_format = champsim::trace_format::value;
+  }
+  if (knob_cvp) {
+    trace_format = champsim::trace_format::cvp;
+  }
+  if (knob_compact) {
+    trace_format = champsim::trace_format::compact;
+  }
+
   std::vector<champsim::tracereader> traces;
-  std::transform(
-      std::begin(trace_names), std::end(trace_names), std::back_inserter(traces),
-      [knob_cloudsuite, repeat = simulation_given, i = uint8_t(0)](auto name) mutable { return get_tracereader(name, i++, knob_cloudsuite, repeat); });
+  std::transform(std::begin(trace_names), std::end(trace_names), std::back_inserter(traces),
+                 [trace_format, repeat = simulation_given, i = uint8_t(0)](auto name) mutable {
+                   auto name_format = trace_format;
+                   if (name_format == champsim::trace_format::input && champsim::is_cvp_trace_name(name)) {
+                     name_format = champsim::trace_format::cvp;
+                   }
+                   if (name_format == champsim::trace_format::input && champsim::is_compact_trace_name(name)) {
+                     name_format = champsim::trace_format::compact;
+                   }
+                   return get_tracereader(name, i++, name_format, repeat);
+                 });
 
   std::vector<champsim::phase_info> phases{
       {champsim::phase_info{"Warmup", true, warmup_instructions, std::vector<std::size_t>(std::size(trace_names), 0), trace_names},
@@ -117,29 +227,60 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
     std::iota(std::begin(p.trace_index), std::end(p.trace_index), 0);
   }
 
-  fmt::print("\n*** ChampSim Multicore Out-of-Order Simulator ***\nWarmup Instructions: {}\nSimulation Instructions: {}\nNumber of CPUs: {}\nPage size: {}\n\n",
-             phases.at(0).length, phases.at(1).length, std::size(gen_environment.cpu_view()), PAGE_SIZE);
+  if (simpoints_option->count() > 0) {
+    std::ifstream simpoints_file{simpoints_file_name};
+    std::ifstream weights_file{weights_file_name};
+    auto points = champsim::read_simpoints(simpoints_file, weights_file);
+    phases = champsim::simpoint_phases(points, simpoint_interval, warmup_instructions, trace_names);
+
+    fmt::print("\n*** ChampSim Multicore Out-of-Order Simulator ***\nSimPoints: {} Interval: {} Warmup Instructions: {}\nNumber of CPUs: {}\nPage size: {}\n\n",
+               std::size(points), simpoint_interval, warmup_instructions, std::size(gen_environment.cpu_view()), PAGE_SIZE);
+  } else {
+    fmt::print("\n*** ChampSim Multicore Out-of-Order Simulator ***\nWarmup Instructions: {}\nSimulation Instructions: {}\nNumber of CPUs: {}\n"
+               "Page size: {}\n\n",
+               phases.at(0).length, phases.at(1).length, std::size(gen_environment.cpu_view()), PAGE_SIZE);
+  }
 
-  auto phase_stats = champsim::main(gen_environment, phases, traces);
+  if (std::size(environments) > 1) {
+    fmt::print("Configurations: {} (sharing one decode of the traces)\n\n", std::size(environments));
+  }
+
+  std::vector<std::vector<champsim::phase_stats>> phase_stats;
+  if (std::size(environments) == 1) {
+    phase_stats.push_back(champsim::main(gen_environment, phases, traces, run_options));
+  } else {
+    phase_stats = champsim::main(environments, phases, std::move(traces), run_options);
+  }
 
   fmt::print("\nChampSim completed all CPUs\n\n");
 
-  champsim::plain_printer{std::cout}.print(phase_stats);
+  for (std::size_t i = 0; i < std::size(environments); ++i) {
+    if (std::size(environments) > 1) {
+      fmt::print("=== Configuration {} ===\n", i);
+    }
 
-  for (CACHE& cache : gen_environment.cache_view()) {
-    cache.impl_prefetcher_final_stats();
-  }
+    champsim::plain_printer{std::cout}.print(phase_stats.at(i));
+
+    for (CACHE& cache : environments.at(i).get().cache_view()) {
+      cache.impl_prefetcher_final_stats();
+    }
 
-  for (CACHE& cache : gen_environment.cache_view()) {
-    cache.impl_replacement_final_stats();
+    for (CACHE& cache : environments.at(i).get().cache_view()) {
+      cache.impl_replacement_final_stats();
+    }
   }
 
   if (json_option->count() > 0) {
-    if (json_file_name.empty()) {
-      champsim::json_printer{std::cout}.print(phase_stats);
+    std::ofstream json_file;
+    if (!json_file_name.empty()) {
+      json_file.open(json_file_name);
+    }
+    std::ostream& json_stream = json_file_name.empty() ? std::cout : json_file;
+
+    if (std::size(environments) == 1) {
+      champsim::json_printer{json_stream}.print(phase_stats.front());
     } else {
-      std::ofstream json_file{json_file_name};
-      champsim::json_printer{json_file}.print(phase_stats);
+      champsim::json_printer{json_stream}.print(phase_stats);
     }
   }
 
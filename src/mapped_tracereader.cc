@@ -0,0 +1,92 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mapped_tracereader.h"
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+champsim::mapped_file::mapped_file(const std::string& fname)
+{
+  int fd = ::open(fname.c_str(), O_RDONLY); // NOLINT(cppcoreguidelines-pro-type-vararg)
+  if (fd < 0) {
+    throw std::system_error{errno, std::generic_category(), fname};
+  }
+
+  struct stat file_stat {
+  };
+  if (::fstat(fd, &file_stat) < 0) {
+    auto err = errno;
+    ::close(fd);
+    throw std::system_error{err, std::generic_category(), fname};
+  }
+  if (!S_ISREG(file_stat.st_mode)) {
+    ::close(fd);
+    throw std::system_error{ENODEV, std::generic_category(), fname};
+  }
+
+  size_ = static_cast<std::size_t>(file_stat.st_size);
+  if (size_ > 0) {
+    void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      auto err = errno;
+      ::close(fd);
+      throw std::system_error{err, std::generic_category(), fname};
+    }
+
+    // These are only hints, so failures are ignored
+    ::madvise(addr, size_, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    ::madvise(addr, size_, MADV_HUGEPAGE);
+#endif
+
+    data_ = static_cast<const unsigned char*>(addr);
+  }
+
+  // The mapping remains valid after the descriptor is closed
+  ::close(fd);
+}
+
+bool champsim::mapped_file::can_map(const std::string& fname)
+{
+  struct stat file_stat {
+  };
+  return ::stat(fname.c_str(), &file_stat) == 0 && S_ISREG(file_stat.st_mode);
+}
+
+champsim::mapped_file::mapped_file(mapped_file&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0))
+{
+}
+
+champsim::mapped_file& champsim::mapped_file::operator=(mapped_file&& other) noexcept
+{
+  std::swap(data_, other.data_);
+  std::swap(size_, other.size_);
+  return *this;
+}
+
+champsim::mapped_file::~mapped_file()
+{
+  if (data_ != nullptr) {
+    ::munmap(const_cast<unsigned char*>(data_), size_); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+  }
+}
@@ -26,6 +26,7 @@
 
 #include "cache.h"
 #include "champsim.h"
+#include "checkpoint.h"
 #include "deadlock.h"
 #include "instruction.h"
 #include "util/span.h"
@@ -61,8 +62,9 @@ long O3_CPU::operate()
     auto phase_instr{std::ceil(num_retired - begin_phase_instr)};
     auto phase_cycle{double_duration{current_time - begin_phase_time} / clock_period};
 
-    fmt::print("Heartbeat CPU {} instructions: {} cycles: {} heartbeat IPC: {:.4g} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n", cpu,
-               num_retired, current_time.time_since_epoch() / clock_period, heartbeat_instr / heartbeat_cycle, phase_instr / phase_cycle, elapsed_time());
+    fmt::print("{}Heartbeat CPU {} instructions: {} cycles: {} heartbeat IPC: {:.4g} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n",
+               champsim::output_prefix(), cpu, num_retired, current_time.time_since_epoch() / clock_period, heartbeat_instr / heartbeat_cycle,
+               phase_instr / phase_cycle, elapsed_time());
 
     last_heartbeat_instr = num_retired;
     last_heartbeat_time = current_time;
@@ -76,6 +78,9 @@ void O3_CPU::initialize()
   // BRANCH PREDICTOR & BTB
   impl_initialize_branch_predictor();
   impl_initialize_btb();
+
+  // VALUE PREDICTOR
+  impl_initialize_value_predictor();
 }
 
 void O3_CPU::begin_phase()
@@ -88,6 +93,7 @@ void O3_CPU::begin_phase()
   stats.name = "CPU " + std::to_string(cpu);
   stats.begin_instrs = num_retired;
   stats.begin_cycles = begin_phase_time.time_since_epoch() / clock_period;
+  stats.value_recovery = VALUE_RECOVERY;
   sim_stats = stats;
 }
 
@@ -105,6 +111,22 @@ void O3_CPU::end_phase(unsigned finished_cpu)
   }
 }
 
+void O3_CPU::save_checkpoint(std::ostream& os) const
+{
+  DIB.save_checkpoint(os);
+  impl_branch_predictor_save_checkpoint(os);
+  impl_btb_save_checkpoint(os);
+  impl_value_predictor_save_checkpoint(os);
+}
+
+void O3_CPU::restore_checkpoint(std::istream& is)
+{
+  DIB.restore_checkpoint(is);
+  impl_branch_predictor_restore_checkpoint(is);
+  impl_btb_restore_checkpoint(is);
+  impl_value_predictor_restore_checkpoint(is);
+}
+
 void O3_CPU::initialize_instruction()
 {
   champsim::bandwidth instrs_to_read_this_cycle{
@@ -140,11 +162,80 @@ void do_stack_pointer_folding(ooo_model_instr& arch_instr)
                        [](auto r) { return r != champsim::REG_STACK_POINTER && r != champsim::REG_FLAGS && r != champsim::REG_INSTRUCTION_POINTER; })
          > 0);
     if ((arch_instr.is_branch) || !(std::empty(arch_instr.destination_memory) && std::empty(arch_instr.source_memory)) || (!reads_other)) {
+      // Keep any recorded values aligned with the registers that remain
+      if (arch_instr.has_values) {
+        for (auto i = std::size(arch_instr.destination_registers); i > 0; --i) {
+          if (arch_instr.destination_registers[i - 1] == champsim::REG_STACK_POINTER) {
+            arch_instr.destination_register_values.erase(std::next(std::begin(arch_instr.destination_register_values), static_cast<long>(i - 1)));
+          }
+        }
+      }
       auto nonsp_end = std::remove(std::begin(arch_instr.destination_registers), std::end(arch_instr.destination_registers), champsim::REG_STACK_POINTER);
       arch_instr.destination_registers.erase(nonsp_end, std::end(arch_instr.destination_registers));
     }
   }
 }
+
+/**
+ * Find the destination register whose value should be predicted, if any.
+ * Only instructions from value-carrying traces are eligible, since the prediction must be checked against the recorded value.
+ */
+std::optional<std::size_t> value_prediction_slot(const ooo_model_instr& arch_instr)
+{
+  if (!arch_instr.has_values || arch_instr.is_branch) {
+    return std::nullopt;
+  }
+
+  auto slot = std::find_if(std::begin(arch_instr.destination_registers), std::end(arch_instr.destination_registers),
+                           [](auto r) { return r != champsim::REG_FLAGS && r != champsim::REG_INSTRUCTION_POINTER; });
+  if (slot == std::end(arch_instr.destination_registers)) {
+    return std::nullopt;
+  }
+  return static_cast<std::size_t>(std::distance(std::begin(arch_instr.destination_registers), slot));
+}
+
+/**
+ * Find the instruction with the given ID in an instruction buffer, which holds its instructions in program order.
+ *
+ * \returns an iterator to the instruction, or the end of the buffer if it is not present.
+ */
+template <typename R>
+auto find_instr(R& buffer, champsim::program_ordered<ooo_model_instr>::id_type id)
+{
+  // Instructions that have left the buffer, such as retired producers, are older than its head
+  if (std::empty(buffer) || id < buffer.front().instr_id) {
+    return std::end(buffer);
+  }
+
+  auto found = std::partition_point(std::begin(buffer), std::end(buffer), ooo_model_instr::precedes(id));
+  if (found != std::end(buffer) && found->instr_id != id) {
+    return std::end(buffer);
+  }
+  return found;
+}
+
+/**
+ * Find the handle of an instruction in an instruction buffer, which holds its instructions in program order.
+ * Copies of an instruction share its ID, so the instruction is told apart from them by its address.
+ */
+template <typename R>
+auto handle_of(R& buffer, const ooo_model_instr& instr)
+{
+  auto id_begin = std::partition_point(std::begin(buffer), std::end(buffer), ooo_model_instr::precedes(instr.instr_id));
+  auto id_end = std::partition_point(id_begin, std::end(buffer), ooo_model_instr::matches_id(instr.instr_id));
+  auto found = std::find_if(id_begin, id_end, [addr = &instr](const auto& x) { return &x == addr; });
+  assert(found != id_end);
+  return buffer.handle(found);
+}
+
+// Add the handle to a list held in program order, if it is not already there
+void insert_in_order(O3_CPU::wait_list_type& list, O3_CPU::instr_buffer_type::handle_type handle)
+{
+  auto pos = std::lower_bound(std::begin(list), std::end(list), handle);
+  if (pos == std::end(list) || *pos != handle) {
+    list.insert(pos, handle);
+  }
+}
 } // namespace
 
 bool O3_CPU::do_predict_branch(ooo_model_instr& arch_instr)
@@ -183,6 +274,7 @@ bool O3_CPU::do_predict_branch(ooo_model_instr& arch_instr)
 
     impl_update_btb(arch_instr.ip, arch_instr.branch_target, arch_instr.branch_taken, arch_instr.branch);
     impl_last_branch_result(arch_instr.ip, arch_instr.branch_target, arch_instr.branch_taken, arch_instr.branch);
+    impl_value_predictor_branch_operate(arch_instr.ip, arch_instr.branch_target, arch_instr.branch_taken, arch_instr.branch);
   }
 
   return stop_fetch;
@@ -192,11 +284,23 @@ bool O3_CPU::do_init_instruction(ooo_model_instr& arch_instr)
 {
   // fast warmup eliminates register dependencies between instructions branch predictor, cache contents, and prefetchers are still warmed up
   if (warmup) {
+    // the value predictor is trained here, in program order, because the registers it predicts are about to be discarded
+    if (auto slot = ::value_prediction_slot(arch_instr); slot.has_value()) {
+      auto [predicted_value, confident] = impl_predict_value(arch_instr.ip, static_cast<uint8_t>(arch_instr.destination_registers.at(*slot)));
+      impl_update_value(arch_instr.ip, arch_instr.destination_register_values.at(*slot), predicted_value, confident);
+    }
+
     arch_instr.source_registers.clear();
     arch_instr.destination_registers.clear();
   }
 
   ::do_stack_pointer_folding(arch_instr);
+
+  // The value prediction is made here and carried to rename, so that the predictor sees the same branch history as it does in warmup
+  if (auto slot = ::value_prediction_slot(arch_instr); slot.has_value()) {
+    do_predict_value(arch_instr, *slot);
+  }
+
   return do_predict_branch(arch_instr);
 }
 
@@ -266,14 +370,17 @@ long O3_CPU::fetch_instruction()
   return progress;
 }
 
-bool O3_CPU::do_fetch_instruction(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end)
+bool O3_CPU::do_fetch_instruction(instr_buffer_type::iterator begin, instr_buffer_type::iterator end)
 {
   CacheBus::request_type fetch_packet;
   fetch_packet.v_address = begin->ip;
   fetch_packet.instr_id = begin->instr_id;
   fetch_packet.ip = begin->ip;
 
-  std::transform(begin, end, std::back_inserter(fetch_packet.instr_depend_on_me), [](const auto& instr) { return instr.instr_id; });
+  // The instructions are found by their handles in the fetch buffer when the block returns
+  for (auto it = begin; it != end; ++it) {
+    fetch_packet.instr_depend_on_me.push_back(IFETCH_BUFFER.handle(it));
+  }
 
   if constexpr (champsim::debug_print) {
     fmt::print("[IFETCH] {} instr_id: {} ip: {} dependents: {} event_cycle: {}\n", __func__, begin->instr_id, begin->ip,
@@ -411,8 +518,7 @@ long O3_CPU::dispatch_instruction()
   // dispatch DISPATCH_WIDTH instructions into the ROB
   while (available_dispatch_bandwidth.has_remaining() && !std::empty(DISPATCH_BUFFER) && DISPATCH_BUFFER.front().ready_time <= current_time
          && std::size(ROB) != ROB_SIZE
-         && ((std::size_t)std::count_if(std::begin(LQ), std::end(LQ), [](const auto& lq_entry) { return !lq_entry.has_value(); })
-             >= std::size(DISPATCH_BUFFER.front().source_memory))
+         && (std::size(LQ_free_slots) >= std::size(DISPATCH_BUFFER.front().source_memory))
          && ((std::size(DISPATCH_BUFFER.front().destination_memory) + std::size(SQ)) <= SQ_SIZE)) {
     ROB.push_back(std::move(DISPATCH_BUFFER.front()));
     DISPATCH_BUFFER.pop_front();
@@ -427,9 +533,42 @@ long O3_CPU::dispatch_instruction()
 
 long O3_CPU::schedule_instruction()
 {
+  // Instructions that have entered the ROB since the last search have not executed
+  const auto rob_begin_handle = ROB.handle(std::cbegin(ROB));
+  const auto rob_end_handle = ROB.handle(std::cend(ROB));
+  unexecuted_instrs.erase(std::begin(unexecuted_instrs), std::lower_bound(std::begin(unexecuted_instrs), std::end(unexecuted_instrs), rob_begin_handle));
+  for (auto handle = std::max(unexecuted_tracked_end, rob_begin_handle); handle < rob_end_handle; ++handle) {
+    unexecuted_instrs.push_back(handle);
+  }
+  unexecuted_tracked_end = rob_end_handle;
+
+  // No instruction needs more free registers than it has operands
+  constexpr unsigned long most_registers_needed = NUM_INSTR_SOURCES + NUM_INSTR_DESTINATIONS_SPARC;
+
   champsim::bandwidth search_bw{SCHEDULER_SIZE};
   int progress{0};
+  auto unexecuted_it = std::begin(unexecuted_instrs);
   for (auto rob_it = std::begin(ROB); rob_it != std::end(ROB) && search_bw.has_remaining(); ++rob_it) {
+    // An executed instruction is neither scheduled nor counted against the search. It can only stop the search for want of registers,
+    // which it cannot do while any instruction would find enough, so the search skips ahead to the next instruction that has not executed.
+    if (reg_allocator.count_free_registers() >= most_registers_needed) {
+      while (unexecuted_it != std::end(unexecuted_instrs)) {
+        auto candidate = ROB.find(*unexecuted_it);
+        if (candidate == std::end(ROB) || (candidate->scheduled && candidate->executed)) {
+          unexecuted_it = unexecuted_instrs.erase(unexecuted_it);
+        } else if (candidate < rob_it) {
+          ++unexecuted_it;
+        } else {
+          rob_it = candidate;
+          break;
+        }
+      }
+
+      if (unexecuted_it == std::end(unexecuted_instrs)) {
+        break;
+      }
+    }
+
     // if there aren't enough physical registers available for the next instruction, stop scheduling
     unsigned long sources_to_allocate = std::count_if(rob_it->source_registers.begin(), rob_it->source_registers.end(),
                                                       [&alloc = std::as_const(reg_allocator)](auto srcreg) { return !alloc.isAllocated(srcreg); });
@@ -455,6 +594,13 @@ void O3_CPU::do_scheduling(ooo_model_instr& instr)
   for (auto& src_reg : instr.source_registers) {
     // rename source register
     src_reg = reg_allocator.rename_src_register(src_reg);
+
+    // find the producer, if it is still in flight, so that value misprediction recovery can find this consumer
+    auto producer = ::find_instr(ROB, reg_allocator.producer_id(src_reg));
+    if (producer != std::end(ROB) && producer->instr_id != instr.instr_id
+        && std::count(std::begin(producer->destination_registers), std::end(producer->destination_registers), src_reg) > 0) {
+      producer->registers_instrs_depend_on_me.push_back(&instr);
+    }
   }
 
   for (auto& dreg : instr.destination_registers) {
@@ -462,20 +608,81 @@ void O3_CPU::do_scheduling(ooo_model_instr& instr)
     dreg = reg_allocator.rename_dest_register(dreg, instr.instr_id);
   }
 
+  // A confident prediction is written into the physical register, so its consumers may issue before the producer executes
+  if (instr.value_prediction_confident) {
+    do_complete_register(instr.destination_registers.at(instr.value_prediction_slot));
+  }
+
   instr.scheduled = true;
+  do_wakeup(instr);
+}
+
+void O3_CPU::do_wakeup(ooo_model_instr& instr)
+{
+  if (!instr.scheduled || instr.executed) {
+    return;
+  }
+
+  auto waiting_on = std::find_if_not(std::begin(instr.source_registers), std::end(instr.source_registers),
+                                     [&alloc = std::as_const(reg_allocator)](auto srcreg) { return alloc.isValid(srcreg); });
+  if (waiting_on != std::end(instr.source_registers)) {
+    register_waiters.at(static_cast<std::size_t>(*waiting_on)).push_back(::handle_of(ROB, instr));
+  } else {
+    ::insert_in_order(ready_instrs, ::handle_of(ROB, instr));
+  }
+}
+
+void O3_CPU::do_complete_register(PHYSICAL_REGISTER_ID physreg)
+{
+  reg_allocator.complete_dest_register(physreg);
+
+  // Nothing waits on the register while it is valid, so the list can be walked in place
+  auto& waiters = register_waiters.at(static_cast<std::size_t>(physreg));
+  for (auto handle : waiters) {
+    if (auto consumer = ROB.find(handle); consumer != std::end(ROB)) {
+      do_wakeup(*consumer);
+    }
+  }
+  waiters.clear();
+}
+
+void O3_CPU::do_predict_value(ooo_model_instr& instr, std::size_t slot)
+{
+  auto [predicted_value, confident] = impl_predict_value(instr.ip, static_cast<uint8_t>(instr.destination_registers.at(slot)));
+  instr.value_predicted = true;
+  instr.value_prediction_confident = confident;
+  instr.value_prediction_slot = static_cast<uint8_t>(slot);
+  instr.predicted_value = predicted_value;
+
+  ++sim_stats.value_predictions;
+  if (confident) {
+    ++sim_stats.value_confident_predictions;
+  }
+
+  if constexpr (champsim::debug_print) {
+    fmt::print("[VALUE] {} instr_id: {} ip: {} predicted: {:#x} confident: {}\n", __func__, instr.instr_id, instr.ip, predicted_value, confident);
+  }
 }
 
 long O3_CPU::execute_instruction()
 {
+  // select the oldest ready instructions
   champsim::bandwidth exec_bw{EXEC_WIDTH};
-  for (auto rob_it = std::begin(ROB); rob_it != std::end(ROB) && exec_bw.has_remaining(); ++rob_it) {
-    if (rob_it->scheduled && !rob_it->executed && rob_it->ready_time <= current_time) {
-      bool ready = std::all_of(std::begin(rob_it->source_registers), std::end(rob_it->source_registers),
-                               [&alloc = std::as_const(reg_allocator)](auto srcreg) { return alloc.isValid(srcreg); });
-      if (ready) {
-        do_execution(*rob_it);
-        exec_bw.consume();
-      }
+  auto ready_it = std::begin(ready_instrs);
+  while (exec_bw.has_remaining() && ready_it != std::end(ready_instrs)) {
+    auto rob_it = ROB.find(*ready_it);
+    if (rob_it == std::end(ROB) || !rob_it->scheduled || rob_it->executed) {
+      ready_it = ready_instrs.erase(ready_it);
+    } else if (reg_allocator.count_reg_dependencies(*rob_it) > 0) {
+      // A source was invalidated by value misprediction recovery after the instruction became ready
+      ready_it = ready_instrs.erase(ready_it);
+      do_wakeup(*rob_it);
+    } else if (rob_it->ready_time <= current_time) {
+      ready_it = ready_instrs.erase(ready_it);
+      do_execution(*rob_it);
+      exec_bw.consume();
+    } else {
+      ++ready_it;
     }
   }
 
@@ -485,21 +692,17 @@ long O3_CPU::execute_instruction()
 void O3_CPU::do_execution(ooo_model_instr& instr)
 {
   instr.executed = true;
+  ::insert_in_order(inflight_instrs, ::handle_of(ROB, instr));
   instr.ready_time = current_time + (warmup ? champsim::chrono::clock::duration{} : EXEC_LATENCY);
 
   // Mark LQ entries as ready to translate
-  for (auto& lq_entry : LQ) {
-    if (lq_entry.has_value() && lq_entry->instr_id == instr.instr_id) {
-      lq_entry->ready_time = current_time + (warmup ? champsim::chrono::clock::duration{} : EXEC_LATENCY);
-    }
-  }
+  auto [lq_begin, lq_end] = LQ_by_instr.equal_range(instr.instr_id);
+  std::for_each(lq_begin, lq_end, [time = instr.ready_time, this](const auto& x) { this->LQ.at(x.second)->ready_time = time; });
 
-  // Mark SQ entries as ready to translate
-  for (auto& sq_entry : SQ) {
-    if (sq_entry.instr_id == instr.instr_id) {
-      sq_entry.ready_time = current_time + (warmup ? champsim::chrono::clock::duration{} : EXEC_LATENCY);
-    }
-  }
+  // Mark SQ entries as ready to translate. The SQ is in program order.
+  auto sq_begin = std::partition_point(std::begin(SQ), std::end(SQ), LSQ_ENTRY::precedes(instr.instr_id));
+  auto sq_end = std::partition_point(sq_begin, std::end(SQ), LSQ_ENTRY::matches_id(instr.instr_id));
+  std::for_each(sq_begin, sq_end, [time = instr.ready_time](auto& x) { x.ready_time = time; });
 
   if constexpr (champsim::debug_print) {
     fmt::print("[ROB] {} instr_id: {} ready_time: {}\n", __func__, instr.instr_id, instr.ready_time.time_since_epoch() / clock_period);
@@ -508,27 +711,27 @@ void O3_CPU::do_execution(ooo_model_instr& instr)
 
 void O3_CPU::do_memory_scheduling(ooo_model_instr& instr)
 {
+  const auto rob_handle = ::handle_of(ROB, instr);
+
   // load
   for (auto& smem : instr.source_memory) {
-    auto q_entry = std::find_if_not(std::begin(LQ), std::end(LQ), [](const auto& lq_entry) { return lq_entry.has_value(); });
-    assert(q_entry != std::end(LQ));
-    q_entry->emplace(smem, instr.instr_id, instr.ip, instr.asid); // add it to the load queue
-
-    // Check for forwarding
-    auto sq_it = std::max_element(std::begin(SQ), std::end(SQ), [smem](const auto& lhs, const auto& rhs) {
-      return lhs.virtual_address != smem || (rhs.virtual_address == smem && LSQ_ENTRY::program_order(lhs, rhs));
-    });
-    if (sq_it != std::end(SQ) && sq_it->virtual_address == smem) {
-      if (sq_it->fetch_issued) { // Store already executed
-        (*q_entry)->finish(instr);
-        q_entry->reset();
+    auto& q_entry = do_allocate_load(smem, instr, rob_handle); // add it to the load queue
+
+    // Check for forwarding from the youngest prior store to the same address
+    if (auto stores = SQ_by_address.find(smem.to<uint64_t>()); stores != std::end(SQ_by_address)) {
+      auto youngest = std::partition_point(std::begin(stores->second), std::end(stores->second),
+                                           [id = stores->second.back().get().instr_id](const LSQ_ENTRY& x) { return x.instr_id < id; });
+      LSQ_ENTRY& sq_entry = youngest->get();
+      if (sq_entry.fetch_issued) { // Store already executed
+        q_entry->finish(instr);
+        do_release_load(q_entry);
       } else {
-        assert(sq_it->instr_id < instr.instr_id);      // The found SQ entry is a prior store
-        sq_it->lq_depend_on_me.emplace_back(*q_entry); // Forward the load when the store finishes
-        (*q_entry)->producer_id = sq_it->instr_id;     // The load waits on the store to finish
+        assert(sq_entry.instr_id < instr.instr_id);     // The found SQ entry is a prior store
+        sq_entry.lq_depend_on_me.emplace_back(q_entry); // Forward the load when the store finishes
+        q_entry->producer_id = sq_entry.instr_id;       // The load waits on the store to finish
 
         if constexpr (champsim::debug_print) {
-          fmt::print("[DISPATCH] {} instr_id: {} waits on: {}\n", __func__, instr.instr_id, sq_it->instr_id);
+          fmt::print("[DISPATCH] {} instr_id: {} waits on: {}\n", __func__, instr.instr_id, sq_entry.instr_id);
         }
       }
     }
@@ -536,7 +739,8 @@ void O3_CPU::do_memory_scheduling(ooo_model_instr& instr)
 
   // store
   for (auto& dmem : instr.destination_memory) {
-    SQ.emplace_back(dmem, instr.instr_id, instr.ip, instr.asid); // add it to the store queue
+    SQ.emplace_back(dmem, instr.instr_id, instr.ip, instr.asid, rob_handle); // add it to the store queue
+    SQ_by_address[dmem.to<uint64_t>()].emplace_back(SQ.back());
   }
 
   if constexpr (champsim::debug_print) {
@@ -566,6 +770,7 @@ long O3_CPU::operate_lsq()
 
   auto [complete_begin, complete_end] = champsim::get_span_p(std::cbegin(SQ), std::cend(SQ), store_bw, do_complete);
   store_bw.consume(std::distance(complete_begin, complete_end));
+  std::for_each(complete_begin, complete_end, [this](const auto& sq_entry) { this->do_release_store(sq_entry); });
   SQ.erase(complete_begin, complete_end);
 
   champsim::bandwidth load_bw{LQ_WIDTH};
@@ -590,15 +795,58 @@ void O3_CPU::do_finish_store(const LSQ_ENTRY& sq_entry)
     fmt::print("[SQ] {} instr_id: {} vaddr: {}\n", __func__, sq_entry.instr_id, sq_entry.virtual_address);
   }
 
-  sq_entry.finish(std::begin(ROB), std::end(ROB));
+  sq_entry.finish(ROB);
 
   // Release dependent loads
   for (std::optional<LSQ_ENTRY>& dependent : sq_entry.lq_depend_on_me) {
     assert(dependent.has_value()); // LQ entry is still allocated
     assert(dependent->producer_id == sq_entry.instr_id);
 
-    dependent->finish(std::begin(ROB), std::end(ROB));
-    dependent.reset();
+    dependent->finish(ROB);
+    do_release_load(dependent);
+  }
+}
+
+std::optional<LSQ_ENTRY>& O3_CPU::do_allocate_load(champsim::address addr, const ooo_model_instr& instr, instr_buffer_type::handle_type rob_handle)
+{
+  assert(!std::empty(LQ_free_slots));
+  auto slot = LQ_free_slots.top();
+  LQ_free_slots.pop();
+
+  auto& lq_entry = LQ.at(slot);
+  lq_entry.emplace(addr, instr.instr_id, instr.ip, instr.asid, rob_handle);
+  LQ_by_instr.emplace(instr.instr_id, slot);
+  LQ_by_block.emplace(champsim::block_number{addr}.to<uint64_t>(), slot);
+  return lq_entry;
+}
+
+void O3_CPU::do_release_load(std::optional<LSQ_ENTRY>& lq_entry)
+{
+  assert(lq_entry.has_value());
+  auto slot = static_cast<std::size_t>(std::distance(LQ.data(), &lq_entry));
+
+  auto erase_slot = [slot](auto& index, auto key) {
+    auto [begin, end] = index.equal_range(key);
+    auto found = std::find_if(begin, end, [slot](const auto& x) { return x.second == slot; });
+    assert(found != end);
+    index.erase(found);
+  };
+  erase_slot(LQ_by_instr, lq_entry->instr_id);
+  erase_slot(LQ_by_block, champsim::block_number{lq_entry->virtual_address}.to<uint64_t>());
+
+  lq_entry.reset();
+  LQ_free_slots.push(slot);
+}
+
+void O3_CPU::do_release_store(const LSQ_ENTRY& sq_entry)
+{
+  // Stores leave the SQ in program order, so each is the oldest store to its address
+  auto stores = SQ_by_address.find(sq_entry.virtual_address.to<uint64_t>());
+  assert(stores != std::end(SQ_by_address));
+  assert(&stores->second.front().get() == &sq_entry);
+  stores->second.pop_front();
+  if (std::empty(stores->second)) {
+    SQ_by_address.erase(stores);
   }
 }
 
@@ -634,7 +882,7 @@ void O3_CPU::do_complete_execution(ooo_model_instr& instr)
 {
   for (auto dreg : instr.destination_registers) {
     // mark physical register's data as valid
-    reg_allocator.complete_dest_register(dreg);
+    do_complete_register(dreg);
   }
 
   instr.completed = true;
@@ -642,16 +890,138 @@ void O3_CPU::do_complete_execution(ooo_model_instr& instr)
   if (instr.branch_mispredicted) {
     fetch_resume_time = current_time + BRANCH_MISPREDICT_PENALTY;
   }
+
+  // Consumers of a wrong confident prediction have used a bad value and must be run again
+  if (instr.value_prediction_confident && !instr.value_mispredicted
+      && instr.predicted_value != instr.destination_register_values.at(instr.value_prediction_slot)) {
+    instr.value_mispredicted = true;
+    ++sim_stats.value_mispredictions;
+
+    if constexpr (champsim::debug_print) {
+      fmt::print("[VALUE] {} instr_id: {} mispredicted recovery: {} cycle: {}\n", __func__, instr.instr_id,
+                 value_recovery_type_names.at(champsim::to_underlying(VALUE_RECOVERY)), current_time.time_since_epoch() / clock_period);
+    }
+
+    if (VALUE_RECOVERY == value_recovery_type::REISSUE) {
+      do_value_reissue(instr);
+    } else {
+      do_value_squash(instr);
+    }
+  }
+}
+
+// Undo the execution of an instruction that must be run again. A destination that holds a prediction not yet found to be wrong remains valid.
+// Returns whether any destination was invalidated.
+bool O3_CPU::do_reset_execution(ooo_model_instr& instr)
+{
+  instr.executed = false;
+  instr.completed = false;
+
+  // The scheduler must search for the instruction again. Instructions it has not yet seen are found when it adds them.
+  if (auto handle = ::handle_of(ROB, instr); handle < unexecuted_tracked_end) {
+    ::insert_in_order(unexecuted_instrs, handle);
+  }
+
+  bool invalidated = false;
+  for (std::size_t i = 0; i < std::size(instr.destination_registers); ++i) {
+    if (!(instr.value_prediction_confident && !instr.value_mispredicted && i == instr.value_prediction_slot)) {
+      reg_allocator.invalidate_dest_register(instr.destination_registers[i]);
+      invalidated = true;
+    }
+  }
+
+  do_wakeup(instr);
+  return invalidated;
+}
+
+void O3_CPU::do_value_squash(const ooo_model_instr& instr)
+{
+  // There is no wrong path, so the instructions that would be refetched are the ones already in flight.
+  // They are held back until the pipeline refills, and those that have executed must execute again.
+  const auto penalty = warmup ? champsim::chrono::clock::duration{} : BRANCH_MISPREDICT_PENALTY;
+  const auto resume_time = current_time + penalty;
+  fetch_resume_time = std::max(fetch_resume_time, resume_time);
+
+  auto hold_back = [resume_time](auto& x) {
+    x.ready_time = std::max(x.ready_time, resume_time);
+  };
+
+  auto squash_begin = std::partition_point(std::begin(ROB), std::end(ROB), [id = instr.instr_id](const auto& x) { return x.instr_id <= id; });
+  std::for_each(squash_begin, std::end(ROB), [this, hold_back](auto& x) {
+    if (x.executed) {
+      this->do_reset_execution(x);
+    }
+    hold_back(x);
+  });
+
+  for (auto* buffer : {&IFETCH_BUFFER, &DECODE_BUFFER, &DISPATCH_BUFFER, &DIB_HIT_BUFFER}) {
+    std::for_each(std::begin(*buffer), std::end(*buffer), hold_back);
+  }
+
+  auto squashed = std::distance(squash_begin, std::end(ROB)) + std::size(IFETCH_BUFFER) + std::size(DECODE_BUFFER) + std::size(DISPATCH_BUFFER)
+                  + std::size(DIB_HIT_BUFFER);
+  sim_stats.value_recovery_cycles += static_cast<uint64_t>(penalty / clock_period);
+  sim_stats.value_reissued_instrs += static_cast<uint64_t>(squashed);
+}
+
+void O3_CPU::do_value_reissue(const ooo_model_instr& instr)
+{
+  // Walk the consumers transitively. Those that have not yet executed will read the corrected value when they do.
+  const auto penalty = warmup ? champsim::chrono::clock::duration{} : SCHEDULING_LATENCY;
+  uint64_t reissued = 0;
+
+  std::vector<ooo_model_instr*> to_visit{};
+  auto reissue = [&](ooo_model_instr& consumer) {
+    consumer.ready_time = current_time + penalty;
+    ++reissued;
+
+    if (do_reset_execution(consumer)) {
+      to_visit.insert(std::end(to_visit), std::begin(consumer.registers_instrs_depend_on_me), std::end(consumer.registers_instrs_depend_on_me));
+    }
+
+    if constexpr (champsim::debug_print) {
+      fmt::print("[VALUE] do_value_reissue instr_id: {} reissued by: {}\n", consumer.instr_id, instr.instr_id);
+    }
+  };
+
+  // The direct consumers read the mispredicted value
+  for (ooo_model_instr* consumer : instr.registers_instrs_depend_on_me) {
+    if (consumer->executed) {
+      reissue(*consumer);
+    }
+  }
+
+  // Further consumers are affected only if they read a register that is now waiting on a reissued instruction
+  while (!std::empty(to_visit)) {
+    ooo_model_instr& consumer = *to_visit.back();
+    to_visit.pop_back();
+
+    if (consumer.executed && reg_allocator.count_reg_dependencies(consumer) > 0) {
+      reissue(consumer);
+    }
+  }
+
+  if (reissued > 0) {
+    sim_stats.value_recovery_cycles += static_cast<uint64_t>(penalty / clock_period);
+  }
+  sim_stats.value_reissued_instrs += reissued;
 }
 
 long O3_CPU::complete_inflight_instruction()
 {
   // update ROB entries with completed executions
   champsim::bandwidth complete_bw{EXEC_WIDTH};
-  for (auto rob_it = std::begin(ROB); rob_it != std::end(ROB) && complete_bw.has_remaining(); ++rob_it) {
-    if (rob_it->executed && !rob_it->completed && (rob_it->ready_time <= current_time) && rob_it->completed_mem_ops == rob_it->num_mem_ops()) {
+  auto inflight_it = std::begin(inflight_instrs);
+  while (complete_bw.has_remaining() && inflight_it != std::end(inflight_instrs)) {
+    auto rob_it = ROB.find(*inflight_it);
+    if (rob_it == std::end(ROB) || !rob_it->executed || rob_it->completed) {
+      inflight_it = inflight_instrs.erase(inflight_it);
+    } else if ((rob_it->ready_time <= current_time) && rob_it->completed_mem_ops == rob_it->num_mem_ops()) {
+      inflight_it = inflight_instrs.erase(inflight_it);
       do_complete_execution(*rob_it);
       complete_bw.consume();
+    } else {
+      ++inflight_it;
     }
   }
 
@@ -667,7 +1037,7 @@ long O3_CPU::handle_memory_return()
     auto& l1i_entry = L1I_bus.lower_level->returned.front();
 
     while (fetch_bw.has_remaining() && !l1i_entry.instr_depend_on_me.empty()) {
-      auto fetched = std::find_if(std::begin(IFETCH_BUFFER), std::end(IFETCH_BUFFER), ooo_model_instr::matches_id(l1i_entry.instr_depend_on_me.front()));
+      auto fetched = IFETCH_BUFFER.find(l1i_entry.instr_depend_on_me.front());
       if (fetched != std::end(IFETCH_BUFFER) && champsim::block_number{fetched->ip} == champsim::block_number{l1i_entry.v_address} && fetched->fetch_issued) {
         fetched->fetch_completed = true;
         fetch_bw.consume();
@@ -690,13 +1060,21 @@ long O3_CPU::handle_memory_return()
 
   auto l1d_it = std::begin(L1D_bus.lower_level->returned);
   for (champsim::bandwidth l1d_bw{L1D_BANDWIDTH}; l1d_bw.has_remaining() && l1d_it != std::end(L1D_bus.lower_level->returned); l1d_bw.consume(), ++l1d_it) {
-    for (auto& lq_entry : LQ) {
-      if (lq_entry.has_value() && lq_entry->fetch_issued && champsim::block_number{lq_entry->virtual_address} == champsim::block_number{l1d_it->v_address}) {
-        lq_entry->finish(std::begin(ROB), std::end(ROB));
-        lq_entry.reset();
-        ++progress;
+    // Finish the loads to this block in LQ order
+    std::vector<std::size_t> finished_slots{};
+    auto [lq_begin, lq_end] = LQ_by_block.equal_range(champsim::block_number{l1d_it->v_address}.to<uint64_t>());
+    for (auto it = lq_begin; it != lq_end; ++it) {
+      if (LQ.at(it->second)->fetch_issued) {
+        finished_slots.push_back(it->second);
       }
     }
+    std::sort(std::begin(finished_slots), std::end(finished_slots));
+
+    for (auto slot : finished_slots) {
+      LQ.at(slot)->finish(ROB);
+      do_release_load(LQ.at(slot));
+      ++progress;
+    }
     ++progress;
   }
   L1D_bus.lower_level->returned.erase(std::begin(L1D_bus.lower_level->returned), l1d_it);
@@ -723,6 +1101,14 @@ long O3_CPU::retire_rob()
     }
   }
 
+  // train the value predictor in program order
+  for (auto rob_it = retire_begin; rob_it != retire_end; ++rob_it) {
+    if (rob_it->value_predicted) {
+      impl_update_value(rob_it->ip, rob_it->destination_register_values.at(rob_it->value_prediction_slot), rob_it->predicted_value,
+                        rob_it->value_prediction_confident);
+    }
+  }
+
   auto retire_count = std::distance(retire_begin, retire_end);
   num_retired += retire_count;
   ROB.erase(retire_begin, retire_end);
@@ -742,6 +1128,10 @@ bool O3_CPU::impl_predict_branch(champsim::address ip, champsim::address predict
   return branch_module_pimpl->impl_predict_branch(ip, predicted_target, always_taken, branch_type);
 }
 
+void O3_CPU::impl_branch_predictor_save_checkpoint(std::ostream& os) const { branch_module_pimpl->impl_branch_predictor_save_checkpoint(os); }
+
+void O3_CPU::impl_branch_predictor_restore_checkpoint(std::istream& is) const { branch_module_pimpl->impl_branch_predictor_restore_checkpoint(is); }
+
 void O3_CPU::impl_initialize_btb() const { btb_module_pimpl->impl_initialize_btb(); }
 
 void O3_CPU::impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) const
@@ -754,6 +1144,89 @@ std::pair<champsim::address, bool> O3_CPU::impl_btb_prediction(champsim::address
   return btb_module_pimpl->impl_btb_prediction(ip, branch_type);
 }
 
+void O3_CPU::impl_btb_save_checkpoint(std::ostream& os) const { btb_module_pimpl->impl_btb_save_checkpoint(os); }
+
+void O3_CPU::impl_btb_restore_checkpoint(std::istream& is) const { btb_module_pimpl->impl_btb_restore_checkpoint(is); }
+
+void O3_CPU::impl_initialize_value_predictor() const { value_module_pimpl->impl_initialize_value_predictor(); }
+
+std::pair<uint64_t, bool> O3_CPU::impl_predict_value(champsim::address ip, uint8_t destination_register) const
+{
+  return value_module_pimpl->impl_predict_value(ip, destination_register);
+}
+
+void O3_CPU::impl_update_value(champsim::address ip, uint64_t actual_value, uint64_t predicted_value, bool confident) const
+{
+  value_module_pimpl->impl_update_value(ip, actual_value, predicted_value, confident);
+}
+
+void O3_CPU::impl_value_predictor_branch_operate(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) const
+{
+  value_module_pimpl->impl_value_predictor_branch_operate(ip, target, taken, branch_type);
+}
+
+void O3_CPU::impl_value_predictor_save_checkpoint(std::ostream& os) const { value_module_pimpl->impl_value_predictor_save_checkpoint(os); }
+
+void O3_CPU::impl_value_predictor_restore_checkpoint(std::istream& is) const { value_module_pimpl->impl_value_predictor_restore_checkpoint(is); }
+
+champsim::chrono::clock::time_point O3_CPU::next_event_time() const
+{
+  const auto next_cycle = current_time + clock_period;
+
+  // Memory returns, new instructions, and memory requests that the caches did not accept are all handled (or retried) every cycle
+  auto needs_fetch = [](const ooo_model_instr& x) {
+    return !x.dib_checked || !x.fetch_issued;
+  };
+  auto needs_load = [time = current_time](const std::optional<LSQ_ENTRY>& x) {
+    return x.has_value() && x->producer_id == std::numeric_limits<uint64_t>::max() && !x->fetch_issued && x->ready_time <= time;
+  };
+  auto needs_store = [complete_id = std::empty(ROB) ? std::numeric_limits<uint64_t>::max() : ROB.front().instr_id](const LSQ_ENTRY& x) {
+    return x.fetch_issued && LSQ_ENTRY::precedes(complete_id)(x);
+  };
+
+  if (!std::empty(L1I_bus.lower_level->returned) || !std::empty(L1D_bus.lower_level->returned) || (!std::empty(ROB) && ROB.front().completed)
+      || std::any_of(std::begin(IFETCH_BUFFER), std::end(IFETCH_BUFFER), needs_fetch) || std::any_of(std::begin(LQ), std::end(LQ), needs_load)
+      || std::any_of(std::begin(SQ), std::end(SQ), needs_store)) {
+    return next_cycle;
+  }
+
+  // Otherwise, wait for the next instruction to become ready in any stage. Instructions that are already ready are waiting on one of the events above.
+  auto next_event = champsim::chrono::clock::time_point::max();
+  auto consider = [&next_event, time = current_time](auto event_time) {
+    if (event_time > time) {
+      next_event = std::min(next_event, event_time);
+    }
+  };
+
+  if (!std::empty(input_queue) && std::size(IFETCH_BUFFER) < IFETCH_BUFFER_SIZE) {
+    consider(std::max(fetch_resume_time, next_cycle));
+  }
+
+  for (auto buffer : {std::cref(IFETCH_BUFFER), std::cref(DIB_HIT_BUFFER), std::cref(DECODE_BUFFER), std::cref(DISPATCH_BUFFER)}) {
+    for (const auto& instr : buffer.get()) {
+      consider(instr.ready_time);
+    }
+  }
+
+  for (const auto& instr : ROB) {
+    if (!instr.completed) {
+      consider(instr.ready_time);
+    }
+  }
+
+  for (const auto& lq_entry : LQ) {
+    if (lq_entry.has_value()) {
+      consider(lq_entry->ready_time);
+    }
+  }
+
+  for (const auto& sq_entry : SQ) {
+    consider(sq_entry.ready_time);
+  }
+
+  return next_event;
+}
+
 // LCOV_EXCL_START Exclude the following function from LCOV
 void O3_CPU::print_deadlock()
 {
@@ -802,15 +1275,16 @@ void O3_CPU::print_deadlock()
 }
 // LCOV_EXCL_STOP
 
-LSQ_ENTRY::LSQ_ENTRY(champsim::address addr, champsim::program_ordered<LSQ_ENTRY>::id_type id, champsim::address local_ip, std::array<uint8_t, 2> local_asid)
-    : champsim::program_ordered<LSQ_ENTRY>{id}, virtual_address(addr), ip(local_ip), asid(local_asid)
+LSQ_ENTRY::LSQ_ENTRY(champsim::address addr, champsim::program_ordered<LSQ_ENTRY>::id_type id, champsim::address local_ip, std::array<uint8_t, 2> local_asid,
+                     champsim::circular_buffer<ooo_model_instr>::handle_type local_rob_handle)
+    : champsim::program_ordered<LSQ_ENTRY>{id}, virtual_address(addr), ip(local_ip), asid(local_asid), rob_handle(local_rob_handle)
 {
 }
 
-void LSQ_ENTRY::finish(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end) const
+void LSQ_ENTRY::finish(champsim::circular_buffer<ooo_model_instr>& rob) const
 {
-  auto rob_entry = std::partition_point(begin, end, ooo_model_instr::precedes(this->instr_id));
-  assert(rob_entry != end);
+  auto rob_entry = rob.find(rob_handle);
+  assert(rob_entry != std::end(rob));
   finish(*rob_entry);
 }
 
@@ -834,7 +1308,7 @@ bool CacheBus::issue_read(request_type data_packet)
   data_packet.cpu = cpu;
   data_packet.type = access_type::LOAD;
 
-  return lower_level->add_rq(data_packet);
+  return lower_level->add_rq(std::move(data_packet));
 }
 
 bool CacheBus::issue_write(request_type data_packet)
@@ -845,5 +1319,5 @@ bool CacheBus::issue_write(request_type data_packet)
   data_packet.type = access_type::WRITE;
   data_packet.response_requested = false;
 
-  return lower_level->add_wq(data_packet);
+  return lower_level->add_wq(std::move(data_packet));
 }
@@ -36,4 +36,22 @@ long champsim::operable::_operate()
   return operate();
 }
 
+long champsim::operable::skip_on(const champsim::chrono::clock& clock)
+{
+  long cycles{0};
+  if (current_time < clock.now()) {
+    // The number of cycles that operate_on() would perform
+    cycles = static_cast<long>((clock.now() - current_time + clock_period - champsim::chrono::clock::duration{1}) / clock_period);
+    _skip(cycles);
+  }
+
+  return cycles;
+}
+
+void champsim::operable::_skip(long cycles)
+{
+  current_time += cycles * clock_period;
+  skip(cycles);
+}
+
 uint64_t champsim::operable::current_cycle() const { return static_cast<uint64_t>(current_time.time_since_epoch() / clock_period); }
@@ -0,0 +1,209 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parallel_engine.h"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <set>
+#include <utility>
+
+#include "cache.h"
+#include "champsim.h"
+#include "environment.h"
+#include "ooo_cpu.h"
+
+long champsim::domain::operate_on(const champsim::chrono::clock& clock)
+{
+  std::sort(std::begin(operables), std::end(operables),
+            [](const champsim::operable& lhs, const champsim::operable& rhs) { return lhs.current_time < rhs.current_time; });
+
+  long progress{0};
+  for (champsim::operable& op : operables) {
+    progress += op.operate_on(clock);
+  }
+
+  return progress;
+}
+
+auto champsim::partition_domains(environment& env) -> domain_partition
+{
+  auto cpus = env.cpu_view();
+  auto caches = env.cache_view();
+
+  // Each channel is consumed by the cache that lists it as an upper level
+  std::map<const champsim::channel*, const CACHE*> consumer;
+  for (const CACHE& cache : caches) {
+    for (const auto* ul : cache.upper_levels) {
+      consumer.try_emplace(ul, &cache);
+    }
+  }
+
+  // Find every core that can reach each cache. The search stops at anything that is not a cache.
+  std::map<const CACHE*, std::set<std::size_t>> reached_by;
+  for (std::size_t cpu_idx = 0; cpu_idx < std::size(cpus); ++cpu_idx) {
+    const O3_CPU& cpu = cpus.at(cpu_idx);
+    std::vector<const champsim::channel*> frontier{cpu.L1I_bus.lower_channel(), cpu.L1D_bus.lower_channel()};
+    std::set<const CACHE*> visited;
+    while (!std::empty(frontier)) {
+      auto found = consumer.find(frontier.back());
+      frontier.pop_back();
+      if (found != std::end(consumer) && visited.insert(found->second).second) {
+        reached_by[found->second].insert(cpu_idx);
+        frontier.push_back(found->second->lower_level);
+        frontier.push_back(found->second->lower_translate);
+      }
+    }
+  }
+
+  std::map<const champsim::operable*, std::size_t> owner;
+  for (auto [cache, reaching_cpus] : reached_by) {
+    if (std::size(reaching_cpus) == 1) {
+      owner.try_emplace(cache, *std::begin(reaching_cpus));
+    }
+  }
+
+  for (std::size_t cpu_idx = 0; cpu_idx < std::size(cpus); ++cpu_idx) {
+    const O3_CPU& cpu = cpus.at(cpu_idx);
+
+    // The core calls into its L1I directly, so it must run alongside it
+    auto l1i_owner = owner.find(cpu.l1i);
+    if (cpu.l1i == nullptr || (l1i_owner != std::end(owner) && l1i_owner->second == cpu_idx)) {
+      owner.try_emplace(&cpu, cpu_idx);
+    }
+  }
+
+  domain_partition retval;
+  retval.cores.resize(std::size(cpus));
+  for (champsim::operable& op : env.operable_view()) {
+    if (auto found = owner.find(&op); found != std::end(owner)) {
+      retval.cores.at(found->second).operables.push_back(op);
+    } else {
+      retval.shared.operables.push_back(op);
+    }
+  }
+
+  return retval;
+}
+
+champsim::parallel_engine::parallel_engine(environment& env, std::size_t num_threads) : partition(partition_domains(env))
+{
+  // The calling thread is also a worker, and there is no use for more threads than core domains
+  auto num_workers = std::clamp<std::size_t>(num_threads, 1, std::max<std::size_t>(std::size(partition.cores), 1)) - 1;
+  for (std::size_t i = 1; i <= num_workers; ++i) {
+    // The workers print the progress of the cores they operate, so they name the environment as the calling thread does
+    workers.emplace_back([this, i, prefix = output_prefix()] {
+      output_prefix() = prefix;
+      worker_loop(i);
+    });
+  }
+}
+
+champsim::parallel_engine::~parallel_engine()
+{
+  {
+    std::lock_guard lock{mtx};
+    stopping = true;
+  }
+  start_cv.notify_all();
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+void champsim::parallel_engine::worker_loop(std::size_t worker_idx)
+{
+  uint64_t seen_generation = 0;
+  while (true) {
+    std::unique_lock lock{mtx};
+    start_cv.wait(lock, [&] { return stopping || generation != seen_generation; });
+    if (stopping) {
+      return;
+    }
+    seen_generation = generation;
+    lock.unlock();
+
+    try {
+      job(worker_idx);
+    } catch (...) {
+      std::lock_guard error_lock{mtx};
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+
+    lock.lock();
+    if (--pending == 0) {
+      done_cv.notify_one();
+    }
+  }
+}
+
+void champsim::parallel_engine::run_on_workers(std::function<void(std::size_t)> work)
+{
+  {
+    std::lock_guard lock{mtx};
+    job = std::move(work);
+    pending = std::size(workers);
+    ++generation;
+  }
+  start_cv.notify_all();
+
+  std::exception_ptr caller_error{};
+  try {
+    job(0);
+  } catch (...) {
+    caller_error = std::current_exception();
+  }
+
+  // Wait for every worker, even if this thread failed, since the job may refer to the caller's state
+  std::unique_lock lock{mtx};
+  done_cv.wait(lock, [&] { return pending == 0; });
+
+  auto worker_error = std::exchange(error, nullptr);
+  if (caller_error) {
+    std::rethrow_exception(caller_error);
+  }
+  if (worker_error) {
+    std::rethrow_exception(worker_error);
+  }
+}
+
+long champsim::parallel_engine::operate_for(const champsim::chrono::clock& start, champsim::chrono::clock::duration time_quantum, long quanta)
+{
+  auto operate_domain = [&](domain& dom) {
+    auto local_clock = start;
+    long progress{0};
+    for (long i = 0; i < quanta; ++i) {
+      local_clock.tick(time_quantum);
+      progress += dom.operate_on(local_clock);
+    }
+    return progress;
+  };
+
+  // Core domains only touch their own state and the channels into the shared domain, which is idle until they finish
+  std::vector<long> progress(std::size(partition.cores), 0);
+  run_on_workers([&](std::size_t worker_idx) {
+    for (auto i = worker_idx; i < std::size(partition.cores); i += num_threads()) {
+      progress.at(i) = operate_domain(partition.cores.at(i));
+    }
+  });
+
+  auto shared_progress = operate_domain(partition.shared);
+  return std::accumulate(std::begin(progress), std::end(progress), shared_progress);
+}
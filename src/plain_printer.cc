@@ -62,6 +62,17 @@ std::vector<std::string> champsim::plain_printer::format(O3_CPU::stats_type stat
                                 ::print_ratio(std::kilo::num * stats.branch_type_misses.value_or(idx, 0), stats.instrs())));
   }
 
+  // Cores that never consulted a value predictor do not report on it
+  if (stats.value_predictions > 0) {
+    lines.push_back(fmt::format("{} Value Prediction Coverage: {}% Accuracy: {}% MPKI: {}", stats.name,
+                                ::print_ratio(100 * stats.value_confident_predictions, stats.value_predictions),
+                                ::print_ratio(100 * (stats.value_confident_predictions - stats.value_mispredictions), stats.value_confident_predictions),
+                                ::print_ratio(std::kilo::num * stats.value_mispredictions, stats.instrs())));
+    lines.push_back(fmt::format("{} Value Misprediction Recovery: {} Penalty Cycles: {} Reissued Instructions: {}", stats.name,
+                                value_recovery_type_names.at(champsim::to_underlying(stats.value_recovery)), stats.value_recovery_cycles,
+                                stats.value_reissued_instrs));
+  }
+
   return lines;
 }
 
@@ -204,9 +215,31 @@ std::vector<std::string> champsim::plain_printer::format(champsim::phase_stats&
   return lines;
 }
 
+std::vector<std::string> champsim::plain_printer::format(const champsim::sampled_stats& stats)
+{
+  std::vector<std::string> lines{};
+  lines.push_back(fmt::format("=== Weighted SimPoint Statistics (total weight {:.4g}) ===", stats.total_weight));
+
+  for (const auto& core : stats.cores) {
+    lines.push_back(fmt::format("{} weighted IPC: {:.4g} branch MPKI: {:.4g}", core.name, core.ipc, core.branch_mpki));
+  }
+
+  for (const auto& cache : stats.caches) {
+    lines.push_back(fmt::format("cpu{}->{} weighted demand MPKI: {:.4g}", cache.cpu, cache.name, cache.mpki));
+  }
+
+  return lines;
+}
+
 void champsim::plain_printer::print(std::vector<phase_stats>& stats)
 {
   for (auto p : stats) {
     print(p);
   }
+
+  if (auto sampled = combine_weighted(stats); sampled.has_value()) {
+    auto lines = format(*sampled);
+    stream << "\n";
+    std::copy(std::begin(lines), std::end(lines), std::ostream_iterator<std::string>(stream, "\n"));
+  }
 }
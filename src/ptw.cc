@@ -16,12 +16,15 @@
 
 #include "ptw.h"
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
 #include <numeric>
 #include <fmt/chrono.h>
 #include <fmt/core.h>
 
 #include "champsim.h"
+#include "checkpoint.h"
 #include "deadlock.h"
 #include "instruction.h"
 #include "ptw_builder.h" // for ptw_builder
@@ -53,9 +56,13 @@ PageTableWalker::mshr_type::mshr_type(const request_type& req, std::size_t level
   asid[1] = req.asid[1];
 }
 
-auto PageTableWalker::handle_read(const request_type& handle_pkt, channel_type* ul) -> std::optional<mshr_type>
+void PageTableWalker::begin_walk(mshr_type& step)
 {
-  pscl_entry walk_init = {handle_pkt.v_address, CR3_addr, std::size(pscl)};
+  // The step is built from the request, whose addresses it replaces
+  const auto req_address = step.address;
+  const auto req_v_address = step.v_address;
+
+  pscl_entry walk_init = {req_v_address, CR3_addr, std::size(pscl)};
   std::vector<std::optional<pscl_entry>> pscl_hits;
   std::transform(std::begin(pscl), std::end(pscl), std::back_inserter(pscl_hits), [walk_init](auto& x) { return x.check_hit(walk_init); });
   walk_init =
@@ -63,24 +70,36 @@ auto PageTableWalker::handle_read(const request_type& handle_pkt, channel_type*
 
   champsim::address_slice walk_offset{
       champsim::dynamic_extent{champsim::data::bits{LOG2_PAGE_SIZE}, champsim::data::bits{champsim::lg2(pte_entry::byte_multiple)}},
-      vmem->get_offset(handle_pkt.address, walk_init.level)};
+      vmem->get_offset(req_address, walk_init.level)};
+
+  step.translation_level = walk_init.level;
+  step.address = champsim::address{champsim::splice(champsim::page_number{walk_init.ptw_addr}, champsim::page_offset{walk_offset})};
+  step.v_address = req_address;
 
-  mshr_type fwd_mshr{handle_pkt, walk_init.level};
-  fwd_mshr.address = champsim::address{champsim::splice(champsim::page_number{walk_init.ptw_addr}, champsim::page_offset{walk_offset})};
-  fwd_mshr.v_address = handle_pkt.address;
+  if constexpr (champsim::debug_print) {
+    fmt::print("[{}] {} address: {} v_address: {} pt_page_offset: {} translation_level: {} cycle: {}\n", NAME, __func__, step.address, req_v_address,
+               walk_offset.to<int>(), walk_init.level, current_time.time_since_epoch() / clock_period);
+  }
+}
+
+bool PageTableWalker::handle_read(const request_type& handle_pkt, channel_type* ul)
+{
+  // The walk is built in its MSHR, which is given back if the first step cannot be issued
+  auto& fwd_mshr = MSHR.emplace_back(handle_pkt, std::size(pscl));
+  begin_walk(fwd_mshr);
   if (handle_pkt.response_requested) {
     fwd_mshr.to_return = {&ul->returned};
   }
 
-  if constexpr (champsim::debug_print) {
-    fmt::print("[{}] {} address: {} v_address: {} pt_page_offset: {} translation_level: {} cycle: {}\n", NAME, __func__, fwd_mshr.address, handle_pkt.v_address,
-               walk_offset.to<int>(), walk_init.level, current_time.time_since_epoch() / clock_period);
+  if (!lower_level->add_rq(step_packet(fwd_mshr))) {
+    MSHR.pop_back();
+    return false;
   }
 
-  return step_translation(fwd_mshr);
+  return true;
 }
 
-auto PageTableWalker::handle_fill(const mshr_type& fill_mshr) -> std::optional<mshr_type>
+bool PageTableWalker::handle_fill(mshr_type& fill_mshr)
 {
   if constexpr (champsim::debug_print) {
     champsim::dynamic_extent pte_offset_extent{champsim::data::bits{LOG2_PAGE_SIZE}, champsim::data::bits{champsim::lg2(pte_entry::byte_multiple)}};
@@ -92,14 +111,20 @@ auto PageTableWalker::handle_fill(const mshr_type& fill_mshr) -> std::optional<m
   const auto pscl_idx = std::size(pscl) - fill_mshr.translation_level;
   pscl.at(pscl_idx).fill({fill_mshr.v_address, *fill_mshr.data, fill_mshr.translation_level});
 
-  mshr_type fwd_mshr = fill_mshr;
-  fwd_mshr.address = *fill_mshr.data;
-  fwd_mshr.translation_level = fill_mshr.translation_level - 1;
+  // The next step is issued from the entry, which is advanced only once the step is accepted
+  auto fwd_pkt = step_packet(fill_mshr);
+  fwd_pkt.address = *fill_mshr.data;
+  if (!lower_level->add_rq(std::move(fwd_pkt))) {
+    return false;
+  }
+
+  fill_mshr.address = *fill_mshr.data;
+  fill_mshr.translation_level = fill_mshr.translation_level - 1;
 
-  return step_translation(fwd_mshr);
+  return true;
 }
 
-auto PageTableWalker::step_translation(const mshr_type& source) -> std::optional<mshr_type>
+auto PageTableWalker::step_packet(const mshr_type& source) -> request_type
 {
   request_type packet;
   packet.address = source.address;
@@ -110,13 +135,24 @@ auto PageTableWalker::step_translation(const mshr_type& source) -> std::optional
   packet.asid[1] = source.asid[1];
   packet.is_translated = true;
   packet.type = access_type::TRANSLATION;
+  return packet;
+}
 
-  bool success = lower_level->add_rq(packet);
-  if (success) {
-    return source;
+champsim::address PageTableWalker::functional_walk(const request_type& pkt, const std::function<void(const channel_type*, const request_type&)>& read_entry)
+{
+  mshr_type step{pkt, std::size(pscl)};
+  begin_walk(step);
+  while (step.translation_level > 0) {
+    read_entry(lower_level, step_packet(step));
+
+    auto pte_addr = vmem->get_pte_pa(step.cpu, champsim::page_number{step.v_address}, step.translation_level).first;
+    pscl.at(std::size(pscl) - step.translation_level).fill({step.v_address, pte_addr, step.translation_level});
+    step.address = pte_addr;
+    step.translation_level = step.translation_level - 1;
   }
 
-  return std::nullopt;
+  read_entry(lower_level, step_packet(step));
+  return champsim::address{vmem->va_to_pa(step.cpu, champsim::page_number{step.v_address}).first};
 }
 
 long PageTableWalker::operate()
@@ -130,8 +166,6 @@ long PageTableWalker::operate()
   progress += std::distance(std::cbegin(lower_level->returned), std::cend(lower_level->returned));
   lower_level->returned.clear();
 
-  std::vector<mshr_type> next_steps{};
-
   champsim::bandwidth fill_bw{MAX_FILL};
   auto [complete_begin, complete_end] = champsim::get_span_p(std::cbegin(completed), std::cend(completed), fill_bw, is_ready);
   std::for_each(complete_begin, complete_end, [](auto& mshr_entry) {
@@ -142,31 +176,20 @@ long PageTableWalker::operate()
   fill_bw.consume(std::distance(complete_begin, complete_end));
   completed.erase(complete_begin, complete_end);
 
-  auto [mshr_begin, mshr_end] = champsim::get_span_p(std::cbegin(finished), std::cend(finished), fill_bw, is_ready);
-  std::tie(mshr_begin, mshr_end) = champsim::get_span_p(mshr_begin, mshr_end, [&next_steps, this](const auto& pkt) {
-    auto result = this->handle_fill(pkt);
-    if (result.has_value()) {
-      next_steps.emplace_back(*result);
-    }
-    return result.has_value();
-  });
+  // Fills that issue their next step return to the MSHRs by handle
+  auto [mshr_begin, mshr_end] = champsim::get_span_p(std::begin(finished), std::end(finished), fill_bw, is_ready);
+  std::tie(mshr_begin, mshr_end) = champsim::get_span_p(mshr_begin, mshr_end, [this](auto& pkt) { return this->handle_fill(pkt); });
   fill_bw.consume(std::distance(mshr_begin, mshr_end));
-  finished.erase(mshr_begin, mshr_end);
+  finished.transfer(mshr_begin, mshr_end, MSHR);
 
   champsim::bandwidth tag_bw{MAX_READ};
   for (auto* ul : upper_levels) {
-    auto [rq_begin, rq_end] = champsim::get_span_p(std::cbegin(ul->RQ), std::cend(ul->RQ), tag_bw, [&next_steps, ul, this](const auto& pkt) {
-      auto result = this->handle_read(pkt, ul);
-      if (result.has_value()) {
-        next_steps.emplace_back(*result);
-      }
-      return result.has_value();
-    });
+    auto [rq_begin, rq_end] =
+        champsim::get_span_p(std::cbegin(ul->RQ), std::cend(ul->RQ), tag_bw, [ul, this](const auto& pkt) { return this->handle_read(pkt, ul); });
     tag_bw.consume(std::distance(rq_begin, rq_end));
     ul->RQ.erase(rq_begin, rq_end);
   }
 
-  MSHR.insert(std::cend(MSHR), std::begin(next_steps), std::end(next_steps));
   progress += fill_bw.amount_consumed() + tag_bw.amount_consumed();
 
   if constexpr (champsim::debug_print) {
@@ -182,7 +205,7 @@ long PageTableWalker::operate()
 
 void PageTableWalker::finish_packet(const response_type& packet)
 {
-  auto finish_step = [this](auto mshr_entry) {
+  auto finish_step = [this](const auto& mshr_entry) {
     auto [ppage, penalty] = this->vmem->get_pte_pa(mshr_entry.cpu, champsim::page_number{mshr_entry.v_address}, mshr_entry.translation_level);
 
     if constexpr (champsim::debug_print) {
@@ -194,7 +217,7 @@ void PageTableWalker::finish_packet(const response_type& packet)
     return champsim::waitable{ppage, this->current_time + penalty + (this->warmup ? champsim::chrono::clock::duration{} : HIT_LATENCY)};
   };
 
-  auto finish_last_step = [this](auto mshr_entry) {
+  auto finish_last_step = [this](const auto& mshr_entry) {
     auto [ppage, penalty] = this->vmem->va_to_pa(mshr_entry.cpu, champsim::page_number{mshr_entry.v_address});
 
     if constexpr (champsim::debug_print) {
@@ -206,20 +229,45 @@ void PageTableWalker::finish_packet(const response_type& packet)
     return champsim::waitable{champsim::address{ppage}, this->current_time + penalty + (this->warmup ? champsim::chrono::clock::duration{} : HIT_LATENCY)};
   };
 
-  auto matches_addr = [block = champsim::block_number{packet.address}](auto x) {
+  auto matches_addr = [block = champsim::block_number{packet.address}](const auto& x) {
     return champsim::block_number{x.address} == block;
   };
-  auto is_last_step = [](auto x) {
+  auto is_last_step = [](const auto& x) {
     return x.translation_level <= 0;
   };
-  auto last_finished = std::partition(std::begin(MSHR), std::end(MSHR), matches_addr);
+  auto last_finished = MSHR.stable_partition(std::begin(MSHR), std::end(MSHR), matches_addr);
 
   std::for_each(std::begin(MSHR), last_finished, [is_last_step, finish_step, finish_last_step](auto& mshr_entry) {
     mshr_entry.data = is_last_step(mshr_entry) ? finish_last_step(mshr_entry) : finish_step(mshr_entry);
   });
 
-  std::partition_copy(std::begin(MSHR), last_finished, std::back_inserter(completed), std::back_inserter(finished), is_last_step);
-  MSHR.erase(std::begin(MSHR), last_finished);
+  // The finished entries move on by handle
+  last_finished = MSHR.transfer_if(std::begin(MSHR), last_finished, completed, is_last_step);
+  MSHR.transfer(std::begin(MSHR), last_finished, finished);
+}
+
+champsim::chrono::clock::time_point PageTableWalker::next_event_time() const
+{
+  auto has_requests = [](const channel_type* ul) {
+    return !std::empty(ul->RQ);
+  };
+  auto is_ready = [time = current_time](const mshr_type& entry) {
+    return entry.data.is_ready_at(time);
+  };
+
+  // Returns and new requests are handled every cycle, as are fills that could not be issued to the lower level
+  if (!std::empty(lower_level->returned) || std::any_of(std::begin(upper_levels), std::end(upper_levels), has_requests)
+      || std::any_of(std::begin(finished), std::end(finished), is_ready) || std::any_of(std::begin(completed), std::end(completed), is_ready)) {
+    return current_time + clock_period;
+  }
+
+  auto next_event = champsim::chrono::clock::time_point::max();
+  for (auto q : {std::cref(finished), std::cref(completed)}) {
+    for (const auto& entry : q.get()) {
+      next_event = std::min(next_event, entry.data.ready_time());
+    }
+  }
+  return next_event;
 }
 
 void PageTableWalker::begin_phase()
@@ -232,6 +280,20 @@ void PageTableWalker::begin_phase()
   }
 }
 
+void PageTableWalker::save_checkpoint(std::ostream& os) const
+{
+  for (const auto& cache : pscl) {
+    cache.save_checkpoint(os);
+  }
+}
+
+void PageTableWalker::restore_checkpoint(std::istream& is)
+{
+  for (auto& cache : pscl) {
+    cache.restore_checkpoint(is);
+  }
+}
+
 // LCOV_EXCL_START Exclude the following function from LCOV
 void PageTableWalker::print_deadlock()
 {
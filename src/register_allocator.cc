@@ -48,6 +48,12 @@ void RegisterAllocator::complete_dest_register(PHYSICAL_REGISTER_ID physreg)
   physical_register_file.at(physreg).valid = true;
 }
 
+void RegisterAllocator::invalidate_dest_register(PHYSICAL_REGISTER_ID physreg)
+{
+  // the producer will execute again, so its consumers must wait for it
+  physical_register_file.at(physreg).valid = false;
+}
+
 void RegisterAllocator::retire_dest_register(PHYSICAL_REGISTER_ID physreg)
 {
   // grab the arch reg index, find old phys reg in backend RAT
@@ -73,6 +79,11 @@ bool RegisterAllocator::isValid(PHYSICAL_REGISTER_ID physreg) const { return phy
 
 bool RegisterAllocator::isAllocated(PHYSICAL_REGISTER_ID archreg) const { return frontend_RAT[archreg] != -1; }
 
+champsim::program_ordered<ooo_model_instr>::id_type RegisterAllocator::producer_id(PHYSICAL_REGISTER_ID physreg) const
+{
+  return physical_register_file.at(physreg).producing_instruction_id;
+}
+
 unsigned long RegisterAllocator::count_free_registers() const { return std::size(free_registers); }
 
 int RegisterAllocator::count_reg_dependencies(const ooo_model_instr& instr) const
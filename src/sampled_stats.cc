@@ -0,0 +1,78 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sampled_stats.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <ratio>
+
+namespace
+{
+template <typename N, typename D>
+double ratio(N num, D denom)
+{
+  if (denom > 0) {
+    return static_cast<double>(num) / static_cast<double>(denom);
+  }
+  return 0;
+}
+} // namespace
+
+std::optional<champsim::sampled_stats> champsim::combine_weighted(const std::vector<phase_stats>& stats)
+{
+  std::vector<std::reference_wrapper<const phase_stats>> weighted;
+  std::copy_if(std::begin(stats), std::end(stats), std::back_inserter(weighted), [](const phase_stats& phase) { return phase.weight.has_value(); });
+  if (std::empty(weighted)) {
+    return std::nullopt;
+  }
+
+  sampled_stats retval;
+  retval.total_weight =
+      std::accumulate(std::begin(weighted), std::end(weighted), 0.0, [](double acc, const phase_stats& phase) { return acc + phase.weight.value(); });
+
+  const phase_stats& first = weighted.front();
+  for (std::size_t cpu = 0; cpu < std::size(first.roi_cpu_stats); ++cpu) {
+    // Every interval has the same number of instructions, so the cycles per instruction combine linearly, but the instructions per cycle do not
+    double cpi{0};
+    double branch_mpki{0};
+    for (const phase_stats& phase : weighted) {
+      const auto& core = phase.roi_cpu_stats.at(cpu);
+      const auto fraction = phase.weight.value() / retval.total_weight;
+      cpi += fraction * ratio(core.cycles(), core.instrs());
+      branch_mpki += fraction * std::kilo::num * ratio(core.branch_type_misses.total(), core.instrs());
+    }
+    retval.cores.push_back({first.roi_cpu_stats.at(cpu).name, cpi > 0 ? 1 / cpi : 0, branch_mpki});
+  }
+
+  for (std::size_t cache_idx = 0; cache_idx < std::size(first.roi_cache_stats); ++cache_idx) {
+    for (std::size_t cpu = 0; cpu < std::size(first.roi_cpu_stats); ++cpu) {
+      double mpki{0};
+      for (const phase_stats& phase : weighted) {
+        const auto& cache = phase.roi_cache_stats.at(cache_idx);
+        uint64_t demand_misses{0};
+        for (const auto type : {access_type::LOAD, access_type::RFO, access_type::WRITE, access_type::TRANSLATION}) {
+          demand_misses += cache.misses.value_or(std::pair{type, cpu}, 0);
+        }
+        mpki += phase.weight.value() / retval.total_weight * std::kilo::num * ratio(demand_misses, phase.roi_cpu_stats.at(cpu).instrs());
+      }
+      retval.caches.push_back({first.roi_cache_stats.at(cache_idx).name, cpu, mpki});
+    }
+  }
+
+  return retval;
+}
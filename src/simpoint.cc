@@ -0,0 +1,105 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "simpoint.h"
+
+#include <algorithm>
+#include <istream>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <fmt/core.h>
+
+namespace
+{
+/**
+ * Read the lines of a SimPoint output file, each of which holds a value and a cluster id.
+ */
+template <typename T>
+std::map<long long, T> read_by_cluster(std::istream& file, std::string_view file_kind)
+{
+  std::map<long long, T> retval;
+  std::string line;
+  for (long long line_num = 1; std::getline(file, line); ++line_num) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+
+    std::istringstream fields{line};
+    T value{};
+    long long cluster{};
+    if (!(fields >> value >> cluster)) {
+      throw std::runtime_error{fmt::format("Malformed line {} in SimPoint {} file: {}", line_num, file_kind, line)};
+    }
+    retval.insert_or_assign(cluster, value);
+  }
+  return retval;
+}
+} // namespace
+
+std::vector<champsim::simpoint> champsim::read_simpoints(std::istream& simpoints, std::istream& weights)
+{
+  auto intervals = read_by_cluster<long long>(simpoints, "simpoints");
+  auto cluster_weights = read_by_cluster<double>(weights, "weights");
+
+  std::vector<simpoint> retval;
+  for (auto [cluster, interval] : intervals) {
+    auto weight = cluster_weights.find(cluster);
+    if (weight == std::end(cluster_weights)) {
+      throw std::runtime_error{fmt::format("SimPoint cluster {} has no weight", cluster)};
+    }
+    retval.push_back({interval, weight->second});
+  }
+
+  if (std::size(cluster_weights) != std::size(intervals)) {
+    throw std::runtime_error{"SimPoint weights file has clusters that are not in the simpoints file"};
+  }
+
+  std::sort(std::begin(retval), std::end(retval), [](const auto& lhs, const auto& rhs) { return lhs.interval < rhs.interval; });
+  return retval;
+}
+
+std::vector<champsim::phase_info> champsim::simpoint_phases(const std::vector<simpoint>& points, long long interval_length, long long warmup_length,
+                                                            const std::vector<std::string>& trace_names)
+{
+  std::vector<std::size_t> trace_index(std::size(trace_names));
+  std::iota(std::begin(trace_index), std::end(trace_index), 0);
+
+  std::vector<phase_info> retval;
+  long long position{0}; // The number of instructions that have been consumed from the trace
+  for (const auto& point : points) {
+    auto detail_begin = point.interval * interval_length;
+    auto warmup_begin = std::max(position, detail_begin - warmup_length);
+
+    phase_info warmup{fmt::format("SimPoint {} Warmup", point.interval), true, detail_begin - warmup_begin, trace_index, trace_names};
+    phase_info detail{fmt::format("SimPoint {}", point.interval), false, interval_length, trace_index, trace_names};
+    detail.weight = point.weight;
+
+    if (warmup.length > 0) {
+      warmup.fast_forward = warmup_begin - position;
+      retval.push_back(warmup);
+    } else {
+      detail.fast_forward = warmup_begin - position;
+    }
+    retval.push_back(detail);
+
+    position = detail_begin + interval_length;
+  }
+
+  return retval;
+}
@@ -0,0 +1,113 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tag_store.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "checkpoint.h"
+#include "util/to_underlying.h"
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+champsim::tag_store::tag_store(std::size_t num_set, std::size_t num_way_, champsim::data::bits offset_bits_)
+    : tags(num_set * num_way_), valid(num_set * num_way_), num_way(num_way_), offset_shift(champsim::to_underlying(offset_bits_))
+{
+}
+
+uint64_t champsim::tag_store::tag_of(champsim::address addr) const { return addr.to<uint64_t>() >> offset_shift; }
+
+void champsim::tag_store::assign(std::size_t index, const champsim::cache_block& blk)
+{
+  tags.at(index) = tag_of(blk.address);
+  valid.at(index) = blk.valid ? 1 : 0;
+}
+
+bool champsim::tag_store::is_valid(std::size_t index) const { return valid.at(index) != 0; }
+
+champsim::address champsim::tag_store::address_of(std::size_t index) const
+{
+  return champsim::address{tags.at(index) << offset_shift};
+}
+
+std::size_t champsim::tag_store::find_first(std::size_t set, uint64_t tag, bool valid_only) const
+{
+  const auto* set_tags = std::data(tags) + set * num_way;
+  const auto* set_valid = std::data(valid) + set * num_way;
+  auto is_match = [set_valid, valid_only](std::size_t way) {
+    return !valid_only || set_valid[way] != 0;
+  };
+
+  std::size_t way = 0;
+#if defined(__AVX2__)
+  // Compare four tags at a time, then check the valid flags of the ways that match
+  const auto needle = _mm256_set1_epi64x(static_cast<long long>(tag));
+  for (; way + 4 <= num_way; way += 4) {
+    const auto lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(set_tags + way)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(lanes, needle)));
+    for (std::size_t lane = 0; lane < 4; ++lane) {
+      if (((mask >> lane) & 1) != 0 && is_match(way + lane)) {
+        return way + lane;
+      }
+    }
+  }
+#elif defined(__SSE4_1__)
+  // Compare two tags at a time, then check the valid flags of the ways that match
+  const auto needle = _mm_set1_epi64x(static_cast<long long>(tag));
+  for (; way + 2 <= num_way; way += 2) {
+    const auto lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set_tags + way)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto mask = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(lanes, needle)));
+    for (std::size_t lane = 0; lane < 2; ++lane) {
+      if (((mask >> lane) & 1) != 0 && is_match(way + lane)) {
+        return way + lane;
+      }
+    }
+  }
+#endif
+
+  for (; way < num_way; ++way) {
+    if (set_tags[way] == tag && is_match(way)) {
+      return way;
+    }
+  }
+  return num_way;
+}
+
+std::size_t champsim::tag_store::find(std::size_t set, champsim::address addr) const { return find_first(set, tag_of(addr), true); }
+
+std::size_t champsim::tag_store::find_any(std::size_t set, champsim::address addr) const { return find_first(set, tag_of(addr), false); }
+
+std::size_t champsim::tag_store::find_invalid(std::size_t set) const
+{
+  auto set_begin = std::next(std::cbegin(valid), static_cast<std::ptrdiff_t>(set * num_way));
+  auto set_end = std::next(set_begin, static_cast<std::ptrdiff_t>(num_way));
+  return static_cast<std::size_t>(std::distance(set_begin, std::find(set_begin, set_end, uint8_t{0})));
+}
+
+void champsim::tag_store::save_checkpoint(std::ostream& os) const
+{
+  champsim::checkpoint::write(os, tags);
+  champsim::checkpoint::write(os, valid);
+}
+
+void champsim::tag_store::restore_checkpoint(std::istream& is)
+{
+  champsim::checkpoint::read(is, tags);
+  champsim::checkpoint::read(is, valid);
+}
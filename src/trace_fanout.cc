@@ -0,0 +1,153 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "trace_fanout.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+champsim::trace_fanout::trace_fanout(std::vector<tracereader> traces, std::size_t consumers, std::size_t batch_sz, std::size_t lead)
+    : next_batch(consumers, std::vector<uint64_t>(std::size(traces), 0)), active(consumers, true), batch_size(batch_sz), max_lead(lead)
+{
+  for (auto& trace : traces) {
+    sources.emplace_back(std::move(trace));
+  }
+}
+
+std::vector<champsim::tracereader> champsim::trace_fanout::readers(std::size_t consumer)
+{
+  std::vector<tracereader> retval;
+  for (std::size_t i = 0; i < std::size(sources); ++i) {
+    retval.emplace_back(cursor{this, consumer, i});
+  }
+  return retval;
+}
+
+void champsim::trace_fanout::release(std::size_t consumer)
+{
+  {
+    std::lock_guard lock{mutex};
+    active.at(consumer) = false;
+    for (std::size_t i = 0; i < std::size(sources); ++i) {
+      trim(i);
+    }
+  }
+  batch_taken.notify_all();
+}
+
+std::size_t champsim::trace_fanout::buffered_batches() const
+{
+  std::lock_guard lock{mutex};
+  return std::accumulate(std::cbegin(sources), std::cend(sources), std::size_t{0}, [](auto acc, const auto& src) { return acc + std::size(src.batches); });
+}
+
+uint64_t champsim::trace_fanout::slowest_batch(std::size_t source_idx) const
+{
+  uint64_t retval = std::numeric_limits<uint64_t>::max();
+  for (std::size_t i = 0; i < std::size(next_batch); ++i) {
+    if (active.at(i)) {
+      retval = std::min(retval, next_batch.at(i).at(source_idx));
+    }
+  }
+  return retval;
+}
+
+std::size_t champsim::trace_fanout::num_active() const { return static_cast<std::size_t>(std::count(std::begin(active), std::end(active), true)); }
+
+void champsim::trace_fanout::trim(std::size_t source_idx)
+{
+  auto& src = sources.at(source_idx);
+  auto slowest = slowest_batch(source_idx);
+  while (!std::empty(src.batches) && src.first_batch < slowest) {
+    src.batches.pop_front();
+    ++src.first_batch;
+  }
+}
+
+auto champsim::trace_fanout::take_batch(std::size_t consumer, std::size_t source_idx) -> std::shared_ptr<const batch_type>
+{
+  std::unique_lock lock{mutex};
+  auto& src = sources.at(source_idx);
+  const auto seq = next_batch.at(consumer).at(source_idx);
+
+  // Waiting while every other consumer also waits would never end, since they may be waiting on this one through another trace
+  ++num_waiting;
+  batch_taken.wait(lock, [&, this] { return seq < slowest_batch(source_idx) + max_lead || num_waiting >= num_active(); });
+  --num_waiting;
+
+  // The first consumer to reach a batch decodes it without holding the lock, so that the other traces can be read meanwhile.
+  // Any other consumer that reaches the same batch waits for it to be published.
+  while (seq - src.first_batch >= std::size(src.batches)) {
+    if (src.decoding) {
+      batch_taken.wait(lock, [&src] { return !src.decoding; });
+      continue;
+    }
+
+    src.decoding = true;
+    lock.unlock();
+
+    batch_type batch;
+    batch.reserve(batch_size);
+    try {
+      while (std::size(batch) < batch_size && !src.reader.eof()) {
+        batch.push_back(src.reader());
+      }
+    } catch (...) {
+      // Do not leave the other consumers waiting on a batch that will never come
+      lock.lock();
+      src.decoding = false;
+      lock.unlock();
+      batch_taken.notify_all();
+      throw;
+    }
+
+    lock.lock();
+    src.decoding = false;
+    if (std::empty(batch)) {
+      lock.unlock();
+      batch_taken.notify_all();
+      return nullptr;
+    }
+    src.batches.push_back(std::make_shared<const batch_type>(std::move(batch)));
+  }
+
+  auto retval = src.batches.at(seq - src.first_batch);
+  ++next_batch.at(consumer).at(source_idx);
+  trim(source_idx);
+
+  lock.unlock();
+  batch_taken.notify_all();
+  return retval;
+}
+
+champsim::trace_fanout::cursor::cursor(trace_fanout* parent, std::size_t consumer_idx, std::size_t src_idx)
+    : fanout(parent), consumer(consumer_idx), source_idx(src_idx), current(parent->take_batch(consumer_idx, src_idx))
+{
+}
+
+ooo_model_instr champsim::trace_fanout::cursor::operator()()
+{
+  auto retval = current->at(offset++);
+
+  // Read ahead, so that the end of the trace is known as soon as the last instruction is taken
+  if (offset == std::size(*current)) {
+    current = fanout->take_batch(consumer, source_idx);
+    offset = 0;
+  }
+
+  return retval;
+}
@@ -0,0 +1,80 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "trace_index.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace
+{
+constexpr std::string_view index_header{"champsim-trace-index"};
+constexpr int index_version = 1;
+} // namespace
+
+auto champsim::trace_index::restart_points() const -> std::vector<restart_point>
+{
+  std::vector<restart_point> retval;
+  std::transform(std::cbegin(entries), std::cend(entries), std::back_inserter(retval),
+                 [size = record_size](const entry& x) { return restart_point{x.instruction * size, x.compressed_offset}; });
+  return retval;
+}
+
+std::string champsim::trace_index_name(std::string_view trace_name) { return std::string{trace_name} + ".idx"; }
+
+champsim::trace_index champsim::read_trace_index(std::istream& strm)
+{
+  std::string header;
+  int version = 0;
+  trace_index retval;
+  strm >> header >> version >> retval.record_size;
+  if (!strm || header != index_header || version != index_version || retval.record_size == 0) {
+    throw std::runtime_error{"Stream does not hold a trace index"};
+  }
+
+  trace_index::entry next;
+  while (strm >> next.instruction >> next.compressed_offset) {
+    if (!std::empty(retval.entries)
+        && (next.instruction < retval.entries.back().instruction || next.compressed_offset < retval.entries.back().compressed_offset)) {
+      throw std::runtime_error{"Trace index is not in order"};
+    }
+    retval.entries.push_back(next);
+  }
+
+  if (!strm.eof()) {
+    throw std::runtime_error{"Trace index is malformed"};
+  }
+  return retval;
+}
+
+void champsim::write_trace_index(std::ostream& strm, const trace_index& index)
+{
+  strm << index_header << ' ' << index_version << ' ' << index.record_size << '\n';
+  for (const auto& entry : index.entries) {
+    strm << entry.instruction << ' ' << entry.compressed_offset << '\n';
+  }
+}
+
+auto champsim::load_restart_points(std::string_view trace_name) -> std::vector<restart_point>
+{
+  std::ifstream index_file{trace_index_name(trace_name)};
+  if (!index_file) {
+    return {};
+  }
+  return read_trace_index(index_file).restart_points();
+}
@@ -18,13 +18,19 @@
 
 #include <fstream>
 #include <string>
+#include <string_view>
 
+#include "async_tracereader.h"
+#include "cvp_tracereader.h"
 #include "inf_stream.h"
+#include "mapped_tracereader.h"
 #include "repeatable.h"
+#include "restartable_istream.h"
+#include "zstd_seekable.h"
 
 namespace champsim
 {
-uint64_t tracereader::instr_unique_id = 0; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+thread_local uint64_t tracereader::instr_unique_id = 0; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 ooo_model_instr apply_branch_target(ooo_model_instr branch, const ooo_model_instr& target)
 {
@@ -32,19 +38,56 @@ ooo_model_instr apply_branch_target(ooo_model_instr branch, const ooo_model_inst
   return branch;
 }
 
+bool is_compressed_trace_name(std::string_view fname)
+{
+  for (std::string_view compression : {"gz", "xz", "bz2", "zst"}) {
+    if (fname.size() >= compression.size() && fname.substr(fname.size() - compression.size()) == compression) {
+      return true;
+    }
+  }
+  return false;
+}
+
+namespace
+{
+// Whether the name has the given extension before any compression extension
+bool has_trace_extension(std::string_view fname, std::string_view extension)
+{
+  for (std::string_view compression : {".gz", ".xz", ".bz2", ".zst"}) {
+    if (fname.size() >= compression.size() && fname.substr(fname.size() - compression.size()) == compression) {
+      fname.remove_suffix(compression.size());
+      break;
+    }
+  }
+
+  return fname.size() >= extension.size() && fname.substr(fname.size() - extension.size()) == extension;
+}
+} // namespace
+
+bool is_cvp_trace_name(std::string_view fname) { return has_trace_extension(fname, ".cvp"); }
+
+bool is_compact_trace_name(std::string_view fname) { return has_trace_extension(fname, ".cst"); }
+
+// Compressed traces are decompressed on a background thread. Traces that are indexed, or that are in the zstd seekable format, skip
+// instructions by restarting decompression near the destination.
 template <template <class, class> typename R, typename T>
 champsim::tracereader get_tracereader_for_type(std::string fname, uint8_t cpu)
 {
   if (bool is_gzip_compressed = (fname.substr(std::size(fname) - 2) == "gz"); is_gzip_compressed) {
-    return champsim::tracereader{R<T, champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>>>(cpu, fname)};
+    return champsim::tracereader{champsim::async_tracereader{R<T, champsim::restartable_istream<champsim::decomp_tags::gzip_tag_t<>>>(cpu, fname)}};
   }
 
   if (bool is_lzma_compressed = (fname.substr(std::size(fname) - 2) == "xz"); is_lzma_compressed) {
-    return champsim::tracereader{R<T, champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<>>>(cpu, fname)};
+    return champsim::tracereader{
+        champsim::async_tracereader{R<T, champsim::restartable_istream<champsim::decomp_tags::lzma_tag_t<LZMA_CONCATENATED>>>(cpu, fname)}};
   }
 
   if (bool is_bzip2_compressed = (fname.substr(std::size(fname) - 3) == "bz2"); is_bzip2_compressed) {
-    return champsim::tracereader{R<T, champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t>>(cpu, fname)};
+    return champsim::tracereader{champsim::async_tracereader{R<T, champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t>>(cpu, fname)}};
+  }
+
+  if (bool is_zstd_compressed = (fname.substr(std::size(fname) - 3) == "zst"); is_zstd_compressed) {
+    return champsim::tracereader{champsim::async_tracereader{R<T, champsim::zstd_seekable_istream<>>(cpu, fname)}};
   }
 
   return champsim::tracereader{R<T, std::ifstream>(cpu, fname)};
@@ -54,19 +97,65 @@ champsim::tracereader get_tracereader_for_type(std::string fname, uint8_t cpu)
 template <typename T, typename S>
 using repeatable_reader_t = champsim::repeatable<champsim::bulk_tracereader<T, S>, uint8_t, std::string>;
 
-champsim::tracereader get_tracereader(const std::string& fname, uint8_t cpu, bool is_cloudsuite, bool repeat)
+// CVP records have no fixed layout, so the record type is unused
+template <typename T, typename S>
+using cvp_reader_t = champsim::cvp_tracereader<S>;
+
+template <typename T, typename S>
+using repeatable_cvp_reader_t = champsim::repeatable<champsim::cvp_tracereader<S>, uint8_t, std::string>;
+
+// Compact records have no fixed layout either
+template <typename T, typename S>
+using compact_reader_t = champsim::compact_tracereader<S>;
+
+template <typename T, typename S>
+using repeatable_compact_reader_t = champsim::repeatable<champsim::compact_tracereader<S>, uint8_t, std::string>;
+
+template <typename T>
+using repeatable_mapped_reader_t = champsim::repeatable<champsim::mapped_tracereader<T>, uint8_t, std::string>;
+
+template <typename T>
+champsim::tracereader get_tracereader_for_format(const std::string& fname, uint8_t cpu, bool repeat)
 {
-  if (is_cloudsuite && repeat) {
-    return champsim::get_tracereader_for_type<repeatable_reader_t, cloudsuite_instr>(fname, cpu);
+  // Uncompressed traces are decoded in place from a mapping of the file. Pipes cannot be mapped, and are streamed like compressed traces.
+  if (!champsim::is_compressed_trace_name(fname) && champsim::mapped_file::can_map(fname)) {
+    if (repeat) {
+      return champsim::tracereader{repeatable_mapped_reader_t<T>(cpu, fname)};
+    }
+    return champsim::tracereader{champsim::mapped_tracereader<T>(cpu, fname)};
   }
 
-  if (is_cloudsuite && !repeat) {
-    return champsim::get_tracereader_for_type<champsim::bulk_tracereader, cloudsuite_instr>(fname, cpu);
+  if (repeat) {
+    return champsim::get_tracereader_for_type<repeatable_reader_t, T>(fname, cpu);
   }
 
-  if (!is_cloudsuite && repeat) {
-    return champsim::get_tracereader_for_type<repeatable_reader_t, input_instr>(fname, cpu);
+  return champsim::get_tracereader_for_type<champsim::bulk_tracereader, T>(fname, cpu);
+}
+
+champsim::tracereader get_tracereader(const std::string& fname, uint8_t cpu, champsim::trace_format format, bool repeat)
+{
+  switch (format) {
+  case champsim::trace_format::cloudsuite:
+    return get_tracereader_for_format<cloudsuite_instr>(fname, cpu, repeat);
+  case champsim::trace_format::value:
+    return get_tracereader_for_format<value_instr>(fname, cpu, repeat);
+  case champsim::trace_format::cvp:
+    if (repeat) {
+      return champsim::get_tracereader_for_type<repeatable_cvp_reader_t, void>(fname, cpu);
+    }
+    return champsim::get_tracereader_for_type<cvp_reader_t, void>(fname, cpu);
+  case champsim::trace_format::compact:
+    if (repeat) {
+      return champsim::get_tracereader_for_type<repeatable_compact_reader_t, void>(fname, cpu);
+    }
+    return champsim::get_tracereader_for_type<compact_reader_t, void>(fname, cpu);
+  case champsim::trace_format::input:
+  default:
+    return get_tracereader_for_format<input_instr>(fname, cpu, repeat);
   }
+}
 
-  return champsim::get_tracereader_for_type<champsim::bulk_tracereader, input_instr>(fname, cpu);
+champsim::tracereader get_tracereader(const std::string& fname, uint8_t cpu, bool is_cloudsuite, bool repeat)
+{
+  return get_tracereader(fname, cpu, is_cloudsuite ? champsim::trace_format::cloudsuite : champsim::trace_format::input, repeat);
 }
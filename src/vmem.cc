@@ -20,6 +20,7 @@
 #include <fmt/core.h>
 
 #include "champsim.h"
+#include "checkpoint.h"
 #include "dram_controller.h"
 #include "util/bits.h"
 
@@ -154,3 +155,79 @@ std::pair<champsim::address, champsim::chrono::clock::duration> VirtualMemory::g
 
   return {paddr, penalty};
 }
+
+void VirtualMemory::save_checkpoint(std::ostream& os) const
+{
+  champsim::checkpoint::write(os, static_cast<uint64_t>(std::size(vpage_to_ppage_map)));
+  for (const auto& [key, ppage] : vpage_to_ppage_map) {
+    champsim::checkpoint::write(os, key.first);
+    champsim::checkpoint::write(os, key.second.to<uint64_t>());
+    champsim::checkpoint::write(os, ppage.to<uint64_t>());
+  }
+
+  champsim::checkpoint::write(os, static_cast<uint64_t>(std::size(page_table)));
+  for (const auto& [key, paddr] : page_table) {
+    const auto& [cpu_num, level, vaddr] = key;
+    champsim::checkpoint::write(os, cpu_num);
+    champsim::checkpoint::write(os, level);
+    champsim::checkpoint::write(os, vaddr.to<uint64_t>());
+    champsim::checkpoint::write(os, paddr.to<uint64_t>());
+  }
+
+  // The order of the free list depends on the seed and on any refills, so the pages are saved in the order they will be allocated
+  champsim::checkpoint::write(os, static_cast<uint64_t>(available_ppages()));
+  for (const auto& ppage : ppage_free_list) {
+    champsim::checkpoint::write(os, ppage.to<uint64_t>());
+  }
+  champsim::checkpoint::write(os, active_pte_page.to<uint64_t>());
+  champsim::checkpoint::write(os, next_pte_page.to<uint64_t>());
+}
+
+void VirtualMemory::restore_checkpoint(std::istream& is)
+{
+  uint64_t num_pages{};
+  champsim::checkpoint::read(is, num_pages);
+  for (uint64_t i = 0; i < num_pages; ++i) {
+    uint32_t cpu_num{};
+    uint64_t vpage{};
+    uint64_t ppage{};
+    champsim::checkpoint::read(is, cpu_num);
+    champsim::checkpoint::read(is, vpage);
+    champsim::checkpoint::read(is, ppage);
+    vpage_to_ppage_map.insert_or_assign({cpu_num, champsim::page_number{vpage}}, champsim::page_number{ppage});
+  }
+
+  uint64_t num_ptes{};
+  champsim::checkpoint::read(is, num_ptes);
+  for (uint64_t i = 0; i < num_ptes; ++i) {
+    uint32_t cpu_num{};
+    uint32_t level{};
+    uint64_t vaddr{};
+    uint64_t paddr{};
+    champsim::checkpoint::read(is, cpu_num);
+    champsim::checkpoint::read(is, level);
+    champsim::checkpoint::read(is, vaddr);
+    champsim::checkpoint::read(is, paddr);
+    champsim::dynamic_extent pte_table_entry_extent{champsim::address::bits, shamt(level)};
+    page_table.insert_or_assign({cpu_num, level, champsim::address_slice{pte_table_entry_extent, vaddr}}, champsim::address{paddr});
+  }
+
+  uint64_t free_pages{};
+  champsim::checkpoint::read(is, free_pages);
+  if (free_pages > available_ppages()) {
+    throw champsim::checkpoint::format_error{"Checkpoint has more free physical pages than the configured memory"};
+  }
+  ppage_free_list.clear();
+  for (uint64_t i = 0; i < free_pages; ++i) {
+    uint64_t ppage{};
+    champsim::checkpoint::read(is, ppage);
+    ppage_free_list.emplace_back(ppage);
+  }
+
+  uint64_t active_page{};
+  uint64_t next_page{};
+  champsim::checkpoint::read(is, active_page);
+  champsim::checkpoint::read(is, next_page);
+  active_pte_page = champsim::page_number{active_page};
+  next_pte_page = champsim::address_slice{champsim::dynamic_extent{next_pte_page.upper_extent(), next_pte_page.lower_extent()}, next_page};
+}
@@ -0,0 +1,152 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "zstd_seekable.h"
+
+#include <stdexcept>
+
+namespace
+{
+constexpr uint32_t skippable_magic = 0x184D2A5E;
+constexpr uint32_t seekable_magic = 0x8F92EAB1;
+constexpr std::size_t skippable_header_size = 8;
+constexpr std::size_t footer_size = 9;
+constexpr unsigned char checksum_flag = 0x80;
+
+uint32_t read_le32(const unsigned char* bytes)
+{
+  return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) | (static_cast<uint32_t>(bytes[2]) << 16)
+         | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+void write_le32(std::ostream& strm, uint32_t value)
+{
+  std::array<char, 4> bytes{static_cast<char>(value), static_cast<char>(value >> 8), static_cast<char>(value >> 16), static_cast<char>(value >> 24)};
+  strm.write(std::data(bytes), std::size(bytes));
+}
+
+bool read_from_end(std::istream& strm, std::streamoff offset, unsigned char* s, std::size_t count)
+{
+  strm.clear();
+  strm.seekg(-offset, std::ios::end);
+  strm.read(reinterpret_cast<char*>(s), static_cast<std::streamsize>(count)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  return strm.gcount() == static_cast<std::streamsize>(count);
+}
+} // namespace
+
+std::vector<champsim::zstd_seek_entry> champsim::read_zstd_seek_table(std::istream& strm)
+{
+  std::vector<zstd_seek_entry> retval;
+
+  std::array<unsigned char, footer_size> footer;
+  if (::read_from_end(strm, footer_size, std::data(footer), std::size(footer)) && ::read_le32(&footer[5]) == seekable_magic) {
+    const auto num_frames = ::read_le32(&footer[0]);
+    const std::size_t entry_size = (footer[4] & checksum_flag) ? 12 : 8;
+    const auto table_size = num_frames * entry_size + footer_size;
+
+    std::vector<unsigned char> table(skippable_header_size + table_size);
+    if (::read_from_end(strm, static_cast<std::streamoff>(std::size(table)), std::data(table), std::size(table)) && ::read_le32(&table[0]) == skippable_magic
+        && ::read_le32(&table[4]) == table_size) {
+      zstd_seek_entry next{};
+      for (std::size_t i = 0; i < num_frames; ++i) {
+        const auto* entry = &table[skippable_header_size + i * entry_size];
+        next.compressed_size = ::read_le32(entry);
+        next.decompressed_size = ::read_le32(entry + 4);
+        retval.push_back(next);
+
+        next.compressed_offset += next.compressed_size;
+        next.decompressed_offset += next.decompressed_size;
+      }
+    }
+  }
+
+  strm.clear();
+  strm.seekg(0);
+  return retval;
+}
+
+void champsim::write_zstd_seek_table(std::ostream& strm, const std::vector<zstd_seek_entry>& frames)
+{
+  ::write_le32(strm, skippable_magic);
+  ::write_le32(strm, static_cast<uint32_t>(std::size(frames) * 8 + footer_size));
+  for (const auto& frame : frames) {
+    ::write_le32(strm, frame.compressed_size);
+    ::write_le32(strm, frame.decompressed_size);
+  }
+  ::write_le32(strm, static_cast<uint32_t>(std::size(frames)));
+  strm.put(0); // No checksums
+  ::write_le32(strm, seekable_magic);
+}
+
+champsim::zstd_seekable_ostream::zstd_seekable_ostream(std::ostream& strm, std::size_t frame_sz) : dest(strm), frame_size(frame_sz) {}
+
+void champsim::zstd_seekable_ostream::compress(const char* s, std::size_t count, bool end_frame)
+{
+  std::array<unsigned char, 1 << 16> out_buf;
+  std::array<unsigned char, 1 << 16> in_buf;
+
+  do {
+    // Take the input in pieces, since the stream state does not refer to constant data
+    auto chunk = std::min(count, std::size(in_buf));
+    std::copy_n(s, chunk, std::begin(in_buf));
+    s = std::next(s, static_cast<std::ptrdiff_t>(chunk));
+    count -= chunk;
+
+    state->next_in = std::data(in_buf);
+    state->avail_in = chunk;
+    auto status = tag_type::status_type::CAN_CONTINUE;
+    do {
+      state->next_out = std::data(out_buf);
+      state->avail_out = std::size(out_buf);
+      status = tag_type::deflate(state, end_frame && count == 0);
+      if (status == tag_type::status_type::ERROR) {
+        throw std::runtime_error{"zstd compression failed"};
+      }
+
+      auto produced = std::size(out_buf) - state->avail_out;
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      dest.write(reinterpret_cast<const char*>(std::data(out_buf)), static_cast<std::streamsize>(produced));
+      current_frame.compressed_size += static_cast<uint32_t>(produced);
+    } while (state->avail_in > 0 || (end_frame && count == 0 && status != tag_type::status_type::END));
+  } while (count > 0);
+
+  if (end_frame) {
+    frames.push_back(current_frame);
+    current_frame = zstd_seek_entry{current_frame.compressed_offset + current_frame.compressed_size,
+                                    current_frame.decompressed_offset + current_frame.decompressed_size, 0, 0};
+  }
+}
+
+auto champsim::zstd_seekable_ostream::write(const char* s, std::size_t count) -> zstd_seekable_ostream&
+{
+  while (count > 0) {
+    auto chunk = std::min(count, frame_size - current_frame.decompressed_size);
+    current_frame.decompressed_size += static_cast<uint32_t>(chunk);
+    compress(s, chunk, current_frame.decompressed_size == frame_size);
+    s = std::next(s, static_cast<std::ptrdiff_t>(chunk));
+    count -= chunk;
+  }
+  return *this;
+}
+
+void champsim::zstd_seekable_ostream::close()
+{
+  if (current_frame.decompressed_size > 0) {
+    compress(nullptr, 0, true);
+  }
+  write_zstd_seek_table(dest, frames);
+  dest.flush();
+}
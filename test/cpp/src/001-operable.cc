@@ -60,3 +60,28 @@ TEST_CASE("An operable with a scale greater than 2 skips multiple cycles")
 
   REQUIRE(uut.count == num_cycles / 4);
 }
+
+TEST_CASE("An operable skipped to a time advances as if it had been operated, without operating")
+{
+  champsim::chrono::clock global_clock{};
+  champsim::chrono::clock::duration period{150};
+  mock_operable uut{period};
+  mock_operable reference{period};
+
+  global_clock.tick(champsim::chrono::picoseconds{1000});
+  auto skipped = uut.skip_on(global_clock);
+  auto operated = reference.operate_on(global_clock);
+
+  REQUIRE(uut.count == 0);
+  REQUIRE(skipped == operated);
+  REQUIRE(uut.current_time == reference.current_time);
+}
+
+TEST_CASE("An operable has an event every cycle by default")
+{
+  champsim::chrono::clock::duration period{150};
+  mock_operable uut{period};
+  uut._operate();
+
+  REQUIRE(uut.next_event_time() == uut.current_time + period);
+}
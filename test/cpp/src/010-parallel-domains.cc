@@ -0,0 +1,195 @@
+#include <catch.hpp>
+
+#include "defaults.hpp"
+#include "dram_controller.h"
+#include "environment.h"
+#include "instr.h"
+#include "mocks.hpp"
+#include "parallel_engine.h"
+
+namespace
+{
+struct private_hierarchy {
+  champsim::channel fetch{}, data{}, l1i_lower{}, l1d_lower{}, l2c_lower{};
+  do_nothing_MRC itlb{1}, dtlb{1}; // not caches, so they stay in the shared domain
+  CACHE l2c;
+  CACHE l1i;
+  CACHE l1d;
+  O3_CPU cpu;
+
+  explicit private_hierarchy(uint32_t idx)
+      : l2c{champsim::cache_builder{champsim::defaults::default_l2c}
+                .name("010-L2C-" + std::to_string(idx))
+                .upper_levels({&l1i_lower, &l1d_lower})
+                .lower_level(&l2c_lower)},
+        l1i{champsim::cache_builder{champsim::defaults::default_l1i}
+                .name("010-L1I-" + std::to_string(idx))
+                .upper_levels({&fetch})
+                .lower_level(&l1i_lower)
+                .lower_translate(&itlb.queues)},
+        l1d{champsim::cache_builder{champsim::defaults::default_l1d}
+                .name("010-L1D-" + std::to_string(idx))
+                .upper_levels({&data})
+                .lower_level(&l1d_lower)
+                .lower_translate(&dtlb.queues)},
+        cpu{champsim::core_builder{champsim::defaults::default_core}.index(idx).fetch_queues(&fetch).data_queues(&data).l1i(&l1i)}
+  {
+    itlb.clock_period = cpu.clock_period;
+    dtlb.clock_period = cpu.clock_period;
+  }
+};
+
+struct two_core_environment final : champsim::environment {
+  private_hierarchy core0{0};
+  private_hierarchy core1{1};
+  champsim::channel llc_lower{};
+  CACHE llc{
+      champsim::cache_builder{champsim::defaults::default_llc}.name("010-LLC").upper_levels({&core0.l2c_lower, &core1.l2c_lower}).lower_level(&llc_lower)};
+  MEMORY_CONTROLLER dram{champsim::chrono::picoseconds{625},
+                         champsim::chrono::picoseconds{1250},
+                         2,
+                         2,
+                         38,
+                         4,
+                         champsim::chrono::microseconds{64000},
+                         {&llc_lower},
+                         64,
+                         64,
+                         1,
+                         champsim::data::bytes{8},
+                         65536,
+                         128,
+                         8,
+                         2,
+                         8,
+                         8192};
+
+  std::vector<std::reference_wrapper<O3_CPU>> cpu_view() override { return {std::ref(core0.cpu), std::ref(core1.cpu)}; }
+  std::vector<std::reference_wrapper<CACHE>> cache_view() override
+  {
+    return {std::ref(core0.l1i), std::ref(core0.l1d), std::ref(core0.l2c), std::ref(core1.l1i), std::ref(core1.l1d), std::ref(core1.l2c), std::ref(llc)};
+  }
+  std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() override { return {}; }
+  MEMORY_CONTROLLER& dram_view() override { return dram; }
+  std::vector<std::reference_wrapper<champsim::operable>> operable_view() override
+  {
+    return {std::ref(core0.cpu),  std::ref(core0.l1i),  std::ref(core0.l1d),  std::ref(core0.l2c),  std::ref(core0.itlb), std::ref(core0.dtlb),
+            std::ref(core1.cpu),  std::ref(core1.l1i),  std::ref(core1.l1d),  std::ref(core1.l2c),  std::ref(core1.itlb), std::ref(core1.dtlb),
+            std::ref(llc),        std::ref(dram)};
+  }
+};
+
+auto contains(const champsim::domain& dom, const champsim::operable& op)
+{
+  return std::any_of(std::begin(dom.operables), std::end(dom.operables), [&](const champsim::operable& x) { return &x == &op; });
+}
+
+struct run_result {
+  std::vector<long long> retired{};
+  std::vector<champsim::chrono::clock::time_point> times{};
+  uint64_t llc_misses = 0;
+};
+
+run_result run_loads(std::size_t num_threads)
+{
+  two_core_environment env{};
+  for (champsim::operable& op : env.operable_view()) {
+    op.initialize();
+    op.warmup = false;
+    op.begin_phase();
+  }
+
+  for (O3_CPU& cpu : env.cpu_view()) {
+    for (uint64_t i = 0; i < 200; ++i) {
+      auto base = 0x100000 * (cpu.cpu + 1);
+      cpu.input_queue.push_back(
+          champsim::test::instruction_with_ip_and_source_memory(champsim::address{base + 4 * i}, champsim::address{base + 0x40000 + 64 * i}));
+    }
+  }
+
+  champsim::parallel_engine engine{env, num_threads};
+  champsim::chrono::clock global_clock{};
+  const auto time_quantum = env.core0.cpu.clock_period;
+  constexpr long sync_interval = 4;
+  for (int i = 0; i < 5000; ++i) {
+    engine.operate_for(global_clock, time_quantum, sync_interval);
+    global_clock.tick(sync_interval * time_quantum);
+  }
+
+  run_result result{};
+  for (champsim::operable& op : env.operable_view()) {
+    result.times.push_back(op.current_time);
+  }
+  for (O3_CPU& cpu : env.cpu_view()) {
+    result.retired.push_back(cpu.num_retired);
+  }
+  for (O3_CPU& cpu : env.cpu_view()) {
+    result.llc_misses += env.llc.sim_stats.misses.value_or(std::pair{access_type::LOAD, std::size_t{cpu.cpu}}, 0);
+  }
+  return result;
+}
+} // namespace
+
+SCENARIO("An environment is partitioned into a domain for each core and a shared domain")
+{
+  GIVEN("Two cores with private caches and a shared last-level cache")
+  {
+    two_core_environment env{};
+
+    WHEN("The environment is partitioned")
+    {
+      auto partition = champsim::partition_domains(env);
+
+      THEN("Each core is alongside its private caches")
+      {
+        REQUIRE(std::size(partition.cores) == 2);
+        for (auto [dom, core] : {std::pair{&partition.cores.at(0), &env.core0}, std::pair{&partition.cores.at(1), &env.core1}}) {
+          CHECK(std::size(dom->operables) == 4);
+          CHECK(contains(*dom, core->cpu));
+          CHECK(contains(*dom, core->l1i));
+          CHECK(contains(*dom, core->l1d));
+          CHECK(contains(*dom, core->l2c));
+        }
+      }
+
+      THEN("The last-level cache, the translators, and the memory controller are shared")
+      {
+        CHECK(std::size(partition.shared.operables) == 6);
+        CHECK(contains(partition.shared, env.llc));
+        CHECK(contains(partition.shared, env.dram));
+        CHECK(contains(partition.shared, env.core0.dtlb));
+        CHECK(contains(partition.shared, env.core1.itlb));
+      }
+    }
+  }
+}
+
+SCENARIO("The parallel engine does not depend on the number of threads")
+{
+  GIVEN("Two cores that each issue a stream of loads")
+  {
+    WHEN("The cores are simulated with one thread and with two threads")
+    {
+      auto serial = run_loads(1);
+      auto parallel = run_loads(2);
+
+      THEN("Every operable advances to the same time")
+      {
+        REQUIRE(serial.times == parallel.times);
+      }
+
+      THEN("The same instructions retire")
+      {
+        CHECK(serial.retired.at(0) > 0);
+        CHECK(serial.retired.at(1) > 0);
+        REQUIRE(serial.retired == parallel.retired);
+      }
+
+      THEN("The shared cache sees the same misses")
+      {
+        CHECK(serial.llc_misses > 0);
+        REQUIRE(serial.llc_misses == parallel.llc_misses);
+      }
+    }
+  }
+}
@@ -0,0 +1,275 @@
+#include <catch.hpp>
+
+#include <sstream>
+
+#include "checkpoint.h"
+#include "defaults.hpp"
+#include "dram_controller.h"
+#include "environment.h"
+#include "instr.h"
+#include "mocks.hpp"
+#include "vmem.h"
+
+namespace
+{
+MEMORY_CONTROLLER make_dram(std::vector<champsim::channel*> uls)
+{
+  return MEMORY_CONTROLLER{champsim::chrono::picoseconds{625},
+                           champsim::chrono::picoseconds{1250},
+                           2,
+                           2,
+                           38,
+                           4,
+                           champsim::chrono::microseconds{64000},
+                           std::move(uls),
+                           64,
+                           64,
+                           1,
+                           champsim::data::bytes{8},
+                           65536,
+                           128,
+                           8,
+                           2,
+                           8,
+                           8192};
+}
+
+struct one_core_environment final : champsim::environment {
+  champsim::channel fetch{}, data{}, l1i_lower{}, l1d_lower{}, l2c_lower{};
+  do_nothing_MRC itlb{1}, dtlb{1};
+  CACHE l2c;
+  CACHE l1i;
+  CACHE l1d;
+  O3_CPU cpu;
+  MEMORY_CONTROLLER dram;
+
+  explicit one_core_environment(uint32_t l2c_sets)
+      : l2c{champsim::cache_builder{champsim::defaults::default_l2c}
+                .name("011-L2C")
+                .sets(l2c_sets)
+                .upper_levels({&l1i_lower, &l1d_lower})
+                .lower_level(&l2c_lower)},
+        l1i{champsim::cache_builder{champsim::defaults::default_l1i}
+                .name("011-L1I")
+                .upper_levels({&fetch})
+                .lower_level(&l1i_lower)
+                .lower_translate(&itlb.queues)},
+        l1d{champsim::cache_builder{champsim::defaults::default_l1d}
+                .name("011-L1D")
+                .upper_levels({&data})
+                .lower_level(&l1d_lower)
+                .lower_translate(&dtlb.queues)},
+        cpu{champsim::core_builder{champsim::defaults::default_core}.fetch_queues(&fetch).data_queues(&data).l1i(&l1i)}, dram{make_dram({&l2c_lower})}
+  {
+    itlb.clock_period = cpu.clock_period;
+    dtlb.clock_period = cpu.clock_period;
+  }
+
+  std::vector<std::reference_wrapper<O3_CPU>> cpu_view() override { return {std::ref(cpu)}; }
+  std::vector<std::reference_wrapper<CACHE>> cache_view() override { return {std::ref(l1i), std::ref(l1d), std::ref(l2c)}; }
+  std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() override { return {}; }
+  MEMORY_CONTROLLER& dram_view() override { return dram; }
+  std::vector<std::reference_wrapper<champsim::operable>> operable_view() override
+  {
+    return {std::ref(cpu), std::ref(l1i), std::ref(l1d), std::ref(l2c), std::ref(itlb), std::ref(dtlb), std::ref(dram)};
+  }
+};
+
+void initialize(champsim::environment& env)
+{
+  for (champsim::operable& op : env.operable_view()) {
+    op.initialize();
+    op.warmup = false;
+    op.begin_phase();
+  }
+}
+
+bool same_blocks(const CACHE& lhs, const CACHE& rhs)
+{
+  return std::equal(std::begin(lhs.block), std::end(lhs.block), std::begin(rhs.block), std::end(rhs.block), [](const auto& x, const auto& y) {
+    return x.valid == y.valid && x.dirty == y.dirty && x.prefetch == y.prefetch && x.address == y.address && x.v_address == y.v_address;
+  });
+}
+} // namespace
+
+SCENARIO("The contents and recency of an LRU table survive a checkpoint")
+{
+  GIVEN("A table with some entries")
+  {
+    struct entry {
+      uint64_t index_ = 0;
+      uint64_t value = 0;
+      [[nodiscard]] auto index() const { return index_; }
+      [[nodiscard]] auto tag() const { return index_; }
+    };
+
+    champsim::msl::lru_table<entry> original{1, 2};
+    original.fill({1, 0xcafe});
+    original.fill({2, 0xbabe});
+    original.check_hit({1, 0});
+
+    WHEN("The table is saved and restored into an empty table")
+    {
+      std::stringstream checkpoint;
+      original.save_checkpoint(checkpoint);
+
+      champsim::msl::lru_table<entry> restored{1, 2};
+      restored.restore_checkpoint(checkpoint);
+
+      THEN("The entries are present")
+      {
+        CHECK(restored.check_hit({1, 0}).value_or(entry{}).value == 0xcafe);
+        CHECK(restored.check_hit({2, 0}).value_or(entry{}).value == 0xbabe);
+      }
+
+      THEN("The least recently used entry is replaced first")
+      {
+        original.fill({3, 0xbead});
+        restored.fill({3, 0xbead});
+        CHECK(original.check_hit({2, 0}).has_value() == restored.check_hit({2, 0}).has_value());
+        CHECK(original.check_hit({1, 0}).has_value() == restored.check_hit({1, 0}).has_value());
+      }
+    }
+
+    WHEN("The table is restored into a table of a different size")
+    {
+      std::stringstream checkpoint;
+      original.save_checkpoint(checkpoint);
+
+      champsim::msl::lru_table<entry> restored{2, 2};
+
+      THEN("The checkpoint is rejected")
+      {
+        REQUIRE_THROWS_AS(restored.restore_checkpoint(checkpoint), champsim::checkpoint::format_error);
+      }
+    }
+  }
+}
+
+SCENARIO("The page mappings of a virtual memory survive a checkpoint")
+{
+  GIVEN("A virtual memory that has allocated some pages")
+  {
+    constexpr std::size_t levels = 5;
+    constexpr champsim::data::bytes pte_page_size{1ull << 12};
+    auto dram = make_dram({});
+    VirtualMemory original{pte_page_size, levels, std::chrono::nanoseconds{6400}, dram, 11};
+
+    std::vector<champsim::page_number> vpages{champsim::page_number{0xdead}, champsim::page_number{0xbeef}, champsim::page_number{0xcafe}};
+    std::vector<champsim::page_number> ppages;
+    std::vector<champsim::address> pte_addrs;
+    for (auto vpage : vpages) {
+      ppages.push_back(original.va_to_pa(0, vpage).first);
+      pte_addrs.push_back(original.get_pte_pa(0, vpage, 2).first);
+    }
+
+    WHEN("The virtual memory is saved and restored into a new one")
+    {
+      std::stringstream checkpoint;
+      original.save_checkpoint(checkpoint);
+
+      VirtualMemory restored{pte_page_size, levels, std::chrono::nanoseconds{6400}, dram, 11};
+      restored.restore_checkpoint(checkpoint);
+
+      THEN("The existing pages are mapped without a fault")
+      {
+        for (std::size_t i = 0; i < std::size(vpages); ++i) {
+          auto [ppage, penalty] = restored.va_to_pa(0, vpages.at(i));
+          CHECK(ppage == ppages.at(i));
+          CHECK(penalty == champsim::chrono::clock::duration::zero());
+
+          auto [pte_addr, pte_penalty] = restored.get_pte_pa(0, vpages.at(i), 2);
+          CHECK(pte_addr == pte_addrs.at(i));
+          CHECK(pte_penalty == champsim::chrono::clock::duration::zero());
+        }
+      }
+
+      THEN("New pages are allocated as they would have been without the checkpoint")
+      {
+        CHECK(restored.available_ppages() == original.available_ppages());
+        CHECK(restored.va_to_pa(0, champsim::page_number{0xf00d}) == original.va_to_pa(0, champsim::page_number{0xf00d}));
+        CHECK(restored.get_pte_pa(0, champsim::page_number{0xf00d}, 1) == original.get_pte_pa(0, champsim::page_number{0xf00d}, 1));
+      }
+    }
+
+    WHEN("The virtual memory is restored into one that was shuffled with another seed")
+    {
+      std::stringstream checkpoint;
+      original.save_checkpoint(checkpoint);
+
+      VirtualMemory restored{pte_page_size, levels, std::chrono::nanoseconds{6400}, dram, 12};
+      restored.restore_checkpoint(checkpoint);
+
+      THEN("New pages are allocated as they would have been without the checkpoint")
+      {
+        CHECK(restored.available_ppages() == original.available_ppages());
+        CHECK(restored.va_to_pa(0, champsim::page_number{0xf00d}) == original.va_to_pa(0, champsim::page_number{0xf00d}));
+      }
+    }
+  }
+}
+
+SCENARIO("A warmed environment can be restored from a checkpoint")
+{
+  GIVEN("A core that has executed a stream of loads")
+  {
+    one_core_environment original{16};
+    initialize(original);
+
+    for (uint64_t i = 0; i < 100; ++i) {
+      original.cpu.input_queue.push_back(
+          champsim::test::instruction_with_ip_and_source_memory(champsim::address{0x100000 + 4 * i}, champsim::address{0x200000 + 64 * i}));
+    }
+    for (int i = 0; i < 10000; ++i) {
+      for (champsim::operable& op : original.operable_view()) {
+        op._operate();
+      }
+    }
+
+    WHEN("The environment is saved and restored into a new environment")
+    {
+      std::stringstream checkpoint;
+      champsim::checkpoint::save(checkpoint, original);
+
+      one_core_environment restored{16};
+      initialize(restored);
+      auto trace_positions = champsim::checkpoint::restore(checkpoint, restored);
+
+      THEN("Every cache holds the same blocks")
+      {
+        CHECK(std::any_of(std::begin(original.l1d.block), std::end(original.l1d.block), [](const auto& blk) { return blk.valid; }));
+        CHECK(same_blocks(original.l1i, restored.l1i));
+        CHECK(same_blocks(original.l1d, restored.l1d));
+        CHECK(same_blocks(original.l2c, restored.l2c));
+      }
+
+      THEN("The trace resumes after the retired instructions")
+      {
+        CHECK(original.cpu.num_retired > 0);
+        REQUIRE(trace_positions == std::vector<uint64_t>{static_cast<uint64_t>(original.cpu.num_retired)});
+      }
+
+      THEN("The replacement state is restored")
+      {
+        for (long set = 0; set < original.l2c.NUM_SET; ++set) {
+          CHECK(original.l2c.impl_find_victim(0, 0, set, nullptr, {}, {}, access_type::LOAD)
+                == restored.l2c.impl_find_victim(0, 0, set, nullptr, {}, {}, access_type::LOAD));
+        }
+      }
+    }
+
+    WHEN("The checkpoint is restored into a different configuration")
+    {
+      std::stringstream checkpoint;
+      champsim::checkpoint::save(checkpoint, original);
+
+      one_core_environment restored{32};
+      initialize(restored);
+
+      THEN("The checkpoint is rejected")
+      {
+        REQUIRE_THROWS_AS(champsim::checkpoint::restore(checkpoint, restored), champsim::checkpoint::format_error);
+      }
+    }
+  }
+}
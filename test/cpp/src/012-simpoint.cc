@@ -0,0 +1,185 @@
+#include <catch.hpp>
+
+#include <sstream>
+
+#include "sampled_stats.h"
+#include "simpoint.h"
+#include "stats_printer.h"
+
+SCENARIO("SimPoint files are read into points ordered by their position in the trace")
+{
+  GIVEN("A simpoints file and a weights file")
+  {
+    std::istringstream simpoints{"12 0\n3 1\n\n40 2\n"};
+    std::istringstream weights{"0.5 0\n0.25 1\n0.25 2\n"};
+
+    WHEN("The files are read")
+    {
+      auto points = champsim::read_simpoints(simpoints, weights);
+
+      THEN("Each point has the weight of its cluster")
+      {
+        REQUIRE(std::size(points) == 3);
+        CHECK(points.at(0).interval == 3);
+        CHECK(points.at(0).weight == 0.25);
+        CHECK(points.at(1).interval == 12);
+        CHECK(points.at(1).weight == 0.5);
+        CHECK(points.at(2).interval == 40);
+        CHECK(points.at(2).weight == 0.25);
+      }
+    }
+  }
+
+  GIVEN("A weights file that is missing a cluster")
+  {
+    std::istringstream simpoints{"12 0\n3 1\n"};
+    std::istringstream weights{"0.5 0\n"};
+
+    THEN("The files are rejected")
+    {
+      REQUIRE_THROWS_AS(champsim::read_simpoints(simpoints, weights), std::runtime_error);
+    }
+  }
+
+  GIVEN("A simpoints file with a malformed line")
+  {
+    std::istringstream simpoints{"12 zero\n"};
+    std::istringstream weights{"0.5 0\n"};
+
+    THEN("The files are rejected")
+    {
+      REQUIRE_THROWS_AS(champsim::read_simpoints(simpoints, weights), std::runtime_error);
+    }
+  }
+}
+
+SCENARIO("Each simulation point is preceded by a fast-forward and a warmup")
+{
+  GIVEN("Two points that are far apart")
+  {
+    std::vector<champsim::simpoint> points{{2, 0.75}, {10, 0.25}};
+
+    WHEN("The phases are built")
+    {
+      auto phases = champsim::simpoint_phases(points, 1000, 500, {"trace.xz"});
+
+      THEN("The trace is skipped up to the warmup of each point")
+      {
+        REQUIRE(std::size(phases) == 4);
+
+        CHECK(phases.at(0).is_warmup);
+        CHECK(phases.at(0).fast_forward == 1500);
+        CHECK(phases.at(0).length == 500);
+
+        CHECK_FALSE(phases.at(1).is_warmup);
+        CHECK(phases.at(1).fast_forward == 0);
+        CHECK(phases.at(1).length == 1000);
+        CHECK(phases.at(1).weight == 0.75);
+
+        CHECK(phases.at(2).is_warmup);
+        CHECK(phases.at(2).fast_forward == 10000 - 500 - 3000);
+        CHECK(phases.at(2).length == 500);
+
+        CHECK_FALSE(phases.at(3).is_warmup);
+        CHECK(phases.at(3).weight == 0.25);
+      }
+    }
+  }
+
+  GIVEN("Two adjacent points")
+  {
+    std::vector<champsim::simpoint> points{{0, 0.5}, {1, 0.5}};
+
+    WHEN("The phases are built")
+    {
+      auto phases = champsim::simpoint_phases(points, 1000, 500, {"trace.xz"});
+
+      THEN("The second point is not warmed up separately")
+      {
+        REQUIRE(std::size(phases) == 2);
+        CHECK_FALSE(phases.at(0).is_warmup);
+        CHECK_FALSE(phases.at(1).is_warmup);
+        CHECK(phases.at(1).fast_forward == 0);
+      }
+    }
+  }
+}
+
+SCENARIO("The statistics of weighted phases are combined")
+{
+  GIVEN("Two weighted phases and an unweighted phase")
+  {
+    auto make_phase = [](std::optional<double> weight, long long cycles, uint64_t misses) {
+      champsim::phase_stats phase{};
+      phase.weight = weight;
+
+      O3_CPU::stats_type core{};
+      core.name = "CPU 0";
+      core.end_instrs = 1000;
+      core.end_cycles = cycles;
+      phase.roi_cpu_stats.push_back(core);
+
+      CACHE::stats_type cache{};
+      cache.name = "LLC";
+      cache.misses.set(std::pair{access_type::LOAD, std::size_t{0}}, misses);
+      cache.misses.set(std::pair{access_type::PREFETCH, std::size_t{0}}, 1000);
+      phase.roi_cache_stats.push_back(cache);
+      return phase;
+    };
+
+    std::vector<champsim::phase_stats> phases{make_phase(3, 1000, 4), make_phase(1, 4000, 8), make_phase(std::nullopt, 100000, 1000)};
+
+    WHEN("The phases are combined")
+    {
+      auto combined = champsim::combine_weighted(phases);
+
+      THEN("The cycles per instruction are weighted")
+      {
+        REQUIRE(combined.has_value());
+        REQUIRE(std::size(combined->cores) == 1);
+        CHECK(combined->total_weight == 4);
+        CHECK(combined->cores.at(0).ipc == Approx(1 / (0.75 * 1 + 0.25 * 4)));
+      }
+
+      THEN("The demand misses per kilo-instruction are weighted")
+      {
+        REQUIRE(std::size(combined->caches) == 1);
+        CHECK(combined->caches.at(0).name == "LLC");
+        CHECK(combined->caches.at(0).mpki == Approx(0.75 * 4 + 0.25 * 8));
+      }
+    }
+  }
+
+  GIVEN("Phases without weights")
+  {
+    std::vector<champsim::phase_stats> phases{champsim::phase_stats{}};
+
+    THEN("Nothing is combined")
+    {
+      REQUIRE_FALSE(champsim::combine_weighted(phases).has_value());
+    }
+  }
+}
+
+SCENARIO("The weighted statistics are printed")
+{
+  GIVEN("Combined statistics")
+  {
+    champsim::sampled_stats stats{};
+    stats.total_weight = 1;
+    stats.cores.push_back({"CPU 0", 1.5, 2.25});
+    stats.caches.push_back({"LLC", 0, 4});
+
+    WHEN("The statistics are formatted")
+    {
+      auto lines = champsim::plain_printer::format(stats);
+
+      THEN("Each core and cache has a line")
+      {
+        REQUIRE(std::size(lines) == 3);
+        CHECK(lines.at(1) == "CPU 0 weighted IPC: 1.5 branch MPKI: 2.25");
+        CHECK(lines.at(2) == "cpu0->LLC weighted demand MPKI: 4");
+      }
+    }
+  }
+}
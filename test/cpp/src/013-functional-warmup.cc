@@ -0,0 +1,211 @@
+#include <catch.hpp>
+
+#include "defaults.hpp"
+#include "dram_controller.h"
+#include "functional_warmer.h"
+#include "instr.h"
+#include "mocks.hpp"
+#include "vmem.h"
+
+namespace
+{
+MEMORY_CONTROLLER make_dram()
+{
+  return MEMORY_CONTROLLER{champsim::chrono::picoseconds{3200},
+                           champsim::chrono::picoseconds{6400},
+                           std::size_t{18},
+                           std::size_t{18},
+                           std::size_t{18},
+                           std::size_t{38},
+                           champsim::chrono::microseconds{64000},
+                           {},
+                           64,
+                           64,
+                           1,
+                           champsim::data::bytes{8},
+                           1024,
+                           1024,
+                           4,
+                           4,
+                           4,
+                           8192};
+}
+
+champsim::channel::request_type translated_request(uint64_t address, access_type type)
+{
+  champsim::channel::request_type packet;
+  packet.address = champsim::address{address};
+  packet.v_address = packet.address;
+  packet.cpu = 0;
+  packet.type = type;
+  return packet;
+}
+
+bool contains(const CACHE& cache, champsim::address address)
+{
+  return std::any_of(std::begin(cache.block), std::end(cache.block), [block = champsim::block_number{address}](const auto& x) {
+    return x.valid && champsim::block_number{x.address} == block;
+  });
+}
+
+bool contains_dirty(const CACHE& cache, champsim::address address)
+{
+  return std::any_of(std::begin(cache.block), std::end(cache.block), [block = champsim::block_number{address}](const auto& x) {
+    return x.valid && x.dirty && champsim::block_number{x.address} == block;
+  });
+}
+} // namespace
+
+SCENARIO("Functional accesses fill each level of the hierarchy")
+{
+  GIVEN("Two levels of cache")
+  {
+    champsim::channel upper{}, middle{}, lower{};
+    CACHE l2c{champsim::cache_builder{champsim::defaults::default_l2c}.name("013a-L2C").upper_levels({&middle}).lower_level(&lower)};
+    CACHE l1d{champsim::cache_builder{champsim::defaults::default_l1d}.name("013a-L1D").sets(1).ways(1).upper_levels({&upper}).lower_level(&middle)};
+
+    for (CACHE* cache : {&l1d, &l2c}) {
+      cache->initialize();
+      cache->warmup = true;
+      cache->begin_phase();
+    }
+
+    champsim::functional_warmer uut{{std::ref(l1d), std::ref(l2c)}, {}};
+
+    WHEN("A load misses in both levels")
+    {
+      uut.access(&upper, translated_request(0xdeadbeef, access_type::LOAD));
+
+      THEN("Both levels are filled")
+      {
+        CHECK(contains(l1d, champsim::address{0xdeadbeef}));
+        CHECK(contains(l2c, champsim::address{0xdeadbeef}));
+        CHECK(l1d.sim_stats.misses.value_or(std::pair{access_type::LOAD, std::size_t{0}}, 0) == 1);
+        CHECK(l2c.sim_stats.misses.value_or(std::pair{access_type::LOAD, std::size_t{0}}, 0) == 1);
+      }
+
+      AND_WHEN("The same block is loaded again")
+      {
+        uut.access(&upper, translated_request(0xdeadbeef, access_type::LOAD));
+
+        THEN("It hits in the first level")
+        {
+          CHECK(l1d.sim_stats.hits.value_or(std::pair{access_type::LOAD, std::size_t{0}}, 0) == 1);
+          CHECK(l2c.sim_stats.hits.value_or(std::pair{access_type::LOAD, std::size_t{0}}, 0) == 0);
+        }
+      }
+    }
+
+    WHEN("A stored block is evicted from the first level")
+    {
+      uut.access(&upper, translated_request(0xdeadbeef, access_type::WRITE));
+      REQUIRE(contains_dirty(l1d, champsim::address{0xdeadbeef}));
+      REQUIRE_FALSE(contains_dirty(l2c, champsim::address{0xdeadbeef}));
+
+      uut.access(&upper, translated_request(0xcafebabe, access_type::LOAD));
+
+      THEN("It is written back to the second level")
+      {
+        CHECK_FALSE(contains(l1d, champsim::address{0xdeadbeef}));
+        CHECK(contains_dirty(l2c, champsim::address{0xdeadbeef}));
+      }
+    }
+  }
+}
+
+SCENARIO("Functional accesses are translated by walking the page table")
+{
+  GIVEN("A cache whose translations come from a TLB and a page table walker")
+  {
+    auto dram = make_dram();
+    VirtualMemory vmem{champsim::data::bytes{1 << 12}, 5, champsim::chrono::nanoseconds{640}, dram};
+
+    champsim::channel upper{}, lower{}, translate{}, walk{}, pte_reads{};
+    CACHE dtlb{champsim::cache_builder{champsim::defaults::default_dtlb}.name("013b-DTLB").upper_levels({&translate}).lower_level(&walk)};
+    CACHE l1d{champsim::cache_builder{champsim::defaults::default_l1d}.name("013b-L1D").upper_levels({&upper}).lower_level(&lower).lower_translate(&translate)};
+    PageTableWalker ptw{champsim::ptw_builder{champsim::defaults::default_ptw}
+                            .name("013b-PTW")
+                            .upper_levels({&walk})
+                            .lower_level(&pte_reads)
+                            .virtual_memory(&vmem)};
+
+    for (champsim::operable* op : std::initializer_list<champsim::operable*>{&l1d, &dtlb, &ptw}) {
+      op->initialize();
+      op->warmup = true;
+      op->begin_phase();
+    }
+
+    champsim::functional_warmer uut{{std::ref(l1d), std::ref(dtlb)}, {std::ref(ptw)}};
+
+    WHEN("A virtual address is loaded")
+    {
+      champsim::address v_address{0xdeadbeef};
+      auto packet = translated_request(v_address.to<uint64_t>(), access_type::LOAD);
+      packet.is_translated = false;
+      uut.access(&upper, packet);
+
+      auto ppage = vmem.va_to_pa(0, champsim::page_number{v_address}).first;
+      champsim::address p_address{champsim::splice(ppage, champsim::page_offset{v_address})};
+
+      THEN("The cache is filled with the physical address")
+      {
+        CHECK(contains(l1d, p_address));
+        CHECK_FALSE(contains(l1d, v_address));
+      }
+
+      THEN("The TLB holds the translation")
+      {
+        CHECK(contains(dtlb, v_address));
+      }
+
+      THEN("The walk filled the paging structure caches")
+      {
+        CHECK(std::any_of(std::begin(ptw.pscl), std::end(ptw.pscl), [v_address](auto& pscl) { return pscl.check_hit({v_address, {}, 0}).has_value(); }));
+      }
+    }
+  }
+}
+
+SCENARIO("A functionally warmed core retires each instruction")
+{
+  GIVEN("A core with its first-level caches")
+  {
+    champsim::channel fetch{}, data{}, l1i_lower{}, l1d_lower{};
+    CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("013c-L1I").upper_levels({&fetch}).lower_level(&l1i_lower)};
+    CACHE l1d{champsim::cache_builder{champsim::defaults::default_l1d}.name("013c-L1D").upper_levels({&data}).lower_level(&l1d_lower)};
+    O3_CPU cpu{champsim::core_builder{champsim::defaults::default_core}.fetch_queues(&fetch).data_queues(&data).l1i(&l1i)};
+
+    for (champsim::operable* op : std::initializer_list<champsim::operable*>{&cpu, &l1i, &l1d}) {
+      op->initialize();
+      op->warmup = true;
+      op->begin_phase();
+    }
+
+    champsim::functional_warmer uut{{std::ref(l1i), std::ref(l1d)}, {}};
+
+    WHEN("An instruction with a load is warmed")
+    {
+      champsim::address ip{0x401000};
+      champsim::address load{0x7fff0000};
+      uut.operate(cpu, champsim::test::instruction_with_ip_and_source_memory(ip, load));
+
+      THEN("It is counted as retired")
+      {
+        CHECK(cpu.sim_instr() == 1);
+      }
+
+      THEN("The instruction and its data are in the caches")
+      {
+        CHECK(contains(l1i, ip));
+        CHECK(contains(l1d, load));
+      }
+
+      THEN("No component was operated")
+      {
+        CHECK(std::empty(fetch.RQ));
+        CHECK(std::empty(data.RQ));
+        CHECK(std::empty(cpu.ROB));
+      }
+    }
+  }
+}
@@ -0,0 +1,51 @@
+#include <catch.hpp>
+#include <random>
+
+#include "msl/fpcounter.h"
+
+TEST_CASE("A forward-probabilistic counter with unit probabilities counts deterministically")
+{
+  std::minstd_rand rng{};
+  champsim::msl::fpcounter<3> uut{};
+  champsim::msl::fpcounter<3>::probability_vector always{1, 1, 1, 1, 1, 1, 1};
+
+  for (int i = 0; i < 3; ++i) {
+    uut.increment(rng, always);
+  }
+  REQUIRE(uut.value() == 3);
+}
+
+TEST_CASE("A forward-probabilistic counter saturates")
+{
+  std::minstd_rand rng{};
+  champsim::msl::fpcounter<3> uut{};
+  champsim::msl::fpcounter<3>::probability_vector always{1, 1, 1, 1, 1, 1, 1};
+
+  for (int i = 0; i < 100; ++i) {
+    uut.increment(rng, always);
+  }
+  REQUIRE(uut.is_max());
+  REQUIRE(uut.value() == 7);
+}
+
+TEST_CASE("A forward-probabilistic counter increments less often with a lower probability")
+{
+  std::minstd_rand rng{};
+  champsim::msl::fpcounter<8> uut{};
+  champsim::msl::fpcounter<8>::probability_vector rarely{};
+  rarely.fill(16);
+
+  for (int i = 0; i < 160; ++i) {
+    uut.increment(rng, rarely);
+  }
+  REQUIRE(uut.value() > 0);
+  REQUIRE(uut.value() < 160);
+}
+
+TEST_CASE("A forward-probabilistic counter resets to zero")
+{
+  champsim::msl::fpcounter<3> uut{5};
+  uut.reset();
+  REQUIRE(uut.value() == 0);
+  REQUIRE_FALSE(uut.is_max());
+}
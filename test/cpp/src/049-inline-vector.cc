@@ -0,0 +1,62 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include "instruction.h"
+#include "util/inline_vector.h"
+
+SCENARIO("An inline vector holds elements up to its capacity")
+{
+  GIVEN("An empty inline vector")
+  {
+    champsim::inline_vector<int, 4> uut;
+
+    THEN("It is empty")
+    {
+      CHECK(std::empty(uut));
+      CHECK(std::begin(uut) == std::end(uut));
+    }
+
+    WHEN("It is filled")
+    {
+      for (int i = 0; i < 4; ++i) {
+        uut.push_back(i);
+      }
+
+      THEN("It holds the elements in order")
+      {
+        CHECK(uut == champsim::inline_vector<int, 4>{0, 1, 2, 3});
+        CHECK(uut.at(3) == 3);
+        CHECK_THROWS_AS(uut.at(4), std::out_of_range);
+      }
+
+      THEN("No more elements can be added")
+      {
+        CHECK_THROWS_AS(uut.push_back(4), std::length_error);
+      }
+    }
+  }
+
+  GIVEN("An inline vector with several elements")
+  {
+    champsim::inline_vector<int, 4> uut{6, 1, 6, 2};
+
+    WHEN("Some elements are removed")
+    {
+      uut.erase(std::remove(std::begin(uut), std::end(uut), 6), std::end(uut));
+
+      THEN("The rest remain in order")
+      {
+        CHECK(uut == champsim::inline_vector<int, 4>{1, 2});
+      }
+    }
+  }
+}
+
+TEST_CASE("Inline vectors of trivial elements are trivially copyable")
+{
+  STATIC_REQUIRE(std::is_trivially_copyable_v<champsim::inline_vector<champsim::address, NUM_INSTR_SOURCES>>);
+  STATIC_REQUIRE(std::is_trivially_copyable_v<champsim::inline_vector<PHYSICAL_REGISTER_ID, NUM_INSTR_DESTINATIONS_SPARC>>);
+}
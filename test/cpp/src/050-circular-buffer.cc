@@ -0,0 +1,116 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "util/circular_buffer.h"
+
+namespace
+{
+std::vector<int> contents(const champsim::circular_buffer<int>& buffer) { return {std::begin(buffer), std::end(buffer)}; }
+} // namespace
+
+SCENARIO("A circular buffer is a queue")
+{
+  GIVEN("A circular buffer that has wrapped around its slots")
+  {
+    champsim::circular_buffer<int> uut{4};
+    for (int i = 0; i < 4; ++i) {
+      uut.push_back(i);
+    }
+    uut.pop_front();
+    uut.pop_front();
+    uut.push_back(4);
+    uut.push_back(5);
+
+    THEN("Its elements are in the order they were added")
+    {
+      CHECK(uut.full());
+      CHECK(::contents(uut) == std::vector<int>{2, 3, 4, 5});
+      CHECK(uut.at(3) == 5);
+      CHECK_THROWS_AS(uut.at(4), std::out_of_range);
+    }
+
+    WHEN("Elements are removed from the front")
+    {
+      auto& last = uut.back();
+      uut.erase(std::begin(uut), std::next(std::begin(uut), 3));
+
+      THEN("The remaining elements have not moved")
+      {
+        CHECK(&uut.front() == &last);
+        CHECK(::contents(uut) == std::vector<int>{5});
+      }
+    }
+
+    WHEN("Elements are removed from the middle")
+    {
+      uut.erase(std::next(std::begin(uut)), std::next(std::begin(uut), 3));
+
+      THEN("The remaining elements are in order")
+      {
+        CHECK(::contents(uut) == std::vector<int>{2, 5});
+      }
+    }
+
+    WHEN("More elements are added than it has slots")
+    {
+      std::array<int, 3> more{6, 7, 8};
+      uut.insert(std::end(uut), std::begin(more), std::end(more));
+
+      THEN("It grows to hold them")
+      {
+        CHECK(uut.capacity() >= 7);
+        CHECK(::contents(uut) == std::vector<int>{2, 3, 4, 5, 6, 7, 8});
+      }
+    }
+  }
+}
+
+TEST_CASE("Circular buffer iterators are random-access")
+{
+  champsim::circular_buffer<int> uut{3};
+  uut.push_back(0);
+  uut.pop_front();
+  for (int i = 5; i > 0; --i) {
+    uut.push_back(i);
+  }
+
+  std::sort(std::begin(uut), std::end(uut));
+  CHECK(::contents(uut) == std::vector<int>{1, 2, 3, 4, 5});
+  CHECK(std::partition_point(std::cbegin(uut), std::cend(uut), [](int x) { return x < 4; }) - std::cbegin(uut) == 3);
+}
+
+TEST_CASE("Circular buffer handles survive removal from the front")
+{
+  champsim::circular_buffer<int> uut{4};
+  for (int i = 0; i < 4; ++i) {
+    uut.push_back(i);
+  }
+
+  auto handle = uut.handle(std::next(std::cbegin(uut), 2));
+  uut.pop_front();
+  uut.push_back(4);
+  uut.push_back(5);
+
+  CHECK(*uut.find(handle) == 2);
+
+  uut.erase(std::begin(uut), std::next(std::begin(uut), 2));
+  CHECK(uut.find(handle) == std::end(uut));
+}
+
+TEST_CASE("A circular buffer that does not grow rejects an element when it is full")
+{
+  champsim::circular_buffer<int> uut{2, champsim::circular_buffer<int>::overflow::error};
+  uut.push_back(0);
+  uut.push_back(1);
+  const int* front = &uut.front();
+
+  CHECK_THROWS_AS(uut.push_back(2), std::length_error);
+  CHECK(uut.capacity() == 2);
+  CHECK(&uut.front() == front);
+  CHECK(::contents(uut) == std::vector<int>{0, 1});
+}
@@ -0,0 +1,102 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include "util/small_vector.h"
+
+SCENARIO("A small vector holds any number of elements")
+{
+  GIVEN("An empty small vector")
+  {
+    champsim::small_vector<int, 2> uut;
+
+    THEN("It is empty")
+    {
+      CHECK(std::empty(uut));
+      CHECK(std::begin(uut) == std::end(uut));
+    }
+
+    WHEN("It is filled past its inline capacity")
+    {
+      for (int i = 0; i < 5; ++i) {
+        uut.push_back(i);
+      }
+
+      THEN("It holds the elements in order")
+      {
+        CHECK(uut == champsim::small_vector<int, 2>{0, 1, 2, 3, 4});
+        CHECK(std::size(uut) == 5);
+      }
+
+      THEN("A copy holds the same elements")
+      {
+        auto copy = uut;
+        CHECK(copy == uut);
+      }
+
+      AND_WHEN("It is cleared and refilled")
+      {
+        uut.clear();
+        uut.push_back(7);
+
+        THEN("It holds only the new element")
+        {
+          CHECK(uut == champsim::small_vector<int, 2>{7});
+        }
+      }
+    }
+  }
+
+  GIVEN("Two sorted small vectors")
+  {
+    champsim::small_vector<int, 2> lhs{1, 3}, rhs{2, 3, 4};
+
+    WHEN("They are merged")
+    {
+      champsim::small_vector<int, 2> merged{};
+      std::set_union(std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs), std::back_inserter(merged));
+
+      THEN("The merged vector holds the union of the elements")
+      {
+        CHECK(merged == champsim::small_vector<int, 2>{1, 2, 3, 4});
+      }
+    }
+
+    WHEN("One is moved into the other")
+    {
+      rhs = std::move(lhs);
+
+      THEN("The destination holds the moved elements")
+      {
+        CHECK(rhs == champsim::small_vector<int, 2>{1, 3});
+      }
+    }
+  }
+
+  GIVEN("A small vector with several elements")
+  {
+    champsim::small_vector<int, 2> uut{6, 1, 6, 2};
+
+    WHEN("Some elements are removed")
+    {
+      uut.erase(std::remove(std::begin(uut), std::end(uut), 6), std::end(uut));
+
+      THEN("The rest remain in order")
+      {
+        CHECK(uut == champsim::small_vector<int, 2>{1, 2});
+      }
+    }
+
+    WHEN("The first element is removed")
+    {
+      uut.erase(std::begin(uut));
+
+      THEN("The rest remain in order")
+      {
+        CHECK(uut == champsim::small_vector<int, 2>{1, 6, 2});
+      }
+    }
+  }
+}
@@ -0,0 +1,123 @@
+#include <catch.hpp>
+#include <string>
+
+#include "tag_store.h"
+
+SCENARIO("A tag store finds the way that holds an address")
+{
+  GIVEN("A tag store with two sets of six ways")
+  {
+    constexpr std::size_t num_way = 6;
+    champsim::tag_store uut{2, num_way, champsim::data::bits{LOG2_BLOCK_SIZE}};
+
+    champsim::cache_block blk{};
+    blk.valid = true;
+    blk.address = champsim::address{0xdeadbeef};
+
+    THEN("No way is valid")
+    {
+      CHECK(uut.find(1, blk.address) == num_way);
+      CHECK(uut.find_invalid(1) == 0);
+    }
+
+    WHEN("A block is held in the last way of a set")
+    {
+      uut.assign(num_way + 5, blk);
+
+      THEN("The way is found from any address in the block")
+      {
+        CHECK(uut.find(1, blk.address) == 5);
+        CHECK(uut.find(1, champsim::address{0xdeadbec0}) == 5);
+        CHECK(uut.find(0, blk.address) == num_way);
+      }
+
+      AND_WHEN("The same block is held in an earlier way")
+      {
+        uut.assign(num_way + 2, blk);
+
+        THEN("The first way is found")
+        {
+          CHECK(uut.find(1, blk.address) == 2);
+        }
+      }
+
+      AND_WHEN("The block is invalidated")
+      {
+        blk.valid = false;
+        uut.assign(num_way + 5, blk);
+
+        THEN("The way is not found, except as one that held the address")
+        {
+          CHECK(uut.find(1, blk.address) == num_way);
+          CHECK(uut.find_any(1, blk.address) == 5);
+        }
+      }
+    }
+
+    WHEN("Every way of a set is valid")
+    {
+      for (std::size_t way = 0; way < num_way; ++way) {
+        blk.address = champsim::address{0x1000 * (way + 1)};
+        uut.assign(way, blk);
+      }
+
+      THEN("No way is invalid")
+      {
+        CHECK(uut.find_invalid(0) == num_way);
+      }
+
+      THEN("Each address is found in its way")
+      {
+        for (std::size_t way = 0; way < num_way; ++way) {
+          CHECK(uut.find(0, champsim::address{0x1000 * (way + 1)}) == way);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("A tag store searches every way of sets of any associativity")
+{
+  // The vector compares take two or four ways at a time, and the ways past the last whole vector are searched one at a time
+  auto num_way = GENERATE(as<std::size_t>{}, 1, 2, 3, 4, 5, 7, 8, 9, 16, 17);
+
+  GIVEN("A tag store with two sets of " + std::to_string(num_way) + " ways, with every way of the second set valid")
+  {
+    champsim::tag_store uut{2, num_way, champsim::data::bits{LOG2_BLOCK_SIZE}};
+
+    champsim::cache_block blk{};
+    blk.valid = true;
+    for (std::size_t way = 0; way < num_way; ++way) {
+      blk.address = champsim::address{0x1000 * (way + 1)};
+      uut.assign(num_way + way, blk);
+    }
+
+    THEN("Each address is found in its way")
+    {
+      for (std::size_t way = 0; way < num_way; ++way) {
+        CHECK(uut.find(1, champsim::address{0x1000 * (way + 1)}) == way);
+        CHECK(uut.find(0, champsim::address{0x1000 * (way + 1)}) == num_way);
+      }
+    }
+
+    THEN("An address that is not held is not found")
+    {
+      CHECK(uut.find(1, champsim::address{0x1000 * (num_way + 1)}) == num_way);
+    }
+
+    WHEN("The first way is invalidated, and its block is held in the last way")
+    {
+      blk.address = champsim::address{0x1000};
+      blk.valid = false;
+      uut.assign(num_way, blk);
+      blk.valid = true;
+      uut.assign(num_way + num_way - 1, blk);
+
+      THEN("The last way is found")
+      {
+        CHECK(uut.find(1, blk.address) == num_way - 1);
+        CHECK(uut.find_any(1, blk.address) == 0);
+      }
+    }
+  }
+}
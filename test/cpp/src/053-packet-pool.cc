@@ -0,0 +1,180 @@
+#include <catch.hpp>
+
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "util/packet_pool.h"
+
+namespace
+{
+std::vector<int> contents(const champsim::pooled_queue<int>& queue) { return {std::begin(queue), std::end(queue)}; }
+} // namespace
+
+SCENARIO("A packet pool reuses the records it releases")
+{
+  GIVEN("A pool with two records")
+  {
+    champsim::packet_pool<int> uut{2};
+    auto first = uut.acquire(1);
+    auto second = uut.acquire(2);
+    const int* second_record = &uut[second];
+
+    WHEN("A record is released and another is acquired")
+    {
+      uut.release(first);
+      auto third = uut.acquire(3);
+
+      THEN("The released record is reused")
+      {
+        CHECK(third == first);
+        CHECK(uut[third] == 3);
+        CHECK(uut.size() == 2);
+      }
+    }
+
+    WHEN("More records are acquired than it was built with")
+    {
+      auto third = uut.acquire(3);
+
+      THEN("The records that are held have not moved")
+      {
+        CHECK(&uut[second] == second_record);
+        CHECK(uut[third] == 3);
+        CHECK(uut.size() == 3);
+      }
+    }
+  }
+}
+
+SCENARIO("Pooled queues pass records by handle")
+{
+  GIVEN("Two queues that share a pool")
+  {
+    auto pool = std::make_shared<champsim::packet_pool<int>>(8);
+    champsim::pooled_queue<int> source{pool};
+    champsim::pooled_queue<int> destination{pool};
+    for (int i = 0; i < 6; ++i) {
+      source.push_back(i);
+    }
+    const int* odd_record = &source[1];
+
+    WHEN("The entries that match a predicate are transferred")
+    {
+      auto kept_end = source.transfer_if(std::begin(source), std::end(source), destination, [](int x) { return x % 2 == 1; });
+
+      THEN("They are moved without copying, and the others keep their order")
+      {
+        CHECK(kept_end == std::end(source));
+        CHECK(::contents(source) == std::vector<int>{0, 2, 4});
+        CHECK(::contents(destination) == std::vector<int>{1, 3, 5});
+        CHECK(&destination.front() == odd_record);
+        CHECK(pool->size() == 6);
+      }
+    }
+
+    WHEN("A range of entries is transferred")
+    {
+      source.transfer(std::next(std::begin(source)), std::next(std::begin(source), 3), destination);
+
+      THEN("The range is moved in order")
+      {
+        CHECK(::contents(source) == std::vector<int>{0, 3, 4, 5});
+        CHECK(::contents(destination) == std::vector<int>{1, 2});
+      }
+    }
+
+    WHEN("Entries are erased")
+    {
+      source.erase(std::begin(source), std::next(std::begin(source), 2));
+
+      THEN("Their records are released")
+      {
+        CHECK(::contents(source) == std::vector<int>{2, 3, 4, 5});
+        CHECK(pool->size() == 4);
+      }
+    }
+  }
+}
+
+TEST_CASE("A pooled queue partitions its entries stably, testing each once")
+{
+  champsim::pooled_queue<int> uut{};
+  for (int i = 0; i < 6; ++i) {
+    uut.push_back(i);
+  }
+  const int* first_record = &uut.front();
+  const auto first_handle = uut.handle_at(std::begin(uut));
+
+  std::vector<int> tested{};
+  auto partition_point = uut.stable_partition(std::next(std::begin(uut)), std::end(uut), [&tested](int x) {
+    tested.push_back(x);
+    return x % 2 == 0;
+  });
+
+  CHECK(tested == std::vector<int>{1, 2, 3, 4, 5});
+  CHECK(partition_point - std::begin(uut) == 3);
+  CHECK(::contents(uut) == std::vector<int>{0, 2, 4, 1, 3, 5});
+  CHECK(&uut.front() == first_record);
+
+  uut.swap_entries(std::begin(uut), std::next(std::begin(uut), 3));
+  CHECK(::contents(uut) == std::vector<int>{1, 2, 4, 0, 3, 5});
+  CHECK(uut.handle_at(std::next(std::begin(uut), 3)) == first_handle);
+}
+
+TEST_CASE("A copy of a pooled queue holds copies of its records")
+{
+  champsim::pooled_queue<int> uut{};
+  uut.push_back(1);
+  uut.push_back(2);
+
+  auto copy = uut;
+  copy.front() = 3;
+
+  CHECK(::contents(uut) == std::vector<int>{1, 2});
+  CHECK(::contents(copy) == std::vector<int>{3, 2});
+}
+
+TEST_CASE("A pooled slot is an optional record")
+{
+  auto pool = std::make_shared<champsim::packet_pool<int>>(2);
+  std::vector<champsim::pooled_slot<int>> uut(2, champsim::pooled_slot<int>{pool});
+
+  CHECK_FALSE(uut.at(0).has_value());
+  uut.at(0) = 5;
+  REQUIRE(uut.at(0).has_value());
+  CHECK(*uut.at(0) == 5);
+  CHECK(pool->size() == 1);
+
+  uut.at(1) = uut.at(0);
+  CHECK(pool->size() == 2);
+
+  uut.at(0).reset();
+  CHECK_FALSE(uut.at(0).has_value());
+  CHECK(uut.at(1).value() == 5);
+  CHECK(pool->size() == 1);
+}
+
+TEST_CASE("A pooled slot that was moved from can be filled again")
+{
+  auto pool = std::make_shared<champsim::packet_pool<int>>(2);
+  champsim::pooled_slot<int> source{pool};
+  source = 5;
+
+  champsim::pooled_slot<int> destination{std::move(source)};
+  CHECK_FALSE(source.has_value());
+  CHECK(*destination == 5);
+
+  source = 6;
+  REQUIRE(source.has_value());
+  CHECK(*source == 6);
+  CHECK(pool->size() == 2);
+
+  destination = std::move(source);
+  CHECK_FALSE(source.has_value());
+  CHECK(*destination == 6);
+  CHECK(pool->size() == 1);
+
+  source.emplace(7);
+  CHECK(source.value() == 7);
+}
@@ -0,0 +1,57 @@
+#include <catch.hpp>
+
+#include "msl/prediction_queue.h"
+
+namespace
+{
+struct lookup {
+  champsim::address ip;
+  int index;
+};
+} // namespace
+
+SCENARIO("A prediction queue gives back the lookups of predictions in order")
+{
+  GIVEN("A queue with lookups for three predictions")
+  {
+    champsim::msl::prediction_queue<::lookup> uut{};
+    uut.push({champsim::address{0x100}, 0});
+    uut.push({champsim::address{0x200}, 1});
+    uut.push({champsim::address{0x100}, 2});
+
+    WHEN("The first prediction is trained")
+    {
+      auto result = uut.take(champsim::address{0x100});
+
+      THEN("Its lookup is given back")
+      {
+        REQUIRE(result.has_value());
+        CHECK(result->index == 0);
+        CHECK(uut.size() == 2);
+      }
+    }
+
+    WHEN("The second prediction is trained before the first")
+    {
+      auto result = uut.take(champsim::address{0x200});
+
+      THEN("The lookup of the first is dropped")
+      {
+        REQUIRE(result.has_value());
+        CHECK(result->index == 1);
+        CHECK(uut.size() == 1);
+      }
+    }
+
+    WHEN("An instruction that was not predicted is trained")
+    {
+      auto result = uut.take(champsim::address{0x300});
+
+      THEN("Nothing is given back, and every lookup is dropped")
+      {
+        CHECK_FALSE(result.has_value());
+        CHECK(uut.size() == 0);
+      }
+    }
+  }
+}
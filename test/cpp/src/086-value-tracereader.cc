@@ -0,0 +1,82 @@
+#include <catch.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+
+#include "tracereader.h"
+
+namespace
+{
+std::string serialize(std::vector<value_instr> instrs)
+{
+  std::string retval(std::size(instrs) * sizeof(value_instr), '\0');
+  std::memcpy(std::data(retval), std::data(instrs), std::size(retval));
+  return retval;
+}
+} // namespace
+
+TEST_CASE("A tracereader can read the byte representation of a value_instr")
+{
+  value_instr load{};
+  load.ip = 0x4c00133a;
+  load.version = champsim::VALUE_TRACE_VERSION;
+  load.destination_registers[1] = 59;
+  load.destination_register_values[1] = 0xfeedface;
+  load.source_memory[2] = 0x7ffeb23758e8;
+  load.source_memory_size[2] = 8;
+  load.source_memory_values[2] = 0xfeedface;
+
+  value_instr store{};
+  store.ip = 0x4c00133e;
+  store.version = champsim::VALUE_TRACE_VERSION;
+  store.source_registers[0] = 59;
+  store.destination_memory[0] = 0x7ffeb23758f0;
+  store.destination_memory_size[0] = 4;
+  store.destination_memory_values[0] = 0xcafe;
+
+  value_instr last{};
+  last.version = champsim::VALUE_TRACE_VERSION;
+
+  champsim::bulk_tracereader<value_instr, std::istringstream> uut{0, std::istringstream{serialize({load, store, last})}};
+
+  auto inst0 = uut();
+  REQUIRE(inst0.ip == champsim::address{0x4c00133a});
+  REQUIRE(inst0.has_values);
+  REQUIRE_THAT(inst0.destination_registers, Catch::Matchers::RangeEquals(std::vector{59}));
+  REQUIRE_THAT(inst0.destination_register_values, Catch::Matchers::RangeEquals(std::vector<uint64_t>{0xfeedface}));
+  REQUIRE_THAT(inst0.source_memory, Catch::Matchers::RangeEquals(std::vector{champsim::address{0x7ffeb23758e8}}));
+  REQUIRE_THAT(inst0.source_memory_size, Catch::Matchers::RangeEquals(std::vector<uint8_t>{8}));
+  REQUIRE_THAT(inst0.source_memory_values, Catch::Matchers::RangeEquals(std::vector<uint64_t>{0xfeedface}));
+  REQUIRE_THAT(inst0.destination_memory_values, Catch::Matchers::IsEmpty());
+
+  auto inst1 = uut();
+  REQUIRE(inst1.ip == champsim::address{0x4c00133e});
+  REQUIRE_THAT(inst1.destination_register_values, Catch::Matchers::IsEmpty());
+  REQUIRE_THAT(inst1.destination_memory, Catch::Matchers::RangeEquals(std::vector{champsim::address{0x7ffeb23758f0}}));
+  REQUIRE_THAT(inst1.destination_memory_size, Catch::Matchers::RangeEquals(std::vector<uint8_t>{4}));
+  REQUIRE_THAT(inst1.destination_memory_values, Catch::Matchers::RangeEquals(std::vector<uint64_t>{0xcafe}));
+}
+
+TEST_CASE("Legacy trace formats carry no values")
+{
+  ooo_model_instr uut{0, input_instr{}};
+  REQUIRE_FALSE(uut.has_values);
+  REQUIRE_THAT(uut.destination_register_values, Catch::Matchers::IsEmpty());
+  REQUIRE_THAT(uut.source_memory_values, Catch::Matchers::IsEmpty());
+}
+
+TEST_CASE("A value_instr with an unknown version is rejected")
+{
+  value_instr instr{};
+  instr.version = champsim::VALUE_TRACE_VERSION + 1;
+  REQUIRE_THROWS_AS((ooo_model_instr{0, instr}), std::runtime_error);
+}
+
+TEST_CASE("The leading members of a value_instr match an input_instr")
+{
+  STATIC_REQUIRE(offsetof(value_instr, ip) == offsetof(input_instr, ip));
+  STATIC_REQUIRE(offsetof(value_instr, destination_registers) == offsetof(input_instr, destination_registers));
+  STATIC_REQUIRE(offsetof(value_instr, source_memory) == offsetof(input_instr, source_memory));
+  STATIC_REQUIRE(offsetof(value_instr, version) == sizeof(input_instr));
+}
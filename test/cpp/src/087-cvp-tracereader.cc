@@ -0,0 +1,127 @@
+#include <catch.hpp>
+
+#include <cstring>
+#include <sstream>
+
+#include "cvp_tracereader.h"
+#include "tracereader.h"
+
+namespace
+{
+// Appends the little-endian bytes of a CVP record field
+template <typename T>
+void put(std::string& buf, T val, std::size_t bytes = sizeof(T))
+{
+  std::string field(bytes, '\0');
+  std::memcpy(std::data(field), &val, std::min(bytes, sizeof(T)));
+  buf += field;
+}
+
+void put_registers(std::string& buf, std::vector<uint8_t> inputs, std::vector<std::pair<uint8_t, uint64_t>> outputs)
+{
+  put<uint8_t>(buf, static_cast<uint8_t>(std::size(inputs)));
+  for (auto reg : inputs)
+    put(buf, reg);
+  put<uint8_t>(buf, static_cast<uint8_t>(std::size(outputs)));
+  for (auto [reg, val] : outputs)
+    put(buf, reg);
+  for (auto [reg, val] : outputs)
+    put(buf, val, (reg >= 32 && reg < 64) ? 16 : 8);
+}
+} // namespace
+
+TEST_CASE("A CVP tracereader decodes variable-length records")
+{
+  std::string trace;
+
+  // ALU x1 <- x2, x3 with a SIMD second output
+  put<uint64_t>(trace, 0x1000);
+  put<uint8_t>(trace, 0);
+  put_registers(trace, {2, 3}, {{1, 0xabcd}, {40, 0x1234}});
+
+  // load x4 <- [0x8000]
+  put<uint64_t>(trace, 0x1004);
+  put<uint8_t>(trace, 1);
+  put<uint64_t>(trace, 0x8000);
+  put<uint8_t>(trace, 8);
+  put_registers(trace, {5}, {{4, 0xfeedface}});
+
+  // taken conditional branch
+  put<uint64_t>(trace, 0x1008);
+  put<uint8_t>(trace, 3);
+  put<uint8_t>(trace, 1);
+  put<uint64_t>(trace, 0x2000);
+  put_registers(trace, {64}, {});
+
+  // direct call, linking in x30
+  put<uint64_t>(trace, 0x2000);
+  put<uint8_t>(trace, 4);
+  put<uint8_t>(trace, 1);
+  put<uint64_t>(trace, 0x3000);
+  put_registers(trace, {}, {{30, 0x2004}});
+
+  // return through x30
+  put<uint64_t>(trace, 0x3000);
+  put<uint8_t>(trace, 5);
+  put<uint8_t>(trace, 1);
+  put<uint64_t>(trace, 0x2004);
+  put_registers(trace, {30}, {});
+
+  champsim::cvp_tracereader<std::istringstream> uut{0, std::istringstream{trace}};
+
+  auto alu = uut();
+  REQUIRE(alu.ip == champsim::address{0x1000});
+  REQUIRE(alu.instr_class == inst_class::ALU);
+  REQUIRE_FALSE(alu.is_branch);
+  REQUIRE(alu.has_values);
+  REQUIRE_THAT(alu.source_registers, Catch::Matchers::RangeEquals(std::vector{2, 3}));
+  REQUIRE_THAT(alu.destination_registers, Catch::Matchers::RangeEquals(std::vector{1}));
+  REQUIRE_THAT(alu.destination_register_values, Catch::Matchers::RangeEquals(std::vector<uint64_t>{0xabcd}));
+
+  auto load = uut();
+  REQUIRE(load.instr_class == inst_class::LOAD);
+  REQUIRE_THAT(load.source_memory, Catch::Matchers::RangeEquals(std::vector{champsim::address{0x8000}}));
+  REQUIRE_THAT(load.source_memory_size, Catch::Matchers::RangeEquals(std::vector<uint8_t>{8}));
+  REQUIRE_THAT(load.source_memory_values, Catch::Matchers::RangeEquals(std::vector<uint64_t>{0xfeedface}));
+
+  auto cond = uut();
+  REQUIRE(cond.instr_class == inst_class::COND_BRANCH);
+  REQUIRE(cond.branch == BRANCH_CONDITIONAL);
+  REQUIRE(cond.branch_taken);
+  REQUIRE(cond.branch_target == champsim::address{0x2000});
+
+  auto call = uut();
+  REQUIRE(call.branch == BRANCH_DIRECT_CALL);
+  REQUIRE(call.branch_target == champsim::address{0x3000});
+
+  REQUIRE_FALSE(uut.eof());
+  auto ret = uut();
+  REQUIRE(ret.branch == BRANCH_RETURN);
+  REQUIRE(ret.branch_target == champsim::address{0x2004});
+
+  REQUIRE(uut.eof());
+}
+
+TEST_CASE("A CVP record is not decoded until it is complete")
+{
+  std::string trace;
+  put<uint64_t>(trace, 0x1000);
+  put<uint8_t>(trace, 0);
+  put_registers(trace, {}, {{1, 0xabcd}});
+
+  const auto* begin = reinterpret_cast<const unsigned char*>(std::data(trace));
+  REQUIRE_FALSE(champsim::cvp::decode(0, begin, begin + std::size(trace) - 1).has_value());
+
+  auto decoded = champsim::cvp::decode(0, begin, begin + std::size(trace));
+  REQUIRE(decoded.has_value());
+  REQUIRE(decoded->second == std::size(trace));
+}
+
+TEST_CASE("CVP traces are recognized by name")
+{
+  REQUIRE(champsim::is_cvp_trace_name("srv_3.cvp"));
+  REQUIRE(champsim::is_cvp_trace_name("srv_3.cvp.gz"));
+  REQUIRE(champsim::is_cvp_trace_name("srv_3.cvp.xz"));
+  REQUIRE_FALSE(champsim::is_cvp_trace_name("srv_3.champsim.xz"));
+  REQUIRE_FALSE(champsim::is_cvp_trace_name("gz"));
+}
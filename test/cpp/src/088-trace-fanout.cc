@@ -0,0 +1,221 @@
+#include <catch.hpp>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "readers.h"
+#include "trace_fanout.h"
+
+namespace
+{
+// Holds up the decode of one instruction until a signal from another trace, which must be decoded at the same time for it to arrive
+struct gated_reader {
+  uint64_t next = 0;
+  uint64_t length;
+  uint64_t gate;
+  std::shared_ptr<std::promise<void>> signal;
+  std::shared_future<void> wait_for;
+  std::shared_ptr<bool> signalled;
+
+  ooo_model_instr operator()()
+  {
+    if (next == gate && signal != nullptr) {
+      signal->set_value();
+    }
+    if (next == gate && wait_for.valid()) {
+      *signalled = (wait_for.wait_for(std::chrono::seconds{10}) == std::future_status::ready);
+    }
+    input_instr instr{};
+    instr.ip = next++;
+    return ooo_model_instr{0, instr};
+  }
+
+  [[nodiscard]] bool eof() const { return next >= length; }
+};
+
+std::vector<uint64_t> read_all(champsim::tracereader& reader)
+{
+  std::vector<uint64_t> ips;
+  while (!reader.eof()) {
+    ips.push_back(reader().ip.to<uint64_t>());
+  }
+  return ips;
+}
+
+std::vector<uint64_t> expected_ips(uint64_t length)
+{
+  std::vector<uint64_t> retval(length);
+  std::iota(std::begin(retval), std::end(retval), 0);
+  return retval;
+}
+} // namespace
+
+SCENARIO("A trace fanout gives each consumer the whole trace")
+{
+  GIVEN("A trace shared by two consumers")
+  {
+    std::size_t decoded = 0;
+    std::vector<champsim::tracereader> traces;
+    traces.emplace_back(champsim::test::counting_reader{0, 100, &decoded});
+    champsim::trace_fanout uut{std::move(traces), 2, 8, 1000};
+
+    auto first = uut.readers(0);
+    auto second = uut.readers(1);
+    REQUIRE(std::size(first) == 1);
+    REQUIRE(std::size(second) == 1);
+
+    WHEN("Both consumers read to the end")
+    {
+      auto first_ips = read_all(first.front());
+      auto second_ips = read_all(second.front());
+
+      THEN("Each consumer sees every instruction in order")
+      {
+        CHECK(first_ips == expected_ips(100));
+        CHECK(second_ips == expected_ips(100));
+      }
+
+      THEN("The trace was decoded once")
+      {
+        CHECK(decoded == 100);
+      }
+
+      THEN("No batches are kept")
+      {
+        CHECK(uut.buffered_batches() == 0);
+      }
+    }
+
+    WHEN("Only one consumer has read to the end")
+    {
+      auto first_ips = read_all(first.front());
+
+      THEN("The batches are kept for the other consumer")
+      {
+        CHECK(uut.buffered_batches() > 1);
+      }
+
+      AND_WHEN("The other consumer is released")
+      {
+        uut.release(1);
+
+        THEN("No batches are kept")
+        {
+          CHECK(uut.buffered_batches() == 0);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("A trace fanout ends each consumer's trace at the end of the source")
+{
+  GIVEN("An empty trace")
+  {
+    std::size_t decoded = 0;
+    std::vector<champsim::tracereader> traces;
+    traces.emplace_back(champsim::test::counting_reader{0, 0, &decoded});
+    champsim::trace_fanout uut{std::move(traces), 1, 8, 1000};
+
+    THEN("The consumer's reader is at its end")
+    {
+      CHECK(uut.readers(0).front().eof());
+    }
+  }
+
+  GIVEN("A trace that ends at the end of a batch")
+  {
+    std::size_t decoded = 0;
+    std::vector<champsim::tracereader> traces;
+    traces.emplace_back(champsim::test::counting_reader{0, 16, &decoded});
+    champsim::trace_fanout uut{std::move(traces), 1, 8, 1000};
+    auto readers = uut.readers(0);
+
+    THEN("The consumer reads each instruction once")
+    {
+      CHECK(read_all(readers.front()) == expected_ips(16));
+    }
+  }
+}
+
+SCENARIO("Consumers of a trace fanout can read concurrently")
+{
+  GIVEN("Two traces shared by three consumers, with a small lead")
+  {
+    constexpr uint64_t length = 10000;
+    std::size_t decoded_a = 0;
+    std::size_t decoded_b = 0;
+    std::vector<champsim::tracereader> traces;
+    traces.emplace_back(champsim::test::counting_reader{0, length, &decoded_a});
+    traces.emplace_back(champsim::test::counting_reader{0, length, &decoded_b});
+    champsim::trace_fanout uut{std::move(traces), 3, 16, 2};
+
+    WHEN("Each consumer reads the traces on its own thread, in different orders")
+    {
+      std::vector<std::future<std::vector<uint64_t>>> results;
+      for (std::size_t i = 0; i < 3; ++i) {
+        results.push_back(std::async(std::launch::async, [&uut, i] {
+          auto readers = uut.readers(i);
+          auto& primary = readers.at(i % 2);
+          auto& secondary = readers.at((i + 1) % 2);
+          auto retval = read_all(primary);
+          auto rest = read_all(secondary);
+          retval.insert(std::end(retval), std::begin(rest), std::end(rest));
+          uut.release(i);
+          return retval;
+        }));
+      }
+
+      THEN("Every consumer sees both traces in full")
+      {
+        auto expected = expected_ips(length);
+        auto second_trace = expected_ips(length);
+        expected.insert(std::end(expected), std::begin(second_trace), std::end(second_trace));
+        for (auto& result : results) {
+          CHECK(result.get() == expected);
+        }
+        CHECK(decoded_a == length);
+        CHECK(decoded_b == length);
+      }
+    }
+  }
+}
+
+SCENARIO("A trace fanout decodes different traces at the same time")
+{
+  GIVEN("Two traces, the first of which cannot finish a batch until the second is being decoded")
+  {
+    auto signal = std::make_shared<std::promise<void>>();
+    auto signalled = std::make_shared<bool>(false);
+    std::vector<champsim::tracereader> traces;
+    traces.emplace_back(gated_reader{0, 16, 8, nullptr, signal->get_future().share(), signalled});
+    traces.emplace_back(gated_reader{0, 16, 8, signal, {}, nullptr});
+    champsim::trace_fanout uut{std::move(traces), 2, 8, 1000};
+
+    WHEN("Each consumer reads a different trace first")
+    {
+      std::vector<std::future<std::vector<uint64_t>>> results;
+      for (std::size_t i = 0; i < 2; ++i) {
+        results.push_back(std::async(std::launch::async, [&uut, i] {
+          auto readers = uut.readers(i);
+          auto retval = read_all(readers.at(i));
+          auto rest = read_all(readers.at((i + 1) % 2));
+          retval.insert(std::end(retval), std::begin(rest), std::end(rest));
+          uut.release(i);
+          return retval;
+        }));
+      }
+
+      THEN("The second trace is decoded while the first is")
+      {
+        for (auto& result : results) {
+          CHECK(std::size(result.get()) == 32);
+        }
+        CHECK(*signalled);
+      }
+    }
+  }
+}
@@ -0,0 +1,159 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "async_tracereader.h"
+#include "readers.h"
+#include "trace_instruction.h"
+#include "tracereader.h"
+
+namespace
+{
+struct throwing_reader {
+  uint64_t next = 0;
+
+  ooo_model_instr operator()()
+  {
+    if (next == 10) {
+      throw std::runtime_error{"Corrupt trace"};
+    }
+    input_instr instr{};
+    instr.ip = next++;
+    return ooo_model_instr{0, instr};
+  }
+
+  [[nodiscard]] bool eof() const { return false; }
+};
+
+std::string jump_trace(std::size_t length)
+{
+  std::string retval;
+  for (std::size_t i = 0; i < length; ++i) {
+    input_instr instr{};
+    instr.ip = 0x1000 + 0x40 * i;
+    instr.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    std::array<char, sizeof(input_instr)> bytes;
+    std::memcpy(std::data(bytes), &instr, sizeof(input_instr));
+    retval.append(std::begin(bytes), std::end(bytes));
+  }
+  return retval;
+}
+} // namespace
+
+SCENARIO("An asynchronous tracereader produces the instructions of the reader it wraps")
+{
+  GIVEN("A reader longer than several batches")
+  {
+    constexpr uint64_t length = 3 * champsim::async_tracereader<champsim::test::counting_reader>::batch_size + 17;
+    champsim::async_tracereader uut{champsim::test::counting_reader{0, length}};
+
+    WHEN("It is read to the end")
+    {
+      std::vector<uint64_t> ips;
+      while (!uut.eof()) {
+        ips.push_back(uut().ip.to<uint64_t>());
+      }
+
+      THEN("Every instruction is produced once, in order")
+      {
+        std::vector<uint64_t> expected(length);
+        std::iota(std::begin(expected), std::end(expected), 0);
+        CHECK(ips == expected);
+      }
+    }
+  }
+
+  GIVEN("A reader that cannot skip")
+  {
+    champsim::async_tracereader uut{champsim::test::counting_reader{0, 5000}};
+
+    WHEN("Instructions are skipped")
+    {
+      (void)uut();
+      uut.skip(3000);
+
+      THEN("The next instruction is the one after them")
+      {
+        CHECK(uut().ip.to<uint64_t>() == 3001);
+      }
+    }
+  }
+
+  GIVEN("An empty reader")
+  {
+    champsim::async_tracereader uut{champsim::test::counting_reader{0, 0}};
+
+    THEN("It is at its end")
+    {
+      CHECK(uut.eof());
+    }
+  }
+
+  GIVEN("A reader that never ends")
+  {
+    THEN("It can be destroyed before it is read")
+    {
+      champsim::async_tracereader uut{champsim::test::counting_reader{0, std::numeric_limits<uint64_t>::max()}};
+      CHECK_FALSE(uut.eof());
+    }
+  }
+}
+
+SCENARIO("An asynchronous tracereader reports errors to the reading thread")
+{
+  GIVEN("A reader that fails partway")
+  {
+    champsim::async_tracereader uut{::throwing_reader{}};
+
+    THEN("The error is thrown where the instructions are read")
+    {
+      CHECK_THROWS_AS(
+          [&] {
+            while (!uut.eof()) {
+              uut();
+            }
+          }(),
+          std::runtime_error);
+    }
+  }
+}
+
+SCENARIO("An asynchronous tracereader keeps branch targets across batches")
+{
+  GIVEN("A trace of taken jumps that spans several batches")
+  {
+    constexpr std::size_t length = 2 * champsim::async_tracereader<champsim::test::counting_reader>::batch_size + 5;
+    champsim::bulk_tracereader<input_instr, std::istringstream> direct{0, std::istringstream{::jump_trace(length)}};
+    champsim::async_tracereader uut{champsim::bulk_tracereader<input_instr, std::istringstream>{0, std::istringstream{::jump_trace(length)}}};
+
+    WHEN("It is read to the end")
+    {
+      std::vector<std::pair<uint64_t, uint64_t>> expected;
+      while (!direct.eof()) {
+        auto instr = direct();
+        expected.emplace_back(instr.ip.to<uint64_t>(), instr.branch_target.to<uint64_t>());
+      }
+
+      std::vector<std::pair<uint64_t, uint64_t>> targets;
+      while (!uut.eof()) {
+        auto instr = uut();
+        targets.emplace_back(instr.ip.to<uint64_t>(), instr.branch_target.to<uint64_t>());
+      }
+
+      THEN("Each jump has the same target as when the trace is read directly")
+      {
+        REQUIRE(std::size(expected) > 2 * champsim::async_tracereader<champsim::test::counting_reader>::batch_size);
+        CHECK(targets == expected);
+        CHECK(std::all_of(std::begin(targets), std::end(targets), [](auto pair) { return pair.second == pair.first + 0x40; }));
+      }
+    }
+  }
+}
@@ -0,0 +1,167 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+
+#include "mapped_tracereader.h"
+#include "trace_instruction.h"
+#include "tracereader.h"
+
+namespace
+{
+std::string branchy_trace(std::size_t length)
+{
+  std::string retval;
+  for (std::size_t i = 0; i < length; ++i) {
+    input_instr instr{};
+    instr.ip = 0x1000 + 0x40 * i;
+    if (i % 3 == 0) {
+      instr.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER; // a direct jump
+    }
+    if (i % 5 == 0) {
+      instr.source_memory[0] = 0x8000 + i;
+    }
+    std::array<char, sizeof(input_instr)> bytes;
+    std::memcpy(std::data(bytes), &instr, sizeof(input_instr));
+    retval.append(std::begin(bytes), std::end(bytes));
+  }
+  return retval;
+}
+
+struct temporary_file {
+  std::filesystem::path path;
+
+  temporary_file(const std::string& name, const std::string& contents) : path(std::filesystem::temp_directory_path() / name)
+  {
+    std::ofstream file{path, std::ios::binary};
+    file.write(std::data(contents), static_cast<std::streamsize>(std::size(contents)));
+  }
+
+  temporary_file(const temporary_file&) = delete;
+  temporary_file& operator=(const temporary_file&) = delete;
+  ~temporary_file() { std::filesystem::remove(path); }
+};
+
+template <typename R>
+std::vector<ooo_model_instr> read_all(R& reader)
+{
+  std::vector<ooo_model_instr> retval;
+  while (!reader.eof()) {
+    retval.push_back(reader());
+  }
+  return retval;
+}
+} // namespace
+
+SCENARIO("A mapped tracereader decodes the same instructions as a stream tracereader")
+{
+  GIVEN("An uncompressed trace on disk")
+  {
+    const auto contents = ::branchy_trace(1000);
+    ::temporary_file trace{"090-mapped-tracereader.champsimtrace", contents};
+
+    champsim::bulk_tracereader<input_instr, std::istringstream> direct{0, std::istringstream{contents}};
+    champsim::mapped_tracereader<input_instr> uut{0, trace.path.string()};
+
+    WHEN("Both are read to the end")
+    {
+      auto expected = ::read_all(direct);
+      auto instrs = ::read_all(uut);
+
+      THEN("They produce the same instructions")
+      {
+        REQUIRE(std::size(instrs) == std::size(expected));
+        CHECK(std::equal(std::begin(instrs), std::end(instrs), std::begin(expected), [](const auto& lhs, const auto& rhs) {
+          return lhs.ip == rhs.ip && lhs.is_branch == rhs.is_branch && lhs.branch_target == rhs.branch_target && lhs.source_memory == rhs.source_memory;
+        }));
+      }
+    }
+  }
+
+  GIVEN("An empty trace on disk")
+  {
+    ::temporary_file trace{"090-mapped-tracereader-empty.champsimtrace", ""};
+    champsim::mapped_tracereader<input_instr> uut{0, trace.path.string()};
+
+    THEN("The reader is at its end")
+    {
+      CHECK(uut.eof());
+    }
+  }
+}
+
+SCENARIO("Uncompressed traces are mapped by get_tracereader")
+{
+  GIVEN("An uncompressed trace on disk")
+  {
+    ::temporary_file trace{"090-get-tracereader.champsimtrace", ::branchy_trace(10)};
+
+    WHEN("A repeating reader is opened")
+    {
+      auto uut = get_tracereader(trace.path.string(), 0, champsim::trace_format::input, true);
+
+      THEN("It returns to the start of the trace after its end")
+      {
+        std::vector<uint64_t> ips;
+        for (int i = 0; i < 12; ++i) {
+          ips.push_back(uut().ip.to<uint64_t>());
+        }
+        CHECK(ips.at(0) == 0x1000);
+        CHECK(ips.at(8) == 0x1200);
+        CHECK(ips.at(9) == 0x1000);
+      }
+    }
+  }
+
+  GIVEN("An uncompressed trace that is written into a pipe")
+  {
+    const auto contents = ::branchy_trace(10);
+    const auto path = std::filesystem::temp_directory_path() / "090-get-tracereader-pipe.champsimtrace";
+    std::filesystem::remove(path);
+    REQUIRE(::mkfifo(path.c_str(), 0600) == 0);
+    CHECK_FALSE(champsim::mapped_file::can_map(path.string()));
+
+    // Opening either end of a pipe blocks until the other end is opened
+    std::thread writer{[&] {
+      std::ofstream file{path, std::ios::binary};
+      file.write(std::data(contents), static_cast<std::streamsize>(std::size(contents)));
+    }};
+
+    WHEN("The trace is read to its end")
+    {
+      std::vector<uint64_t> ips;
+      {
+        auto uut = get_tracereader(path.string(), 0, champsim::trace_format::input, false);
+        while (!uut.eof()) {
+          ips.push_back(uut().ip.to<uint64_t>());
+        }
+      }
+      writer.join();
+      std::filesystem::remove(path);
+
+      THEN("The pipe is streamed rather than mapped, and every instruction is read")
+      {
+        CHECK(std::size(ips) == 9);
+        CHECK(ips.front() == 0x1000);
+        CHECK(ips.back() == 0x1200);
+      }
+    }
+  }
+
+  GIVEN("A trace that does not exist")
+  {
+    THEN("Opening it is an error")
+    {
+      CHECK_THROWS_AS(champsim::mapped_tracereader<input_instr>(0, "/nonexistent/090.champsimtrace"), std::system_error);
+    }
+  }
+}
@@ -0,0 +1,137 @@
+#include <catch.hpp>
+
+#include <array>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "async_tracereader.h"
+#include "readers.h"
+#include "trace_instruction.h"
+#include "tracereader.h"
+#include "zstd_seekable.h"
+
+namespace
+{
+std::string seekable_compress(const std::string& plaintext, std::size_t frame_size)
+{
+  std::ostringstream compressed;
+  champsim::zstd_seekable_ostream uut{compressed, frame_size};
+  uut.write(std::data(plaintext), std::size(plaintext));
+  uut.close();
+  return compressed.str();
+}
+
+std::string input_trace(std::size_t length)
+{
+  std::string retval;
+  for (std::size_t i = 0; i < length; ++i) {
+    input_instr instr{};
+    instr.ip = 0x1000 + 0x40 * i;
+    std::array<char, sizeof(input_instr)> bytes;
+    std::memcpy(std::data(bytes), &instr, sizeof(input_instr));
+    retval.append(std::begin(bytes), std::end(bytes));
+  }
+  return retval;
+}
+} // namespace
+
+SCENARIO("A seekable zstd stream decompresses what was compressed")
+{
+  GIVEN("A stream compressed in several frames")
+  {
+    const auto plaintext = champsim::test::counting_bytes(10000);
+    const auto compressed = ::seekable_compress(plaintext, 1024);
+    champsim::zstd_seekable_istream<std::istringstream> uut{std::istringstream{compressed}};
+
+    THEN("The stream has a seek table")
+    {
+      CHECK(uut.seekable());
+    }
+
+    THEN("The whole stream is decompressed")
+    {
+      CHECK(champsim::test::read_rest(uut) == plaintext);
+    }
+
+    WHEN("The stream skips into a later frame")
+    {
+      uut.skip(5000);
+
+      THEN("Reading resumes at the destination")
+      {
+        CHECK(champsim::test::read_rest(uut) == plaintext.substr(5000));
+      }
+    }
+
+    WHEN("The stream skips several times")
+    {
+      std::array<char, 10> buffer;
+      uut.skip(100);
+      uut.read(std::data(buffer), std::size(buffer));
+      uut.skip(3000);
+
+      THEN("Each skip is from the current position")
+      {
+        CHECK(std::string(std::data(buffer), std::size(buffer)) == plaintext.substr(100, 10));
+        CHECK(champsim::test::read_rest(uut) == plaintext.substr(3110));
+      }
+    }
+
+    WHEN("The stream skips past its end")
+    {
+      uut.skip(20000);
+
+      THEN("The stream is at its end")
+      {
+        CHECK(uut.eof());
+      }
+    }
+  }
+
+  GIVEN("A stream without a seek table")
+  {
+    const auto plaintext = champsim::test::counting_bytes(10000);
+    auto compressed = ::seekable_compress(plaintext, 1024);
+    compressed.resize(std::size(compressed) - (8 + 10 * 8 + 9)); // Remove the seek table of 10 frames
+    champsim::zstd_seekable_istream<std::istringstream> uut{std::istringstream{compressed}};
+
+    THEN("The stream has no seek table")
+    {
+      CHECK_FALSE(uut.seekable());
+    }
+
+    WHEN("The stream skips forward")
+    {
+      uut.skip(5000);
+
+      THEN("Reading resumes at the destination")
+      {
+        CHECK(champsim::test::read_rest(uut) == plaintext.substr(5000));
+      }
+    }
+  }
+}
+
+SCENARIO("A tracereader skips instructions in a seekable zstd trace")
+{
+  GIVEN("A trace compressed in several frames, longer than the instructions that are decoded ahead")
+  {
+    const auto compressed = ::seekable_compress(::input_trace(30000), sizeof(input_instr) * 1000);
+
+    WHEN("The first instructions are skipped")
+    {
+      champsim::tracereader uut{champsim::async_tracereader{champsim::bulk_tracereader<input_instr, champsim::zstd_seekable_istream<std::istringstream>>{
+          0, champsim::zstd_seekable_istream<std::istringstream>{std::istringstream{compressed}}}}};
+      (void)uut();
+      uut.skip(20000);
+
+      THEN("The next instruction is the one after them")
+      {
+        CHECK(uut().ip == champsim::address{0x1000 + 0x40 * 20001});
+        CHECK(uut().ip == champsim::address{0x1000 + 0x40 * 20002});
+      }
+    }
+  }
+}
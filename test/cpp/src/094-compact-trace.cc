@@ -0,0 +1,202 @@
+#include <catch.hpp>
+
+#include <array>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "compact_trace.h"
+#include "trace_instruction.h"
+#include "tracereader.h"
+
+namespace
+{
+// A loop with a load, a store, and a taken backward branch, interrupted by calls to a far-away function
+std::vector<input_instr> loop_trace(std::size_t iterations)
+{
+  std::vector<input_instr> retval;
+  for (std::size_t i = 0; i < iterations; ++i) {
+    input_instr load{};
+    load.ip = 0x401000;
+    load.destination_registers[0] = 1;
+    load.source_registers[0] = 2;
+    load.source_memory[0] = 0x7fff0000 + 8 * i;
+    retval.push_back(load);
+
+    input_instr store{};
+    store.ip = 0x401004;
+    store.source_registers[0] = 1;
+    store.destination_memory[0] = 0x10000000 - 64 * i;
+    retval.push_back(store);
+
+    if (i % 7 == 0) {
+      input_instr call{};
+      call.ip = 0x401008;
+      call.is_branch = 1;
+      call.branch_taken = 1;
+      call.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+      call.destination_registers[1] = champsim::REG_STACK_POINTER;
+      call.source_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+      call.source_registers[1] = champsim::REG_STACK_POINTER;
+      call.destination_memory[0] = 0x7ffffff0;
+      retval.push_back(call);
+
+      input_instr callee{};
+      callee.ip = 0xffffffff81000000;
+      callee.is_branch = 2; // Not a flag, but it must survive the conversion
+      retval.push_back(callee);
+    }
+
+    input_instr branch{};
+    branch.ip = 0x40100c;
+    branch.is_branch = 1;
+    branch.branch_taken = (i + 1 < iterations);
+    branch.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    branch.source_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    branch.source_registers[1] = champsim::REG_FLAGS;
+    retval.push_back(branch);
+  }
+  return retval;
+}
+
+std::string encode(const std::vector<input_instr>& instrs)
+{
+  champsim::compact::encoder encoder;
+  std::vector<unsigned char> bytes{std::begin(champsim::compact::magic), std::end(champsim::compact::magic)};
+  for (const auto& instr : instrs) {
+    encoder.encode(instr, bytes);
+  }
+  return std::string{std::begin(bytes), std::end(bytes)};
+}
+
+std::string raw_trace(const std::vector<input_instr>& instrs)
+{
+  std::string retval(std::size(instrs) * sizeof(input_instr), '\0');
+  std::memcpy(std::data(retval), std::data(instrs), std::size(retval));
+  return retval;
+}
+
+bool same_record(const input_instr& lhs, const input_instr& rhs) { return std::memcmp(&lhs, &rhs, sizeof(input_instr)) == 0; }
+} // namespace
+
+SCENARIO("The compact trace format is lossless")
+{
+  GIVEN("A trace of loops and calls")
+  {
+    const auto instrs = ::loop_trace(100);
+    const auto compact = ::encode(instrs);
+
+    THEN("The encoding is much smaller than the fixed-size records")
+    {
+      CHECK(std::size(compact) * 8 < std::size(instrs) * sizeof(input_instr));
+    }
+
+    WHEN("The records are decoded")
+    {
+      champsim::compact::decoder decoder;
+      const auto* begin = reinterpret_cast<const unsigned char*>(std::data(compact)) + std::size(champsim::compact::magic);
+      const auto* end = reinterpret_cast<const unsigned char*>(std::data(compact)) + std::size(compact);
+
+      std::vector<input_instr> decoded;
+      for (auto next = decoder.decode(begin, end); next.has_value(); next = decoder.decode(begin, end)) {
+        decoded.push_back(next->first);
+        begin += next->second;
+      }
+
+      THEN("Every record is restored exactly")
+      {
+        REQUIRE(begin == end);
+        REQUIRE(std::size(decoded) == std::size(instrs));
+        CHECK(std::equal(std::begin(decoded), std::end(decoded), std::begin(instrs), ::same_record));
+      }
+    }
+  }
+}
+
+SCENARIO("A compact record is not decoded until it is complete")
+{
+  GIVEN("An encoding of two instructions")
+  {
+    const auto instrs = ::loop_trace(1);
+    const auto compact = ::encode(instrs);
+    const auto* begin = reinterpret_cast<const unsigned char*>(std::data(compact)) + std::size(champsim::compact::magic);
+    const auto* end = reinterpret_cast<const unsigned char*>(std::data(compact)) + std::size(compact);
+
+    WHEN("The first record is cut short")
+    {
+      champsim::compact::decoder decoder;
+      auto partial = decoder.decode(begin, std::next(begin, 3));
+
+      THEN("Nothing is decoded, and the whole record is decoded later")
+      {
+        CHECK_FALSE(partial.has_value());
+        auto decoded = decoder.decode(begin, end);
+        REQUIRE(decoded.has_value());
+        CHECK(::same_record(decoded->first, instrs.at(0)));
+        decoded = decoder.decode(begin + decoded->second, end);
+        REQUIRE(decoded.has_value());
+        CHECK(::same_record(decoded->first, instrs.at(1)));
+      }
+    }
+  }
+
+  GIVEN("A record with an unknown field")
+  {
+    std::array<unsigned char, 3> record{0, 0x80, 0};
+    champsim::compact::decoder decoder;
+
+    THEN("Decoding it is an error")
+    {
+      CHECK_THROWS_AS(decoder.decode(std::data(record), std::data(record) + std::size(record)), std::runtime_error);
+    }
+  }
+}
+
+SCENARIO("A compact tracereader produces the same instructions as the fixed-size trace")
+{
+  GIVEN("A trace that spans several reads")
+  {
+    const auto instrs = ::loop_trace(20000);
+    champsim::bulk_tracereader<input_instr, std::istringstream> direct{0, std::istringstream{::raw_trace(instrs)}};
+    champsim::compact_tracereader<std::istringstream> uut{0, std::istringstream{::encode(instrs)}};
+
+    WHEN("Both are read to the end")
+    {
+      std::vector<ooo_model_instr> expected;
+      while (!direct.eof()) {
+        expected.push_back(direct());
+      }
+      std::vector<ooo_model_instr> read;
+      while (!uut.eof()) {
+        read.push_back(uut());
+      }
+
+      THEN("They produce the same instructions and branch targets")
+      {
+        REQUIRE(std::size(read) == std::size(expected));
+        CHECK(std::equal(std::begin(read), std::end(read), std::begin(expected), [](const auto& lhs, const auto& rhs) {
+          return lhs.ip == rhs.ip && lhs.is_branch == rhs.is_branch && lhs.branch_taken == rhs.branch_taken && lhs.branch_target == rhs.branch_target
+                 && lhs.source_memory == rhs.source_memory && lhs.destination_memory == rhs.destination_memory;
+        }));
+      }
+    }
+  }
+
+  GIVEN("A file that is not a compact trace")
+  {
+    THEN("Opening it is an error")
+    {
+      CHECK_THROWS_AS(champsim::compact_tracereader<std::istringstream>(0, std::istringstream{::raw_trace(::loop_trace(1))}), std::runtime_error);
+    }
+  }
+}
+
+TEST_CASE("Compact traces are recognized by name")
+{
+  REQUIRE(champsim::is_compact_trace_name("600.perlbench_s-210B.cst"));
+  REQUIRE(champsim::is_compact_trace_name("600.perlbench_s-210B.cst.zst"));
+  REQUIRE_FALSE(champsim::is_compact_trace_name("600.perlbench_s-210B.champsimtrace.xz"));
+  REQUIRE_FALSE(champsim::is_compact_trace_name("srv_3.cvp.gz"));
+}
@@ -0,0 +1,155 @@
+#include <catch.hpp>
+
+#include <array>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+#include "readers.h"
+#include "repeatable.h"
+#include "restartable_istream.h"
+#include "trace_index.h"
+#include "trace_instruction.h"
+#include "tracereader.h"
+
+namespace
+{
+// Compress each block of the plaintext as a separate gzip member, and note where each begins
+std::string gzip_members(const std::string& plaintext, std::size_t block_size, std::vector<champsim::restart_point>& points)
+{
+  std::string retval;
+  for (std::size_t begin = 0; begin < std::size(plaintext); begin += block_size) {
+    points.push_back({begin, std::size(retval)});
+
+    z_stream strm{};
+    deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+    std::string block = plaintext.substr(begin, block_size);
+    std::vector<unsigned char> out(deflateBound(&strm, std::size(block)) + 32);
+    strm.next_in = reinterpret_cast<unsigned char*>(std::data(block));
+    strm.avail_in = static_cast<unsigned>(std::size(block));
+    strm.next_out = std::data(out);
+    strm.avail_out = static_cast<unsigned>(std::size(out));
+    deflate(&strm, Z_FINISH);
+    retval.append(reinterpret_cast<const char*>(std::data(out)), std::size(out) - strm.avail_out);
+    deflateEnd(&strm);
+  }
+  return retval;
+}
+} // namespace
+
+SCENARIO("A trace index is written and read")
+{
+  GIVEN("An index of several blocks")
+  {
+    champsim::trace_index index{64, {{0, 0}, {1000, 4321}, {2000, 8765}}};
+    std::stringstream file;
+    champsim::write_trace_index(file, index);
+
+    WHEN("It is read back")
+    {
+      auto uut = champsim::read_trace_index(file);
+
+      THEN("The restart points are measured in decompressed bytes")
+      {
+        auto points = uut.restart_points();
+        REQUIRE(std::size(points) == 3);
+        CHECK(points.at(1).decompressed_offset == 64000);
+        CHECK(points.at(1).compressed_offset == 4321);
+      }
+    }
+  }
+
+  GIVEN("A file that is not an index")
+  {
+    std::istringstream file{"not an index"};
+
+    THEN("Reading it is an error")
+    {
+      CHECK_THROWS_AS(champsim::read_trace_index(file), std::runtime_error);
+    }
+  }
+
+  THEN("An index is named after its trace")
+  {
+    CHECK(champsim::trace_index_name("600.perlbench_s-210B.champsimtrace.xz") == "600.perlbench_s-210B.champsimtrace.xz.idx");
+  }
+}
+
+SCENARIO("A restartable stream skips to the member that holds its destination")
+{
+  GIVEN("A stream of several gzip members with their restart points")
+  {
+    const auto plaintext = champsim::test::counting_bytes(10000);
+    std::vector<champsim::restart_point> points;
+    const auto compressed = ::gzip_members(plaintext, 1024, points);
+
+    WHEN("The stream is read without skipping")
+    {
+      champsim::restartable_istream<champsim::decomp_tags::gzip_tag_t<>, std::istringstream> uut{std::istringstream{compressed}};
+
+      THEN("Every member is decompressed")
+      {
+        CHECK(champsim::test::read_rest(uut) == plaintext);
+      }
+    }
+
+    WHEN("The stream skips into a later member")
+    {
+      champsim::restartable_istream<champsim::decomp_tags::gzip_tag_t<>, std::istringstream> uut{std::istringstream{compressed}, points};
+      std::array<char, 10> buffer;
+      uut.read(std::data(buffer), std::size(buffer));
+      uut.skip(5000);
+
+      THEN("Reading resumes at the destination")
+      {
+        CHECK(uut.seekable());
+        CHECK(champsim::test::read_rest(uut) == plaintext.substr(5010));
+      }
+    }
+  }
+}
+
+SCENARIO("A tracereader seeks to an instruction")
+{
+  GIVEN("A reader that can return to its beginning")
+  {
+    champsim::tracereader uut{champsim::repeatable<champsim::test::counting_reader>{}};
+
+    WHEN("It seeks forward")
+    {
+      uut.seek(40);
+
+      THEN("The next instruction is the one that was sought")
+      {
+        CHECK(uut().ip == champsim::address{40});
+        CHECK(uut.tell() == 41);
+      }
+    }
+
+    WHEN("It seeks backward")
+    {
+      uut.seek(40);
+      uut.seek(10);
+
+      THEN("The next instruction is the one that was sought")
+      {
+        CHECK(uut().ip == champsim::address{10});
+      }
+    }
+  }
+
+  GIVEN("A reader that cannot return to its beginning")
+  {
+    champsim::tracereader uut{champsim::test::counting_reader{}};
+    uut.seek(40);
+
+    THEN("It cannot seek backward")
+    {
+      CHECK_THROWS_AS(uut.seek(10), std::logic_error);
+    }
+  }
+}
@@ -1,6 +1,6 @@
 #include <catch.hpp>
 
-#include "../../../branch/hashed_perceptron/folded_shift_register.h"
+#include "msl/folded_shift_register.h"
 
 using global_history = folded_shift_register<champsim::data::bits{12}>;
 
@@ -0,0 +1,133 @@
+#include <catch.hpp>
+#include <memory>
+#include <sstream>
+
+#include "../../../value_predictor/dvtage/dvtage.h"
+#include "../../../value_predictor/eves/eves.h"
+#include "../../../value_predictor/last_value/last_value.h"
+#include "../../../value_predictor/stride/stride.h"
+#include "../../../value_predictor/vtage/vtage.h"
+
+namespace
+{
+template <typename T>
+void train(T& uut, champsim::address ip, uint64_t start, uint64_t step, std::size_t count)
+{
+  for (std::size_t i{0}; i < count; ++i) {
+    auto [predicted, confident] = uut.predict_value(ip);
+    uut.update_value(ip, start + step * i, predicted, confident);
+  }
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("A value predictor does not predict confidently for an unseen instruction", "", last_value, stride, vtage, dvtage, eves)
+{
+  auto uut = std::make_unique<TestType>(nullptr);
+  champsim::address ip_under_test{0xdeadbeef};
+
+  REQUIRE_FALSE(uut->predict_value(ip_under_test).second);
+}
+
+TEMPLATE_TEST_CASE("A value predictor confidently predicts a constant value", "", last_value, stride, vtage, dvtage, eves)
+{
+  auto uut = std::make_unique<TestType>(nullptr);
+  champsim::address ip_under_test{0xdeadbeef};
+
+  train(*uut, ip_under_test, 0xcafe, 0, 1000);
+
+  auto [predicted, confident] = uut->predict_value(ip_under_test);
+  REQUIRE(confident);
+  REQUIRE(predicted == 0xcafe);
+}
+
+TEMPLATE_TEST_CASE("A stride-based value predictor confidently predicts an arithmetic sequence", "", stride, dvtage, eves)
+{
+  auto uut = std::make_unique<TestType>(nullptr);
+  champsim::address ip_under_test{0xdeadbeef};
+
+  train(*uut, ip_under_test, 100, 8, 1000);
+
+  auto [predicted, confident] = uut->predict_value(ip_under_test);
+  REQUIRE(confident);
+  REQUIRE(predicted == 100 + 8 * 1000);
+}
+
+TEMPLATE_TEST_CASE("A stride-based value predictor accounts for instances in flight", "", stride, dvtage, eves)
+{
+  auto uut = std::make_unique<TestType>(nullptr);
+  champsim::address ip_under_test{0xdeadbeef};
+
+  train(*uut, ip_under_test, 100, 8, 1000);
+
+  auto first = uut->predict_value(ip_under_test).first;
+  auto second = uut->predict_value(ip_under_test).first;
+  REQUIRE(first == 100 + 8 * 1000);
+  REQUIRE(second == 100 + 8 * 1001);
+}
+
+TEST_CASE("A last value predictor loses confidence when the value changes")
+{
+  auto uut = std::make_unique<last_value>(nullptr);
+  champsim::address ip_under_test{0xdeadbeef};
+
+  train(*uut, ip_under_test, 0xcafe, 0, 1000);
+  train(*uut, ip_under_test, 0xbeef, 0, 1);
+
+  auto [predicted, confident] = uut->predict_value(ip_under_test);
+  REQUIRE_FALSE(confident);
+  REQUIRE(predicted == 0xbeef);
+}
+
+TEST_CASE("The VTAGE predictor distinguishes values by branch history")
+{
+  auto uut = std::make_unique<vtage>(nullptr);
+  champsim::address ip_under_test{0xdeadbeef};
+  champsim::address branch_ip{0x1000};
+
+  for (std::size_t i{0}; i < 4000; ++i) {
+    bool taken = (i % 2 == 0);
+    uut->value_predictor_branch_operate(branch_ip, champsim::address{}, taken, 0);
+    auto [predicted, confident] = uut->predict_value(ip_under_test);
+    uut->update_value(ip_under_test, taken ? 0x1111 : 0x2222, predicted, confident);
+  }
+
+  uut->value_predictor_branch_operate(branch_ip, champsim::address{}, true, 0);
+  auto [predicted, confident] = uut->predict_value(ip_under_test);
+  REQUIRE(confident);
+  REQUIRE(predicted == 0x1111);
+}
+
+TEMPLATE_TEST_CASE("A value predictor's training survives a checkpoint", "", last_value, stride, vtage, dvtage, eves)
+{
+  auto original = std::make_unique<TestType>(nullptr);
+  champsim::address ip_under_test{0xdeadbeef};
+
+  train(*original, ip_under_test, 0xcafe, 0, 1000);
+
+  std::stringstream checkpoint;
+  original->value_predictor_save_checkpoint(checkpoint);
+
+  auto restored = std::make_unique<TestType>(nullptr);
+  restored->value_predictor_restore_checkpoint(checkpoint);
+
+  auto [predicted, confident] = restored->predict_value(ip_under_test);
+  REQUIRE(confident);
+  REQUIRE(predicted == 0xcafe);
+}
+
+TEMPLATE_TEST_CASE("A stride-based value predictor restored from a checkpoint forgets the instances in flight", "", stride, dvtage, eves)
+{
+  auto original = std::make_unique<TestType>(nullptr);
+  champsim::address ip_under_test{0xdeadbeef};
+
+  train(*original, ip_under_test, 100, 8, 1000);
+  (void)original->predict_value(ip_under_test);
+
+  std::stringstream checkpoint;
+  original->value_predictor_save_checkpoint(checkpoint);
+
+  auto restored = std::make_unique<TestType>(nullptr);
+  restored->value_predictor_restore_checkpoint(checkpoint);
+
+  REQUIRE(restored->predict_value(ip_under_test).first == 100 + 8 * 1000);
+}
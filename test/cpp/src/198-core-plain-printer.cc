@@ -101,3 +101,25 @@ TEST_CASE("The ROB occupancy modifies the flush penalty")
 
   REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
 }
+
+TEST_CASE("A core that consulted a value predictor reports on it")
+{
+  cpu_stats given{};
+  given.name = "test_cpu";
+  given.begin_instrs = 0;
+  given.begin_cycles = 0;
+  given.end_instrs = 1000;
+  given.end_cycles = 500;
+  given.value_recovery = value_recovery_type::REISSUE;
+  given.value_predictions = 200;
+  given.value_confident_predictions = 100;
+  given.value_mispredictions = 10;
+  given.value_recovery_cycles = 30;
+  given.value_reissued_instrs = 25;
+
+  std::vector<std::string> expected{"test_cpu Value Prediction Coverage: 50% Accuracy: 90% MPKI: 10",
+                                    "test_cpu Value Misprediction Recovery: REISSUE Penalty Cycles: 30 Reissued Instructions: 25"};
+
+  auto lines = champsim::plain_printer::format(given);
+  REQUIRE_THAT(std::vector<std::string>(std::end(lines) - 2, std::end(lines)), Catch::Matchers::RangeEquals(expected));
+}
@@ -47,6 +47,7 @@ SCENARIO("The scheduler can detect RAW hazards")
 
     do_nothing_MRC mock_L1I, mock_L1D;
     O3_CPU uut{champsim::core_builder{}
+                   .rob_size(2)
                    .schedule_width(champsim::bandwidth::maximum_type{schedule_width})
                    .register_file_size(128)
                    .schedule_latency(schedule_latency)
@@ -88,6 +89,7 @@ SCENARIO("The scheduler can detect RAW hazards")
 
     do_nothing_MRC mock_L1I, mock_L1D;
     O3_CPU uut{champsim::core_builder{}
+                   .rob_size(schedule_width + 1)
                    .schedule_width(champsim::bandwidth::maximum_type{schedule_width})
                    .register_file_size(128)
                    .schedule_latency(schedule_latency)
@@ -152,6 +154,7 @@ SCENARIO("The scheduler handles WAW hazards")
 
     do_nothing_MRC mock_L1I, mock_L1D;
     O3_CPU uut{champsim::core_builder{}
+                   .rob_size(3)
                    .schedule_width(champsim::bandwidth::maximum_type{schedule_width})
                    .register_file_size(128)
                    .schedule_latency(schedule_latency)
@@ -228,6 +231,7 @@ SCENARIO("The scheduler handles WAW hazards")
 
     do_nothing_MRC mock_L1I, mock_L1D;
     O3_CPU uut{champsim::core_builder{}
+                   .rob_size(3)
                    .schedule_width(champsim::bandwidth::maximum_type{schedule_width})
                    .schedule_latency(schedule_latency)
                    .execute_latency(execute_latency)
@@ -291,6 +295,150 @@ SCENARIO("The scheduler handles WAW hazards")
   }
 }
 
+SCENARIO("The select logic issues the oldest ready instructions")
+{
+  GIVEN("A ROB with more independent instructions than the execution width")
+  {
+    constexpr unsigned execute_width = 1;
+
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .rob_size(3)
+                   .schedule_width(champsim::bandwidth::maximum_type{128})
+                   .register_file_size(128)
+                   .execute_width(champsim::bandwidth::maximum_type{execute_width})
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)};
+
+    for (uint64_t id = 1; id <= 3; ++id) {
+      uut.ROB.push_back(champsim::test::instruction_with_ip(id));
+      uut.ROB.back().instr_id = id;
+      uut.ROB.back().destination_registers.push_back(static_cast<uint8_t>(id));
+      uut.ROB.back().ready_time = champsim::chrono::clock::time_point{};
+    }
+
+    WHEN("The instructions are scheduled and one cycle passes")
+    {
+      for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+        op->_operate();
+      for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+        op->_operate();
+
+      THEN("Only the oldest instruction executes")
+      {
+        REQUIRE(uut.ROB.at(0).executed);
+        REQUIRE_FALSE(uut.ROB.at(1).executed);
+        REQUIRE_FALSE(uut.ROB.at(2).executed);
+      }
+
+      AND_WHEN("Another cycle passes")
+      {
+        for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+          op->_operate();
+
+        THEN("The next oldest instruction executes")
+        {
+          REQUIRE(uut.ROB.at(1).executed);
+          REQUIRE_FALSE(uut.ROB.at(2).executed);
+        }
+      }
+    }
+  }
+
+  GIVEN("A ROB with an instruction that reads a register written by a long-running instruction")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .rob_size(2)
+                   .schedule_width(champsim::bandwidth::maximum_type{128})
+                   .register_file_size(128)
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)};
+
+    uut.ROB.push_back(champsim::test::instruction_with_ip(1));
+    uut.ROB.at(0).instr_id = 1;
+    uut.ROB.at(0).destination_registers.push_back(5);
+    uut.ROB.push_back(champsim::test::instruction_with_ip(2));
+    uut.ROB.at(1).instr_id = 2;
+    uut.ROB.at(1).source_registers.push_back(5);
+    for (auto& instr : uut.ROB)
+      instr.ready_time = champsim::chrono::clock::time_point{};
+
+    // Schedule, then execute the producer
+    for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+      op->_operate();
+    for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+      op->_operate();
+    uut.ROB.at(0).ready_time = champsim::chrono::clock::time_point::max();
+
+    WHEN("The producer has not completed")
+    {
+      for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+        op->_operate();
+
+      THEN("The consumer waits on the register")
+      {
+        REQUIRE(uut.ROB.at(0).executed);
+        REQUIRE_FALSE(uut.ROB.at(1).executed);
+      }
+
+      AND_WHEN("The producer completes")
+      {
+        uut.ROB.at(0).ready_time = champsim::chrono::clock::time_point{};
+        for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+          op->_operate();
+
+        THEN("The consumer is woken and executes in the same cycle")
+        {
+          REQUIRE(uut.ROB.at(0).completed);
+          REQUIRE(uut.ROB.at(1).executed);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("The scheduler searches past instructions that have executed")
+{
+  // With few free registers, every instruction is checked for registers as the search passes it
+  auto register_file_size = GENERATE(as<std::size_t>(), 4, 128);
+
+  GIVEN("A ROB whose oldest instructions have executed, with a register file of " + std::to_string(register_file_size))
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .rob_size(3)
+                   .schedule_width(champsim::bandwidth::maximum_type{1})
+                   .register_file_size(register_file_size)
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)};
+
+    for (uint64_t id = 1; id <= 3; ++id) {
+      uut.ROB.push_back(champsim::test::instruction_with_ip(id));
+      uut.ROB.back().instr_id = id;
+      uut.ROB.back().ready_time = champsim::chrono::clock::time_point{};
+    }
+
+    // The executed instructions do not complete
+    for (std::size_t i = 0; i < 2; ++i) {
+      uut.ROB.at(i).scheduled = true;
+      uut.ROB.at(i).executed = true;
+      uut.ROB.at(i).ready_time = champsim::chrono::clock::time_point::max();
+    }
+
+    WHEN("A cycle passes")
+    {
+      for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+        op->_operate();
+
+      THEN("The youngest instruction is scheduled within a search width of one")
+      {
+        REQUIRE(uut.ROB.at(2).scheduled);
+      }
+    }
+  }
+}
+
 TEST_CASE("ooo_cpu Benchmarks") {
   BENCHMARK_ADVANCED("ooo_cpu::operate()")(Catch::Benchmark::Chronometer meter){
     constexpr unsigned schedule_width = 128;
@@ -300,6 +448,7 @@ TEST_CASE("ooo_cpu Benchmarks") {
 
     do_nothing_MRC mock_L1I, mock_L1D;
     O3_CPU uut{champsim::core_builder{}
+      .rob_size(3)
       .schedule_width(champsim::bandwidth::maximum_type{schedule_width})
       .schedule_latency(schedule_latency)
       .execute_latency(execute_latency)
@@ -0,0 +1,177 @@
+#include <catch.hpp>
+
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+
+namespace
+{
+template <bool CONFIDENT>
+struct fixed_value_predictor : champsim::modules::value_predictor {
+  using value_predictor::value_predictor;
+
+  inline static std::vector<std::pair<uint64_t, uint64_t>> updates{};
+
+  std::pair<uint64_t, bool> predict_value(champsim::address) { return {0xfeed, CONFIDENT}; }
+  void update_value(champsim::address, uint64_t actual, uint64_t predicted, bool) { updates.emplace_back(actual, predicted); }
+};
+
+// Records how many branches it had seen when each prediction was made
+struct history_value_predictor : champsim::modules::value_predictor {
+  using value_predictor::value_predictor;
+
+  inline static std::vector<int> history_at_prediction{};
+  int branches_seen = 0;
+
+  std::pair<uint64_t, bool> predict_value(champsim::address)
+  {
+    history_at_prediction.push_back(branches_seen);
+    return {0xfeed, false};
+  }
+  void value_predictor_branch_operate(champsim::address, champsim::address, bool, uint8_t) { ++branches_seen; }
+};
+} // namespace
+
+SCENARIO("A confident value prediction breaks a RAW hazard")
+{
+  GIVEN("A ROB with a RAW hazard and a confident value predictor")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .rob_size(2)
+                   .schedule_width(champsim::bandwidth::maximum_type{128})
+                   .register_file_size(128)
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)
+                   .value_predictor<fixed_value_predictor<true>>()};
+
+    uut.warmup = false;
+
+    // The prediction is made at fetch
+    std::vector test_instructions(2, champsim::test::instruction_with_register_value(42, 0xfeed));
+    for (auto& instr : test_instructions)
+      uut.do_init_instruction(instr);
+    std::copy(std::begin(test_instructions), std::end(test_instructions), std::back_inserter(uut.ROB));
+    for (auto& instr : uut.ROB)
+      instr.ready_time = champsim::chrono::clock::time_point{};
+
+    WHEN("The instructions are scheduled")
+    {
+      for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+        op->_operate();
+
+      THEN("The second instruction does not wait on the first")
+      {
+        REQUIRE(uut.ROB.at(0).value_prediction_confident);
+        REQUIRE(uut.reg_allocator.count_reg_dependencies(uut.ROB.at(1)) == 0);
+      }
+    }
+  }
+
+  GIVEN("A ROB with a RAW hazard and an unconfident value predictor")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .rob_size(2)
+                   .schedule_width(champsim::bandwidth::maximum_type{128})
+                   .register_file_size(128)
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)
+                   .value_predictor<fixed_value_predictor<false>>()};
+
+    uut.warmup = false;
+
+    // The prediction is made at fetch
+    std::vector test_instructions(2, champsim::test::instruction_with_register_value(42, 0xfeed));
+    for (auto& instr : test_instructions)
+      uut.do_init_instruction(instr);
+    std::copy(std::begin(test_instructions), std::end(test_instructions), std::back_inserter(uut.ROB));
+    for (auto& instr : uut.ROB)
+      instr.ready_time = champsim::chrono::clock::time_point{};
+
+    WHEN("The instructions are scheduled")
+    {
+      for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+        op->_operate();
+
+      THEN("The second instruction waits on the first")
+      {
+        REQUIRE(uut.ROB.at(0).value_predicted);
+        REQUIRE_FALSE(uut.ROB.at(0).value_prediction_confident);
+        REQUIRE(uut.reg_allocator.count_reg_dependencies(uut.ROB.at(1)) == 1);
+      }
+    }
+  }
+}
+
+SCENARIO("The value predictor is trained when an instruction retires")
+{
+  GIVEN("A predicted instruction")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .schedule_width(champsim::bandwidth::maximum_type{128})
+                   .register_file_size(128)
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)
+                   .value_predictor<fixed_value_predictor<true>>()};
+
+    uut.warmup = false;
+
+    auto test_instruction = champsim::test::instruction_with_register_value(42, 0xbeef);
+    uut.do_init_instruction(test_instruction);
+    uut.ROB.push_back(test_instruction);
+    uut.ROB.front().ready_time = champsim::chrono::clock::time_point{};
+    fixed_value_predictor<true>::updates.clear();
+
+    WHEN("The instruction runs to retirement")
+    {
+      for (int i = 0; i < 10 && !std::empty(uut.ROB); ++i) {
+        for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+          op->_operate();
+      }
+
+      THEN("The predictor sees the recorded value and its own prediction")
+      {
+        REQUIRE(std::empty(uut.ROB));
+        REQUIRE_THAT(fixed_value_predictor<true>::updates, Catch::Matchers::RangeEquals(std::vector<std::pair<uint64_t, uint64_t>>{{0xbeef, 0xfeed}}));
+      }
+    }
+  }
+}
+
+SCENARIO("The value prediction is made at fetch")
+{
+  GIVEN("An instruction fetched before a younger branch")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .schedule_width(champsim::bandwidth::maximum_type{128})
+                   .register_file_size(128)
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)
+                   .value_predictor<history_value_predictor>()};
+
+    uut.warmup = false;
+    history_value_predictor::history_at_prediction.clear();
+
+    auto test_instruction = champsim::test::instruction_with_register_value(42, 0xbeef);
+    uut.do_init_instruction(test_instruction);
+    uut.impl_value_predictor_branch_operate(champsim::address{0x100}, champsim::address{0x200}, true, BRANCH_CONDITIONAL);
+    uut.ROB.push_back(test_instruction);
+    uut.ROB.front().ready_time = champsim::chrono::clock::time_point{};
+
+    WHEN("The instruction is renamed")
+    {
+      for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+        op->_operate();
+
+      THEN("The prediction was made once, without the younger branch in its history")
+      {
+        REQUIRE(uut.ROB.front().scheduled);
+        REQUIRE(uut.ROB.front().value_predicted);
+        REQUIRE_THAT(history_value_predictor::history_at_prediction, Catch::Matchers::RangeEquals(std::vector<int>{0}));
+      }
+    }
+  }
+}
@@ -0,0 +1,110 @@
+#include <catch.hpp>
+
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+
+namespace
+{
+// Confidently predicts a wrong value for the instruction at IP 1 only
+struct wrong_value_predictor : champsim::modules::value_predictor {
+  using value_predictor::value_predictor;
+
+  std::pair<uint64_t, bool> predict_value(champsim::address ip) { return {0xfeed, ip == champsim::address{1}}; }
+};
+
+ooo_model_instr instruction_with_dependence(uint64_t id, uint8_t src, uint8_t dest)
+{
+  auto instr = champsim::test::instruction_with_register_value(dest, 0xbeef);
+  instr.instr_id = id;
+  instr.ip = champsim::address{id};
+  instr.source_registers = {src};
+  instr.ready_time = champsim::chrono::clock::time_point{};
+  return instr;
+}
+
+// The value prediction is made at fetch, before the instruction enters the ROB
+void fetch(O3_CPU& uut, ooo_model_instr instr)
+{
+  uut.do_init_instruction(instr);
+  uut.ROB.push_back(instr);
+}
+
+O3_CPU make_core(do_nothing_MRC& mock_L1I, do_nothing_MRC& mock_L1D, value_recovery_type recovery)
+{
+  return O3_CPU{champsim::core_builder{}
+                    .rob_size(4)
+                    .schedule_width(champsim::bandwidth::maximum_type{128})
+                    .execute_width(champsim::bandwidth::maximum_type{128})
+                    .retire_width(champsim::bandwidth::maximum_type{128})
+                    .register_file_size(128)
+                    .execute_latency(4)
+                    .mispredict_penalty(7)
+                    .value_recovery(recovery)
+                    .fetch_queues(&mock_L1I.queues)
+                    .data_queues(&mock_L1D.queues)
+                    .value_predictor<wrong_value_predictor>()};
+}
+} // namespace
+
+SCENARIO("Scheduling records the consumers of each producer")
+{
+  GIVEN("A producer and its consumer")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    auto uut = make_core(mock_L1I, mock_L1D, value_recovery_type::REISSUE);
+    uut.warmup = false;
+
+    fetch(uut, instruction_with_dependence(1, 42, 42));
+    fetch(uut, instruction_with_dependence(2, 42, 43));
+    fetch(uut, instruction_with_dependence(3, 50, 50));
+
+    WHEN("The instructions are scheduled")
+    {
+      for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+        op->_operate();
+
+      THEN("The producer knows its consumer")
+      {
+        REQUIRE(std::size(uut.ROB.at(0).registers_instrs_depend_on_me) == 1);
+        REQUIRE(uut.ROB.at(0).registers_instrs_depend_on_me.front()->instr_id == 2);
+        REQUIRE(std::empty(uut.ROB.at(1).registers_instrs_depend_on_me));
+        REQUIRE(std::empty(uut.ROB.at(2).registers_instrs_depend_on_me));
+      }
+    }
+  }
+}
+
+SCENARIO("A value misprediction is recovered according to the configured mechanism")
+{
+  GIVEN("A chain of dependent instructions whose head is confidently mispredicted")
+  {
+    auto [recovery, expected_reissued, expected_cycles] =
+        GENERATE(std::tuple{value_recovery_type::REISSUE, 1u, 0u}, std::tuple{value_recovery_type::SQUASH, 3u, 7u});
+
+    do_nothing_MRC mock_L1I, mock_L1D;
+    auto uut = make_core(mock_L1I, mock_L1D, recovery);
+    uut.warmup = false;
+
+    fetch(uut, instruction_with_dependence(1, 42, 42)); // mispredicted
+    fetch(uut, instruction_with_dependence(2, 42, 43)); // issues early on the prediction
+    fetch(uut, instruction_with_dependence(3, 43, 44)); // waits for its producer
+    fetch(uut, instruction_with_dependence(4, 50, 50)); // independent
+
+    WHEN("The instructions run to retirement")
+    {
+      for (int i = 0; i < 100 && !std::empty(uut.ROB); ++i) {
+        for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+          op->_operate();
+      }
+
+      THEN("Only the affected instructions are run again")
+      {
+        REQUIRE(std::empty(uut.ROB));
+        REQUIRE(uut.sim_stats.value_mispredictions == 1);
+        REQUIRE(uut.sim_stats.value_reissued_instrs == expected_reissued);
+        REQUIRE(uut.sim_stats.value_recovery_cycles == expected_cycles);
+      }
+    }
+  }
+}
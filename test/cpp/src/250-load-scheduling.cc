@@ -66,3 +66,43 @@ SCENARIO("The core issues loads only after its registers are finished")
     }
   }
 }
+
+SCENARIO("A load finishes its instruction when instruction IDs are not consecutive")
+{
+  GIVEN("A DISPATCH_BUFFER with two loads whose IDs are far apart")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)
+                   .dispatch_width(champsim::bandwidth::maximum_type{2})
+                   .rob_size(2)
+                   .lq_size(2)};
+
+    // Cores that share a trace draw their IDs from the same counter
+    auto first = champsim::test::instruction_with_ip_and_source_memory(champsim::address{2000}, champsim::address{0xcafe0000});
+    first.instr_id = 10;
+    auto second = champsim::test::instruction_with_ip_and_source_memory(champsim::address{2004}, champsim::address{0xbeef0000});
+    second.instr_id = 30;
+
+    uut.DISPATCH_BUFFER.push_back(first);
+    uut.DISPATCH_BUFFER.push_back(second);
+    for (auto& instr : uut.DISPATCH_BUFFER)
+      instr.ready_time = champsim::chrono::clock::time_point{};
+
+    WHEN("The instructions run to retirement")
+    {
+      for (int i = 0; i < 100 && uut.num_retired < 2; ++i) {
+        for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+          op->_operate();
+      }
+
+      THEN("Both loads were returned to their instructions")
+      {
+        REQUIRE(uut.num_retired == 2);
+        REQUIRE(std::empty(uut.ROB));
+        REQUIRE(mock_L1D.packet_count() == 2);
+      }
+    }
+  }
+}
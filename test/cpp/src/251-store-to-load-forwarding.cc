@@ -0,0 +1,82 @@
+#include <catch.hpp>
+
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+
+namespace
+{
+ooo_model_instr store_with_id(uint64_t id, champsim::address dmem)
+{
+  auto instr = champsim::test::instruction_with_ip(champsim::address{2000 + 4 * id});
+  instr.destination_memory.push_back(dmem);
+  instr.instr_id = id;
+  return instr;
+}
+
+ooo_model_instr load_with_id(uint64_t id, champsim::address smem)
+{
+  auto instr = champsim::test::instruction_with_ip_and_source_memory(champsim::address{2000 + 4 * id}, smem);
+  instr.instr_id = id;
+  return instr;
+}
+} // namespace
+
+SCENARIO("A load waits on the youngest prior store to its address")
+{
+  GIVEN("A DISPATCH_BUFFER with two stores to an address, a store to another address, and a load from the first address")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)
+                   .dispatch_width(champsim::bandwidth::maximum_type{4})
+                   .rob_size(4)
+                   .lq_size(2)
+                   .sq_size(3)};
+
+    uut.DISPATCH_BUFFER.push_back(store_with_id(1, champsim::address{0xcafe0000}));
+    uut.DISPATCH_BUFFER.push_back(store_with_id(2, champsim::address{0xcafe0000}));
+    uut.DISPATCH_BUFFER.push_back(store_with_id(3, champsim::address{0xbeef0000}));
+    uut.DISPATCH_BUFFER.push_back(load_with_id(4, champsim::address{0xcafe0000}));
+    for (auto& instr : uut.DISPATCH_BUFFER)
+      instr.ready_time = champsim::chrono::clock::time_point{};
+
+    WHEN("The instructions are dispatched")
+    {
+      for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+        op->_operate();
+
+      THEN("The load waits on the younger store to its address")
+      {
+        REQUIRE(std::size(uut.ROB) == 4);
+        REQUIRE(std::size(uut.SQ) == 3);
+        REQUIRE(uut.LQ.at(0).has_value());
+        REQUIRE(uut.LQ.at(0)->producer_id == 2);
+        REQUIRE(std::size(uut.SQ.at(1).lq_depend_on_me) == 1);
+        REQUIRE(std::empty(uut.SQ.at(0).lq_depend_on_me));
+        REQUIRE(std::size(uut.LQ_free_slots) == 1);
+      }
+
+      AND_WHEN("The stores execute")
+      {
+        for (int i = 0; i < 100 && !uut.ROB.at(1).executed; ++i) {
+          for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+            op->_operate();
+        }
+        for (int i = 0; i < 10; ++i) {
+          for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+            op->_operate();
+        }
+
+        THEN("The load is forwarded from the store and its LQ entry is freed")
+        {
+          REQUIRE_FALSE(uut.LQ.at(0).has_value());
+          REQUIRE(std::size(uut.LQ_free_slots) == 2);
+          REQUIRE(std::empty(uut.LQ_by_instr));
+          REQUIRE(std::empty(uut.LQ_by_block));
+        }
+      }
+    }
+  }
+}
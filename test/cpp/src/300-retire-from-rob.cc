@@ -83,6 +83,7 @@ SCENARIO("Completed instructions are retired in order")
     do_nothing_MRC mock_L1I, mock_L1D;
     constexpr long retire_bandwidth = 2;
     O3_CPU uut{champsim::core_builder{}
+                   .rob_size(retire_bandwidth)
                    .retire_width(champsim::bandwidth::maximum_type{retire_bandwidth})
                    .fetch_queues(&mock_L1I.queues)
                    .data_queues(&mock_L1D.queues)};
@@ -134,6 +135,7 @@ SCENARIO("The retire bandwidth limits the number of retirements per cycle")
     constexpr long retire_bandwidth = 1;
     constexpr long num_instrs = 2 * retire_bandwidth;
     O3_CPU uut{champsim::core_builder{}
+                   .rob_size(num_instrs)
                    .retire_width(champsim::bandwidth::maximum_type{retire_bandwidth})
                    .fetch_queues(&mock_L1I.queues)
                    .data_queues(&mock_L1D.queues)};
@@ -321,3 +321,51 @@ SCENARIO("Translating cache queues forward RQ virtual to physical RQ")
     }
   }
 }
+
+SCENARIO("Cache queues merge into the oldest packet to the same block")
+{
+  GIVEN("A read queue that holds packets to two blocks")
+  {
+    champsim::address address_a{0xdeadbeef};
+    champsim::address address_b{0xcafebabe};
+    champsim::channel uut{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+
+    issue(uut, address_a, issue_rq<champsim::channel>);
+    issue(uut, address_b, issue_rq<champsim::channel>);
+    uut.check_collision();
+
+    WHEN("Packets to both blocks and to a third block arrive")
+    {
+      champsim::address address_c{0xfeedf00d};
+      issue(uut, address_b, issue_rq<champsim::channel>);
+      issue(uut, address_c, issue_rq<champsim::channel>);
+      issue(uut, address_a, issue_rq<champsim::channel>);
+      uut.check_collision();
+
+      THEN("Only the packet to the new block remains")
+      {
+        REQUIRE(uut.rq_occupancy() == 3);
+        CHECK(uut.RQ.at(0).address == address_a);
+        CHECK(uut.RQ.at(1).address == address_b);
+        CHECK(uut.RQ.at(2).address == address_c);
+        CHECK(uut.sim_stats.RQ_MERGED == 2);
+      }
+    }
+
+    WHEN("The oldest packet is drained and another packet to its block arrives")
+    {
+      uut.RQ.pop_front();
+      issue(uut, address_b, issue_rq<champsim::channel>);
+      issue(uut, address_a, issue_rq<champsim::channel>);
+      uut.check_collision();
+
+      THEN("The packet to the drained block is not merged")
+      {
+        REQUIRE(uut.rq_occupancy() == 2);
+        CHECK(uut.RQ.at(0).address == address_b);
+        CHECK(uut.RQ.at(1).address == address_a);
+        CHECK(uut.sim_stats.RQ_MERGED == 1);
+      }
+    }
+  }
+}
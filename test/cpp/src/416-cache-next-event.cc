@@ -0,0 +1,74 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+SCENARIO("A cache reports when it next needs to be operated")
+{
+  GIVEN("An empty cache")
+  {
+    constexpr auto hit_latency = 4;
+    release_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("416-uut")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .hit_latency(hit_latency)
+                  .fill_latency(2)
+                  .prefetch_activate(access_type::LOAD)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    THEN("It has no event of its own") { REQUIRE(uut.next_event_time() == champsim::chrono::clock::time_point::max()); }
+
+    WHEN("A packet is issued")
+    {
+      decltype(mock_ul)::request_type test;
+      test.address = champsim::address{0xdeadbeef};
+      test.cpu = 0;
+      test.type = access_type::LOAD;
+      auto test_result = mock_ul.issue(test);
+      REQUIRE(test_result);
+
+      THEN("It must be operated in the next cycle") { REQUIRE(uut.next_event_time() == uut.current_time + uut.clock_period); }
+
+      AND_WHEN("The packet is being checked")
+      {
+        for (auto elem : elements)
+          elem->_operate();
+
+        THEN("The next event is the end of the tag check")
+        {
+          REQUIRE(uut.next_event_time() > uut.current_time + uut.clock_period);
+          REQUIRE(uut.next_event_time() <= uut.current_time + hit_latency * uut.clock_period);
+        }
+      }
+
+      AND_WHEN("The packet waits on the lower level")
+      {
+        for (uint64_t i = 0; i < hit_latency + 2; ++i)
+          for (auto elem : elements)
+            elem->_operate();
+
+        REQUIRE(mock_ll.packet_count() == 1);
+
+        THEN("It has no event of its own") { REQUIRE(uut.next_event_time() == champsim::chrono::clock::time_point::max()); }
+
+        AND_WHEN("The lower level returns the packet")
+        {
+          mock_ll.release_all();
+
+          THEN("It must be operated in the next cycle") { REQUIRE(uut.next_event_time() == uut.current_time + uut.clock_period); }
+        }
+      }
+    }
+  }
+}
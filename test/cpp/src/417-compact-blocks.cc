@@ -0,0 +1,112 @@
+#include <catch.hpp>
+
+#include <sstream>
+
+#include "cache.h"
+#include "defaults.hpp"
+
+namespace
+{
+champsim::channel::request_type translated_request(uint64_t address, access_type type)
+{
+  champsim::channel::request_type packet;
+  packet.address = champsim::address{address};
+  packet.v_address = packet.address;
+  packet.data = champsim::address{0x1000};
+  packet.cpu = 0;
+  packet.type = type;
+  return packet;
+}
+
+champsim::channel::response_type response_to(const champsim::channel::request_type& packet) { return champsim::channel::response_type{packet}; }
+} // namespace
+
+SCENARIO("A cache with compact blocks holds the same blocks as one with full blocks")
+{
+  GIVEN("A one-way cache with compact blocks")
+  {
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}.name("417-uut").sets(1).ways(1).set_compact_blocks()};
+    uut.initialize();
+    uut.warmup = true;
+    uut.begin_phase();
+
+    THEN("It holds no full blocks") { CHECK(std::empty(uut.block)); }
+
+    WHEN("A block is stored to")
+    {
+      auto store = translated_request(0xdeadbeef, access_type::WRITE);
+      REQUIRE_FALSE(uut.functional_fill(store, response_to(store), false).has_value());
+
+      THEN("A load to the block hits")
+      {
+        auto load = translated_request(0xdeadbec0, access_type::LOAD);
+        REQUIRE(uut.functional_lookup(load, false).has_value());
+
+        AND_THEN("The data of the block is not held")
+        {
+          CHECK(uut.functional_lookup(load, false)->data == champsim::address{});
+        }
+      }
+
+      AND_WHEN("Another block is filled")
+      {
+        auto load = translated_request(0xcafebabe, access_type::LOAD);
+        auto writeback = uut.functional_fill(load, response_to(load), false);
+
+        THEN("The stored block is written back from its first byte")
+        {
+          REQUIRE(writeback.has_value());
+          CHECK(writeback->address == champsim::address{0xdeadbec0});
+        }
+      }
+
+      AND_WHEN("The block is invalidated")
+      {
+        CHECK(uut.invalidate_entry(champsim::address{0xdeadbeef}) == 0);
+
+        THEN("A load to the block misses")
+        {
+          CHECK_FALSE(uut.functional_lookup(translated_request(0xdeadbeef, access_type::LOAD), false).has_value());
+        }
+      }
+
+      AND_WHEN("The cache is checkpointed and restored into another")
+      {
+        std::stringstream checkpoint;
+        uut.save_checkpoint(checkpoint);
+
+        CACHE restored{champsim::cache_builder{champsim::defaults::default_l1d}.name("417-restored").sets(1).ways(1).set_compact_blocks()};
+        restored.initialize();
+        restored.warmup = true;
+        restored.begin_phase();
+        restored.restore_checkpoint(checkpoint);
+
+        THEN("The restored cache holds the block")
+        {
+          CHECK(restored.functional_lookup(translated_request(0xdeadbeef, access_type::LOAD), false).has_value());
+        }
+      }
+    }
+  }
+
+  GIVEN("A one-way cache with compact translation blocks")
+  {
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_dtlb}.name("417-tlb").sets(1).ways(1).set_compact_translation_blocks()};
+    uut.initialize();
+    uut.warmup = true;
+    uut.begin_phase();
+
+    WHEN("A translation is filled")
+    {
+      auto load = translated_request(0xdeadbeef, access_type::LOAD);
+      REQUIRE_FALSE(uut.functional_fill(load, response_to(load), false).has_value());
+
+      THEN("A lookup returns the translation")
+      {
+        auto found = uut.functional_lookup(load, false);
+        REQUIRE(found.has_value());
+        CHECK(found->data == champsim::address{0x1000});
+      }
+    }
+  }
+}
@@ -1,5 +1,6 @@
 #include <catch.hpp>
 #include <numeric>
+#include <sstream>
 
 #include "../../../prefetcher/va_ampm_lite/va_ampm_lite.h"
 #include "cache.h"
@@ -93,6 +94,40 @@ SCENARIO("The va_ampm_lite prefetcher issues prefetches when addresses stride in
   }
 }
 
+SCENARIO("The regions of the va_ampm_lite prefetcher survive a checkpoint")
+{
+  GIVEN("A prefetcher that has seen an access and issued a prefetch")
+  {
+    va_ampm_lite original{nullptr};
+    champsim::block_number accessed{0xdeadbeef};
+    champsim::block_number prefetched{accessed + 1};
+
+    auto offset_in_page = [](champsim::block_number block) {
+      return block.to<std::size_t>() % (PAGE_SIZE / BLOCK_SIZE);
+    };
+    va_ampm_lite::region_type region{champsim::page_number{accessed}};
+    region.access_map.at(offset_in_page(accessed)) = true;
+    region.prefetch_map.at(offset_in_page(prefetched)) = true;
+    original.regions.fill(region);
+
+    WHEN("The prefetcher is saved and restored into a new prefetcher")
+    {
+      std::stringstream checkpoint;
+      original.prefetcher_save_checkpoint(checkpoint);
+
+      va_ampm_lite restored{nullptr};
+      restored.prefetcher_restore_checkpoint(checkpoint);
+
+      THEN("The access and the prefetch are remembered")
+      {
+        REQUIRE(restored.check_cl_access(accessed));
+        REQUIRE(restored.check_cl_prefetch(prefetched));
+        REQUIRE_FALSE(restored.check_cl_access(prefetched));
+      }
+    }
+  }
+}
+
 TEST_CASE("va_ampm_lite benchmark")
 {
   BENCHMARK_ADVANCED("va_ampm_lite::prefetcher_initialize()")(Catch::Benchmark::Chronometer meter)
@@ -0,0 +1,105 @@
+#include <catch.hpp>
+
+#include "defaults.hpp"
+#include "dram_controller.h"
+
+namespace
+{
+struct dram_run_result {
+  std::vector<champsim::chrono::clock::time_point> return_times{};
+  dram_stats stats{};
+  long operations = 0;
+};
+
+dram_run_result run_reads(bool skip_idle, const std::vector<uint64_t>& addresses)
+{
+  const auto clock_period = champsim::chrono::picoseconds{3200};
+  champsim::channel ul{};
+  MEMORY_CONTROLLER uut{clock_period,
+                        clock_period * 2,
+                        2,
+                        2,
+                        38,
+                        4,
+                        champsim::chrono::microseconds{64000},
+                        {&ul},
+                        64,
+                        64,
+                        1,
+                        champsim::data::bytes{8},
+                        65536,
+                        128,
+                        8,
+                        2,
+                        8,
+                        8192};
+  uut.warmup = false;
+  uut.channels[0].warmup = false;
+  uut.initialize();
+  uut.begin_phase();
+
+  for (auto addr : addresses) {
+    champsim::channel::request_type r;
+    r.type = access_type::LOAD;
+    r.address = champsim::address{addr};
+    r.v_address = champsim::address{addr};
+    r.response_requested = true;
+    ul.add_rq(r);
+  }
+
+  // Run past the first two refreshes
+  dram_run_result result{};
+  const auto end = champsim::chrono::clock::time_point{} + champsim::chrono::microseconds{20};
+  while (uut.current_time < end) {
+    auto progress = uut._operate();
+    ++result.operations;
+    for (std::size_t i = 0; i < std::size(ul.returned); ++i) {
+      result.return_times.push_back(uut.current_time);
+    }
+    ul.returned.clear();
+
+    if (skip_idle && progress == 0) {
+      // Skip every cycle that comes strictly before the next event
+      auto next_event = std::min(uut.next_event_time(), end);
+      if (next_event > uut.current_time) {
+        uut._skip(static_cast<long>((next_event - uut.current_time - champsim::chrono::picoseconds{1}) / uut.clock_period));
+      }
+    }
+  }
+
+  result.stats = uut.channels[0].sim_stats;
+  return result;
+}
+} // namespace
+
+SCENARIO("A memory controller skipped over its idle cycles behaves as if it had been operated")
+{
+  GIVEN("Reads to a mix of banks and rows")
+  {
+    std::vector<uint64_t> addresses{0x0, 0x40, 0x1000, 0x21000, 0x400000, 0x400040, 0x8001000};
+
+    WHEN("The memory controller is run with and without skipping idle cycles")
+    {
+      auto operated = run_reads(false, addresses);
+      auto skipped = run_reads(true, addresses);
+
+      THEN("Every read returns at the same time")
+      {
+        REQUIRE(std::size(operated.return_times) == std::size(addresses));
+        REQUIRE(operated.return_times == skipped.return_times);
+      }
+
+      THEN("The statistics are the same")
+      {
+        CHECK(skipped.stats.dbus_cycle_congested == operated.stats.dbus_cycle_congested);
+        CHECK(skipped.stats.dbus_count_congested == operated.stats.dbus_count_congested);
+        CHECK(skipped.stats.refresh_cycles == operated.stats.refresh_cycles);
+        CHECK(skipped.stats.RQ_ROW_BUFFER_HIT == operated.stats.RQ_ROW_BUFFER_HIT);
+        CHECK(skipped.stats.RQ_ROW_BUFFER_MISS == operated.stats.RQ_ROW_BUFFER_MISS);
+        CHECK(operated.stats.refresh_cycles > 0);
+      }
+
+      THEN("Fewer cycles are operated") { REQUIRE(skipped.operations < operated.operations); }
+    }
+  }
+}
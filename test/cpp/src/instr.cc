@@ -55,6 +55,18 @@ ooo_model_instr champsim::test::instruction_with_registers(uint8_t reg)
   return ooo_model_instr{0, i};
 }
 
+ooo_model_instr champsim::test::instruction_with_register_value(uint8_t reg, uint64_t value)
+{
+  value_instr i{};
+  i.ip = 1;
+  i.version = champsim::VALUE_TRACE_VERSION;
+
+  i.destination_registers[0] = reg;
+  i.source_registers[0] = reg;
+  i.destination_register_values[0] = value;
+  return ooo_model_instr{0, i};
+}
+
 ooo_model_instr champsim::test::instruction_with_ip_and_source_memory(champsim::address ip, champsim::address smem)
 {
   input_instr i;
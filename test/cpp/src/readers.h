@@ -0,0 +1,64 @@
+#ifndef TEST_READERS_H
+#define TEST_READERS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "instruction.h"
+#include "trace_instruction.h"
+
+namespace champsim::test
+{
+/**
+ * A trace reader of the given number of instructions, whose IPs count up from zero.
+ * If it is given a counter, it counts the instructions that it decodes.
+ */
+struct counting_reader {
+  uint64_t next = 0;
+  uint64_t length = 100;
+  std::size_t* decoded = nullptr;
+
+  ooo_model_instr operator()()
+  {
+    if (decoded != nullptr) {
+      ++(*decoded);
+    }
+    input_instr instr{};
+    instr.ip = next++;
+    return ooo_model_instr{0, instr};
+  }
+
+  [[nodiscard]] bool eof() const { return next >= length; }
+};
+
+/**
+ * Bytes that do not repeat within any small block, so that a read from the wrong offset is noticed.
+ */
+inline std::string counting_bytes(std::size_t length)
+{
+  std::string retval(length, '\0');
+  for (std::size_t i = 0; i < length; ++i) {
+    retval[i] = static_cast<char>(i % 251);
+  }
+  return retval;
+}
+
+/**
+ * Read the stream until its end.
+ */
+template <typename Stream>
+std::string read_rest(Stream& strm)
+{
+  std::string retval;
+  std::array<char, 1000> buffer;
+  do {
+    strm.read(std::data(buffer), std::size(buffer));
+    retval.append(std::data(buffer), static_cast<std::size_t>(strm.gcount()));
+  } while (!strm.eof());
+  return retval;
+}
+} // namespace champsim::test
+
+#endif
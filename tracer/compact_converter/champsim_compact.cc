@@ -0,0 +1,144 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../../inc/compact_trace.h"
+#include "../../inc/inf_stream.h"
+
+namespace
+{
+template <typename F>
+void encode(F& source, std::ostream& dest)
+{
+  champsim::compact::encoder encoder;
+  std::vector<unsigned char> out{std::begin(champsim::compact::magic), std::end(champsim::compact::magic)};
+
+  std::array<input_instr, 1 << 12> records;
+  do {
+    source.read(reinterpret_cast<char*>(std::data(records)), sizeof(records)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    auto count = static_cast<std::size_t>(source.gcount()) / sizeof(input_instr);
+    for (std::size_t i = 0; i < count; ++i) {
+      encoder.encode(records[i], out);
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    dest.write(reinterpret_cast<const char*>(std::data(out)), static_cast<std::streamsize>(std::size(out)));
+    out.clear();
+  } while (!source.eof() && source.gcount() > 0);
+}
+
+template <typename F>
+void decode(F& source, std::ostream& dest)
+{
+  champsim::compact::decoder decoder;
+  std::vector<unsigned char> raw(std::size(champsim::compact::magic));
+  source.read(reinterpret_cast<char*>(std::data(raw)), static_cast<std::streamsize>(std::size(raw))); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (static_cast<std::size_t>(source.gcount()) != std::size(raw) || !std::equal(std::begin(raw), std::end(raw), std::begin(champsim::compact::magic))) {
+    throw std::runtime_error{"Input is not a compact trace"};
+  }
+  raw.clear();
+
+  constexpr std::size_t read_size = 1 << 16;
+  do {
+    auto old_size = std::size(raw);
+    raw.resize(old_size + read_size);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    source.read(reinterpret_cast<char*>(std::data(raw) + old_size), static_cast<std::streamsize>(read_size));
+    raw.resize(old_size + static_cast<std::size_t>(source.gcount()));
+
+    std::size_t decoded_bytes = 0;
+    const auto* raw_end = std::data(raw) + std::size(raw);
+    for (auto decoded = decoder.decode(std::data(raw), raw_end); decoded.has_value(); decoded = decoder.decode(std::data(raw) + decoded_bytes, raw_end)) {
+      dest.write(reinterpret_cast<const char*>(&decoded->first), sizeof(input_instr)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      decoded_bytes += decoded->second;
+    }
+    raw.erase(std::begin(raw), std::next(std::begin(raw), static_cast<std::ptrdiff_t>(decoded_bytes)));
+  } while (!source.eof() && source.gcount() > 0);
+
+  if (!std::empty(raw)) {
+    throw std::runtime_error{"Compact trace ends in a partial record"};
+  }
+}
+
+bool ends_with(std::string_view name, std::string_view suffix)
+{
+  return name.size() >= suffix.size() && name.substr(name.size() - suffix.size()) == suffix;
+}
+
+template <typename F>
+void convert_stream(F& source, bool to_compact)
+{
+  if (to_compact) {
+    encode(source, std::cout);
+  } else {
+    decode(source, std::cout);
+  }
+}
+
+void convert(const std::string& input, bool to_compact)
+{
+  if (ends_with(input, "xz")) {
+    champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<>> source{input};
+    convert_stream(source, to_compact);
+  } else if (ends_with(input, "gz")) {
+    champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>> source{input};
+    convert_stream(source, to_compact);
+  } else if (ends_with(input, "bz2")) {
+    champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t> source{input};
+    convert_stream(source, to_compact);
+  } else if (ends_with(input, "zst")) {
+    champsim::inf_istream<champsim::decomp_tags::zstd_tag_t<>> source{input};
+    convert_stream(source, to_compact);
+  } else {
+    std::ifstream source{input, std::ios::binary};
+    convert_stream(source, to_compact);
+  }
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+  bool to_compact = true;
+  int argi = 1;
+  if (argc > 1 && std::strcmp(argv[argi], "-d") == 0) {
+    to_compact = false;
+    ++argi;
+  }
+
+  if (argc - argi != 1) {
+    std::cerr << "usage: " << argv[0] << " [-d] INPUT_TRACE\n";
+    return 1;
+  }
+
+  try {
+    ::convert(argv[argi], to_compact);
+  } catch (const std::exception& e) {
+    std::cerr << argv[argi] << ": " << e.what() << '\n';
+    return 1;
+  }
+
+  std::cout.flush();
+  return std::cout.good() ? 0 : 1;
+}
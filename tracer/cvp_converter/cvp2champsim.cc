@@ -40,8 +40,11 @@
 
 bool verbose = false;
 
-// use non-cloudsuite ChampSim trace format
-using trace_instr_format = input_instr;
+// emit the value-carrying trace format instead of the legacy one
+bool emit_values = false;
+
+// records are built in the value-carrying format and cut down to input_instr unless -V is given
+using trace_instr_format = value_instr;
 
 // orginal instruction types from CVP-1 traces
 
@@ -205,6 +208,42 @@ struct trace {
   }
 };
 
+// write a record in whichever format was requested
+
+void write_instr(const trace_instr_format& ct)
+{
+  if (emit_values) {
+    fwrite(&ct, sizeof(ct), 1, stdout);
+    return;
+  }
+
+  input_instr legacy;
+  legacy.ip = ct.ip;
+  legacy.is_branch = ct.is_branch;
+  legacy.branch_taken = ct.branch_taken;
+  memcpy(legacy.destination_registers, ct.destination_registers, sizeof(legacy.destination_registers));
+  memcpy(legacy.source_registers, ct.source_registers, sizeof(legacy.source_registers));
+  memcpy(legacy.destination_memory, ct.destination_memory, sizeof(legacy.destination_memory));
+  memcpy(legacy.source_memory, ct.source_memory, sizeof(legacy.source_memory));
+  fwrite(&legacy, sizeof(legacy), 1, stdout);
+}
+
+// clear the operands and values of a record
+
+void clear_instr(trace_instr_format& ct)
+{
+  memset(ct.destination_registers, 0, sizeof(ct.destination_registers));
+  memset(ct.source_registers, 0, sizeof(ct.source_registers));
+  memset(ct.destination_memory, 0, sizeof(ct.destination_memory));
+  memset(ct.source_memory, 0, sizeof(ct.source_memory));
+  ct.version = champsim::VALUE_TRACE_VERSION;
+  memset(ct.destination_memory_size, 0, sizeof(ct.destination_memory_size));
+  memset(ct.source_memory_size, 0, sizeof(ct.source_memory_size));
+  memset(ct.destination_register_values, 0, sizeof(ct.destination_register_values));
+  memset(ct.destination_memory_values, 0, sizeof(ct.destination_memory_values));
+  memset(ct.source_memory_values, 0, sizeof(ct.source_memory_values));
+}
+
 // is this a branch type?
 
 bool is_branch(InstClass t) { return (t == uncondIndirectBranchInstClass || t == uncondDirectBranchInstClass || t == condBranchInstClass); }
@@ -364,6 +403,8 @@ int main(int argc, char** argv)
   for (int i = 1; i < argc; i++) {
     if (!strcmp(argv[i], "-v"))
       verbose = true;
+    else if (!strcmp(argv[i], "-V"))
+      emit_values = true;
     else
       strcpy(tracefilename, argv[i]);
   }
@@ -467,10 +508,7 @@ int main(int argc, char** argv)
 
       // OK now make a branch instruction out of this bad boy
 
-      memset(ct.destination_registers, 0, sizeof(ct.destination_registers));
-      memset(ct.source_registers, 0, sizeof(ct.source_registers));
-      memset(ct.destination_memory, 0, sizeof(ct.destination_memory));
-      memset(ct.source_memory, 0, sizeof(ct.source_memory));
+      clear_instr(ct);
       switch (c) {
       case OPTYPE_JMP_DIRECT_UNCOND:
         // writes IP only
@@ -518,12 +556,12 @@ int main(int argc, char** argv)
       default:
         assert(0);
       }
-      fwrite(&ct, sizeof(ct), 1, stdout); // write a branch trace
+
+      // the IP is always the first destination; its new value is the target (or the fallthrough)
+      ct.destination_register_values[0] = t.target;
+      write_instr(ct); // write a branch trace
     } else {
-      memset(ct.destination_registers, 0, sizeof(ct.destination_registers));
-      memset(ct.source_registers, 0, sizeof(ct.source_registers));
-      memset(ct.destination_memory, 0, sizeof(ct.destination_memory));
-      memset(ct.source_memory, 0, sizeof(ct.source_memory));
+      clear_instr(ct);
       counts[OPTYPE_OP]++;
       if (t.num_input_regs > NUM_INSTR_SOURCES)
         t.num_input_regs = NUM_INSTR_SOURCES;
@@ -543,6 +581,7 @@ int main(int argc, char** argv)
         if (x == 0)
           x = 67;
         ct.destination_registers[a] = x;
+        ct.destination_register_values[a] = t.output_reg_values[a][0];
         for (int i = 0; i < t.num_input_regs; i++) {
           int x = t.input_reg_names[i];
           if (x == champsim::REG_INSTRUCTION_POINTER)
@@ -558,9 +597,14 @@ int main(int argc, char** argv)
         switch (t.type) {
         case loadInstClass:
           ct.source_memory[0] = transform(t.EA);
+          ct.source_memory_size[0] = t.access_size;
+          // the loaded value is what lands in the destination register
+          ct.source_memory_values[0] = t.output_reg_values[a][0];
           break;
         case storeInstClass:
+          // CVP traces do not record store data, so only the size is known
           ct.destination_memory[0] = transform(t.EA);
+          ct.destination_memory_size[0] = t.access_size;
           break;
         case aluInstClass:
         case fpInstClass:
@@ -572,7 +616,7 @@ int main(int argc, char** argv)
         case undefInstClass:
           assert(0);
         }
-        fwrite(&ct, sizeof(ct), 1, stdout); // write a non-branch trace
+        write_instr(ct); // write a non-branch trace
       }
     }
 
@@ -580,8 +624,8 @@ int main(int argc, char** argv)
 
     for (int i = 0; i < t.num_output_regs; i++) {
       int x = t.output_reg_names[i];
-      registers[x][0] = t.output_reg_values[x][0];
-      registers[x][1] = t.output_reg_values[x][1];
+      registers[x][0] = t.output_reg_values[i][0];
+      registers[x][1] = t.output_reg_values[i][1];
     }
     if (verbose) {
       static long long int n = 0;
@@ -19,6 +19,7 @@
  *  and could serve as the starting point for developing your first PIN tool
  */
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <stdlib.h>
@@ -28,7 +29,8 @@
 #include "../../inc/trace_instruction.h"
 #include "pin.H"
 
-using trace_instr_format_t = input_instr;
+// records are built in the value-carrying format and cut down to input_instr unless -v is given
+using trace_instr_format_t = value_instr;
 
 /* ================================================================== */
 // Global variables
@@ -49,6 +51,8 @@ KNOB<UINT64> KnobSkipInstructions(KNOB_MODE_WRITEONCE, "pintool", "s", "0", "How
 
 KNOB<UINT64> KnobTraceInstructions(KNOB_MODE_WRITEONCE, "pintool", "t", "1000000", "How many instructions to trace");
 
+KNOB<BOOL> KnobValues(KNOB_MODE_WRITEONCE, "pintool", "v", "0", "Emit the value-carrying trace format");
+
 /* ===================================================================== */
 // Utilities
 /* ===================================================================== */
@@ -62,6 +66,7 @@ INT32 Usage()
             << "Specify the output trace file with -o" << std::endl
             << "Specify the number of instructions to skip before tracing with -s" << std::endl
             << "Specify the number of instructions to trace with -t" << std::endl
+            << "Emit register values, load/store data, and access sizes with -v" << std::endl
             << std::endl;
 
   std::cerr << KNOB_BASE::StringKnobSummary() << std::endl;
@@ -77,6 +82,7 @@ void ResetCurrentInstruction(VOID* ip)
 {
   curr_instr = {};
   curr_instr.ip = (unsigned long long int)ip;
+  curr_instr.version = champsim::VALUE_TRACE_VERSION;
 }
 
 BOOL ShouldWrite()
@@ -88,8 +94,21 @@ BOOL ShouldWrite()
 void WriteCurrentInstruction()
 {
   typename decltype(outfile)::char_type buf[sizeof(trace_instr_format_t)];
-  std::memcpy(buf, &curr_instr, sizeof(trace_instr_format_t));
-  outfile.write(buf, sizeof(trace_instr_format_t));
+  if (KnobValues.Value()) {
+    std::memcpy(buf, &curr_instr, sizeof(trace_instr_format_t));
+    outfile.write(buf, sizeof(trace_instr_format_t));
+  } else {
+    input_instr legacy;
+    legacy.ip = curr_instr.ip;
+    legacy.is_branch = curr_instr.is_branch;
+    legacy.branch_taken = curr_instr.branch_taken;
+    std::copy(std::begin(curr_instr.destination_registers), std::end(curr_instr.destination_registers), std::begin(legacy.destination_registers));
+    std::copy(std::begin(curr_instr.source_registers), std::end(curr_instr.source_registers), std::begin(legacy.source_registers));
+    std::copy(std::begin(curr_instr.destination_memory), std::end(curr_instr.destination_memory), std::begin(legacy.destination_memory));
+    std::copy(std::begin(curr_instr.source_memory), std::end(curr_instr.source_memory), std::begin(legacy.source_memory));
+    std::memcpy(buf, &legacy, sizeof(input_instr));
+    outfile.write(buf, sizeof(input_instr));
+  }
 }
 
 void BranchOrNot(UINT32 taken)
@@ -106,6 +125,44 @@ void WriteToSet(T* begin, T* end, UINT32 r)
   *found_reg = r;
 }
 
+// Record the value of a destination register in the slot that WriteToSet gave it
+void WriteRegisterValue(UINT32 r, ADDRINT value)
+{
+  auto begin = std::begin(curr_instr.destination_registers);
+  auto found_reg = std::find(begin, std::end(curr_instr.destination_registers), (unsigned char)r);
+  if (found_reg != std::end(curr_instr.destination_registers))
+    curr_instr.destination_register_values[std::distance(begin, found_reg)] = value;
+}
+
+// Record the size of a memory access in the slot that WriteToSet gave its address
+void WriteMemorySize(unsigned long long* begin, unsigned long long* end, unsigned char* sizes, ADDRINT ea, UINT32 size)
+{
+  auto found_addr = std::find(begin, end, ea);
+  if (found_addr != end)
+    sizes[std::distance(begin, found_addr)] = (unsigned char)size;
+}
+
+// Copy up to eight bytes from each recorded address into the matching value slot
+void ReadMemoryValues(unsigned long long* begin, unsigned long long* end, unsigned char* sizes, unsigned long long* values)
+{
+  for (auto addr = begin; addr != end && *addr != 0; ++addr) {
+    auto idx = std::distance(begin, addr);
+    values[idx] = 0;
+    PIN_SafeCopy(&values[idx], (VOID*)*addr, std::min<std::size_t>(sizes[idx], sizeof(values[idx])));
+  }
+}
+
+void ReadLoadValues()
+{
+  ReadMemoryValues(curr_instr.source_memory, curr_instr.source_memory + NUM_INSTR_SOURCES, curr_instr.source_memory_size, curr_instr.source_memory_values);
+}
+
+void ReadStoreValues()
+{
+  ReadMemoryValues(curr_instr.destination_memory, curr_instr.destination_memory + NUM_INSTR_DESTINATIONS, curr_instr.destination_memory_size,
+                   curr_instr.destination_memory_values);
+}
+
 /* ===================================================================== */
 // Instrumentation callbacks
 /* ===================================================================== */
@@ -149,9 +206,44 @@ VOID Instruction(INS ins, VOID* v)
                      curr_instr.destination_memory + NUM_INSTR_DESTINATIONS, IARG_MEMORYOP_EA, memOp, IARG_END);
   }
 
-  // finalize each instruction with this function
-  INS_InsertIfCall(ins, IPOINT_BEFORE, (AFUNPTR)ShouldWrite, IARG_END);
-  INS_InsertThenCall(ins, IPOINT_BEFORE, (AFUNPTR)WriteCurrentInstruction, IARG_END);
+  if (!KnobValues.Value()) {
+    // finalize each instruction with this function
+    INS_InsertIfCall(ins, IPOINT_BEFORE, (AFUNPTR)ShouldWrite, IARG_END);
+    INS_InsertThenCall(ins, IPOINT_BEFORE, (AFUNPTR)WriteCurrentInstruction, IARG_END);
+    return;
+  }
+
+  // record the size of each memory access, and the loaded data before the instruction can overwrite it
+  for (UINT32 memOp = 0; memOp < memOperands; memOp++) {
+    UINT32 size = INS_MemoryOperandSize(ins, memOp);
+    if (INS_MemoryOperandIsRead(ins, memOp))
+      INS_InsertCall(ins, IPOINT_BEFORE, (AFUNPTR)WriteMemorySize, IARG_PTR, curr_instr.source_memory, IARG_PTR, curr_instr.source_memory + NUM_INSTR_SOURCES,
+                     IARG_PTR, curr_instr.source_memory_size, IARG_MEMORYOP_EA, memOp, IARG_UINT32, size, IARG_END);
+    if (INS_MemoryOperandIsWritten(ins, memOp))
+      INS_InsertCall(ins, IPOINT_BEFORE, (AFUNPTR)WriteMemorySize, IARG_PTR, curr_instr.destination_memory, IARG_PTR,
+                     curr_instr.destination_memory + NUM_INSTR_DESTINATIONS, IARG_PTR, curr_instr.destination_memory_size, IARG_MEMORYOP_EA, memOp,
+                     IARG_UINT32, size, IARG_END);
+  }
+  if (INS_IsMemoryRead(ins))
+    INS_InsertCall(ins, IPOINT_BEFORE, (AFUNPTR)ReadLoadValues, IARG_END);
+
+  // values are only known once the instruction has executed, so they are recorded (and the instruction written) on every path out of it
+  for (IPOINT where : {IPOINT_AFTER, IPOINT_TAKEN_BRANCH}) {
+    if ((where == IPOINT_AFTER && !INS_IsValidForIpointAfter(ins)) || (where == IPOINT_TAKEN_BRANCH && !INS_IsValidForIpointTakenBranch(ins)))
+      continue;
+
+    for (UINT32 i = 0; i < writeRegCount; i++) {
+      REG reg = INS_RegW(ins, i);
+      if (REG_valid_for_iarg_reg_value(reg))
+        INS_InsertCall(ins, where, (AFUNPTR)WriteRegisterValue, IARG_UINT32, (UINT32)reg, IARG_REG_VALUE, reg, IARG_END);
+    }
+
+    if (INS_IsMemoryWrite(ins))
+      INS_InsertCall(ins, where, (AFUNPTR)ReadStoreValues, IARG_END);
+
+    INS_InsertIfCall(ins, where, (AFUNPTR)ShouldWrite, IARG_END);
+    INS_InsertThenCall(ins, where, (AFUNPTR)WriteCurrentInstruction, IARG_END);
+  }
 }
 
 /*!
@@ -0,0 +1,193 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <lzma.h>
+#include <zlib.h>
+
+#include "../../inc/inf_stream.h"
+#include "../../inc/trace_index.h"
+#include "../../inc/zstd_seekable.h"
+
+namespace
+{
+bool ends_with(std::string_view name, std::string_view suffix)
+{
+  return name.size() >= suffix.size() && name.substr(name.size() - suffix.size()) == suffix;
+}
+
+// Compress one block as a complete gzip member
+void write_gzip_member(const std::vector<char>& block, std::ostream& dest)
+{
+  z_stream strm{};
+  if (::deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw std::runtime_error{"gzip compression failed"};
+  }
+
+  std::vector<unsigned char> in{std::begin(block), std::end(block)};
+  std::array<unsigned char, 1 << 16> out;
+  strm.next_in = std::data(in);
+  strm.avail_in = static_cast<unsigned>(std::size(in));
+  int ret = Z_OK;
+  do {
+    strm.next_out = std::data(out);
+    strm.avail_out = static_cast<unsigned>(std::size(out));
+    ret = ::deflate(&strm, Z_FINISH);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    dest.write(reinterpret_cast<const char*>(std::data(out)), static_cast<std::streamsize>(std::size(out) - strm.avail_out));
+  } while (ret == Z_OK);
+  ::deflateEnd(&strm);
+
+  if (ret != Z_STREAM_END) {
+    throw std::runtime_error{"gzip compression failed"};
+  }
+}
+
+// Compress one block as a complete xz stream
+void write_xz_stream(const std::vector<char>& block, std::ostream& dest)
+{
+  lzma_stream strm = LZMA_STREAM_INIT;
+  if (::lzma_easy_encoder(&strm, LZMA_PRESET_DEFAULT, LZMA_CHECK_CRC64) != LZMA_OK) {
+    throw std::runtime_error{"xz compression failed"};
+  }
+
+  std::array<uint8_t, 1 << 16> out;
+  strm.next_in = reinterpret_cast<const uint8_t*>(std::data(block)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  strm.avail_in = std::size(block);
+  lzma_ret ret = LZMA_OK;
+  do {
+    strm.next_out = std::data(out);
+    strm.avail_out = std::size(out);
+    ret = ::lzma_code(&strm, LZMA_FINISH);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    dest.write(reinterpret_cast<const char*>(std::data(out)), static_cast<std::streamsize>(std::size(out) - strm.avail_out));
+  } while (ret == LZMA_OK);
+  ::lzma_end(&strm);
+
+  if (ret != LZMA_STREAM_END) {
+    throw std::runtime_error{"xz compression failed"};
+  }
+}
+
+template <typename F>
+champsim::trace_index reblock_stream(F& source, const std::string& output, std::size_t block_instructions, std::size_t record_size)
+{
+  champsim::trace_index index{record_size, {}};
+  std::ofstream dest{output, std::ios::binary};
+  std::vector<char> block(block_instructions * record_size);
+
+  if (ends_with(output, "zst")) {
+    // The seek table of the zstd seekable format holds the same restart points as the index
+    champsim::zstd_seekable_ostream zstd_dest{dest, std::size(block)};
+    do {
+      source.read(std::data(block), static_cast<std::streamsize>(std::size(block)));
+      zstd_dest.write(std::data(block), static_cast<std::size_t>(source.gcount()));
+    } while (!source.eof() && source.gcount() > 0);
+    zstd_dest.close();
+
+    for (const auto& frame : zstd_dest.frame_table()) {
+      index.entries.push_back({frame.decompressed_offset / record_size, frame.compressed_offset});
+    }
+    return index;
+  }
+
+  uint64_t instruction = 0;
+  do {
+    source.read(std::data(block), static_cast<std::streamsize>(std::size(block)));
+    auto bytes_read = static_cast<std::size_t>(source.gcount());
+    if (bytes_read == 0) {
+      break;
+    }
+
+    index.entries.push_back({instruction, static_cast<uint64_t>(dest.tellp())});
+    block.resize(bytes_read);
+    if (ends_with(output, "gz")) {
+      write_gzip_member(block, dest);
+    } else {
+      write_xz_stream(block, dest);
+    }
+    block.resize(block_instructions * record_size);
+    instruction += bytes_read / record_size;
+  } while (!source.eof());
+
+  return index;
+}
+
+champsim::trace_index reblock(const std::string& input, const std::string& output, std::size_t block_instructions, std::size_t record_size)
+{
+  if (ends_with(input, "xz")) {
+    champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<LZMA_CONCATENATED>> source{input};
+    return reblock_stream(source, output, block_instructions, record_size);
+  }
+  if (ends_with(input, "gz")) {
+    champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>> source{input};
+    return reblock_stream(source, output, block_instructions, record_size);
+  }
+  if (ends_with(input, "bz2")) {
+    champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t> source{input};
+    return reblock_stream(source, output, block_instructions, record_size);
+  }
+  if (ends_with(input, "zst")) {
+    champsim::inf_istream<champsim::decomp_tags::zstd_tag_t<>> source{input};
+    return reblock_stream(source, output, block_instructions, record_size);
+  }
+  std::ifstream source{input, std::ios::binary};
+  return reblock_stream(source, output, block_instructions, record_size);
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+  std::size_t block_instructions = 1 << 20;
+  std::size_t record_size = 64; // sizeof(input_instr)
+  int argi = 1;
+  while (argc - argi > 2 && argv[argi][0] == '-') {
+    if (std::strcmp(argv[argi], "-b") == 0) {
+      block_instructions = std::strtoull(argv[argi + 1], nullptr, 10);
+    } else if (std::strcmp(argv[argi], "-r") == 0) {
+      record_size = std::strtoull(argv[argi + 1], nullptr, 10);
+    } else {
+      break;
+    }
+    argi += 2;
+  }
+
+  std::string_view output{argc - argi == 2 ? argv[argi + 1] : ""};
+  if (argc - argi != 2 || block_instructions == 0 || record_size == 0 || !(ends_with(output, "gz") || ends_with(output, "xz") || ends_with(output, "zst"))) {
+    std::cerr << "usage: " << argv[0] << " [-b BLOCK_INSTRUCTIONS] [-r RECORD_BYTES] INPUT_TRACE OUTPUT_TRACE.{gz,xz,zst}\n";
+    return 1;
+  }
+
+  try {
+    auto index = ::reblock(argv[argi], argv[argi + 1], block_instructions, record_size);
+    std::ofstream index_file{champsim::trace_index_name(output)};
+    champsim::write_trace_index(index_file, index);
+    std::cout << "Wrote " << std::size(index.entries) << " blocks to " << output << " and its index to " << champsim::trace_index_name(output) << '\n';
+    return index_file.good() ? 0 : 1;
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    return 1;
+  }
+}
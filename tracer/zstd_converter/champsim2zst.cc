@@ -0,0 +1,84 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "../../inc/inf_stream.h"
+#include "../../inc/zstd_seekable.h"
+
+namespace
+{
+template <typename F>
+void copy_to(F& source, champsim::zstd_seekable_ostream& dest)
+{
+  std::array<char, 1 << 16> buffer;
+  do {
+    source.read(std::data(buffer), std::size(buffer));
+    dest.write(std::data(buffer), static_cast<std::size_t>(source.gcount()));
+  } while (!source.eof() && source.gcount() > 0);
+}
+
+bool ends_with(std::string_view name, std::string_view suffix)
+{
+  return name.size() >= suffix.size() && name.substr(name.size() - suffix.size()) == suffix;
+}
+
+void convert(const std::string& input, champsim::zstd_seekable_ostream& dest)
+{
+  if (ends_with(input, "xz")) {
+    champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<>> source{input};
+    copy_to(source, dest);
+  } else if (ends_with(input, "gz")) {
+    champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>> source{input};
+    copy_to(source, dest);
+  } else if (ends_with(input, "bz2")) {
+    champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t> source{input};
+    copy_to(source, dest);
+  } else {
+    std::ifstream source{input, std::ios::binary};
+    copy_to(source, dest);
+  }
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+  std::size_t frame_size = champsim::zstd_seekable_ostream::default_frame_size;
+  int argi = 1;
+  if (argc > 2 && std::strcmp(argv[argi], "-f") == 0) {
+    frame_size = std::strtoull(argv[argi + 1], nullptr, 10);
+    argi += 2;
+  }
+
+  if (argc - argi != 2 || frame_size == 0) {
+    std::cerr << "usage: " << argv[0] << " [-f FRAME_BYTES] INPUT_TRACE OUTPUT_TRACE.zst\n";
+    return 1;
+  }
+
+  std::ofstream output{argv[argi + 1], std::ios::binary};
+  champsim::zstd_seekable_ostream dest{output, frame_size};
+  ::convert(argv[argi], dest);
+  dest.close();
+
+  std::cout << "Wrote " << std::size(dest.frame_table()) << " frames to " << argv[argi + 1] << '\n';
+  return output.good() ? 0 : 1;
+}
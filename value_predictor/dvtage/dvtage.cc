@@ -0,0 +1,146 @@
+#include "dvtage.h"
+
+#include <algorithm>
+
+#include "checkpoint.h"
+
+auto dvtage::lookup(champsim::address ip) const -> prediction_result
+{
+  auto pc = ip.to<uint64_t>() >> 2;
+
+  prediction_result result;
+  result.ip = ip;
+  result.lvt_index = pc % LVT_SIZE;
+  result.lvt_tag = (pc / LVT_SIZE) & champsim::msl::bitmask(LVT_TAG_BITS);
+  result.base_index = pc % BASE_SIZE;
+  for (std::size_t i = 0; i < NTABLES; ++i) {
+    result.indices[i] = (pc ^ (pc >> champsim::to_underlying(TABLE_INDEX_BITS)) ^ index_history[i].value()) & champsim::msl::bitmask(TABLE_INDEX_BITS);
+    result.tags[i] = (pc ^ (tag_history[i].value() << 1) ^ i) & champsim::msl::bitmask(TAG_BITS);
+  }
+
+  // The longest hitting history provides the stride
+  for (std::size_t i = NTABLES; i > 0; --i) {
+    if (tables[i - 1][result.indices[i - 1]].tag == result.tags[i - 1]) {
+      result.provider = i - 1;
+      break;
+    }
+  }
+
+  return result;
+}
+
+std::pair<uint64_t, bool> dvtage::predict_value(champsim::address ip)
+{
+  auto result = lookup(ip);
+  inflight_predictions.push(result);
+
+  auto& lvt = last_value_table[result.lvt_index];
+  if (lvt.tag != result.lvt_tag)
+    return {0, false};
+
+  // Each instance still in flight advances the value by one stride
+  ++lvt.inflight;
+
+  if (result.provider == NTABLES) {
+    const auto& e = base_table[result.base_index];
+    return {lvt.last_value + static_cast<uint64_t>(e.stride) * lvt.inflight, e.confidence.is_max()};
+  }
+
+  const auto& e = tables[result.provider][result.indices[result.provider]];
+  return {lvt.last_value + static_cast<uint64_t>(e.stride) * lvt.inflight, e.confidence.is_max()};
+}
+
+void dvtage::allocate(const prediction_result& result, int64_t actual_stride)
+{
+  auto first = (result.provider == NTABLES) ? 0 : result.provider + 1;
+  for (auto i = first; i < NTABLES; ++i) {
+    auto& e = tables[i][result.indices[i]];
+    if (!e.useful) {
+      e = tagged_entry{result.tags[i], actual_stride, {}, false};
+      return;
+    }
+  }
+
+  // No victim could be found, so age the candidates
+  for (auto i = first; i < NTABLES; ++i)
+    tables[i][result.indices[i]].useful = false;
+}
+
+void dvtage::update_value(champsim::address ip, uint64_t actual_value, uint64_t predicted_value, bool confident)
+{
+  auto held = inflight_predictions.take(ip);
+  auto result = held.has_value() ? *held : lookup(ip);
+
+  auto& lvt = last_value_table[result.lvt_index];
+  if (lvt.tag != result.lvt_tag) {
+    lvt = lvt_entry{result.lvt_tag, actual_value, 0};
+    return;
+  }
+
+  if (lvt.inflight > 0)
+    --lvt.inflight;
+
+  auto actual_stride = static_cast<int64_t>(actual_value - lvt.last_value);
+  lvt.last_value = actual_value;
+
+  auto train = [&](auto& e) {
+    bool correct = (e.stride == actual_stride);
+    if (correct) {
+      e.confidence.increment(rng, CONF_PROBABILITY);
+    } else if (e.confidence.value() == 0) {
+      e.stride = actual_stride; // only replace the stride once the confidence has drained away
+    } else {
+      e.confidence.reset();
+    }
+    return correct;
+  };
+
+  if (result.provider == NTABLES) {
+    if (!train(base_table[result.base_index]))
+      allocate(result, actual_stride);
+    return;
+  }
+
+  auto& provider = tables[result.provider][result.indices[result.provider]];
+  bool provider_correct = train(provider);
+
+  // The provider was useful if the base table would have been wrong
+  if (provider_correct && base_table[result.base_index].stride != actual_stride)
+    provider.useful = true;
+
+  if (!provider_correct)
+    allocate(result, actual_stride);
+}
+
+void dvtage::value_predictor_branch_operate(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type)
+{
+  // Include one bit of the branch address as path history
+  auto path_bit = ((ip.to<uint64_t>() >> 2) & 1) != 0;
+  for (auto& hist : index_history) {
+    hist.push_back(taken);
+    hist.push_back(path_bit);
+  }
+  for (auto& hist : tag_history) {
+    hist.push_back(taken);
+    hist.push_back(path_bit);
+  }
+}
+
+// The last values are saved with the stride tables. Their in-flight counts are cleared on restore, since the restored core starts with no loads in flight.
+void dvtage::value_predictor_save_checkpoint(std::ostream& os) const
+{
+  champsim::checkpoint::write(os, last_value_table);
+  champsim::checkpoint::write(os, base_table);
+  champsim::checkpoint::write(os, tables);
+  champsim::checkpoint::write(os, rng);
+}
+
+void dvtage::value_predictor_restore_checkpoint(std::istream& is)
+{
+  champsim::checkpoint::read(is, last_value_table);
+  champsim::checkpoint::read(is, base_table);
+  champsim::checkpoint::read(is, tables);
+  champsim::checkpoint::read(is, rng);
+  for (auto& lvt : last_value_table)
+    lvt.inflight = 0;
+}
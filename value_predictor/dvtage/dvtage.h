@@ -0,0 +1,100 @@
+#ifndef VALUE_PREDICTOR_DVTAGE_H
+#define VALUE_PREDICTOR_DVTAGE_H
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <numeric>
+#include <random>
+#include <utility>
+
+#include "address.h"
+#include "modules.h"
+#include "msl/bits.h"
+#include "msl/folded_shift_register.h"
+#include "msl/fpcounter.h"
+#include "msl/prediction_queue.h"
+
+/**
+ * The D-VTAGE value predictor, after Perais and Seznec, "BeBoP: A Cost Effective Predictor Infrastructure for Superscalar Value Prediction," HPCA 2015.
+ * A tagged last-value table holds the most recent value of each instruction, and a VTAGE-like structure predicts the stride from that value.
+ */
+class dvtage : champsim::modules::value_predictor
+{
+  using bits = champsim::data::bits;
+  constexpr static std::size_t NTABLES = 6;          // number of tagged components
+  constexpr static std::size_t LVT_SIZE = 1 << 12;   // entries in the last value table
+  constexpr static std::size_t BASE_SIZE = 1 << 12;  // entries in the base stride table
+  constexpr static std::size_t TABLE_SIZE = 1 << 10; // entries in each tagged component
+  constexpr static bits TABLE_INDEX_BITS{champsim::msl::lg2(TABLE_SIZE)};
+  constexpr static bits TAG_BITS{12};
+  constexpr static bits LVT_TAG_BITS{14};
+  constexpr static std::size_t CONF_BITS = 3;
+
+  constexpr static std::array<bits, NTABLES> history_lengths = {bits{2}, bits{4}, bits{8}, bits{16}, bits{32}, bits{64}};
+
+  static constexpr champsim::msl::fpcounter<CONF_BITS>::probability_vector CONF_PROBABILITY = {1, 16, 16, 16, 16, 16, 32};
+
+  struct lvt_entry {
+    uint64_t tag = 0;
+    uint64_t last_value = 0;
+    uint64_t inflight = 0;
+  };
+
+  struct base_entry {
+    int64_t stride = 0;
+    champsim::msl::fpcounter<CONF_BITS> confidence{};
+  };
+
+  struct tagged_entry {
+    uint64_t tag = 0;
+    int64_t stride = 0;
+    champsim::msl::fpcounter<CONF_BITS> confidence{};
+    bool useful = false;
+  };
+
+  std::array<lvt_entry, LVT_SIZE> last_value_table{};
+  std::array<base_entry, BASE_SIZE> base_table{};
+  std::array<std::array<tagged_entry, TABLE_SIZE>, NTABLES> tables{};
+
+  using index_history_type = folded_shift_register<TABLE_INDEX_BITS>;
+  using tag_history_type = folded_shift_register<TAG_BITS>;
+  std::array<index_history_type, NTABLES> index_history = []() {
+    decltype(index_history) retval;
+    std::transform(std::cbegin(history_lengths), std::cend(history_lengths), std::begin(retval), [](const auto len) { return index_history_type{len}; });
+    return retval;
+  }();
+  std::array<tag_history_type, NTABLES> tag_history = []() {
+    decltype(tag_history) retval;
+    std::transform(std::cbegin(history_lengths), std::cend(history_lengths), std::begin(retval), [](const auto len) { return tag_history_type{len}; });
+    return retval;
+  }();
+
+  struct prediction_result {
+    champsim::address ip{};
+    std::size_t lvt_index = 0;
+    uint64_t lvt_tag = 0;
+    std::size_t base_index = 0;
+    std::array<std::size_t, NTABLES> indices = {};
+    std::array<uint64_t, NTABLES> tags = {};
+    std::size_t provider = NTABLES; // NTABLES indicates the base table
+  };
+
+  champsim::msl::prediction_queue<prediction_result> inflight_predictions{};
+
+  std::minstd_rand rng{};
+
+  [[nodiscard]] prediction_result lookup(champsim::address ip) const;
+  void allocate(const prediction_result& result, int64_t actual_stride);
+
+public:
+  using value_predictor::value_predictor;
+
+  std::pair<uint64_t, bool> predict_value(champsim::address ip);
+  void update_value(champsim::address ip, uint64_t actual_value, uint64_t predicted_value, bool confident);
+  void value_predictor_branch_operate(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+  void value_predictor_save_checkpoint(std::ostream& os) const;
+  void value_predictor_restore_checkpoint(std::istream& is);
+};
+
+#endif
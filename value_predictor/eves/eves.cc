@@ -0,0 +1,160 @@
+#include "eves.h"
+
+#include <algorithm>
+
+#include "checkpoint.h"
+
+auto eves::lookup(champsim::address ip) const -> prediction_result
+{
+  auto pc = ip.to<uint64_t>() >> 2;
+
+  prediction_result result;
+  result.ip = ip;
+  for (std::size_t i = 0; i < NTABLES; ++i) {
+    result.indices[i] = (pc ^ (pc >> champsim::to_underlying(TABLE_INDEX_BITS)) ^ index_history[i].value()) & champsim::msl::bitmask(TABLE_INDEX_BITS);
+    result.tags[i] = (pc ^ (tag_history[i].value() << 1) ^ i) & champsim::msl::bitmask(TAG_BITS);
+  }
+
+  // The longest hitting history provides the prediction
+  for (std::size_t i = NTABLES; i > 0; --i) {
+    if (tables[i - 1][result.indices[i - 1]].tag == result.tags[i - 1]) {
+      result.provider = i - 1;
+      break;
+    }
+  }
+
+  result.stride_index = pc % STRIDE_SIZE;
+  result.stride_tag = (pc / STRIDE_SIZE) & champsim::msl::bitmask(STRIDE_TAG_BITS);
+
+  return result;
+}
+
+std::pair<uint64_t, bool> eves::predict_value(champsim::address ip)
+{
+  auto result = lookup(ip);
+
+  std::pair<uint64_t, bool> vtage_prediction{0, false};
+  if (result.provider != NTABLES) {
+    const auto& e = tables[result.provider][result.indices[result.provider]];
+    vtage_prediction = {e.value, e.confidence.is_max()};
+  }
+
+  std::pair<uint64_t, bool> stride_prediction{0, false};
+  if (auto& e = stride_table[result.stride_index]; e.tag == result.stride_tag) {
+    // Each instance still in flight advances the value by one stride
+    ++e.inflight;
+    result.stride_predicted = true;
+    stride_prediction = {e.last_value + static_cast<uint64_t>(e.stride) * e.inflight, e.confidence.is_max()};
+  }
+
+  inflight_predictions.push(result);
+
+  if (vtage_prediction.second)
+    return vtage_prediction;
+  if (stride_prediction.second || result.provider == NTABLES)
+    return stride_prediction;
+  return vtage_prediction;
+}
+
+void eves::update_vtage(const prediction_result& result, uint64_t actual_value)
+{
+  auto first = std::size_t{0};
+  if (result.provider != NTABLES) {
+    auto& e = tables[result.provider][result.indices[result.provider]];
+    if (e.value == actual_value) {
+      e.confidence.increment(rng, VTAGE_CONF_PROBABILITY);
+      e.useful = true;
+      return;
+    }
+
+    if (e.confidence.value() == 0) {
+      e.value = actual_value; // only replace the value once the confidence has drained away
+    } else {
+      e.confidence.reset();
+    }
+    e.useful = false;
+    first = result.provider + 1;
+  }
+
+  // Allocate in a longer history. Values the stride predictor already covers are not allocated, to save space.
+  if (const auto& s = stride_table[result.stride_index]; s.tag == result.stride_tag && s.confidence.is_max()
+                                                           && s.last_value + static_cast<uint64_t>(s.stride) == actual_value) {
+    return;
+  }
+
+  for (auto i = first; i < NTABLES; ++i) {
+    auto& e = tables[i][result.indices[i]];
+    if (!e.useful) {
+      e = tagged_entry{result.tags[i], actual_value, {}, false};
+      return;
+    }
+  }
+
+  // No victim could be found, so age the candidates
+  for (auto i = first; i < NTABLES; ++i)
+    tables[i][result.indices[i]].useful = false;
+}
+
+void eves::update_stride(const prediction_result& result, uint64_t actual_value)
+{
+  auto& e = stride_table[result.stride_index];
+  if (e.tag != result.stride_tag) {
+    e = stride_entry{};
+    e.tag = result.stride_tag;
+    e.last_value = actual_value;
+    return;
+  }
+
+  if (result.stride_predicted && e.inflight > 0)
+    --e.inflight;
+
+  auto actual_stride = static_cast<int64_t>(actual_value - e.last_value);
+  if (actual_stride == e.stride) {
+    e.confidence.increment(rng, STRIDE_CONF_PROBABILITY);
+  } else {
+    e.stride = actual_stride;
+    e.confidence.reset();
+  }
+  e.last_value = actual_value;
+}
+
+void eves::update_value(champsim::address ip, uint64_t actual_value, uint64_t predicted_value, bool confident)
+{
+  auto held = inflight_predictions.take(ip);
+  auto result = held.has_value() ? *held : lookup(ip);
+
+  // The VTAGE filter consults the stride table before it is trained on this value
+  update_vtage(result, actual_value);
+  update_stride(result, actual_value);
+}
+
+void eves::value_predictor_branch_operate(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type)
+{
+  // Include one bit of the branch address as path history
+  auto path_bit = ((ip.to<uint64_t>() >> 2) & 1) != 0;
+  for (auto& hist : index_history) {
+    hist.push_back(taken);
+    hist.push_back(path_bit);
+  }
+  for (auto& hist : tag_history) {
+    hist.push_back(taken);
+    hist.push_back(path_bit);
+  }
+}
+
+// The stride entries count the instances of each load in flight, which the restored core has none of, so those counts are cleared on restore
+void eves::value_predictor_save_checkpoint(std::ostream& os) const
+{
+  champsim::checkpoint::write(os, tables);
+  champsim::checkpoint::write(os, stride_table);
+  champsim::checkpoint::write(os, rng);
+}
+
+void eves::value_predictor_restore_checkpoint(std::istream& is)
+{
+  champsim::checkpoint::read(is, tables);
+  champsim::checkpoint::read(is, stride_table);
+  champsim::checkpoint::read(is, rng);
+  for (auto& e : stride_table)
+    e.inflight = 0;
+}
@@ -0,0 +1,98 @@
+#ifndef VALUE_PREDICTOR_EVES_H
+#define VALUE_PREDICTOR_EVES_H
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <numeric>
+#include <random>
+#include <utility>
+
+#include "address.h"
+#include "modules.h"
+#include "msl/bits.h"
+#include "msl/folded_shift_register.h"
+#include "msl/fpcounter.h"
+#include "msl/prediction_queue.h"
+
+/**
+ * The EVES value predictor, after Seznec, "Exploring value prediction with the EVES predictor," CVP-1 2018.
+ * An enhanced VTAGE, which has no untagged base table, is paired with a tagged stride predictor.
+ * The VTAGE component is preferred when it is confident.
+ */
+class eves : champsim::modules::value_predictor
+{
+  using bits = champsim::data::bits;
+  constexpr static std::size_t NTABLES = 6;             // number of tagged E-VTAGE components
+  constexpr static std::size_t TABLE_SIZE = 1 << 10;    // entries in each tagged component
+  constexpr static std::size_t STRIDE_SIZE = 1 << 11;   // entries in the E-Stride table
+  constexpr static bits TABLE_INDEX_BITS{champsim::msl::lg2(TABLE_SIZE)};
+  constexpr static bits TAG_BITS{12};
+  constexpr static bits STRIDE_TAG_BITS{14};
+  constexpr static std::size_t CONF_BITS = 3;
+
+  constexpr static std::array<bits, NTABLES> history_lengths = {bits{0}, bits{2}, bits{5}, bits{11}, bits{23}, bits{47}};
+
+  static constexpr champsim::msl::fpcounter<CONF_BITS>::probability_vector VTAGE_CONF_PROBABILITY = {1, 16, 16, 16, 16, 16, 32};
+  static constexpr champsim::msl::fpcounter<CONF_BITS>::probability_vector STRIDE_CONF_PROBABILITY = {1, 4, 4, 8, 8, 8, 16};
+
+  struct tagged_entry {
+    uint64_t tag = 0;
+    uint64_t value = 0;
+    champsim::msl::fpcounter<CONF_BITS> confidence{};
+    bool useful = false;
+  };
+
+  struct stride_entry {
+    uint64_t tag = 0;
+    uint64_t last_value = 0;
+    int64_t stride = 0;
+    uint64_t inflight = 0;
+    champsim::msl::fpcounter<CONF_BITS> confidence{};
+  };
+
+  std::array<std::array<tagged_entry, TABLE_SIZE>, NTABLES> tables{};
+  std::array<stride_entry, STRIDE_SIZE> stride_table{};
+
+  using index_history_type = folded_shift_register<TABLE_INDEX_BITS>;
+  using tag_history_type = folded_shift_register<TAG_BITS>;
+  std::array<index_history_type, NTABLES> index_history = []() {
+    decltype(index_history) retval;
+    std::transform(std::cbegin(history_lengths), std::cend(history_lengths), std::begin(retval), [](const auto len) { return index_history_type{len}; });
+    return retval;
+  }();
+  std::array<tag_history_type, NTABLES> tag_history = []() {
+    decltype(tag_history) retval;
+    std::transform(std::cbegin(history_lengths), std::cend(history_lengths), std::begin(retval), [](const auto len) { return tag_history_type{len}; });
+    return retval;
+  }();
+
+  struct prediction_result {
+    champsim::address ip{};
+    std::array<std::size_t, NTABLES> indices = {};
+    std::array<uint64_t, NTABLES> tags = {};
+    std::size_t provider = NTABLES; // NTABLES indicates that no component hit
+    std::size_t stride_index = 0;
+    uint64_t stride_tag = 0;
+    bool stride_predicted = false;
+  };
+
+  champsim::msl::prediction_queue<prediction_result> inflight_predictions{};
+
+  std::minstd_rand rng{};
+
+  [[nodiscard]] prediction_result lookup(champsim::address ip) const;
+  void update_vtage(const prediction_result& result, uint64_t actual_value);
+  void update_stride(const prediction_result& result, uint64_t actual_value);
+
+public:
+  using value_predictor::value_predictor;
+
+  std::pair<uint64_t, bool> predict_value(champsim::address ip);
+  void update_value(champsim::address ip, uint64_t actual_value, uint64_t predicted_value, bool confident);
+  void value_predictor_branch_operate(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+  void value_predictor_save_checkpoint(std::ostream& os) const;
+  void value_predictor_restore_checkpoint(std::istream& is);
+};
+
+#endif
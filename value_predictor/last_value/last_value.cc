@@ -0,0 +1,36 @@
+#include "last_value.h"
+
+#include "checkpoint.h"
+
+std::pair<uint64_t, bool> last_value::predict_value(champsim::address ip)
+{
+  const auto& e = table[index(ip)];
+  if (e.tag != tag(ip))
+    return {0, false};
+  return {e.value, e.confidence.is_max()};
+}
+
+void last_value::update_value(champsim::address ip, uint64_t actual_value, uint64_t predicted_value, bool confident)
+{
+  auto& e = table[index(ip)];
+  if (e.tag != tag(ip)) {
+    e = entry{tag(ip), actual_value, {}};
+  } else if (e.value == actual_value) {
+    e.confidence.increment(rng, CONF_PROBABILITY);
+  } else {
+    e.value = actual_value;
+    e.confidence.reset();
+  }
+}
+
+void last_value::value_predictor_save_checkpoint(std::ostream& os) const
+{
+  champsim::checkpoint::write(os, table);
+  champsim::checkpoint::write(os, rng);
+}
+
+void last_value::value_predictor_restore_checkpoint(std::istream& is)
+{
+  champsim::checkpoint::read(is, table);
+  champsim::checkpoint::read(is, rng);
+}
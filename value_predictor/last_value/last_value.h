@@ -0,0 +1,44 @@
+#ifndef VALUE_PREDICTOR_LAST_VALUE_H
+#define VALUE_PREDICTOR_LAST_VALUE_H
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <random>
+#include <utility>
+
+#include "address.h"
+#include "modules.h"
+#include "msl/fpcounter.h"
+
+class last_value : champsim::modules::value_predictor
+{
+  [[nodiscard]] static constexpr auto index(champsim::address ip) { return (ip.to<uint64_t>() >> 2) % TABLE_SIZE; }
+  [[nodiscard]] static constexpr auto tag(champsim::address ip) { return ((ip.to<uint64_t>() >> 2) / TABLE_SIZE) % (1ull << TAG_BITS); }
+
+  static constexpr std::size_t TABLE_SIZE = 4096;
+  static constexpr std::size_t TAG_BITS = 14;
+  static constexpr std::size_t CONF_BITS = 3;
+
+  // The counter saturates after about 40 consecutive correct predictions
+  static constexpr champsim::msl::fpcounter<CONF_BITS>::probability_vector CONF_PROBABILITY = {1, 2, 4, 8, 8, 8, 8};
+
+  struct entry {
+    uint64_t tag = 0;
+    uint64_t value = 0;
+    champsim::msl::fpcounter<CONF_BITS> confidence{};
+  };
+
+  std::array<entry, TABLE_SIZE> table{};
+  std::minstd_rand rng{};
+
+public:
+  using value_predictor::value_predictor;
+
+  std::pair<uint64_t, bool> predict_value(champsim::address ip);
+  void update_value(champsim::address ip, uint64_t actual_value, uint64_t predicted_value, bool confident);
+  void value_predictor_save_checkpoint(std::ostream& os) const;
+  void value_predictor_restore_checkpoint(std::istream& is);
+};
+
+#endif
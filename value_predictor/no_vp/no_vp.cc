@@ -0,0 +1,7 @@
+#include "no_vp.h"
+
+std::pair<uint64_t, bool> no_vp::predict_value(champsim::address ip)
+{
+  // Never confident, so no consumer is ever woken early
+  return {0, false};
+}
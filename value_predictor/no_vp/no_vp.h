@@ -0,0 +1,21 @@
+#ifndef VALUE_PREDICTOR_NO_VP_H
+#define VALUE_PREDICTOR_NO_VP_H
+
+#include <cstdint>
+#include <utility>
+
+#include "address.h"
+#include "modules.h"
+
+class no_vp : champsim::modules::value_predictor
+{
+public:
+  using value_predictor::value_predictor;
+
+  // void initialize_value_predictor() {}
+  std::pair<uint64_t, bool> predict_value(champsim::address ip);
+  // void update_value(champsim::address ip, uint64_t actual_value, uint64_t predicted_value, bool confident) {}
+  // void value_predictor_branch_operate(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type) {}
+};
+
+#endif
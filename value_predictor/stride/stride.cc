@@ -0,0 +1,54 @@
+#include "stride.h"
+
+#include "checkpoint.h"
+
+std::pair<uint64_t, bool> stride::predict_value(champsim::address ip)
+{
+  auto& e = table[index(ip)];
+  if (e.tag != tag(ip))
+    return {0, false};
+
+  ++e.inflight;
+  return {e.last_value + static_cast<uint64_t>(e.stride1) * e.inflight, e.confidence.is_max()};
+}
+
+void stride::update_value(champsim::address ip, uint64_t actual_value, uint64_t predicted_value, bool confident)
+{
+  auto& e = table[index(ip)];
+  if (e.tag != tag(ip)) {
+    e = entry{};
+    e.tag = tag(ip);
+    e.last_value = actual_value;
+    return;
+  }
+
+  if (e.inflight > 0)
+    --e.inflight;
+
+  auto observed_stride = static_cast<int64_t>(actual_value - e.last_value);
+  if (observed_stride == e.stride1) {
+    e.confidence.increment(rng, CONF_PROBABILITY);
+  } else {
+    e.confidence.reset();
+    if (observed_stride == e.stride2)
+      e.stride1 = observed_stride;
+  }
+
+  e.stride2 = observed_stride;
+  e.last_value = actual_value;
+}
+
+// The instances in flight are not saved, and are fetched again by the restored run
+void stride::value_predictor_save_checkpoint(std::ostream& os) const
+{
+  champsim::checkpoint::write(os, table);
+  champsim::checkpoint::write(os, rng);
+}
+
+void stride::value_predictor_restore_checkpoint(std::istream& is)
+{
+  champsim::checkpoint::read(is, table);
+  champsim::checkpoint::read(is, rng);
+  for (auto& e : table)
+    e.inflight = 0;
+}
@@ -0,0 +1,50 @@
+#ifndef VALUE_PREDICTOR_STRIDE_H
+#define VALUE_PREDICTOR_STRIDE_H
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <random>
+#include <utility>
+
+#include "address.h"
+#include "modules.h"
+#include "msl/fpcounter.h"
+
+/**
+ * A 2-delta stride predictor. The stride used for prediction is only replaced once the same new stride has been observed twice in a row.
+ * Instances that are still in flight between prediction and retirement are accounted for, so that back-to-back instances predict successive values.
+ */
+class stride : champsim::modules::value_predictor
+{
+  [[nodiscard]] static constexpr auto index(champsim::address ip) { return (ip.to<uint64_t>() >> 2) % TABLE_SIZE; }
+  [[nodiscard]] static constexpr auto tag(champsim::address ip) { return ((ip.to<uint64_t>() >> 2) / TABLE_SIZE) % (1ull << TAG_BITS); }
+
+  static constexpr std::size_t TABLE_SIZE = 4096;
+  static constexpr std::size_t TAG_BITS = 14;
+  static constexpr std::size_t CONF_BITS = 3;
+
+  static constexpr champsim::msl::fpcounter<CONF_BITS>::probability_vector CONF_PROBABILITY = {1, 2, 4, 8, 8, 8, 8};
+
+  struct entry {
+    uint64_t tag = 0;
+    uint64_t last_value = 0;
+    int64_t stride1 = 0; // the stride used for prediction
+    int64_t stride2 = 0; // the most recently observed stride
+    uint64_t inflight = 0;
+    champsim::msl::fpcounter<CONF_BITS> confidence{};
+  };
+
+  std::array<entry, TABLE_SIZE> table{};
+  std::minstd_rand rng{};
+
+public:
+  using value_predictor::value_predictor;
+
+  std::pair<uint64_t, bool> predict_value(champsim::address ip);
+  void update_value(champsim::address ip, uint64_t actual_value, uint64_t predicted_value, bool confident);
+  void value_predictor_save_checkpoint(std::ostream& os) const;
+  void value_predictor_restore_checkpoint(std::istream& is);
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef VALUE_PREDICTOR_VTAGE_H
+#define VALUE_PREDICTOR_VTAGE_H
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <numeric>
+#include <random>
+#include <utility>
+
+#include "address.h"
+#include "modules.h"
+#include "msl/bits.h"
+#include "msl/folded_shift_register.h"
+#include "msl/fpcounter.h"
+#include "msl/prediction_queue.h"
+
+/**
+ * The VTAGE value predictor, after Perais and Seznec, "Practical Data Value Speculation for Future High-end Processors," HPCA 2014.
+ * A last-value base table is backed by several tagged components indexed with geometrically increasing lengths of global branch history.
+ * The longest matching component provides the prediction.
+ */
+class vtage : champsim::modules::value_predictor
+{
+  using bits = champsim::data::bits;
+  constexpr static std::size_t NTABLES = 6;            // number of tagged components
+  constexpr static std::size_t BASE_SIZE = 1 << 12;    // entries in the base table
+  constexpr static std::size_t TABLE_SIZE = 1 << 10;   // entries in each tagged component
+  constexpr static bits TABLE_INDEX_BITS{champsim::msl::lg2(TABLE_SIZE)};
+  constexpr static bits TAG_BITS{12};
+  constexpr static std::size_t CONF_BITS = 3;
+
+  constexpr static std::array<bits, NTABLES> history_lengths = {bits{2}, bits{4}, bits{8}, bits{16}, bits{32}, bits{64}};
+
+  static constexpr champsim::msl::fpcounter<CONF_BITS>::probability_vector CONF_PROBABILITY = {1, 16, 16, 16, 16, 16, 32};
+
+  struct base_entry {
+    uint64_t value = 0;
+    champsim::msl::fpcounter<CONF_BITS> confidence{};
+  };
+
+  struct tagged_entry {
+    uint64_t tag = 0;
+    uint64_t value = 0;
+    champsim::msl::fpcounter<CONF_BITS> confidence{};
+    bool useful = false;
+  };
+
+  std::array<base_entry, BASE_SIZE> base_table{};
+  std::array<std::array<tagged_entry, TABLE_SIZE>, NTABLES> tables{};
+
+  using index_history_type = folded_shift_register<TABLE_INDEX_BITS>;
+  using tag_history_type = folded_shift_register<TAG_BITS>;
+  std::array<index_history_type, NTABLES> index_history = []() {
+    decltype(index_history) retval;
+    std::transform(std::cbegin(history_lengths), std::cend(history_lengths), std::begin(retval), [](const auto len) { return index_history_type{len}; });
+    return retval;
+  }();
+  std::array<tag_history_type, NTABLES> tag_history = []() {
+    decltype(tag_history) retval;
+    std::transform(std::cbegin(history_lengths), std::cend(history_lengths), std::begin(retval), [](const auto len) { return tag_history_type{len}; });
+    return retval;
+  }();
+
+  struct prediction_result {
+    champsim::address ip{};
+    std::size_t base_index = 0;
+    std::array<std::size_t, NTABLES> indices = {};
+    std::array<uint64_t, NTABLES> tags = {};
+    std::size_t provider = NTABLES; // NTABLES indicates the base table
+  };
+
+  champsim::msl::prediction_queue<prediction_result> inflight_predictions{};
+
+  std::minstd_rand rng{};
+
+  [[nodiscard]] prediction_result lookup(champsim::address ip) const;
+  void allocate(const prediction_result& result, uint64_t actual_value);
+
+public:
+  using value_predictor::value_predictor;
+
+  std::pair<uint64_t, bool> predict_value(champsim::address ip);
+  void update_value(champsim::address ip, uint64_t actual_value, uint64_t predicted_value, bool confident);
+  void value_predictor_branch_operate(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+  void value_predictor_save_checkpoint(std::ostream& os) const;
+  void value_predictor_restore_checkpoint(std::istream& is);
+};
+
+#endif